@@ -0,0 +1,126 @@
+/**
+ * @file AllocTracker.cpp
+ * @brief Implementacja licznika alokacji i podmiana globalnych operatorów new/delete.
+ */
+
+#include "AllocTracker.h"
+
+#ifdef FLAPPY_TRACK_ALLOCS
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<std::uint64_t> allocationCount{0}; /**< Liczba alokacji od startu programu. */
+std::atomic<std::uint64_t> allocatedBytes{0}; /**< Liczba zaalokowanych bajtów od startu programu. */
+thread_local bool enforced = false; /**< Czy alokacje w tym wątku są zabronione. */
+
+/**
+ * @brief Zlicza alokację i przerywa program, jeśli wątek wymusza brak alokacji.
+ *
+ * @param size Rozmiar alokacji.
+ */
+void track(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    if (enforced) {
+        enforced = false;
+        std::fprintf(stderr, "AllocTracker: alokacja %zu bajtow w petli gry po rozgrzewce\n", size);
+        std::abort();
+    }
+}
+
+/**
+ * @brief Alokuje pamięć i zlicza alokację.
+ *
+ * @param size Rozmiar alokacji.
+ * @return Wskaźnik na pamięć lub nullptr.
+ */
+void* allocate(std::size_t size) {
+    track(size);
+    return std::malloc(size ? size : 1);
+}
+
+/**
+ * @brief Alokuje wyrównaną pamięć i zlicza alokację.
+ *
+ * @param size Rozmiar alokacji.
+ * @param align Wymagane wyrównanie.
+ * @return Wskaźnik na pamięć lub nullptr.
+ */
+void* allocateAligned(std::size_t size, std::align_val_t align) {
+    track(size);
+#ifdef _WIN32
+    return _aligned_malloc(size ? size : 1, static_cast<std::size_t>(align));
+#else
+    void* ptr = nullptr;
+    if (posix_memalign(&ptr, static_cast<std::size_t>(align), size ? size : 1) != 0) return nullptr;
+    return ptr;
+#endif
+}
+
+/**
+ * @brief Zwalnia pamięć zaalokowaną przez allocateAligned.
+ *
+ * @param ptr Wskaźnik na pamięć.
+ */
+void freeAligned(void* ptr) {
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+}
+
+void* operator new(std::size_t size) {
+    if (void* ptr = allocate(size)) return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    if (void* ptr = allocate(size)) return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+
+void* operator new(std::size_t size, std::align_val_t align) {
+    if (void* ptr = allocateAligned(size, align)) return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t align) {
+    if (void* ptr = allocateAligned(size, align)) return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { freeAligned(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { freeAligned(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { freeAligned(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { freeAligned(ptr); }
+
+bool AllocTracker::enabled() { return true; }
+std::uint64_t AllocTracker::allocations() { return allocationCount.load(std::memory_order_relaxed); }
+std::uint64_t AllocTracker::bytes() { return allocatedBytes.load(std::memory_order_relaxed); }
+void AllocTracker::setEnforced(bool state) { enforced = state; }
+
+#else
+
+bool AllocTracker::enabled() { return false; }
+std::uint64_t AllocTracker::allocations() { return 0; }
+std::uint64_t AllocTracker::bytes() { return 0; }
+void AllocTracker::setEnforced(bool) {}
+
+#endif
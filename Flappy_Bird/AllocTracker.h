@@ -0,0 +1,78 @@
+/**
+ * @file AllocTracker.h
+ * @brief Licznik alokacji na stercie do wykrywania alokacji w pętli gry.
+ */
+
+#pragma once
+#ifndef ALLOCTRACKER_H
+#define ALLOCTRACKER_H
+
+#include <cstdint>
+
+/**
+ * @brief Licznik alokacji oparty na globalnym operatorze new.
+ *
+ * Działa tylko w kompilacji z FLAPPY_TRACK_ALLOCS (opcja CMake o tej samej
+ * nazwie) - wtedy AllocTracker.cpp podmienia globalne operatory new/delete.
+ * W zwykłej kompilacji wszystkie funkcje zwracają zera i nic nie kosztują.
+ *
+ * W trybie wymuszania (setEnforced) każda alokacja w wątku, który włączył
+ * tryb, przerywa program z komunikatem - w ten sposób regresja w pętli gry
+ * jest wykrywana od razu, a nie dopiero w profilerze.
+ */
+class AllocTracker {
+public:
+    /**
+     * @brief Sprawdza, czy licznik został wkompilowany.
+     *
+     * @return true jeśli operatory new/delete są podmienione.
+     */
+    static bool enabled();
+
+    /**
+     * @brief Zwraca liczbę alokacji od startu programu.
+     *
+     * @return Liczba wywołań operatora new.
+     */
+    static std::uint64_t allocations();
+
+    /**
+     * @brief Zwraca liczbę zaalokowanych bajtów od startu programu.
+     *
+     * @return Suma rozmiarów alokacji.
+     */
+    static std::uint64_t bytes();
+
+    /**
+     * @brief Włącza lub wyłącza wymuszanie braku alokacji w bieżącym wątku.
+     *
+     * @param state Nowy stan wymuszania.
+     */
+    static void setEnforced(bool state);
+
+    /**
+     * @brief Zakres, w którym alokacje w bieżącym wątku są zabronione.
+     */
+    class Scope {
+    public:
+        /**
+         * @brief Włącza wymuszanie, jeśli active jest prawdą.
+         *
+         * @param active Czy zakres ma wymuszać brak alokacji.
+         */
+        explicit Scope(bool active) : active(active) { if (active) setEnforced(true); }
+
+        /**
+         * @brief Wyłącza wymuszanie włączone przez konstruktor.
+         */
+        ~Scope() { if (active) setEnforced(false); }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        bool active; /**< Czy zakres włączył wymuszanie. */
+    };
+};
+
+#endif
@@ -0,0 +1,390 @@
+/**
+ * @file Arena.cpp
+ * @brief Implementacja serwera areny.
+ */
+
+#include "Arena.h"
+#include <algorithm>
+#include <cstring>
+#include "Difficulty.h"
+
+#ifdef __linux__
+#include <cerrno>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Połączenie bota: jego gry i bufory.
+ */
+struct ArenaServer::Connection {
+    int fd = -1; /**< Gniazdo połączenia. */
+    std::size_t slot = 0; /**< Indeks na liście połączeń wątku. */
+    FlappyEnv* env = nullptr; /**< Gry sesji lub nullptr przed Open. */
+    std::uint16_t games = 0; /**< Liczba gier sesji. */
+    bool writing = false; /**< Czy połączenie czeka na możliwość zapisu (EPOLLOUT). */
+
+    std::vector<std::uint8_t> in; /**< Odebrane, jeszcze nieobsłużone bajty. */
+    std::size_t inSize = 0; /**< Liczba bajtów w buforze wejściowym. */
+    std::vector<std::uint8_t> out; /**< Odpowiedź do wysłania. */
+    std::size_t outBegin = 0; /**< Pierwszy niewysłany bajt odpowiedzi. */
+    std::size_t outEnd = 0; /**< Koniec odpowiedzi. */
+
+    std::vector<float> observations; /**< Obserwacje z flappy_env_step. */
+    std::vector<float> rewards; /**< Nagrody z flappy_env_step. */
+    std::vector<std::uint8_t> dones; /**< Flagi zakończenia z flappy_env_step. */
+};
+
+namespace {
+
+const std::size_t inputCapacity = 64 * 1024; /**< Bufor wejściowy mieści kilka żądań największej sesji. */
+
+/**
+ * @brief Zapisuje nagłówek odpowiedzi.
+ *
+ * @param out Bufor odpowiedzi.
+ * @param request Nagłówek żądania.
+ * @param status Wynik obsługi.
+ * @param count Liczba gier w odpowiedzi.
+ */
+void writeHeader(std::uint8_t* out, const ArenaHeader& request, ArenaStatus status, std::uint16_t count) {
+    ArenaHeader response{ArenaHeader::magicValue, request.type, static_cast<std::uint8_t>(status), count, request.seed};
+    std::memcpy(out, &response, sizeof(response));
+}
+
+}
+
+/**
+ * @brief Konstruktor klasy ArenaServer
+ *
+ * @param workers Liczba wątków roboczych
+ */
+ArenaServer::ArenaServer(unsigned workers)
+        : workers(nullptr), workerCount(workers ? workers : std::max(1u, std::thread::hardware_concurrency())),
+          listenFd(-1), stopping(false) {
+}
+
+/**
+ * @brief Destruktor klasy ArenaServer
+ */
+ArenaServer::~ArenaServer() {
+    stop();
+}
+
+/**
+ * @brief Tworzy gniazdo i uruchamia wątki robocze
+ *
+ * @param path Ścieżka gniazda
+ * @return true jeśli serwer działa
+ */
+bool ArenaServer::start(const std::string& path) {
+#ifndef __linux__
+    (void)path;
+    return false;
+#else
+    sockaddr_un addr{};
+    if (path.size() >= sizeof(addr.sun_path)) return false;
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+
+    listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listenFd < 0) return false;
+    unlink(path.c_str());
+    // Gniazdo powstaje z uprawnieniami 0600, zanim ktokolwiek może się połączyć.
+    mode_t mask = umask(0177);
+    bool bound = bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0;
+    umask(mask);
+    if (!bound || listen(listenFd, SOMAXCONN) != 0) {
+        close(listenFd);
+        listenFd = -1;
+        return false;
+    }
+    socketPath = path;
+
+    stopping.store(false);
+    workers = new Worker[workerCount];
+    for (unsigned i = 0; i < workerCount; ++i) {
+        workers[i].epollFd = epoll_create1(EPOLL_CLOEXEC);
+    }
+    for (unsigned i = 0; i < workerCount; ++i) {
+        Worker& worker = workers[i];
+        worker.thread = std::thread([this, &worker] { serve(worker); });
+    }
+    return true;
+#endif
+}
+
+/**
+ * @brief Przyjmuje połączenia, dopóki serwer nie zostanie zatrzymany
+ */
+void ArenaServer::run() {
+#ifdef __linux__
+    unsigned next = 0;
+    while (!stopping.load(std::memory_order_relaxed)) {
+        pollfd pfd{listenFd, POLLIN, 0};
+        if (poll(&pfd, 1, 200) <= 0) continue;
+        while (true) {
+            int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0) break;
+
+            auto* connection = new Connection;
+            connection->fd = fd;
+            connection->in.resize(inputCapacity);
+            connection->out.resize(sizeof(ArenaHeader));
+
+            Worker& worker = workers[next++ % workerCount];
+            {
+                std::lock_guard<std::mutex> lock(worker.mutex);
+                connection->slot = worker.connections.size();
+                worker.connections.push_back(connection);
+            }
+            epoll_event event{};
+            event.events = EPOLLIN;
+            event.data.ptr = connection;
+            epoll_ctl(worker.epollFd, EPOLL_CTL_ADD, fd, &event);
+        }
+    }
+#endif
+}
+
+/**
+ * @brief Zatrzymuje wątki robocze, zamyka połączenia i usuwa plik gniazda
+ */
+void ArenaServer::stop() {
+#ifdef __linux__
+    if (!workers) return;
+    stopping.store(true);
+    for (unsigned i = 0; i < workerCount; ++i) {
+        if (workers[i].thread.joinable()) {
+            workers[i].thread.join();
+        }
+    }
+    for (unsigned i = 0; i < workerCount; ++i) {
+        while (!workers[i].connections.empty()) {
+            closeConnection(workers[i], workers[i].connections.back());
+        }
+        close(workers[i].epollFd);
+    }
+    delete[] workers;
+    workers = nullptr;
+    close(listenFd);
+    listenFd = -1;
+    unlink(socketPath.c_str());
+#endif
+}
+
+/**
+ * @brief Zwraca łączną liczbę wykonanych kroków gier
+ *
+ * @return Liczba kroków
+ */
+std::uint64_t ArenaServer::getGameSteps() const {
+    std::uint64_t total = 0;
+    for (unsigned i = 0; workers && i < workerCount; ++i) {
+        total += workers[i].gameSteps.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+/**
+ * @brief Zwraca łączną liczbę zakończonych gier
+ *
+ * @return Liczba gier
+ */
+std::uint64_t ArenaServer::getGamesFinished() const {
+    std::uint64_t total = 0;
+    for (unsigned i = 0; workers && i < workerCount; ++i) {
+        total += workers[i].gamesFinished.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+/**
+ * @brief Pętla wątku roboczego
+ *
+ * @param worker Wątek
+ */
+void ArenaServer::serve(Worker& worker) {
+#ifdef __linux__
+    epoll_event events[64];
+    while (!stopping.load(std::memory_order_relaxed)) {
+        int n = epoll_wait(worker.epollFd, events, 64, 200);
+        for (int i = 0; i < n; ++i) {
+            auto* connection = static_cast<Connection*>(events[i].data.ptr);
+            bool alive = true;
+            if (events[i].events & EPOLLOUT) {
+                alive = flush(worker, *connection) && (connection->writing || handleRequests(worker, *connection));
+            } else if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+                while (alive && connection->inSize < connection->in.size()) {
+                    ssize_t got = recv(connection->fd, connection->in.data() + connection->inSize,
+                                       connection->in.size() - connection->inSize, 0);
+                    if (got > 0) {
+                        connection->inSize += (std::size_t)got;
+                    } else if (got < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                        break;
+                    } else if (got < 0 && errno == EINTR) {
+                        continue;
+                    } else {
+                        alive = false;
+                    }
+                }
+                alive = alive && handleRequests(worker, *connection);
+            }
+            if (!alive) {
+                closeConnection(worker, connection);
+            }
+        }
+    }
+#else
+    (void)worker;
+#endif
+}
+
+/**
+ * @brief Obsługuje kompletne żądania z bufora wejściowego
+ *
+ * Kolejne żądanie jest obsługiwane dopiero po wysłaniu odpowiedzi na poprzednie.
+ *
+ * @param worker Wątek
+ * @param connection Połączenie
+ * @return false jeśli połączenie trzeba zamknąć
+ */
+bool ArenaServer::handleRequests(Worker& worker, Connection& connection) {
+    std::size_t used = 0;
+    while (!connection.writing && connection.inSize - used >= sizeof(ArenaHeader)) {
+        const std::uint8_t* message = connection.in.data() + used;
+        ArenaHeader request;
+        std::memcpy(&request, message, sizeof(request));
+        if (request.magic != ArenaHeader::magicValue) return false;
+
+        if (request.type == static_cast<std::uint8_t>(ArenaMessage::Open)) {
+            used += sizeof(ArenaHeader);
+            ArenaStatus status = ArenaStatus::Ok;
+            if (request.arg > static_cast<std::uint8_t>(Difficulty::Nightmare)) status = ArenaStatus::BadDifficulty;
+            else if (request.count == 0 || request.count > Arena::maxGames) status = ArenaStatus::BadCount;
+            if (status != ArenaStatus::Ok) {
+                writeHeader(connection.out.data(), request, status, 0);
+                connection.outEnd = sizeof(ArenaHeader);
+            } else {
+                flappy_env_destroy(connection.env);
+                connection.env = flappy_env_create(request.count, request.seed, request.arg);
+                if (!connection.env) return false;
+                connection.games = request.count;
+                connection.observations.assign((std::size_t)request.count * FLAPPY_ENV_OBS_SIZE, 0.0f);
+                connection.rewards.assign(request.count, 0.0f);
+                connection.dones.assign(request.count, 0);
+                connection.out.resize(sizeof(ArenaHeader) + Arena::resultSize(request.count));
+                flappy_env_reset(connection.env, connection.observations.data());
+            }
+        } else if (request.type == static_cast<std::uint8_t>(ArenaMessage::Step)) {
+            if (connection.inSize - used < sizeof(ArenaHeader) + request.count) break;
+            const std::uint8_t* actions = message + sizeof(ArenaHeader);
+            used += sizeof(ArenaHeader) + request.count;
+            ArenaStatus status = !connection.env ? ArenaStatus::NotOpen
+                               : request.count != connection.games ? ArenaStatus::BadCount
+                               : ArenaStatus::Ok;
+            if (status != ArenaStatus::Ok) {
+                writeHeader(connection.out.data(), request, status, 0);
+                connection.outEnd = sizeof(ArenaHeader);
+            } else {
+                flappy_env_step(connection.env, actions, connection.observations.data(),
+                                connection.rewards.data(), connection.dones.data());
+                std::uint64_t finished = 0;
+                for (std::uint8_t done : connection.dones) {
+                    finished += done;
+                }
+                worker.gameSteps.fetch_add(connection.games, std::memory_order_relaxed);
+                worker.gamesFinished.fetch_add(finished, std::memory_order_relaxed);
+            }
+        } else {
+            return false;
+        }
+
+        if (connection.outEnd == 0) {
+            // Odpowiedź Ok: obserwacje, nagrody i flagi, jedne za drugimi.
+            std::uint8_t* out = connection.out.data();
+            writeHeader(out, request, ArenaStatus::Ok, connection.games);
+            out += sizeof(ArenaHeader);
+            std::memcpy(out, connection.observations.data(), connection.observations.size() * sizeof(float));
+            out += connection.observations.size() * sizeof(float);
+            std::memcpy(out, connection.rewards.data(), connection.rewards.size() * sizeof(float));
+            out += connection.rewards.size() * sizeof(float);
+            std::memcpy(out, connection.dones.data(), connection.dones.size());
+            connection.outEnd = sizeof(ArenaHeader) + Arena::resultSize(connection.games);
+        }
+        if (!flush(worker, connection)) return false;
+    }
+    if (used > 0) {
+        std::memmove(connection.in.data(), connection.in.data() + used, connection.inSize - used);
+        connection.inSize -= used;
+    }
+    return true;
+}
+
+/**
+ * @brief Wysyła zaległą odpowiedź i ustawia zdarzenia epoll połączenia
+ *
+ * @param worker Wątek
+ * @param connection Połączenie
+ * @return false jeśli połączenie trzeba zamknąć
+ */
+bool ArenaServer::flush(Worker& worker, Connection& connection) {
+#ifdef __linux__
+    while (connection.outBegin < connection.outEnd) {
+        ssize_t sent = send(connection.fd, connection.out.data() + connection.outBegin,
+                            connection.outEnd - connection.outBegin, MSG_NOSIGNAL);
+        if (sent > 0) {
+            connection.outBegin += (std::size_t)sent;
+        } else if (sent < 0 && errno == EINTR) {
+            continue;
+        } else if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        } else {
+            return false;
+        }
+    }
+    bool pending = connection.outBegin < connection.outEnd;
+    if (!pending) {
+        connection.outBegin = connection.outEnd = 0;
+    }
+    if (pending != connection.writing) {
+        connection.writing = pending;
+        epoll_event event{};
+        event.events = pending ? EPOLLOUT : EPOLLIN;
+        event.data.ptr = &connection;
+        epoll_ctl(worker.epollFd, EPOLL_CTL_MOD, connection.fd, &event);
+    }
+    return true;
+#else
+    (void)worker;
+    (void)connection;
+    return false;
+#endif
+}
+
+/**
+ * @brief Zamyka połączenie i zwalnia jego gry
+ *
+ * @param worker Wątek
+ * @param connection Połączenie
+ */
+void ArenaServer::closeConnection(Worker& worker, Connection* connection) {
+#ifdef __linux__
+    {
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        Connection* last = worker.connections.back();
+        worker.connections[connection->slot] = last;
+        last->slot = connection->slot;
+        worker.connections.pop_back();
+    }
+    close(connection->fd);
+#else
+    (void)worker;
+#endif
+    flappy_env_destroy(connection->env);
+    delete connection;
+}
@@ -0,0 +1,209 @@
+/**
+ * @file Arena.h
+ * @brief Serwer areny: wiele gier bez okna dla botów w osobnych procesach, przez gniazdo domeny uniksowej.
+ *
+ * Protokół (binarny, kolejność bajtów maszyny - klient i serwer działają na tym samym komputerze):
+ *
+ * Każda wiadomość zaczyna się nagłówkiem ArenaHeader (12 bajtów). Klient wysyła:
+ *   Open - arg: poziom trudności, count: liczba gier sesji, seed: ziarno torów; bez danych.
+ *   Step - count: liczba gier sesji, seed: numer żądania (odsyłany w odpowiedzi);
+ *          dane: count bajtów akcji (1 - machnięcie, 0 - brak akcji).
+ * Serwer odpowiada nagłówkiem z tym samym typem, arg = ArenaStatus i count gier, a po nim
+ * (gdy status to Ok) danymi w układzie flappy_env_step:
+ *   count * FLAPPY_ENV_OBS_SIZE liczb float - obserwacje,
+ *   count liczb float - nagrody,
+ *   count bajtów - flagi zakończenia gry.
+ * Odpowiedź na Open zawiera obserwacje początkowe, zerowe nagrody i flagi.
+ *
+ * Jedno połączenie to jedna sesja bota: jego gry żyją, dopóki połączenie jest otwarte,
+ * a ponowne Open zastępuje je nowymi. Bot nie widzi gier innych połączeń i nie może
+ * zrobić nic poza wyborem akcji; wiadomość z błędną sygnaturą lub typem zamyka połączenie.
+ */
+
+#pragma once
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "FlappyEnv.h"
+
+/**
+ * @brief Rodzaj wiadomości protokołu areny.
+ */
+enum class ArenaMessage : std::uint8_t {
+    Open = 1, /**< Utworzenie gier sesji. */
+    Step = 2  /**< Krok wszystkich gier sesji. */
+};
+
+/**
+ * @brief Wynik obsługi żądania.
+ */
+enum class ArenaStatus : std::uint8_t {
+    Ok = 0,           /**< Żądanie wykonane. */
+    NotOpen = 1,      /**< Step przed Open. */
+    BadCount = 2,     /**< Liczba gier spoza zakresu albo różna od liczby gier sesji. */
+    BadDifficulty = 3 /**< Nieznany poziom trudności. */
+};
+
+/**
+ * @brief Nagłówek każdej wiadomości protokołu.
+ */
+struct ArenaHeader {
+    static constexpr std::uint32_t magicValue = 0x52414246; /**< Sygnatura "FBAR". */
+
+    std::uint32_t magic; /**< Sygnatura. */
+    std::uint8_t type; /**< ArenaMessage. */
+    std::uint8_t arg; /**< Open: poziom trudności; odpowiedź: ArenaStatus. */
+    std::uint16_t count; /**< Liczba gier. */
+    std::uint32_t seed; /**< Open: ziarno torów; Step: numer żądania. */
+};
+static_assert(sizeof(ArenaHeader) == 12, "ArenaHeader to 12 bajtów na łączu");
+
+/**
+ * @brief Stałe protokołu areny.
+ */
+namespace Arena {
+    constexpr std::uint16_t maxGames = 4096; /**< Największa liczba gier jednej sesji. */
+    constexpr std::size_t gameResultSize = FLAPPY_ENV_OBS_SIZE * sizeof(float) + sizeof(float) + 1; /**< Bajty odpowiedzi na grę. */
+    constexpr const char* defaultSocket = "flappy_arena.sock"; /**< Domyślna ścieżka gniazda. */
+
+    /**
+     * @brief Zwraca rozmiar danych odpowiedzi dla podanej liczby gier.
+     *
+     * @param games Liczba gier.
+     * @return Liczba bajtów po nagłówku.
+     */
+    constexpr std::size_t resultSize(std::size_t games) { return games * gameResultSize; }
+}
+
+/**
+ * @brief Serwer areny: wątek przyjmujący połączenia i pula wątków krokujących gry.
+ *
+ * Każde przyjęte połączenie trafia (po kolei) do jednego z wątków roboczych
+ * i zostaje w nim do zamknięcia. Każdy wątek ma własną kolejkę epoll i obsługuje
+ * swoje połączenia bez blokad: czyta dostępne żądania, wykonuje krok wszystkich gier
+ * sesji przez flappy_env_step i odsyła wynik. Bufory połączenia są przydzielane przy
+ * Open, więc krok nie alokuje pamięci. Dopóki odpowiedź nie została w całości
+ * wysłana, serwer nie czyta kolejnych żądań tego połączenia - wolny klient
+ * nie zajmuje pamięci serwera.
+ *
+ * Dostępny tylko na Linuksie (epoll); na innych systemach start() zwraca false.
+ */
+class ArenaServer {
+public:
+    /**
+     * @brief Konstruktor klasy ArenaServer.
+     *
+     * @param workers Liczba wątków roboczych (0 - po jednym na rdzeń).
+     */
+    explicit ArenaServer(unsigned workers = 0);
+
+    /**
+     * @brief Destruktor klasy ArenaServer. Zatrzymuje serwer.
+     */
+    ~ArenaServer();
+
+    ArenaServer(const ArenaServer&) = delete;
+    ArenaServer& operator=(const ArenaServer&) = delete;
+
+    /**
+     * @brief Tworzy gniazdo i uruchamia wątki robocze.
+     *
+     * Istniejący plik gniazda pod tą ścieżką jest usuwany. Gniazdo jest dostępne
+     * tylko dla właściciela (0600).
+     *
+     * @param path Ścieżka gniazda.
+     * @return true jeśli serwer działa.
+     */
+    bool start(const std::string& path);
+
+    /**
+     * @brief Przyjmuje połączenia, dopóki nie zostanie wywołane stop(). Blokuje wywołujący wątek.
+     */
+    void run();
+
+    /**
+     * @brief Prosi serwer o zakończenie. Można wywołać z innego wątku lub z obsługi sygnału.
+     */
+    void requestStop() { stopping.store(true, std::memory_order_relaxed); }
+
+    /**
+     * @brief Zatrzymuje wątki robocze, zamyka połączenia i usuwa plik gniazda.
+     */
+    void stop();
+
+    /**
+     * @brief Zwraca łączną liczbę wykonanych kroków gier.
+     *
+     * @return Liczba kroków.
+     */
+    std::uint64_t getGameSteps() const;
+
+    /**
+     * @brief Zwraca łączną liczbę zakończonych gier.
+     *
+     * @return Liczba gier.
+     */
+    std::uint64_t getGamesFinished() const;
+
+private:
+    struct Connection;
+
+    /**
+     * @brief Wątek roboczy z własną kolejką epoll.
+     */
+    struct Worker {
+        int epollFd = -1; /**< Kolejka epoll wątku. */
+        std::thread thread; /**< Wątek. */
+        std::atomic<std::uint64_t> gameSteps{0}; /**< Kroki gier wykonane przez wątek. */
+        std::atomic<std::uint64_t> gamesFinished{0}; /**< Gry zakończone w wątku. */
+        std::mutex mutex; /**< Chroni listę połączeń (dodawanie i zamykanie, nie krok). */
+        std::vector<Connection*> connections; /**< Połączenia obsługiwane przez wątek. */
+    };
+
+    /**
+     * @brief Pętla wątku roboczego.
+     *
+     * @param worker Wątek.
+     */
+    void serve(Worker& worker);
+
+    /**
+     * @brief Obsługuje wszystkie kompletne żądania z bufora wejściowego połączenia.
+     *
+     * @param worker Wątek.
+     * @param connection Połączenie.
+     * @return false jeśli połączenie trzeba zamknąć.
+     */
+    bool handleRequests(Worker& worker, Connection& connection);
+
+    /**
+     * @brief Wysyła zaległą odpowiedź i ustawia zdarzenia epoll połączenia.
+     *
+     * @param worker Wątek.
+     * @param connection Połączenie.
+     * @return false jeśli połączenie trzeba zamknąć.
+     */
+    bool flush(Worker& worker, Connection& connection);
+
+    /**
+     * @brief Zamyka połączenie, usuwa je z listy wątku i zwalnia jego gry.
+     *
+     * @param worker Wątek.
+     * @param connection Połączenie.
+     */
+    static void closeConnection(Worker& worker, Connection* connection);
+
+    Worker* workers; /**< Pula wątków roboczych. */
+    unsigned workerCount; /**< Liczba wątków roboczych. */
+    std::string socketPath; /**< Ścieżka gniazda. */
+    int listenFd; /**< Gniazdo nasłuchujące. */
+    std::atomic<bool> stopping; /**< Czy serwer ma się zatrzymać. */
+};
+
+#endif
@@ -0,0 +1,84 @@
+/**
+ * @file BirdAtlas.cpp
+ * @brief Implementacja klasy BirdAtlas.
+ */
+
+#include "BirdAtlas.h"
+#include <atomic>
+#include "Metrics.h"
+
+/**
+ * @brief Zwraca wspólny atlas, ładując go przy pierwszym użyciu.
+ *
+ * Atlas jest statyczną zmienną lokalną, więc jest tworzony dokładnie raz, także
+ * przy wywołaniach z wielu wątków, i niszczony przy końcu programu. Chybienie
+ * liczy konstruktor; pobranie, które nie było pierwsze, jest trafieniem.
+ *
+ * @return Referencja do atlasu.
+ */
+const BirdAtlas& BirdAtlas::get() {
+    static BirdAtlas atlas;
+    static std::atomic<std::uint64_t> requests{0};
+    if (requests.fetch_add(1, std::memory_order_relaxed) > 0) {
+        Metrics::increment(Metrics::get().assetCacheHits);
+    }
+    return atlas;
+}
+
+/**
+ * @brief Pobiera model ścieżki dla podanego modelu gracza
+ *
+ * @param model Model gracza
+ * @return Struktura pathModel zawierająca ścieżki do tekstur ptaka
+ */
+pathModel BirdAtlas::getPathModel(PlayerModel model)
+{
+    switch(model)
+    {
+        case PlayerModel::Yellow:
+            return {"res/textures/bird/1-1.png", "res/textures/bird/1-2.png", "res/textures/bird/1-3.png"};
+        case PlayerModel::Blue:
+            return {"res/textures/bird/2-1.png", "res/textures/bird/2-2.png", "res/textures/bird/2-3.png"};
+        case PlayerModel::Red:
+            return {"res/textures/bird/3-1.png", "res/textures/bird/3-2.png", "res/textures/bird/3-3.png"};
+        default:
+            return {"res/textures/bird/1-1.png", "res/textures/bird/1-2.png", "res/textures/bird/1-3.png"};
+    }
+}
+
+/**
+ * @brief Konstruktor klasy BirdAtlas.
+ */
+BirdAtlas::BirdAtlas() {
+    Metrics::increment(Metrics::get().assetCacheMisses);
+    sf::Image atlasImage;
+    for (int skin = 0; skin < skinCount; ++skin) {
+        pathModel paths = getPathModel(static_cast<PlayerModel>(skin));
+        int column = 0;
+        for (const auto& path : {paths.wingUp, paths.wingParallel, paths.wingDown}) {
+            sf::Image frame;
+            frame.loadFromFile(path);
+            if (atlasImage.getSize().x == 0) {
+                frameSize = frame.getSize();
+                atlasImage.create(frameSize.x * wingPoses, frameSize.y * skinCount, sf::Color::Transparent);
+            }
+            atlasImage.copy(frame, column * frameSize.x, skin * frameSize.y);
+            column++;
+        }
+    }
+    texture.loadFromImage(atlasImage);
+}
+
+/**
+ * @brief Zwraca prostokąt klatki animacji w atlasie.
+ *
+ * @param skin Model gracza.
+ * @param frame Numer klatki w cyklu animacji.
+ * @return Prostokąt tekstury klatki.
+ */
+sf::IntRect BirdAtlas::getFrameRect(PlayerModel skin, int frame) const {
+    return {
+            frameColumns[frame] * (int)frameSize.x, static_cast<int>(skin) * (int)frameSize.y,
+            (int)frameSize.x, (int)frameSize.y
+    };
+}
@@ -0,0 +1,86 @@
+/**
+ * @file BirdAtlas.h
+ * @brief Definicja klasy BirdAtlas - wspólnej tekstury klatek animacji ptaków.
+ */
+
+#pragma once
+#ifndef BIRDATLAS_H
+#define BIRDATLAS_H
+
+#include <SFML/Graphics.hpp>
+#include "PlayerModel.h"
+
+/**
+ * @brief Atlas klatek animacji wszystkich modeli ptaka.
+ *
+ * Klatki wszystkich modeli są ładowane jeden raz do jednej tekstury
+ * (wiersz = model gracza, kolumna = pozycja skrzydeł). Każdy ptak korzysta
+ * z tego samego atlasu, dzięki czemu dowolną liczbę ptaków można narysować
+ * jednym wywołaniem draw z jedną teksturą.
+ */
+class BirdAtlas {
+public:
+    static constexpr int skinCount = 3; /**< Liczba modeli gracza w atlasie. */
+    static constexpr int animationFrames = 4; /**< Liczba klatek w cyklu animacji skrzydeł. */
+    static constexpr int wingPoses = 3; /**< Liczba kolumn atlasu (pozycji skrzydeł). */
+
+    /**
+     * @brief Kolumny atlasu odpowiadające kolejnym klatkom animacji.
+     *
+     * Kolumna 0 - skrzydła w górze, 1 - równolegle, 2 - w dole.
+     */
+    static constexpr int frameColumns[animationFrames] = {1, 2, 1, 0};
+
+    /**
+     * @brief Zwraca wspólny atlas, ładując go przy pierwszym użyciu.
+     *
+     * Ptak (Engine) i populacja pobierają atlas raz i trzymają referencję, więc
+     * każde wywołanie to jedno pobranie: pierwsze liczy się jako chybienie
+     * pamięci podręcznej zasobów (wczytanie tekstur), kolejne jako trafienia.
+     *
+     * @return Referencja do atlasu.
+     */
+    static const BirdAtlas& get();
+
+    /**
+     * @brief Zwraca teksturę atlasu.
+     *
+     * @return Tekstura zawierająca wszystkie klatki.
+     */
+    const sf::Texture& getTexture() const { return texture; }
+
+    /**
+     * @brief Zwraca rozmiar pojedynczej klatki.
+     *
+     * @return Rozmiar klatki w pikselach.
+     */
+    sf::Vector2u getFrameSize() const { return frameSize; }
+
+    /**
+     * @brief Zwraca prostokąt klatki animacji w atlasie.
+     *
+     * @param skin Model gracza.
+     * @param frame Numer klatki w cyklu animacji, z zakresu [0, animationFrames).
+     * @return Prostokąt tekstury klatki.
+     */
+    sf::IntRect getFrameRect(PlayerModel skin, int frame) const;
+
+    /**
+     * @brief Pobiera model ścieżki dla podanego modelu gracza.
+     *
+     * @param model Model gracza.
+     * @return Struktura pathModel zawierająca ścieżki do tekstur ptaka.
+     */
+    static pathModel getPathModel(PlayerModel model);
+
+private:
+    /**
+     * @brief Konstruktor klasy BirdAtlas. Wczytuje klatki wszystkich modeli.
+     */
+    BirdAtlas();
+
+    sf::Texture texture; /**< Tekstura atlasu. */
+    sf::Vector2u frameSize; /**< Rozmiar pojedynczej klatki. */
+};
+
+#endif
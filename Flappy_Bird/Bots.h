@@ -0,0 +1,105 @@
+/**
+ * @file Bots.h
+ * @brief Boty sterujące ptakiem w symulacji bez okna.
+ */
+
+#ifndef FLAPPY_BIRD_BOTS_H
+#define FLAPPY_BIRD_BOTS_H
+
+#include <cstdint>
+#include "Simulation.h"
+
+/**
+ * @brief Referencyjne boty, wspólne dla pomiarów, kalibracji i testów sieciowych.
+ */
+namespace Bots {
+
+    /**
+     * @brief Zwraca wysokość, na której bot chce utrzymać środek ptaka.
+     *
+     * @param world Świat.
+     * @return Środek przerwy najbliższej nieminiętej rury lub środek ekranu.
+     */
+    inline float target(const World& world) {
+        int next = Simulation::nextPipe(world);
+        return next < 0 ? 300.0f : world.pipes[next].y + Physics::pipeHeight / 2;
+    }
+
+    /**
+     * @brief Prosty bot: macha, gdy ptak spada poniżej środka przerwy najbliższej rury.
+     *
+     * @param world Świat.
+     * @return true jeśli bot chce machnąć skrzydłami.
+     */
+    inline bool center(const World& world) {
+        return world.birdVel >= 0 && world.birdY + Physics::birdHeight / 2 > target(world) + 10;
+    }
+
+    /**
+     * @brief Bot z losowo przesuwanym progiem machnięcia.
+     *
+     * Gra prawie tak dobrze jak center, ale jego decyzje są trudniejsze do przewidzenia.
+     *
+     * @param world Świat.
+     * @param rng Stan generatora bota.
+     * @return true jeśli bot chce machnąć skrzydłami.
+     */
+    inline bool jitter(const World& world, std::uint32_t& rng) {
+        float aim = target(world) - (float)(Simulation::nextRandom(rng) % 24);
+        return world.birdVel >= 0 && world.birdY + Physics::birdHeight / 2 > aim + 10;
+    }
+
+    /**
+     * @brief Parametry bota naśladującego gracza o danej wprawie.
+     */
+    struct Skill {
+        const char* name; /**< Nazwa poziomu wprawy. */
+        std::uint32_t aimNoise; /**< Największy błąd celowania w pikselach (w obie strony). */
+        std::uint32_t lateOneIn; /**< Co która decyzja o machnięciu jest spóźniona o krok. */
+    };
+
+    constexpr Skill expert{"expert", 10, 8}; /**< Wprawny gracz. */
+    constexpr Skill casual{"casual", 30, 4}; /**< Gracz okazjonalny. */
+
+    /**
+     * @brief Bot z błędem celowania i spóźnionymi reakcjami.
+     *
+     * Błąd celowania jest losowany po każdym machnięciu i obowiązuje do następnego,
+     * tak jak u gracza, który przez chwilę trzyma się źle oszacowanej wysokości.
+     */
+    class Human {
+    public:
+        /**
+         * @brief Konstruktor klasy Human.
+         *
+         * @param skill Wprawa bota.
+         * @param seed Ziarno generatora bota, różne od zera.
+         */
+        Human(const Skill& skill, std::uint32_t seed) : skill(skill), rng(seed ? seed : 1), aimOffset(0) {}
+
+        /**
+         * @brief Decyduje o machnięciu w bieżącym kroku.
+         *
+         * @param world Świat.
+         * @return true jeśli bot chce machnąć skrzydłami.
+         */
+        bool operator()(const World& world) {
+            if (world.birdVel < 0 || world.birdY + Physics::birdHeight / 2 <= target(world) + aimOffset + 10) {
+                return false;
+            }
+            std::uint32_t roll = Simulation::nextRandom(rng);
+            if (roll % skill.lateOneIn == 0) {
+                return false;
+            }
+            aimOffset = (float)((roll >> 8) % (2 * skill.aimNoise + 1)) - (float)skill.aimNoise;
+            return true;
+        }
+
+    private:
+        Skill skill; /**< Wprawa bota. */
+        std::uint32_t rng; /**< Stan generatora bota. */
+        float aimOffset; /**< Bieżący błąd celowania w pikselach. */
+    };
+}
+
+#endif //FLAPPY_BIRD_BOTS_H
@@ -0,0 +1,311 @@
+/**
+ * @file Course.cpp
+ * @brief Implementacja torów gry i formatu pliku toru.
+ */
+
+#include "Course.h"
+#include "Simulation.h"
+#include <cstring>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+/**
+ * @brief Nagłówek pliku toru.
+ */
+struct CourseHeader {
+    char magic[8];              /**< Sygnatura pliku "FBCOURS1". */
+    std::uint32_t recordSize;   /**< Rozmiar rekordu w bajtach. */
+    std::uint32_t chunkPipes;   /**< Liczba rur we fragmencie. */
+    std::uint64_t pipeCount;    /**< Liczba rur toru. */
+    std::uint64_t chunkCount;   /**< Liczba fragmentów. */
+    std::uint64_t indexOffset;  /**< Przesunięcie indeksu fragmentów. */
+};
+
+const char courseMagic[8] = {'F', 'B', 'C', 'O', 'U', 'R', 'S', '1'};
+
+/**
+ * @brief Liczy skrót FNV-1a rekordów fragmentu.
+ *
+ * @param records Rekordy.
+ * @param count Liczba rekordów.
+ * @return Skrót.
+ */
+std::uint32_t checksum(const CourseRecord* records, std::uint32_t count) {
+    std::uint32_t hash = 2166136261u;
+    const auto* bytes = reinterpret_cast<const unsigned char*>(records);
+    for (std::size_t i = 0; i < count * sizeof(CourseRecord); ++i) {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief Sprawdza, czy nagłówek opisuje poprawny plik toru o danym rozmiarze.
+ *
+ * @param header Wczytany nagłówek.
+ * @param fileSize Rozmiar pliku.
+ * @return true jeśli plik jest torem w obsługiwanym formacie.
+ */
+bool validHeader(const CourseHeader& header, std::uint64_t fileSize) {
+    const std::uint64_t chunkPipes = FileCourse::chunkPipes;
+    return std::memcmp(header.magic, courseMagic, sizeof(courseMagic)) == 0 &&
+           header.recordSize == sizeof(CourseRecord) && header.chunkPipes == FileCourse::chunkPipes &&
+           header.chunkCount == (header.pipeCount + chunkPipes - 1) / chunkPipes &&
+           header.indexOffset % FileCourse::chunkBytes == 0 &&
+           header.indexOffset <= fileSize && header.chunkCount <= (fileSize - header.indexOffset) / 16;
+}
+
+}
+
+/**
+ * @brief Przewija tor na początek
+ *
+ * @param seed Ziarno rozgrywki
+ */
+void GeneratedCourse::restart(std::uint64_t seed) {
+    // Tak samo jak Simulation::reset dla 32-bitowego ziarna.
+    rng = (std::uint32_t)seed ? (std::uint32_t)seed : 0x9e3779b9u;
+    index = 0;
+}
+
+/**
+ * @brief Losuje wysokość następnej rury
+ *
+ * @param pipe Rura do uzupełnienia
+ * @return Zawsze true - tor nie ma końca
+ */
+bool GeneratedCourse::next(CoursePipe& pipe) {
+    pipe.y = Physics::pipeY((int)(Simulation::nextRandom(rng) % Physics::pipeHeights));
+    index++;
+    return true;
+}
+
+/**
+ * @brief Wraca do zapisanej pozycji
+ *
+ * @param position Numer rury i stan generatora
+ */
+void GeneratedCourse::seek(std::uint64_t position) {
+    index = (std::uint32_t)(position >> 32);
+    rng = (std::uint32_t)position;
+}
+
+/**
+ * @brief Konstruktor klasy FileCourse
+ *
+ * @param path Ścieżka do pliku toru
+ */
+FileCourse::FileCourse(const std::string& path)
+        : open(false), pipeCount(0), chunkCount(0), index(0), current(0), records(nullptr) {
+#ifdef _WIN32
+    file = std::fopen(path.c_str(), "rb");
+    if (!file) return;
+    CourseHeader header{};
+    _fseeki64(file, 0, SEEK_END);
+    auto size = (std::uint64_t)_ftelli64(file);
+    _fseeki64(file, 0, SEEK_SET);
+    if (std::fread(&header, sizeof(header), 1, file) != 1 || !validHeader(header, size)) return;
+    entries.resize(header.chunkCount);
+    _fseeki64(file, (long long)header.indexOffset, SEEK_SET);
+    if (std::fread(entries.data(), sizeof(ChunkEntry), entries.size(), file) != entries.size()) return;
+    buffer.resize(chunkPipes);
+#else
+    entries = nullptr;
+    data = nullptr;
+    mappedSize = 0;
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return;
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || (std::size_t)st.st_size < sizeof(CourseHeader)) {
+        close(fd);
+        return;
+    }
+    void* mapped = mmap(nullptr, (std::size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) return;
+    data = static_cast<unsigned char*>(mapped);
+    mappedSize = (std::size_t)st.st_size;
+    // Fragmenty są sprowadzane jawnie w load, więc domyślne czytanie z wyprzedzeniem tylko by przeszkadzało.
+    madvise(data, mappedSize, MADV_RANDOM);
+
+    CourseHeader header{};
+    std::memcpy(&header, data, sizeof(header));
+    if (!validHeader(header, mappedSize)) return;
+    entries = reinterpret_cast<const ChunkEntry*>(data + header.indexOffset);
+#endif
+    static_assert(sizeof(ChunkEntry) == 16, "ChunkEntry musi miec staly rozmiar w pliku");
+    pipeCount = header.pipeCount;
+    chunkCount = header.chunkCount;
+    current = chunkCount;
+    open = true;
+}
+
+/**
+ * @brief Destruktor klasy FileCourse
+ */
+FileCourse::~FileCourse() {
+#ifdef _WIN32
+    if (file) std::fclose(file);
+#else
+    if (data) munmap(data, mappedSize);
+#endif
+}
+
+/**
+ * @brief Przewija tor na początek
+ *
+ * @param seed Ziarno rozgrywki (pomijane)
+ */
+void FileCourse::restart(std::uint64_t) {
+    index = 0;
+}
+
+/**
+ * @brief Pobiera następną rurę z pliku
+ *
+ * @param pipe Rura do uzupełnienia
+ * @return false, gdy tor się skończył lub fragment jest uszkodzony
+ */
+bool FileCourse::next(CoursePipe& pipe) {
+    if (!open || index >= pipeCount) return false;
+    if (!load(index / chunkPipes)) return false;
+    const CourseRecord& record = records[index % chunkPipes];
+    pipe.spacing = record.spacing;
+    pipe.y = record.y;
+    pipe.throat = record.throat;
+    pipe.coin = (record.flags & CourseRecord::coinFlag) != 0;
+    index++;
+    return true;
+}
+
+/**
+ * @brief Sprowadza fragment do pamięci
+ *
+ * @param chunk Numer fragmentu
+ * @return false, gdy fragment jest uszkodzony
+ */
+bool FileCourse::load(std::uint64_t chunk) {
+    if (chunk == current) return records != nullptr;
+    const ChunkEntry& entry = entries[chunk];
+    const std::uint64_t expectedPipes = chunk + 1 < chunkCount ? chunkPipes : pipeCount - chunk * chunkPipes;
+    records = nullptr;
+
+#ifdef _WIN32
+    if (entry.pipes == expectedPipes && _fseeki64(file, (long long)entry.offset, SEEK_SET) == 0 &&
+        std::fread(buffer.data(), sizeof(CourseRecord), entry.pipes, file) == entry.pipes) {
+        records = buffer.data();
+    }
+#else
+    auto inFile = [this](const ChunkEntry& e) {
+        return e.offset % chunkBytes == 0 && e.offset <= mappedSize && chunkBytes <= mappedSize - e.offset;
+    };
+    if (current < chunkCount && inFile(entries[current])) {
+        // Minięty fragment wraca do pliku; przy ponownym odczycie zostanie sprowadzony od nowa.
+        madvise(data + entries[current].offset, chunkBytes, MADV_DONTNEED);
+    }
+    if (entry.pipes == expectedPipes && inFile(entry)) {
+        records = reinterpret_cast<const CourseRecord*>(data + entry.offset);
+        if (chunk + 1 < chunkCount && inFile(entries[chunk + 1])) {
+            madvise(data + entries[chunk + 1].offset, chunkBytes, MADV_WILLNEED);
+        }
+    }
+#endif
+
+    current = chunk;
+    if (records && checksum(records, entry.pipes) != entry.checksum) {
+        records = nullptr;
+    }
+    if (!records) {
+        std::fprintf(stderr, "FileCourse: uszkodzony fragment %llu toru\n", (unsigned long long)chunk);
+    }
+    return records != nullptr;
+}
+
+/**
+ * @brief Konstruktor klasy CourseWriter
+ *
+ * Miejsce na nagłówek jest rezerwowane od razu; nagłówek zapisuje finish.
+ *
+ * @param path Ścieżka do pliku toru
+ */
+CourseWriter::CourseWriter(const std::string& path) : pipeCount(0) {
+    chunk.reserve(FileCourse::chunkPipes);
+    file = std::fopen(path.c_str(), "wb");
+    std::vector<unsigned char> zeros(FileCourse::chunkBytes, 0);
+    if (file && std::fwrite(zeros.data(), 1, zeros.size(), file) != zeros.size()) {
+        std::fclose(file);
+        file = nullptr;
+    }
+}
+
+/**
+ * @brief Destruktor klasy CourseWriter
+ */
+CourseWriter::~CourseWriter() {
+    finish();
+}
+
+/**
+ * @brief Dopisuje rurę do toru
+ *
+ * @param pipe Rura
+ * @return false przy błędzie zapisu
+ */
+bool CourseWriter::add(const CoursePipe& pipe) {
+    if (!file) return false;
+    chunk.push_back({pipe.spacing, pipe.y, pipe.throat, pipe.coin ? CourseRecord::coinFlag : 0u});
+    pipeCount++;
+    return chunk.size() < FileCourse::chunkPipes || flushChunk();
+}
+
+/**
+ * @brief Zapisuje bieżący fragment
+ *
+ * @return false przy błędzie zapisu
+ */
+bool CourseWriter::flushChunk() {
+    auto pipes = (std::uint32_t)chunk.size();
+    FileCourse::ChunkEntry entry{(std::uint64_t)(entries.size() + 1) * FileCourse::chunkBytes, pipes,
+                                 checksum(chunk.data(), pipes)};
+    chunk.resize(FileCourse::chunkPipes, CourseRecord{});
+    bool ok = std::fwrite(chunk.data(), sizeof(CourseRecord), chunk.size(), file) == chunk.size();
+    chunk.clear();
+    entries.push_back(entry);
+    if (!ok) {
+        std::fclose(file);
+        file = nullptr;
+    }
+    return ok;
+}
+
+/**
+ * @brief Zapisuje ostatni fragment, indeks i nagłówek
+ *
+ * @return false przy błędzie zapisu
+ */
+bool CourseWriter::finish() {
+    if (!file) return false;
+    if (!chunk.empty() && !flushChunk()) return false;
+
+    CourseHeader header{};
+    std::memcpy(header.magic, courseMagic, sizeof(courseMagic));
+    header.recordSize = sizeof(CourseRecord);
+    header.chunkPipes = FileCourse::chunkPipes;
+    header.pipeCount = pipeCount;
+    header.chunkCount = entries.size();
+    header.indexOffset = (std::uint64_t)(entries.size() + 1) * FileCourse::chunkBytes;
+
+    bool ok = std::fwrite(entries.data(), sizeof(FileCourse::ChunkEntry), entries.size(), file) == entries.size() &&
+              std::fseek(file, 0, SEEK_SET) == 0 && std::fwrite(&header, sizeof(header), 1, file) == 1;
+    ok = std::fclose(file) == 0 && ok;
+    file = nullptr;
+    return ok;
+}
@@ -0,0 +1,256 @@
+/**
+ * @file Course.h
+ * @brief Tory gry: generowany losowo lub wczytywany z pliku podzielonego na fragmenty.
+ */
+
+#pragma once
+#ifndef COURSE_H
+#define COURSE_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Parametry jednej rury toru.
+ */
+struct CoursePipe {
+    float spacing; /**< Odległość w poziomie od poprzedniej rury, w pikselach. */
+    float y; /**< Pozycja Y środka przerwy (jak Physics::pipeY). */
+    float throat; /**< Gardło rury. */
+    bool coin; /**< Czy rura ma monetę. */
+};
+
+/**
+ * @brief Rekord rury w pliku toru.
+ *
+ * Rekord ma stały rozmiar i jest zapisywany bez konwersji, więc fragment pliku
+ * zmapowany do pamięci jest od razu tablicą rekordów.
+ */
+struct CourseRecord {
+    float spacing; /**< Odległość od poprzedniej rury, w pikselach. */
+    float y; /**< Pozycja Y środka przerwy. */
+    float throat; /**< Gardło rury. */
+    std::uint32_t flags; /**< Flagi rury (coinFlag). */
+
+    static constexpr std::uint32_t coinFlag = 1; /**< Rura ma monetę. */
+};
+
+static_assert(sizeof(CourseRecord) == 16, "CourseRecord musi miec staly rozmiar w pliku");
+
+/**
+ * @brief Wspólny interfejs torów, z którego Engine pobiera kolejne rury.
+ */
+class Course {
+public:
+    virtual ~Course() = default;
+
+    /**
+     * @brief Przewija tor na początek przed nową grą.
+     *
+     * @param seed Ziarno rozgrywki (tor z pliku je pomija).
+     */
+    virtual void restart(std::uint64_t seed) = 0;
+
+    /**
+     * @brief Pobiera następną rurę toru.
+     *
+     * Przed wywołaniem pipe zawiera wartości wynikające z bieżącego poziomu trudności.
+     * Tor nadpisuje te, które sam określa.
+     *
+     * @param pipe Rura do uzupełnienia.
+     * @return false, gdy tor się skończył.
+     */
+    virtual bool next(CoursePipe& pipe) = 0;
+
+    /**
+     * @brief Zwraca pozycję w torze, do zapisania w migawce stanu gry.
+     *
+     * @return Pozycja, którą przyjmuje seek.
+     */
+    virtual std::uint64_t tell() const = 0;
+
+    /**
+     * @brief Wraca do pozycji zwróconej wcześniej przez tell.
+     *
+     * @param position Pozycja w torze.
+     */
+    virtual void seek(std::uint64_t position) = 0;
+};
+
+/**
+ * @brief Tor losowany w trakcie gry, bez końca.
+ *
+ * Wysokości rur pochodzą z tego samego generatora co w Simulation::spawnPipe,
+ * więc gra i symulacja bez okna z tym samym ziarnem mają ten sam tor. Odstęp
+ * i gardło zależą od bieżącego poziomu trudności.
+ */
+class GeneratedCourse : public Course {
+public:
+    /**
+     * @brief Konstruktor klasy GeneratedCourse.
+     */
+    GeneratedCourse() : rng(1), index(0) {}
+
+    void restart(std::uint64_t seed) override;
+    bool next(CoursePipe& pipe) override;
+    std::uint64_t tell() const override { return (std::uint64_t)index << 32 | rng; }
+    void seek(std::uint64_t position) override;
+
+private:
+    std::uint32_t rng; /**< Stan generatora wysokości rur. */
+    std::uint32_t index; /**< Liczba wydanych rur. */
+};
+
+/**
+ * @brief Tor wczytywany z pliku, mapowanego do pamięci fragment po fragmencie.
+ *
+ * Plik toru ("FBCOURS1") składa się z:
+ *   - nagłówka, dopełnionego do rozmiaru fragmentu,
+ *   - fragmentów o stałym rozmiarze chunkBytes (chunkPipes rekordów CourseRecord,
+ *     ostatni dopełniony zerami), wyrównanych do chunkBytes,
+ *   - indeksu fragmentów na końcu pliku: przesunięcie, liczba rur i skrót FNV-1a.
+ *
+ * Cały plik jest mapowany (mmap), ale w pamięci przebywa tylko bieżący fragment
+ * i następny, sprowadzany zawczasu (MADV_WILLNEED). Fragment, który ptak minął,
+ * jest zwalniany (MADV_DONTNEED), więc zużycie pamięci jest stałe niezależnie od
+ * długości toru. Skrót fragmentu jest sprawdzany przy jego wczytaniu; uszkodzony
+ * fragment kończy tor. Na Windows fragmenty są czytane do bufora zwykłym fread.
+ */
+class FileCourse : public Course {
+public:
+    static constexpr std::uint32_t chunkPipes = 4096; /**< Liczba rur we fragmencie. */
+    static constexpr std::size_t chunkBytes = chunkPipes * sizeof(CourseRecord); /**< Rozmiar fragmentu (64 KiB). */
+
+    /**
+     * @brief Konstruktor klasy FileCourse. Otwiera i sprawdza plik toru.
+     *
+     * @param path Ścieżka do pliku toru.
+     */
+    explicit FileCourse(const std::string& path);
+
+    /**
+     * @brief Destruktor klasy FileCourse.
+     */
+    ~FileCourse() override;
+
+    FileCourse(const FileCourse&) = delete;
+    FileCourse& operator=(const FileCourse&) = delete;
+
+    /**
+     * @brief Sprawdza, czy plik toru został poprawnie otwarty.
+     *
+     * @return true jeśli tor można odtwarzać.
+     */
+    bool isOpen() const { return open; }
+
+    /**
+     * @brief Zwraca liczbę rur toru.
+     *
+     * @return Liczba rur.
+     */
+    std::uint64_t size() const { return pipeCount; }
+
+    /**
+     * @brief Zwraca liczbę fragmentów toru.
+     *
+     * @return Liczba fragmentów.
+     */
+    std::uint64_t chunks() const { return chunkCount; }
+
+    void restart(std::uint64_t seed) override;
+    bool next(CoursePipe& pipe) override;
+    std::uint64_t tell() const override { return index; }
+    void seek(std::uint64_t position) override { index = position; }
+
+private:
+    /**
+     * @brief Pozycja fragmentu w indeksie pliku.
+     */
+    struct ChunkEntry {
+        std::uint64_t offset; /**< Przesunięcie fragmentu w pliku. */
+        std::uint32_t pipes; /**< Liczba rur we fragmencie. */
+        std::uint32_t checksum; /**< Skrót FNV-1a rekordów fragmentu. */
+    };
+
+    /**
+     * @brief Sprowadza fragment do pamięci i zwalnia poprzedni.
+     *
+     * @param chunk Numer fragmentu.
+     * @return false, gdy fragment jest uszkodzony.
+     */
+    bool load(std::uint64_t chunk);
+
+    bool open; /**< Czy plik jest poprawnie otwarty. */
+    std::uint64_t pipeCount; /**< Liczba rur toru. */
+    std::uint64_t chunkCount; /**< Liczba fragmentów. */
+    std::uint64_t index; /**< Numer następnej rury. */
+    std::uint64_t current; /**< Numer wczytanego fragmentu (chunkCount, gdy żaden). */
+    const CourseRecord* records; /**< Rekordy wczytanego fragmentu. */
+#ifdef _WIN32
+    std::FILE* file; /**< Plik toru. */
+    std::vector<ChunkEntry> entries; /**< Indeks fragmentów. */
+    std::vector<CourseRecord> buffer; /**< Bufor bieżącego fragmentu. */
+#else
+    const ChunkEntry* entries; /**< Indeks fragmentów w zmapowanym pliku. */
+    unsigned char* data; /**< Zmapowany plik. */
+    std::size_t mappedSize; /**< Rozmiar mapowania. */
+#endif
+
+    friend class CourseWriter;
+};
+
+/**
+ * @brief Zapisuje tor do pliku w formacie FileCourse, rura po rurze.
+ *
+ * W pamięci przebywa tylko bieżący fragment i indeks, więc można zapisać tor
+ * dowolnej długości.
+ */
+class CourseWriter {
+public:
+    /**
+     * @brief Konstruktor klasy CourseWriter. Tworzy plik toru.
+     *
+     * @param path Ścieżka do pliku toru.
+     */
+    explicit CourseWriter(const std::string& path);
+
+    /**
+     * @brief Destruktor klasy CourseWriter. Kończy zapis, jeśli nie wywołano finish.
+     */
+    ~CourseWriter();
+
+    CourseWriter(const CourseWriter&) = delete;
+    CourseWriter& operator=(const CourseWriter&) = delete;
+
+    /**
+     * @brief Dopisuje rurę do toru.
+     *
+     * @param pipe Rura.
+     * @return false przy błędzie zapisu.
+     */
+    bool add(const CoursePipe& pipe);
+
+    /**
+     * @brief Zapisuje ostatni fragment, indeks i nagłówek.
+     *
+     * @return false przy błędzie zapisu.
+     */
+    bool finish();
+
+private:
+    /**
+     * @brief Zapisuje bieżący fragment, dopełniony zerami.
+     *
+     * @return false przy błędzie zapisu.
+     */
+    bool flushChunk();
+
+    std::FILE* file; /**< Plik toru lub nullptr po błędzie. */
+    std::vector<CourseRecord> chunk; /**< Rekordy bieżącego fragmentu. */
+    std::vector<FileCourse::ChunkEntry> entries; /**< Indeks zapisanych fragmentów. */
+    std::uint64_t pipeCount; /**< Liczba zapisanych rur. */
+};
+
+#endif
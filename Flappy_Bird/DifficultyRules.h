@@ -0,0 +1,91 @@
+/**
+ * @file DifficultyRules.h
+ * @brief Stałe reguły gry dla każdego poziomu trudności oraz stałe fizyki.
+ */
+
+#ifndef FLAPPY_BIRD_DIFFICULTYRULES_H
+#define FLAPPY_BIRD_DIFFICULTYRULES_H
+
+#include "Difficulty.h"
+
+/**
+ * @brief Reguły gry zależne od poziomu trudności.
+ */
+struct DifficultyRules {
+    float throat; /**< Odległość górnej i dolnej rury od środka przerwy ("gardło"). */
+    float coinOffsetDivisor; /**< Dzielnik gardła wyznaczający wysokość rysowania monety. */
+    float spawnInterval; /**< Odstęp czasu między kolejnymi rurami, w sekundach. */
+    const char* background; /**< Ścieżka do tekstury tła. */
+};
+
+/**
+ * @brief Tablica reguł, indeksowana wartością Difficulty.
+ */
+constexpr DifficultyRules difficultyRules[] = {
+        {380, 2.0f, 3.5f, "res/textures/background/day.png"},        // Easy
+        {340, 1.8f, 3.5f, "res/textures/background/day.png"},        // Medium
+        {320, 1.7f, 3.5f, "res/textures/background/night.png"},      // Hard
+        {315, 1.5f, 3.5f, "res/textures/background/impossible.png"}, // Nightmare
+};
+
+/**
+ * @brief Zwraca reguły dla poziomu trudności znanego w czasie działania.
+ *
+ * @param difficulty Poziom trudności.
+ * @return Reguły poziomu trudności.
+ */
+constexpr const DifficultyRules& rulesFor(Difficulty difficulty) {
+    return difficultyRules[static_cast<int>(difficulty)];
+}
+
+/**
+ * @brief Reguły poziomu trudności znanego w czasie kompilacji.
+ *
+ * Funkcje szablonowe parametryzowane poziomem trudności odczytują stąd stałe,
+ * więc w ich pętlach nie ma żadnych porównań z bieżącym poziomem trudności.
+ *
+ * @tparam D Poziom trudności.
+ */
+template<Difficulty D>
+struct RulesOf {
+    static constexpr DifficultyRules value = difficultyRules[static_cast<int>(D)]; /**< Reguły poziomu D. */
+    static constexpr float throat = value.throat; /**< Gardło rury. */
+    static constexpr float coinOffsetDivisor = value.coinOffsetDivisor; /**< Dzielnik położenia monety. */
+    static constexpr float spawnInterval = value.spawnInterval; /**< Odstęp między rurami. */
+};
+
+/**
+ * @brief Stałe fizyki i geometrii gry, wspólne dla gry w oknie i symulacji bez okna.
+ *
+ * Rozmiary odpowiadają teksturom z res/textures.
+ */
+namespace Physics {
+    constexpr float gravity = 1200; /**< Przyspieszenie grawitacyjne ptaka. */
+    constexpr float flapVelocity = -420; /**< Prędkość nadawana ptakowi przez machnięcie. */
+    constexpr float pipeSpeed = 100; /**< Prędkość przesuwania się rur w lewo. */
+    constexpr float birdX = 50; /**< Stała pozycja X ptaka. */
+    constexpr float birdStartY = 400; /**< Początkowa pozycja Y ptaka. */
+    constexpr float birdWidth = 68; /**< Szerokość klatki ptaka. */
+    constexpr float birdHeight = 48; /**< Wysokość klatki ptaka. */
+    constexpr float pipeWidth = 104; /**< Szerokość rury. */
+    constexpr float pipeHeight = 473; /**< Wysokość rury. */
+    constexpr float coinWidth = 63; /**< Szerokość monety. */
+    constexpr float coinHeight = 65; /**< Wysokość monety. */
+    constexpr float floorY = 644; /**< Wysokość tła, czyli poziom ziemi. */
+    constexpr float windowWidth = 450; /**< Szerokość okna gry. */
+    constexpr float pipeSpawnX = windowWidth + pipeWidth; /**< Pozycja X nowej rury. */
+    constexpr int maxPipes = 4; /**< Maksymalna liczba rur na ekranie. */
+    constexpr int pipeHeights = 5; /**< Liczba możliwych wysokości rury. */
+
+    /**
+     * @brief Zwraca pozycję Y rury dla wylosowanej wysokości.
+     *
+     * @param roll Wylosowana wysokość z zakresu [0, pipeHeights).
+     * @return Pozycja Y rury.
+     */
+    constexpr float pipeY(int roll) {
+        return 100.0f + (float)(roll - 3) * 50;
+    }
+}
+
+#endif //FLAPPY_BIRD_DIFFICULTYRULES_H
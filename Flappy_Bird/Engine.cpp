@@ -1,27 +1,26 @@
 #include "Engine.h"
-#include "Bird.h"
-#include "Pipe.h"
 #include "PlayerModel.h"
+#include "Metrics.h"
+#include "StateMirror.h"
+#include "AllocTracker.h"
+#include "Bots.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
 
 /**
  * @file Engine.cpp
  * @brief Implementacja klasy Engine
  */
 
-/**
- * @brief Inicjalizuje wartości zmiennych statycznych
- */
-int Engine::score = 0; /**< Zlicza wynik */
-bool Engine::gameRunning = false; /**< Flaga wskazująca, czy gra jest uruchomiona */
-bool Engine::gameOvered = false; /**< Flaga wskazująca, czy gra jest zakończona */
-Difficulty Engine::chosenDifficulty = Difficulty::Medium; /**< Wybrany poziom trudności */
-float Engine::throatDifficulty = 340; /**< Wysokość rury */
-
 /**
  * @brief Konstruktor klasy Engine
+ *
+ * @param windowed Czy otworzyć okno
  */
-Engine::Engine(){
-    Engine::setup();
+Engine::Engine(bool windowed){
+    Engine::setup(windowed);
 }
 
 /**
@@ -51,15 +50,34 @@ void Engine::setupSounds() {
 
 /**
  * @brief Inicjalizuje grę
+ *
+ * @param windowed Czy otworzyć okno
  */
-void Engine::setup() {
+void Engine::setup(bool windowed) {
     inMainMenu = true;
     inGetReady = false;
     GetReadyFrame = false;
-    gamePaused = false;
 
-    srand((unsigned int)time(nullptr));
-    pipeGeneratingClock = new sf::Clock;
+    course = nullptr;
+    if (const char* path = std::getenv("FLAPPY_COURSE")) {
+        auto* file = new FileCourse(path);
+        if (file->isOpen()) {
+            course = file;
+        } else {
+            std::fprintf(stderr, "Nie udalo sie wczytac toru %s, tor bedzie losowany\n", path);
+            delete file;
+        }
+    }
+    if (!course) {
+        course = new GeneratedCourse;
+    }
+
+    reseed(nextSeed());
+    Metrics::open();
+    StateMirror::open();
+    ledger = new ScoreLedger("scores.bin");
+    blinkTimer = Scheduler::noTimer;
+    restartTimer = Scheduler::noTimer;
 
     gameoverTexture = new sf::Texture();
     gameoverTexture->loadFromFile("res/textures/gameover.png");
@@ -80,11 +98,33 @@ void Engine::setup() {
     font = new sf::Font();
     font->loadFromFile("res/fonts/04B_19__.TTF");
 
-    window = new sf::RenderWindow(sf::VideoMode(450, 700), "Flappy Bird 1.1");
-    window->setPosition({ 1000, 275 });
+    window = nullptr;
+    offscreen = nullptr;
+    if (windowed) {
+        window = new sf::RenderWindow(sf::VideoMode(450, 700), "Flappy Bird 1.1");
+        window->setPosition({ 1000, 275 });
+        target = window;
+    } else {
+        offscreen = new sf::RenderTexture();
+        offscreen->create(450, 700);
+        target = offscreen;
+    }
+
+    // FLAPPY_CAPTURE=plik.y4m nagrywa strumień Y4M, każda inna ścieżka to katalog na klatki PNG.
+    capture = nullptr;
+    softwareRenderer = nullptr;
+    dieSoundPending = false;
+    soundsDeferred = false;
+    pendingSoundCount = 0;
+    screenshotRequested = false;
+    captureClock = 0;
+    frameDelta = 0;
+    const char* capturePath = std::getenv("FLAPPY_CAPTURE");
+    if (capturePath && window) {
+        capture = new FrameCapture(capturePath, window->getSize(), captureFramerate);
+    }
 
-    b_skin = PlayerModel::Blue;
-    bird = new Bird(b_skin, hitSound, dieSound);
+    wingPhase = false;
 
     backgroundTexture = new sf::Texture();
 
@@ -111,60 +151,275 @@ void Engine::setup() {
     coinImage.loadFromFile("res/textures/coin.png");
     coin = new sf::Texture();
     coin->loadFromImage(coinImage);
+    birdAtlas = &BirdAtlas::get();
     setupSounds();
+
+    lowerRectangle.setSize({
+                                   (float)target->getSize().x,
+                                   (float)target->getSize().y - backgroundTexture->getSize().y - groundTexture->getSize().y
+                           });
+    lowerRectangle.setPosition(0, (float)backgroundTexture->getSize().y + groundTexture->getSize().y);
+    lowerRectangle.setFillColor({ 245, 228, 138 });
+
+    // Rozgrzewka: wczytanie glifów wszystkich cyfr i rezerwacja miejsca na długi wynik,
+    // żeby późniejsze zmiany wyniku nie alokowały pamięci.
+    scoreText.setFont(*font);
+    scoreText.setString("Score: 0123456789");
+    scoreText.getLocalBounds();
+    scoreString = "Score: 0000000000";
+    displayedScore = -1;
+    updateScoreText();
+
+    speedText.setFont(*font);
+    speedText.setCharacterSize(16);
+    speedText.setString("x0123456789 ticks/s");
+    speedText.getLocalBounds();
+    speedString = "x000 0000000 ticks/s";
+    speedText.setPosition(5, (float)target->getSize().y - 24);
+
+    // FLAPPY_SPEED=N uruchamia grę z najbliższym dostępnym przyspieszeniem nie większym niż N,
+    // FLAPPY_BOT=1 oddaje sterowanie botowi. Klawisze [ i ] zmieniają przyspieszenie.
+    timeScaleIndex = 0;
+    segmentSteps = 0;
+    segmentSeconds = 0;
+    if (const char* speed = std::getenv("FLAPPY_SPEED")) {
+        unsigned requested = (unsigned)std::strtoul(speed, nullptr, 10);
+        while (timeScaleIndex + 1 < timeScaleCount && timeScales[timeScaleIndex + 1] <= requested) {
+            timeScaleIndex++;
+        }
+    }
+    autopilot = std::getenv("FLAPPY_BOT") != nullptr;
+    // FLAPPY_REACH=plik wczytuje tablicę osiągalności (Flappy_Bird_reach build) dla bota.
+    reachTable = nullptr;
+    if (const char* path = std::getenv("FLAPPY_REACH")) {
+        auto* table = new ReachTable(path);
+        if (table->isOpen()) {
+            reachTable = table;
+        } else {
+            std::fprintf(stderr, "Nie udalo sie wczytac tablicy %s, bot bedzie trzymal sie srodka szczeliny\n", path);
+            delete table;
+        }
+    }
+    setTimeScale(timeScaleIndex);
+
+    // FLAPPY_FRAME_BUDGET_US=N ustawia budżet kosztu klatki, 0 wyłącza ograniczanie rysowania.
+    std::uint64_t budgetUs = defaultFrameBudgetUs;
+    if (const char* budget = std::getenv("FLAPPY_FRAME_BUDGET_US")) {
+        budgetUs = std::strtoull(budget, nullptr, 10);
+    }
+    frameBudget.reset(budgetUs);
+    budgetFrames = 0;
+    groundPending = 0;
+    Metrics::get().frameBudgetUs.store(budgetUs, std::memory_order_relaxed);
+    Metrics::get().qualityLevel.store(frameBudget.level(), std::memory_order_relaxed);
+
+    enforceNoAlloc = AllocTracker::enabled() && std::getenv("FLAPPY_NO_ALLOC") != nullptr;
+    frameCount = 0;
+    gameAllocations = 0;
+    maxFrameAllocations = 0;
+    allocationsReported = false;
 }
 
 /**
  * @brief Czyści grę
  */
 void Engine::destroy() {
+    reportTimeScale();
+    delete capture;
+    delete softwareRenderer;
     delete window;
-    delete bird;
+    delete offscreen;
     delete backgroundTexture;
-    delete pipeGeneratingClock;
     delete font;
     delete getReadyTexture[0];
     delete getReadyTexture[1];
     delete gameoverTexture;
     delete logoTexture;
     delete startTexture;
-
-    for (auto& pipe : pipes) { delete pipe; }
-    pipes.clear();
+    delete ledger;
+    delete course;
+    delete reachTable;
+    reachTable = nullptr;
+    Metrics::close();
+    StateMirror::close();
+
+    entities.clearPipes();
 }
 
 /**
  * @brief Restartuje grę
  */
 void Engine::restartGame() {
-    pipes.clear();
-    score = 0;
+    restart(nextSeed());
+    scheduler.cancel(restartTimer);
+    restartTimer = Scheduler::noTimer;
+    dieSoundPending = false;
     inMainMenu = true;
-    inGetReady = false;
-    gameRunning = false;
-    gameOvered = false;
-    bird = new Bird(b_skin, hitSound, dieSound);
-    SetGamePaused(false);
+    setGetReady(false);
+    gameAllocations = 0;
+    maxFrameAllocations = 0;
+    allocationsReported = false;
+}
+
+/**
+ * @brief Zapisuje stan rozgrywki i ekranu
+ *
+ * @param state Struktura, do której trafia stan
+ */
+void Engine::saveState(State& state) const {
+    GameCore::saveState(state);
+    state.inMainMenu = inMainMenu;
+    state.inGetReady = inGetReady;
+    state.groundOffset = groundOffset;
+}
+
+/**
+ * @brief Przywraca stan rozgrywki i ekranu
+ *
+ * @param state Zapisany stan
+ */
+void Engine::loadState(const State& state) {
+    GameCore::loadState(state);
+    dieSoundPending = false;
+    scheduler.cancel(restartTimer);
+    restartTimer = Scheduler::noTimer;
+    inMainMenu = state.inMainMenu;
+    if (inGetReady != state.inGetReady) {
+        setGetReady(state.inGetReady);
+    }
+    groundOffset = state.groundOffset;
+    groundPending = 0;
+}
+
+/**
+ * @brief Włącza lub wyłącza ekran "Get Ready"
+ *
+ * Miganie napisu trwa tylko wtedy, gdy ekran jest widoczny.
+ *
+ * @param active Czy ekran ma być widoczny
+ */
+void Engine::setGetReady(bool active) {
+    inGetReady = active;
+    scheduler.cancel(blinkTimer);
+    blinkTimer = Scheduler::noTimer;
+    if (active) {
+        GetReadyFrame = false;
+        blinkTimer = scheduler.schedule(blinkPeriod, &Engine::onBlinkTimer, this, blinkPeriod);
+    }
+}
+
+/**
+ * @brief Zdarzenie zegara: przełącza klatkę napisu "Get Ready"
+ *
+ * @param engine Silnik gry
+ */
+void Engine::onBlinkTimer(void* engine) {
+    auto* self = static_cast<Engine*>(engine);
+    self->GetReadyFrame = !self->GetReadyFrame;
+}
+
+/**
+ * @brief Przełącza klatkę animacji ptaka
+ */
+void Engine::animate() {
+    wingPhase = !wingPhase;
+    if (wingPhase && frameBudget.sheds(FrameBudget::SlowWings)) return;
+    GameCore::animate();
+}
+
+/**
+ * @brief Aktualizuje tekst z wynikiem
+ *
+ * Cyfry są wstawiane pojedynczo do scoreString, który ma już zarezerwowane
+ * miejsce, dzięki czemu zmiana wyniku nie alokuje pamięci.
+ */
+void Engine::updateScoreText() {
+    if (displayedScore == score) return;
+    displayedScore = score;
+
+    const std::size_t prefix = 7; // "Score: "
+    scoreString.erase(prefix, scoreString.getSize() - prefix);
+    char digits[16];
+    int len = std::snprintf(digits, sizeof(digits), "%d", score);
+    for (int i = 0; i < len; ++i) {
+        scoreString.insert(prefix + i, sf::String((sf::Uint32)digits[i]));
+    }
+    scoreText.setString(scoreString);
+    scoreText.setPosition(target->getSize().x / 2 - scoreText.getLocalBounds().width / 2, 5);
+}
+
+/**
+ * @brief Zlicza alokacje klatki i raportuje je po zakończeniu rozgrywki
+ *
+ * @param frameAllocations Liczba alokacji w ostatniej klatce
+ */
+void Engine::trackAllocations(std::uint64_t frameAllocations) {
+    if (!AllocTracker::enabled()) return;
+    frameCount++;
+    if (allocationsReported) return;
+
+    gameAllocations += frameAllocations;
+    if (frameAllocations > maxFrameAllocations) {
+        maxFrameAllocations = frameAllocations;
+    }
+    if (gameOvered) {
+        std::fprintf(stderr, "AllocTracker: gra zakonczona, %llu alokacji, maks. %llu w klatce\n",
+                     (unsigned long long)gameAllocations, (unsigned long long)maxFrameAllocations);
+        allocationsReported = true;
+    }
+}
+
+/**
+ * @brief Losuje ziarno nowej rozgrywki
+ *
+ * Licznik startuje z losowej wartości z std::random_device i rośnie o stałą złotego
+ * podziału, więc restarty w tej samej sekundzie dostają różne ziarna, a młodsze
+ * 32 bity (z których korzysta tor) różnią się między kolejnymi grami.
+ *
+ * @return Ziarno
+ */
+std::uint64_t Engine::nextSeed() {
+    static std::uint64_t counter = [] {
+        std::random_device device;
+        return ((std::uint64_t)device() << 32) ^ device();
+    }();
+    counter += 0x9E3779B97F4A7C15ull;
+    return counter;
 }
 
 /**
  * @brief Aktualizuje stan gry
  */
 void Engine::update() {
-    bird->update(delta, backgroundTexture);
-    for (const auto& pipe : pipes) {
-        pipe->update(bird, delta);
-    }
-    if (gameRunning && !gameOvered) {
-        if (pipeGeneratingClock->getElapsedTime().asSeconds() > 3.5) {
-            pipeGeneratingClock->restart();
-            pipes.push_back(new Pipe(pointSound, hitSound, upperPipe, lowerPipe, coin, window));
-            if (pipes.size() > 4) {
-                delete pipes[0];
-                pipes.erase(pipes.begin());
-            }
-        }
+    speedSteps++;
+    GameCore::update(delta);
+    playDieSound();
+    publishState();
+}
+
+/**
+ * @brief Publikuje stan gry w pamięci współdzielonej
+ */
+void Engine::publishState() {
+    static_assert(maxPipes <= MirrorState::maxPipes, "MirrorState musi pomiescic wszystkie rury");
+    MirrorState state{};
+    BirdState birdState = entities.saveBird(bird);
+    state.seed = seed;
+    state.ticks = ticks;
+    state.score = score;
+    state.birdY = birdState.y;
+    state.birdVel = birdState.vel;
+    state.difficulty = static_cast<std::uint8_t>(chosenDifficulty);
+    state.flags = (inMainMenu ? MirrorState::MainMenu : 0) | (inGetReady ? MirrorState::GetReady : 0) |
+                  (gamePaused ? MirrorState::Paused : 0) | (gameRunning ? MirrorState::Running : 0) |
+                  (gameOvered ? MirrorState::GameOver : 0);
+    PipeState pipes[maxPipes];
+    std::uint32_t pipeCount = entities.savePipes(pipes, (std::uint32_t)maxPipes);
+    for (std::uint32_t i = 0; i < pipeCount; ++i) {
+        const PipeState& p = pipes[i];
+        state.pipes[state.pipeCount++] = {p.x, p.y, p.throat, p.scored, p.coinVisible, {}};
     }
+    StateMirror::publish(state);
 }
 
 /**
@@ -186,25 +441,27 @@ void Engine::handleEvent(sf::Event& event) {
             wasBtnPressed = true;
             wasBtnReleased = false;
 
-            if (!gameRunning) {
-                gameRunning = true;
-                pipeGeneratingClock->restart();
-                pipes.push_back(new Pipe(pointSound, hitSound, upperPipe, lowerPipe, coin, window));
-            }
-            bird->flap();
-            if (wingSound.getStatus() != sf::Sound::Playing) {
-                wingSound.play();
-            }
+            flap();
         }
     }
 
+    if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::RBracket && timeScaleIndex + 1 < timeScaleCount) {
+        setTimeScale(timeScaleIndex + 1);
+    }
+    if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::LBracket && timeScaleIndex > 0) {
+        setTimeScale(timeScaleIndex - 1);
+    }
+    if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F12) {
+        screenshotRequested = true;
+    }
+
     if ((startSprite.getGlobalBounds().contains(event.mouseButton.x, event.mouseButton.y) && event.type == sf::Event::MouseButtonReleased) && inMainMenu) {
         inMainMenu = false;
-        inGetReady = true;
+        setGetReady(true);
     }
 
     if ((event.type == sf::Event::KeyPressed || event.type == sf::Event::MouseButtonPressed) && inGetReady) {
-        inGetReady = false;
+        setGetReady(false);
     }
 
     if (event.type == sf::Event::MouseButtonReleased && gameOvered) {
@@ -230,68 +487,156 @@ void Engine::handleEvent(sf::Event& event) {
  */
 void Engine::draw() {
 
-    window->clear();
-    window->draw(sf::Sprite(*backgroundTexture));
+    target->clear();
+    target->draw(sf::Sprite(*backgroundTexture));
 
-    for (const auto& pipe : pipes) {
-        pipe->draw(*window);
+    // Poziom trudności jest sprawdzany raz na klatkę, a nie dla każdej rury.
+    switch (chosenDifficulty) {
+        case Difficulty::Easy: drawPipes<Difficulty::Easy>(); break;
+        case Difficulty::Medium: drawPipes<Difficulty::Medium>(); break;
+        case Difficulty::Hard: drawPipes<Difficulty::Hard>(); break;
+        case Difficulty::Nightmare: drawPipes<Difficulty::Nightmare>(); break;
     }
 
     sf::Sprite groundSprite(*groundTexture);
     if (!(not gameRunning || gameOvered)) {
-        groundOffset -= delta * 100;
-        if (groundOffset <= -24) {
-            groundOffset += 24;
+        // Przy FrameBudget::CoarseGround ziemia przesuwa się co drugą klatkę, o czas obu klatek.
+        groundPending += delta;
+        if (!frameBudget.sheds(FrameBudget::CoarseGround) || (budgetFrames & 1) == 0) {
+            groundOffset -= groundPending * 100;
+            groundPending = 0;
+            if (groundOffset <= -24) {
+                groundOffset += 24;
+            }
         }
     }
     groundSprite.setPosition(groundOffset, backgroundTexture->getSize().y);
-    window->draw(groundSprite);
+    target->draw(groundSprite);
 
     if(inMainMenu)
         ShowMainMenu();
 
     if(inGetReady)
-    {
-        static sf::Clock clk;
-        if(clk.getElapsedTime().asMilliseconds() > 400)
-        {
-            GetReadyFrame = !GetReadyFrame;
-            clk.restart();
-        }
         ShowGetReady(GetReadyFrame);
-    }
 
-    sf::RectangleShape lowerRectangle({
-                                              (float)window->getSize().x,
-                                              (float)window->getSize().y - backgroundTexture->getSize().y - groundTexture->getSize().y
-                                      });
-    lowerRectangle.setPosition(0, (float)backgroundTexture->getSize().y + groundTexture->getSize().y);
-    lowerRectangle.setFillColor({ 245, 228, 138 });
-    window->draw(lowerRectangle);
+    target->draw(lowerRectangle);
 
-    bird->draw(*window);
+    drawBird();
 
     if(!inMainMenu && !inGetReady)
     {
-        sf::Text scoreText("Score: " + to_string(score), *font);
-        scoreText.setPosition(window->getSize().x / 2 - scoreText.getLocalBounds().width / 2, 5);
-        window->draw(scoreText);
+        if (!frameBudget.sheds(FrameBudget::SlowHud) || budgetFrames % hudInterval == 0) {
+            updateScoreText();
+        }
+        target->draw(scoreText);
+    }
+
+    if (timeScales[timeScaleIndex] > 1) {
+        target->draw(speedText);
     }
 
     if (gameOvered) {
         // Draw the restart button only after death
         gameoverSprite.setTexture(*gameoverTexture);
-        gameoverSprite.setPosition(window->getSize().x / 2 - gameoverSprite.getLocalBounds().width / 2, window->getSize().y / 4 - gameoverSprite.getLocalBounds().height / 4);
+        gameoverSprite.setPosition(target->getSize().x / 2 - gameoverSprite.getLocalBounds().width / 2, target->getSize().y / 4 - gameoverSprite.getLocalBounds().height / 4);
 
 
 
         sf::Sprite restartSprite(*restartTexture);
-        restartSprite.setPosition(window->getSize().x / 2 - restartSprite.getLocalBounds().width / 2, window->getSize().y / 2 - restartSprite.getLocalBounds().height / 2);
-        window->draw(gameoverSprite);
-        window->draw(restartSprite);
+        restartSprite.setPosition(target->getSize().x / 2 - restartSprite.getLocalBounds().width / 2, target->getSize().y / 2 - restartSprite.getLocalBounds().height / 2);
+        target->draw(gameoverSprite);
+        target->draw(restartSprite);
+    }
+
+    if (capture) {
+        // Nagranie ma stałe tempo: klatka gry zajmuje tyle klatek nagrania, ile minęło ich
+        // w czasie rzeczywistym. Przy przyspieszeniu delta to cały czas symulacji klatki,
+        // więc nagranie liczone od niej powtarzałoby każdą klatkę tyle razy, ile wynosi skala.
+        const float period = 1.0f / captureFramerate;
+        captureClock += frameDelta;
+        auto due = (unsigned)(captureClock / period);
+        if (due > 0) {
+            captureClock -= (float)due * period;
+            capture->capture(*window, due);
+        }
+    }
+
+    if (screenshotRequested) {
+        screenshotRequested = false;
+        saveScreenshots();
+    }
+
+    adjustQuality((std::uint64_t)workClock.getElapsedTime().asMicroseconds());
+    if (window) {
+        window->display();
+    } else {
+        offscreen->display();
     }
+}
 
-    window->display();
+/**
+ * @brief Zapisuje koszt klatki i dobiera poziom ograniczenia rysowania
+ *
+ * Decyzje trafiają do metryk, więc Flappy_Bird_metrics pokazuje poziom, liczbę
+ * jego zmian i liczbę klatek ponad budżetem.
+ *
+ * @param costUs Koszt klatki w mikrosekundach
+ */
+void Engine::adjustQuality(std::uint64_t costUs) {
+    auto& m = Metrics::get();
+    budgetFrames++;
+    m.frameCostUs.store(costUs, std::memory_order_relaxed);
+    if (frameBudget.budget() != 0 && costUs > frameBudget.budget()) {
+        Metrics::increment(m.framesOverBudget);
+    }
+    int change = frameBudget.record(costUs);
+    if (change == 0) return;
+    m.qualityLevel.store(frameBudget.level(), std::memory_order_relaxed);
+    Metrics::increment(change > 0 ? m.qualityDrops : m.qualityRestores);
+}
+
+/**
+ * @brief Rysuje ptaka
+ */
+void Engine::drawBird() {
+    static_assert(Animation::frames == BirdAtlas::animationFrames, "Animacja ptaka musi miec tyle klatek co atlas");
+    const BirdAtlas& atlas = *birdAtlas;
+    const Transform& t = entities.getBirdTransform(bird);
+    const Animation& animation = entities.getBirdAnimation(bird);
+    sf::Sprite birdSprite(atlas.getTexture(), atlas.getFrameRect(animation.skin, (int)animation.frame));
+    birdSprite.setRotation(8 * (t.vy / 400));
+    birdSprite.setPosition(t.x, t.y);
+    target->draw(birdSprite);
+}
+
+/**
+ * @brief Rysuje rury i monety dla poziomu trudności D
+ *
+ * Monety są rysowane po wszystkich rurach; rury nie nachodzą na siebie, więc
+ * obraz jest taki sam jak przy rysowaniu każdej monety zaraz po jej rurze.
+ */
+template<Difficulty D>
+void Engine::drawPipes() {
+    const auto& transforms = entities.getPipeTransforms();
+    const auto& gaps = entities.getGaps();
+    const std::size_t count = entities.pipeCount();
+    for (std::size_t i = 0; i < count; ++i) {
+        sf::Sprite upperSprite(*upperPipe);
+        upperSprite.setPosition(transforms[i].x, transforms[i].y + gaps[i].throat);
+        sf::Sprite lowerSprite(*lowerPipe);
+        lowerSprite.setPosition(transforms[i].x, transforms[i].y - gaps[i].throat);
+        target->draw(upperSprite);
+        target->draw(lowerSprite);
+    }
+
+    if (frameBudget.sheds(FrameBudget::NoCoins)) return;
+    const auto& coins = entities.getCoinTriggers();
+    for (std::size_t i = 0; i < count; ++i) {
+        if (coins[i].fired) continue;
+        sf::Sprite coinSprite(*coin);
+        coinSprite.setPosition(transforms[i].x, transforms[i].y + gaps[i].throat / RulesOf<D>::coinOffsetDivisor);
+        target->draw(coinSprite);
+    }
 }
 
 /**
@@ -303,141 +648,317 @@ void Engine::Play(){
         //if(GetScore() > 10) updateDifficulty(Difficulty::Nightmare);
 
         sf::Event event{};
+        workClock.restart();
+        bool noAlloc = enforceNoAlloc && frameCount >= allocWarmupFrames;
+        std::uint64_t allocsBefore = AllocTracker::allocations();
 
         while (window->pollEvent(event)) {
+            AllocTracker::Scope frameScope(noAlloc);
             handleEvent(event);
         }
 
-        //if (!gamePaused) {
-        delta = deltaClock.restart().asSeconds();
+        sf::Time frameTime = deltaClock.restart();
+        Metrics::recordFrame((std::uint64_t)frameTime.asMicroseconds());
+        {
+            AllocTracker::Scope frameScope(noAlloc);
+            frame(frameTime.asSeconds());
+        }
+        trackAllocations(AllocTracker::allocations() - allocsBefore);
+    }
+}
+
+/**
+ * @brief Wykonuje jedną klatkę bez obsługi zdarzeń okna
+ *
+ * @param frameTime Czas rzeczywisty klatki w sekundach
+ */
+void Engine::frame(float frameTime) {
+    frameDelta = frameTime;
+    if (timeScales[timeScaleIndex] > 1) {
+        fastForward(frameTime);
+    } else {
+        delta = frameTime;
+        if (autopilot) steerBot();
         update();
-        //}
-        draw();
     }
+    draw();
+    measureSpeed();
 }
 
 /**
- * @brief Wyświetla menu główne
+ * @brief Wykonuje kroki symulacji przypadające na jedną klatkę
+ *
+ * Symulacja idzie stałymi krokami fixedStep, a rysowanie, dźwięki i tekst wyniku
+ * są obsługiwane raz na wyświetlaną klatkę. Gdy kroki nie mieszczą się w klatce,
+ * zaległość jest obcinana do maxStepsPerScale klatek - gra zwalnia, zamiast
+ * wykonywać coraz więcej kroków, a pomiar kroków na sekundę to pokazuje.
+ *
+ * @param frameTime Czas rzeczywisty klatki w sekundach
  */
-void Engine::ShowMainMenu()
-{
-    logoSprite.setPosition(window->getSize().x / 2 - logoSprite.getLocalBounds().width / 2, window->getSize().y / 4 - logoSprite.getLocalBounds().height / 4);
-    window->draw(logoSprite);
+void Engine::fastForward(float frameTime) {
+    const unsigned scale = timeScales[timeScaleIndex];
+    stepAccumulator += frameTime * (float)scale;
+    const float maxBacklog = fixedStep * (float)(scale * maxStepsPerScale);
+    if (stepAccumulator > maxBacklog) {
+        stepAccumulator = maxBacklog;
+    }
+
+    float simulated = 0;
+    delta = fixedStep;
+    soundsDeferred = true;
+    while (stepAccumulator >= fixedStep) {
+        stepAccumulator -= fixedStep;
+        if (autopilot) steerBot();
+        update();
+        simulated += fixedStep;
+    }
+    soundsDeferred = false;
+    flushSounds();
 
-    startSprite.setPosition(window->getSize().x / 2 - startSprite.getLocalBounds().width / 2, window->getSize().y / 2 - startSprite.getLocalBounds().height / 2);
-    window->draw(startSprite);
+    // Przesunięcie ziemi w draw obejmuje cały czas symulacji tej klatki.
+    delta = simulated;
 }
 
 /**
- * @brief Wyświetla "Get Ready"
- * 
- * @param idx Index odpowiedzialny za teksturę którą wyświetlić
+ * @brief Raz na sekundę zapisuje zmierzoną liczbę kroków na sekundę
  */
-void Engine::ShowGetReady(bool idx)
-{
-    getReadySprite.setTexture(*getReadyTexture[static_cast<int>(idx)]);
-    getReadySprite.setPosition(window->getSize().x / 2 - getReadySprite.getLocalBounds().width / 2, window->getSize().y / 2 - getReadySprite.getLocalBounds().height / 2);
-    window->draw(getReadySprite);
+void Engine::measureSpeed() {
+    float elapsed = speedClock.getElapsedTime().asSeconds();
+    if (elapsed < 1.0f) return;
+    speedClock.restart();
+
+    auto ticksPerSecond = (unsigned)((float)speedSteps / elapsed + 0.5f);
+    Metrics::get().simTicksPerSecond.store(ticksPerSecond, std::memory_order_relaxed);
+    segmentSteps += speedSteps;
+    segmentSeconds += elapsed;
+    speedSteps = 0;
+    updateSpeedText(ticksPerSecond);
 }
 
 /**
- * @brief Uruchamia grę
+ * @brief Aktualizuje tekst z przyspieszeniem
+ *
+ * Tak jak updateScoreText, znaki są wstawiane do zarezerwowanego speedString.
+ *
+ * @param ticksPerSecond Zmierzona liczba kroków na sekundę
  */
-void Engine::Run()
-{
-    Play();
-    destroy();
+void Engine::updateSpeedText(unsigned ticksPerSecond) {
+    char line[32];
+    int len = std::snprintf(line, sizeof(line), "x%u %u ticks/s", timeScales[timeScaleIndex], ticksPerSecond);
+    speedString.erase(0, speedString.getSize());
+    for (int i = 0; i < len; ++i) {
+        speedString.insert(i, sf::String((sf::Uint32)line[i]));
+    }
+    speedText.setString(speedString);
 }
 
 /**
- * @brief Ustawia stan gry
- * 
- * @param state Odpwoiada za stan gry
+ * @brief Zmienia przyspieszenie gry
+ *
+ * @param index Indeks przyspieszenia w timeScales
  */
-void Engine::SetGameRunning(bool state){
-    Engine::gameRunning = state;
+void Engine::setTimeScale(std::size_t index) {
+    reportTimeScale();
+    timeScaleIndex = index;
+    stepAccumulator = 0;
+    speedSteps = 0;
+    segmentSteps = 0;
+    segmentSeconds = 0;
+    speedClock.restart();
+    Metrics::get().timeScale.store(timeScales[index], std::memory_order_relaxed);
+    updateSpeedText(timeScales[index] * 60);
 }
 
 /**
- * @brief Ustawia stan zakończenia gry
- * 
- * @param state Nowy stan zakonczenia gry
+ * @brief Wypisuje średnią liczbę kroków na sekundę dla bieżącego przyspieszenia
  */
-void Engine::SetGameOvered(bool state){
-    Engine::gameOvered = state;
+void Engine::reportTimeScale() {
+    if (timeScales[timeScaleIndex] == 1 || segmentSeconds <= 0) return;
+    std::fprintf(stderr, "Przyspieszenie x%u: %.0f krokow symulacji/s przez %.0f s (cel %u)\n",
+                 timeScales[timeScaleIndex], (double)segmentSteps / segmentSeconds, segmentSeconds,
+                 timeScales[timeScaleIndex] * 60);
 }
 
 /**
- * @brief Pobiera aktualny stan gry
- * 
- * @return true if the game is running, false otherwise
+ * @brief Steruje ptakiem botem
+ *
+ * Bot widzi grę przez World, tak samo jak w symulacji bez okna. Gdy wczytana jest
+ * tablica osiągalności, decyzje bierze z niej, a poza tablicą używa Bots::center.
  */
-bool Engine::isGameRunning(){
-    return Engine::gameRunning;
+void Engine::steerBot() {
+    if (inMainMenu || inGetReady) {
+        inMainMenu = false;
+        setGetReady(false);
+    }
+    if (gameOvered) {
+        if (restartTimer == Scheduler::noTimer) {
+            restartTimer = scheduler.schedule(1.0, &Engine::onRestartTimer, this);
+        }
+        return;
+    }
+
+    World world = toWorld();
+    bool flapNow;
+    if (!reachTable || !reachTable->decide(world, flapNow)) {
+        flapNow = Bots::center(world);
+    }
+    if (flapNow) {
+        flap();
+    }
 }
 
 /**
- * @brief Pobiera aktualny stan gameOvered
- * 
- * @return true if the game is over, false otherwise
+ * @brief Zapisuje zrzut okna i zrzut tej samej klatki z SoftwareRenderer
+ *
+ * Zrzut przydziela pamięć, więc wymuszanie braku alokacji jest wyłączane
+ * do końca tej klatki.
+ */
+void Engine::saveScreenshots() {
+    AllocTracker::setEnforced(false);
+
+    sf::Texture windowTexture;
+    windowTexture.create(window->getSize().x, window->getSize().y);
+    windowTexture.update(*window);
+    sf::Image gpu = windowTexture.copyToImage();
+    gpu.saveToFile("screenshot_gpu.png");
+
+    if (inMainMenu) {
+        std::fprintf(stderr, "Zapisano screenshot_gpu.png (menu glowne nie jest rysowane przez SoftwareRenderer)\n");
+        return;
+    }
+    if (!softwareRenderer) {
+        softwareRenderer = new SoftwareRenderer();
+    }
+    World world = toWorld();
+    RenderScene scene{&world, chosenDifficulty, b_skin, (int)entities.saveBird(bird).frame, groundOffset,
+                      !inGetReady, inGetReady, GetReadyFrame ? 1 : 0, gameOvered};
+    std::vector<std::uint8_t> cpu((std::size_t)SoftwareRenderer::width * SoftwareRenderer::height * 4);
+    softwareRenderer->render(scene, cpu.data());
+    SoftwareRenderer::savePng("screenshot_cpu.png", cpu.data(), SoftwareRenderer::width, SoftwareRenderer::height);
+
+    if (gpu.getSize() != sf::Vector2u(SoftwareRenderer::width, SoftwareRenderer::height)) {
+        std::fprintf(stderr, "Zapisano screenshot_gpu.png i screenshot_cpu.png (rozne rozmiary, bez porownania)\n");
+        return;
+    }
+    ImageDiff diff = SoftwareRenderer::compare(gpu.getPixelsPtr(), cpu.data(), gpu.getSize().x * gpu.getSize().y, 8);
+    std::fprintf(stderr, "Zapisano screenshot_gpu.png i screenshot_cpu.png: %zu z %zu pikseli rozni sie o wiecej niz 8, "
+                         "najwieksza roznica %d, srednia %.3f\n",
+                 diff.differing, diff.pixels, diff.maxDifference, diff.meanDifference);
+}
+
+/**
+ * @brief Zdarzenie zegara: restartuje grę bota
+ *
+ * @param engine Silnik gry
  */
-bool Engine::isGameOvered(){
-    return Engine::gameOvered;
+void Engine::onRestartTimer(void* engine) {
+    auto* self = static_cast<Engine*>(engine);
+    self->restartTimer = Scheduler::noTimer;
+    self->restartGame();
 }
 
 /**
- * @brief Pobiera aktualny wynik
- * 
- * @return Aktualny wynik
+ * @brief Odtwarza dźwięk zdarzenia gry
+ *
+ * @param sound Dźwięk
  */
-int Engine::GetScore(){
-    return Engine::score;
+void Engine::playSound(sf::Sound& sound) {
+    if (!soundsDeferred) {
+        sound.play();
+        return;
+    }
+    for (std::size_t i = 0; i < pendingSoundCount; ++i) {
+        if (pendingSounds[i] == &sound) return;
+    }
+    if (pendingSoundCount < maxPendingSounds) {
+        pendingSounds[pendingSoundCount++] = &sound;
+    }
 }
 
 /**
- * @brief Ustanawia aktualny wynik
- * 
- * @param __score Nowy wynik
+ * @brief Odtwarza dźwięk zdarzenia kroku symulacji
+ *
+ * Wynik z monet liczy GameCore::handleGameEvents przed tym wywołaniem.
+ *
+ * @param event Zdarzenie
  */
-void Engine::SetScore(int __score){
-    Engine::score = __score;
+void Engine::onGameEvent(const GameEvent& event) {
+    switch (event.type) {
+        case GameEventType::Flap:
+            if (wingSound.getStatus() != sf::Sound::Playing) {
+                playSound(wingSound);
+            }
+            break;
+        case GameEventType::Coin:
+            playSound(pointSound);
+            break;
+        case GameEventType::Pass:
+            break;
+        case GameEventType::Hit:
+            playSound(hitSound);
+            break;
+        case GameEventType::Die:
+            if (hitSound.getStatus() != sf::Sound::Playing) {
+                playSound(hitSound);
+            }
+            dieSoundPending = true;
+            break;
+    }
 }
 
 /**
- * @brief Ustawia trudność gry
- * 
- * @param __diff Nowa trudność gry
+ * @brief Odtwarza dźwięk śmierci
+ *
+ * Dźwięk śmierci czeka, aż skończy się dźwięk uderzenia.
  */
-void Engine::SetDifficulty(Difficulty __diff){
-    Engine::chosenDifficulty = __diff;
+void Engine::playDieSound() {
+    if (dieSoundPending && hitSound.getStatus() != sf::Sound::Playing) {
+        playSound(dieSound);
+        dieSoundPending = false;
+    }
 }
 
 /**
- * @brief Pobiera aktualną trudność
- * 
- * @return Aktualna trudność gry
+ * @brief Odtwarza odłożone dźwięki
+ */
+void Engine::flushSounds() {
+    for (std::size_t i = 0; i < pendingSoundCount; ++i) {
+        pendingSounds[i]->play();
+    }
+    pendingSoundCount = 0;
+}
+
+/**
+ * @brief Wyświetla menu główne
  */
-Difficulty Engine::GetDifficulty(){
-    return Engine::chosenDifficulty;
+void Engine::ShowMainMenu()
+{
+    logoSprite.setPosition(target->getSize().x / 2 - logoSprite.getLocalBounds().width / 2, target->getSize().y / 4 - logoSprite.getLocalBounds().height / 4);
+    target->draw(logoSprite);
+
+    startSprite.setPosition(target->getSize().x / 2 - startSprite.getLocalBounds().width / 2, target->getSize().y / 2 - startSprite.getLocalBounds().height / 2);
+    target->draw(startSprite);
 }
 
 /**
- * @brief Ustanawia trudność "gardła" rury
+ * @brief Wyświetla "Get Ready"
  * 
- * @param __throat Nowa trudność "gardła"
+ * @param idx Index odpowiedzialny za teksturę którą wyświetlić
  */
-void Engine::SetThroatDifficulty(float __throat)
+void Engine::ShowGetReady(bool idx)
 {
-    Engine::throatDifficulty = __throat;
+    getReadySprite.setTexture(*getReadyTexture[static_cast<int>(idx)]);
+    getReadySprite.setPosition(target->getSize().x / 2 - getReadySprite.getLocalBounds().width / 2, target->getSize().y / 2 - getReadySprite.getLocalBounds().height / 2);
+    target->draw(getReadySprite);
 }
 
 /**
- * @brief Pobiera aktualną trudność "gardła"
- * 
- * @return Aktualna trudność "gardła"
+ * @brief Uruchamia grę
  */
-float Engine::GetThroatDifficulty(){
-    return Engine::throatDifficulty;
+void Engine::Run()
+{
+    Play();
+    destroy();
 }
 
 /**
@@ -447,26 +968,7 @@ float Engine::GetThroatDifficulty(){
  */
 void Engine::updateDifficulty(Difficulty diff) {
     SetDifficulty(diff);
-    switch(chosenDifficulty)
-    {
-        case Difficulty::Easy:
-            backgroundTexture->loadFromFile("res/textures/background/day.png");
-            Engine::SetThroatDifficulty(380);
-            break;
-        case Difficulty::Medium:
-            backgroundTexture->loadFromFile("res/textures/background/day.png");
-            Engine::SetThroatDifficulty(340);
-            break;
-        case Difficulty::Hard:
-            backgroundTexture->loadFromFile("res/textures/background/night.png");
-            Engine::SetThroatDifficulty(320);
-            break;
-        case Difficulty::Nightmare:
-            backgroundTexture->loadFromFile("res/textures/background/impossible.png");
-            Engine::SetThroatDifficulty(315);
-            break;
-        default:
-            backgroundTexture->loadFromFile("res/textures/background/day.png");
-            Engine::SetThroatDifficulty(340);
-    }
+    const DifficultyRules& rules = rulesFor(chosenDifficulty);
+    backgroundTexture->loadFromFile(rules.background);
+    Engine::SetThroatDifficulty(rules.throat);
 }
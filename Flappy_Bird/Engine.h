@@ -5,38 +5,63 @@
 #include <SFML/Graphics.hpp>
 #include <SFML/Audio.hpp>
 #include <vector>
-#include "Pipe.h"
-#include "Bird.h"
+#include "GameCore.h"
+#include "BirdAtlas.h"
 #include "Difficulty.h"
+#include "DifficultyRules.h"
 #include "PlayerModel.h"
+#include "ScoreLedger.h"
+#include "FrameCapture.h"
+#include "FrameBudget.h"
+#include "Scheduler.h"
+#include "Course.h"
+#include "ReachTable.h"
+#include "GameEvents.h"
+#include "SoftwareRenderer.h"
+#include <cstdint>
 #include <string>
 
 /**
  * @brief Klasa silnika gry Flappy Bird.
  *
  * Klasa zarządza główną logiką gry, w tym grafiką, dźwiękiem, fizyką obiektów oraz interakcjami użytkownika.
+ * Krok gry bez okna (encje, rury, wynik, restart) pochodzi z GameCore.
  */
-class Engine {
+class Engine : public GameCore {
 protected:
-    static Difficulty chosenDifficulty; /**< Wybrany poziom trudności gry. */
-    static float throatDifficulty; /**< Poziom trudności gry ustalony przez gracza. */
-    static int score; /**< Aktualny wynik gracza. */
-    static bool gameRunning, gameOvered; /**< Flaga określająca, czy gra jest w trakcie działania lub zakończona. */
-    bool inMainMenu, inGetReady, GetReadyFrame, gamePaused; /**< Flagi stanów gry: menu główne, przygotowanie do rozpoczęcia, pauza. */
+    bool inMainMenu, inGetReady, GetReadyFrame; /**< Flagi stanów gry: menu główne, przygotowanie do rozpoczęcia. */
     float groundOffset; /**< Przesunięcie terenu gry (ziemi). */
     float delta; /**< Czas delta - czas od ostatniej klatki, używany do obliczeń fizycznych. */
 
-    sf::RenderWindow* window; /**< Okno renderowania SFML. */
+    sf::RenderWindow* window; /**< Okno renderowania SFML lub nullptr przy rysowaniu poza ekranem. */
+    sf::RenderTexture* offscreen; /**< Tekstura, na którą rysuje silnik bez okna, lub nullptr. */
+    sf::RenderTarget* target; /**< Cel rysowania: okno albo offscreen. */
 
     sf::Texture* backgroundTexture; /**< Tekstura tła gry. */
-    Bird *bird; /**< Obiekt reprezentujący postać ptaka w grze. */
-
-    PlayerModel b_skin; /**< Model gracza (postać gracza). */
-
-    std::vector<Pipe*> pipes; /**< Wektor przechowujący wskaźniki na rury (przeszkody) w grze. */
 
     sf::Texture* groundTexture; /**< Tekstura terenu gry (ziemi). */
-    sf::Clock* pipeGeneratingClock; /**< Zegar do generowania rur w grze. */
+    Scheduler::TimerId blinkTimer; /**< Zdarzenie migania napisu "Get Ready" lub Scheduler::noTimer. */
+    static constexpr double blinkPeriod = 0.4; /**< Czas wyświetlania jednej klatki napisu "Get Ready". */
+
+    static constexpr unsigned timeScales[] = {1, 2, 5, 10, 20, 50, 100}; /**< Dostępne przyspieszenia gry. */
+    static constexpr std::size_t timeScaleCount = sizeof(timeScales) / sizeof(timeScales[0]); /**< Liczba przyspieszeń. */
+    static constexpr float fixedStep = 1.0f / 60.0f; /**< Czas kroku symulacji w trybie przyspieszonym. */
+    static constexpr unsigned maxStepsPerScale = 8; /**< Limit kroków na klatkę, jako wielokrotność przyspieszenia. */
+    std::size_t timeScaleIndex; /**< Indeks bieżącego przyspieszenia w timeScales. */
+    float stepAccumulator; /**< Czas symulacji czekający na wykonanie w trybie przyspieszonym. */
+    std::uint64_t speedSteps; /**< Kroki symulacji od początku bieżącego okna pomiaru. */
+    sf::Clock speedClock; /**< Zegar okna pomiaru kroków na sekundę (1 s). */
+    std::uint64_t segmentSteps; /**< Kroki symulacji od ostatniej zmiany przyspieszenia. */
+    float segmentSeconds; /**< Czas rzeczywisty od ostatniej zmiany przyspieszenia. */
+    bool autopilot; /**< Czy ptakiem steruje bot (zmienna środowiskowa FLAPPY_BOT). */
+    ReachTable* reachTable; /**< Tablica osiągalności bota (zmienna środowiskowa FLAPPY_REACH) lub nullptr. */
+    Scheduler::TimerId restartTimer; /**< Zdarzenie automatycznego restartu gry bota lub Scheduler::noTimer. */
+
+    bool dieSoundPending; /**< Czy dźwięk śmierci czeka na koniec dźwięku uderzenia. */
+    bool soundsDeferred; /**< Czy dźwięki są odkładane do końca klatki. */
+    static constexpr std::size_t maxPendingSounds = 8; /**< Pojemność kolejki odłożonych dźwięków. */
+    sf::Sound* pendingSounds[maxPendingSounds]; /**< Dźwięki do odtworzenia na końcu klatki, bez powtórzeń. */
+    std::size_t pendingSoundCount; /**< Liczba odłożonych dźwięków. */
 
     sf::Font* font; /**< Czcionka używana do wyświetlania tekstu w grze. */
     sf::SoundBuffer pointSoundBuffer; /**< Bufor dźwięku punktu zdobytego w grze. */
@@ -70,12 +95,44 @@ protected:
     sf::Sprite coinSprite; /**< Sprite monety w grze. */
 
     sf::Texture* coin; /**< Tekstura monety w grze. */
+    const BirdAtlas* birdAtlas; /**< Atlas klatek ptaka, pobrany raz w setup. */
+
+    static constexpr unsigned captureFramerate = 60; /**< Liczba klatek na sekundę nagrania. */
+    FrameCapture* capture; /**< Nagrywanie rozgrywki lub nullptr, gdy wyłączone. */
+    float captureClock; /**< Czas rzeczywisty, który nie wypełnił jeszcze pełnej klatki nagrania, w sekundach. */
+    float frameDelta; /**< Czas rzeczywisty bieżącej klatki; przy przyspieszeniu delta obejmuje cały czas symulacji. */
+    SoftwareRenderer* softwareRenderer; /**< Rysowanie na procesorze do porównań, tworzone przy pierwszym zrzucie. */
+    bool screenshotRequested; /**< Czy zapisać zrzuty ekranu w najbliższej klatce (klawisz F12). */
+
+    static constexpr std::uint64_t defaultFrameBudgetUs = 12000; /**< Domyślny budżet kosztu klatki: zapas na wyświetlenie przy 60 Hz. */
+    static constexpr std::uint32_t hudInterval = 15; /**< Co ile klatek odświeżany jest wynik przy FrameBudget::SlowHud. */
+    FrameBudget frameBudget; /**< Poziom ograniczenia rysowania (zmienna środowiskowa FLAPPY_FRAME_BUDGET_US). */
+    sf::Clock workClock; /**< Zegar kosztu bieżącej klatki: od początku klatki do wyświetlenia. */
+    std::uint32_t budgetFrames; /**< Licznik klatek, według którego pomijana jest co n-ta praca. */
+    bool wingPhase; /**< Co drugie zdarzenie animacji skrzydeł, pomijane przy FrameBudget::SlowWings. */
+    float groundPending; /**< Czas, o który ziemia jeszcze nie została przesunięta. */
+
+    sf::RectangleShape lowerRectangle; /**< Pas pod ziemią, wypełniający dół okna. */
+    sf::Text scoreText; /**< Tekst z wynikiem gracza. */
+    sf::String scoreString; /**< Treść tekstu z wynikiem, modyfikowana w miejscu. */
+    int displayedScore; /**< Wynik aktualnie wyświetlany w scoreText. */
+    sf::Text speedText; /**< Tekst z przyspieszeniem i zmierzoną liczbą kroków na sekundę. */
+    sf::String speedString; /**< Treść tekstu z przyspieszeniem, modyfikowana w miejscu. */
+
+    static constexpr std::uint32_t allocWarmupFrames = 120; /**< Liczba klatek rozgrzewki przed wymuszaniem braku alokacji. */
+    bool enforceNoAlloc; /**< Czy po rozgrzewce alokacje w pętli gry mają przerywać program. */
+    std::uint32_t frameCount; /**< Liczba klatek od uruchomienia gry. */
+    std::uint64_t gameAllocations; /**< Liczba alokacji w bieżącej rozgrywce. */
+    std::uint64_t maxFrameAllocations; /**< Największa liczba alokacji w jednej klatce bieżącej rozgrywki. */
+    bool allocationsReported; /**< Flaga określająca, czy alokacje bieżącej rozgrywki zostały już zgłoszone. */
 
 public:
     /**
      * @brief Konstruktor klasy Engine.
+     *
+     * @param windowed Czy otworzyć okno; bez niego silnik rysuje na teksturze poza ekranem.
      */
-    Engine();
+    explicit Engine(bool windowed = true);
 
     /**
      * @brief Destruktor klasy Engine.
@@ -89,8 +146,10 @@ public:
 
     /**
      * @brief Przygotowuje silnik gry do rozpoczęcia nowej gry.
+     *
+     * @param windowed Czy otworzyć okno.
      */
-    void setup();
+    void setup(bool windowed);
 
     /**
      * @brief Niszczy zasoby używane przez silnik gry.
@@ -103,136 +162,220 @@ public:
     void restartGame();
 
     /**
-     * @brief Aktualizuje stan gry i fizykę obiektów w grze.
+     * @brief Migawka stanu rozgrywki razem ze stanem ekranu.
      */
-    void update();
+    struct State : GameCore::State {
+        bool inMainMenu; /**< Flaga menu głównego. */
+        bool inGetReady; /**< Flaga ekranu "Get Ready". */
+        float groundOffset; /**< Przesunięcie terenu. */
+    };
 
     /**
-     * @brief Obsługuje zdarzenia generowane przez użytkownika (np. klawisze, mysz).
+     * @brief Zapisuje stan rozgrywki i ekranu.
      *
-     * @param event Zdarzenie SFML do obsłużenia.
+     * @param state Struktura, do której trafia stan.
      */
-    void handleEvent(sf::Event& event);
+    void saveState(State& state) const;
 
     /**
-     * @brief Renderuje obiekty gry na ekranie.
+     * @brief Przywraca stan zapisany przez saveState.
+     *
+     * Odłożony dźwięk śmierci i zaplanowany restart bota są odwoływane.
+     *
+     * @param state Zapisany stan.
      */
-    void draw();
+    void loadState(const State& state);
 
     /**
-     * @brief Rozpoczyna główną pętlę gry.
+     * @brief Włącza lub wyłącza ekran "Get Ready" razem z miganiem napisu.
+     *
+     * @param active Czy ekran ma być widoczny.
      */
-    void Run();
+    void setGetReady(bool active);
 
     /**
-     * @brief Rozpoczyna fazę gry.
+     * @brief Zdarzenie zegara: przełącza klatkę napisu "Get Ready".
+     *
+     * @param engine Silnik gry.
      */
-    void Play();
+    static void onBlinkTimer(void* engine);
 
     /**
-     * @brief Wyświetla menu główne gry.
+     * @brief Przełącza klatkę animacji ptaka, co drugą pomijając przy FrameBudget::SlowWings.
      */
-    void ShowMainMenu();
+    void animate() override;
 
     /**
-     * @brief Wyświetla ekran "Get Ready".
+     * @brief Aktualizuje tekst z wynikiem, jeśli wynik się zmienił.
+     */
+    void updateScoreText();
+
+    /**
+     * @brief Zmienia przyspieszenie gry i podsumowuje pomiar poprzedniego.
      *
-     * @param idx Indeks do wyboru tekstury "Get Ready".
+     * @param index Indeks przyspieszenia w timeScales.
      */
-    void ShowGetReady(bool idx);
+    void setTimeScale(std::size_t index);
+
+    /**
+     * @brief Wypisuje średnią liczbę kroków na sekundę od ostatniej zmiany przyspieszenia.
+     */
+    void reportTimeScale();
+
+    /**
+     * @brief Wykonuje kroki symulacji przypadające na jedną klatkę w trybie przyspieszonym.
+     *
+     * @param frameTime Czas rzeczywisty klatki w sekundach.
+     */
+    void fastForward(float frameTime);
 
     /**
-     * @brief Ustawia stan działania gry (uruchomiona lub zatrzymana).
+     * @brief Raz na sekundę zapisuje zmierzoną liczbę kroków na sekundę.
+     */
+    void measureSpeed();
+
+    /**
+     * @brief Aktualizuje tekst z przyspieszeniem i liczbą kroków na sekundę.
      *
-     * @param state Nowy stan gry.
+     * @param ticksPerSecond Zmierzona liczba kroków na sekundę.
+     */
+    void updateSpeedText(unsigned ticksPerSecond);
+
+    /**
+     * @brief Steruje ptakiem botem (tablicą osiągalności albo Bots::center), pomijając menu i restartując grę po śmierci.
      */
-    static void SetGameRunning(bool state);
+    void steerBot();
 
     /**
-     * @brief Ustawia stan zakończenia gry.
+     * @brief Zapisuje zrzut okna i zrzut tej samej klatki z SoftwareRenderer, i wypisuje różnice.
      *
-     * @param state Nowy stan zakończenia gry.
+     * Wywoływana w draw przed display, gdy tylny bufor zawiera gotową klatkę.
      */
-    static void SetGameOvered(bool state);
+    void saveScreenshots();
 
     /**
-     * @brief Sprawdza, czy gra jest uruchomiona.
+     * @brief Zdarzenie zegara: restartuje grę bota.
      *
-     * @return true jeśli gra jest uruchomiona.
-     * @return false jeśli gra nie jest uruchomiona.
+     * @param engine Silnik gry.
      */
-    static bool isGameRunning();
+    static void onRestartTimer(void* engine);
 
     /**
-     * @brief Sprawdza, czy gra jest zakończona.
+     * @brief Odtwarza dźwięk zdarzenia gry.
      *
-     * @return true jeśli gra jest zakończona.
-     * @return false jeśli gra nie jest zakończona.
+     * W trybie przyspieszonym dźwięki są odkładane i odtwarzane raz na wyświetlaną klatkę.
+     *
+     * @param sound Dźwięk.
      */
-    static bool isGameOvered();
+    void playSound(sf::Sound& sound);
 
     /**
-     * @brief Zwraca stan pauzy gry.
+     * @brief Odtwarza odłożone dźwięki, każdy raz.
+     */
+    void flushSounds();
+
+    /**
+     * @brief Odtwarza dźwięk zdarzenia kroku symulacji.
      *
-     * @return true jeśli gra jest w trybie pauzy.
-     * @return false jeśli gra nie jest w trybie pauzy.
+     * @param event Zdarzenie.
+     */
+    void onGameEvent(const GameEvent& event) override;
+
+    /**
+     * @brief Odtwarza dźwięk śmierci, gdy skończy się dźwięk uderzenia.
      */
-    bool GetGamePaused(){return gamePaused;};
+    void playDieSound();
 
     /**
-     * @brief Ustawia stan pauzy gry.
+     * @brief Zlicza alokacje klatki i raportuje je po zakończeniu rozgrywki.
      *
-     * @param __paused Nowy stan pauzy gry.
+     * @param frameAllocations Liczba alokacji w ostatniej klatce.
      */
-    void SetGamePaused(bool __paused){gamePaused = __paused;};
+    void trackAllocations(std::uint64_t frameAllocations);
 
     /**
-     * @brief Zwraca aktualny wynik gry.
+     * @brief Zwraca ziarno nowej rozgrywki.
      *
-     * @return Aktualny wynik gracza.
+     * @return Ziarno.
+     */
+    static std::uint64_t nextSeed();
+
+    /**
+     * @brief Aktualizuje stan gry i fizykę obiektów w grze.
      */
-    static int GetScore();
+    void update();
 
     /**
-     * @brief Ustawia nowy wynik gry.
+     * @brief Wykonuje jedną klatkę bez obsługi zdarzeń okna: kroki symulacji i rysowanie.
      *
-     * @param __score Nowy wynik gracza.
+     * @param frameTime Czas rzeczywisty klatki w sekundach.
+     */
+    void frame(float frameTime);
+
+    /**
+     * @brief Publikuje stan gry dla zewnętrznych podglądów (StateMirror), co krok symulacji.
      */
-    static void SetScore(int __score);
+    void publishState();
 
     /**
-     * @brief Ustawia poziom trudności gry.
+     * @brief Obsługuje zdarzenia generowane przez użytkownika (np. klawisze, mysz).
      *
-     * @param __diff Nowy poziom trudności.
+     * @param event Zdarzenie SFML do obsłużenia.
      */
-    static void SetDifficulty(Difficulty __diff);
+    void handleEvent(sf::Event& event);
+
+    /**
+     * @brief Renderuje obiekty gry na ekranie.
+     */
+    void draw();
 
     /**
-     * @brief Zwraca aktualnie ustawiony poziom trudności gry.
+     * @brief Zapisuje koszt klatki i dobiera poziom ograniczenia rysowania (FrameBudget).
      *
-     * @return Aktualny poziom trudności gry.
+     * @param costUs Koszt klatki w mikrosekundach, bez czekania na wyświetlenie.
      */
-    static Difficulty GetDifficulty();
+    void adjustQuality(std::uint64_t costUs);
 
     /**
-     * @brief Aktualizuje poziom trudności gry na podstawie nowego ustawienia.
+     * @brief Rysuje ptaka z jego komponentów Transform i Animation.
+     */
+    void drawBird();
+
+    /**
+     * @brief Rysuje wszystkie rury i monety dla danego poziomu trudności.
      *
-     * @param __diff Nowy poziom trudności do zaktualizowania.
+     * @tparam D Poziom trudności.
      */
-    void updateDifficulty(Difficulty __diff);
+    template<Difficulty D>
+    void drawPipes();
+
+    /**
+     * @brief Rozpoczyna główną pętlę gry.
+     */
+    void Run();
+
+    /**
+     * @brief Rozpoczyna fazę gry.
+     */
+    void Play();
 
     /**
-     * @brief Ustawia poziom trudności fizycznej przeszkód w grze.
+     * @brief Wyświetla menu główne gry.
+     */
+    void ShowMainMenu();
+
+    /**
+     * @brief Wyświetla ekran "Get Ready".
      *
-     * @param __throat Nowy poziom trudności fizycznej przeszkód.
+     * @param idx Indeks do wyboru tekstury "Get Ready".
      */
-    static void SetThroatDifficulty(float __throat);
+    void ShowGetReady(bool idx);
 
     /**
-     * @brief Zwraca aktualnie ustawiony poziom trudności fizycznej przeszkód w grze.
+     * @brief Aktualizuje poziom trudności gry na podstawie nowego ustawienia.
      *
-     * @return Aktualny poziom trudności fizycznej przeszkód.
+     * @param __diff Nowy poziom trudności do zaktualizowania.
      */
-    static float GetThroatDifficulty();
+    void updateDifficulty(Difficulty __diff);
 };
 #endif
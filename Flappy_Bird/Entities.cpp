@@ -0,0 +1,355 @@
+/**
+ * @file Entities.cpp
+ * @brief Implementacja encji gry i systemów, które je aktualizują.
+ */
+
+#include "Entities.h"
+#include "Metrics.h"
+
+/**
+ * @brief Konstruktor klasy EntityWorld
+ */
+EntityWorld::EntityWorld() : nextOrder(0), freeCount((std::uint32_t)capacity) {
+    for (std::size_t i = 0; i < capacity; ++i) {
+        freeEntities[i] = (Entity)(capacity - 1 - i);
+    }
+}
+
+/**
+ * @brief Tworzy encję bez komponentów
+ *
+ * @return Nowa encja lub noEntity, gdy skończyły się identyfikatory
+ */
+Entity EntityWorld::create() {
+    if (freeCount == 0) return noEntity;
+    return freeEntities[--freeCount];
+}
+
+/**
+ * @brief Usuwa encję i wszystkie jej komponenty
+ *
+ * Ostatni wiersz tabeli encji przechodzi na jej miejsce we wszystkich kolumnach.
+ *
+ * @param entity Encja
+ */
+void EntityWorld::destroy(Entity entity) {
+    std::uint32_t row = birds.remove(entity);
+    if (row != npos) {
+        const std::size_t last = birds.size();
+        birdTransforms[row] = birdTransforms[last];
+        birdColliders[row] = birdColliders[last];
+        flights[row] = flights[last];
+        animations[row] = animations[last];
+    }
+    row = pipes.remove(entity);
+    if (row != npos) {
+        const std::size_t last = pipes.size();
+        pipeTransforms[row] = pipeTransforms[last];
+        gaps[row] = gaps[last];
+        passTriggers[row] = passTriggers[last];
+        coinColliders[row] = coinColliders[last];
+        coinTriggers[row] = coinTriggers[last];
+        spawnOrder[row] = spawnOrder[last];
+    }
+    freeEntities[freeCount++] = entity;
+}
+
+/**
+ * @brief Tworzy ptaka w pozycji startowej
+ *
+ * @param skin Model gracza
+ * @return Encja ptaka
+ */
+Entity EntityWorld::spawnBird(PlayerModel skin) {
+    Entity bird = create();
+    if (bird == noEntity) return noEntity;
+    std::uint32_t row = birds.add(bird);
+    if (row == npos) {
+        freeEntities[freeCount++] = bird;
+        return noEntity;
+    }
+    birdTransforms[row] = {Physics::birdX, Physics::birdStartY, 0, 0};
+    birdColliders[row] = {0, 0, Physics::birdWidth, Physics::birdHeight};
+    flights[row] = {false};
+    animations[row] = {0, skin};
+    return bird;
+}
+
+/**
+ * @brief Ustawia ptaka w pozycji startowej
+ *
+ * @param bird Encja ptaka
+ */
+void EntityWorld::resetBird(Entity bird) {
+    loadBird(bird, {Physics::birdStartY, 0, 0, false});
+}
+
+/**
+ * @brief Tworzy rurę z monetą lub bez
+ *
+ * Rura bez monety ma wyzwalacz monety utworzony jako zadziałany.
+ *
+ * @param x Pozycja X rury
+ * @param y Pozycja Y rury
+ * @param throat Gardło rury
+ * @param coin Czy rura ma monetę
+ * @return Encja rury
+ */
+Entity EntityWorld::spawnPipe(float x, float y, float throat, bool coin) {
+    Entity pipe = create();
+    if (pipe == noEntity) return noEntity;
+    std::uint32_t row = pipes.add(pipe);
+    if (row == npos) {
+        freeEntities[freeCount++] = pipe;
+        return noEntity;
+    }
+    pipeTransforms[row] = {x, y, -Physics::pipeSpeed, 0};
+    gaps[row] = {throat, Physics::pipeWidth, Physics::pipeHeight};
+    passTriggers[row] = {GameEventType::Pass, false};
+    coinColliders[row] = {0, throat / 2, Physics::coinWidth, Physics::coinHeight};
+    coinTriggers[row] = {GameEventType::Coin, !coin};
+    spawnOrder[row] = nextOrder++;
+    return pipe;
+}
+
+/**
+ * @brief Zwraca wiersz najstarszej rury
+ *
+ * @return Wiersz rury o najmniejszym numerze kolejnym lub npos
+ */
+std::uint32_t EntityWorld::oldestPipe() const {
+    std::uint32_t oldest = npos;
+    for (std::uint32_t i = 0; i < pipes.size(); ++i) {
+        if (oldest == npos || spawnOrder[i] < spawnOrder[oldest]) oldest = i;
+    }
+    return oldest;
+}
+
+/**
+ * @brief Usuwa najstarszą rurę razem z jej monetą
+ */
+void EntityWorld::destroyOldestPipe() {
+    std::uint32_t row = oldestPipe();
+    if (row == npos) return;
+    destroy(pipes.owner(row));
+}
+
+/**
+ * @brief Usuwa wszystkie rury i monety
+ */
+void EntityWorld::clearPipes() {
+    for (std::size_t i = 0; i < pipes.size(); ++i) {
+        freeEntities[freeCount++] = pipes.owner(i);
+    }
+    pipes.clear();
+    nextOrder = 0;
+}
+
+/**
+ * @brief Machnięcie skrzydłami ptaka
+ *
+ * @param bird Encja ptaka
+ * @param running Czy gra została rozpoczęta
+ * @param over Czy gra jest zakończona
+ * @param events Kolejka zdarzeń gry
+ */
+void EntityWorld::flap(Entity bird, bool running, bool over, EventQueue& events) {
+    if (!running || over) return;
+    birdTransforms[birds.rowOf(bird)].vy = Physics::flapVelocity;
+    events.emit(GameEventType::Flap);
+}
+
+/**
+ * @brief Wykonuje krok wszystkich systemów
+ *
+ * @param dt Czas kroku w sekundach
+ * @param running Czy gra została rozpoczęta
+ * @param over Czy gra jest zakończona
+ * @param events Kolejka zdarzeń gry
+ */
+void EntityWorld::step(float dt, bool running, bool& over, EventQueue& events) {
+    fly(dt, running, over, events);
+    moveObstacles(dt, running, over, events);
+}
+
+/**
+ * @brief System lotu
+ *
+ * Ptak spada także po zderzeniu z rurą, aż do ziemi; zdarzenie śmierci jest
+ * zgłaszane raz, a licznik śmierci na ziemi tylko wtedy, gdy to ona zakończyła grę.
+ */
+void EntityWorld::fly(float dt, bool running, bool& over, EventQueue& events) {
+    if (!running) return;
+    for (std::size_t i = 0; i < birds.size(); ++i) {
+        Transform& t = birdTransforms[i];
+        const Collider& c = birdColliders[i];
+        t.vy += dt * Physics::gravity;
+        t.y += t.vy * dt;
+
+        float bottom = t.y + c.top + c.height;
+        if (t.y + c.top < 0 || bottom > Physics::floorY) {
+            if (!flights[i].dieReported) {
+                events.emit(GameEventType::Die);
+                flights[i].dieReported = true;
+            }
+            if (!over) {
+                Metrics::increment(Metrics::get().deathsGround);
+            }
+            over = true;
+        }
+        if (bottom > Physics::floorY) {
+            t.y = Physics::floorY - c.height - c.top;
+            t.vy = 0;
+        }
+    }
+}
+
+/**
+ * @brief System przeszkód i wyzwalaczy
+ *
+ * W Simulation::stepWith rury ruszają po kolei od najstarszej, a po zderzeniu
+ * kolejne już stoją, więc ich monety i minięcia nie są sprawdzane. Tutaj
+ * ruszają wszystkie naraz i od razu są sprawdzane zderzenia, monety i minięcia;
+ * wyniki trafiają do masek bitowych wierszy. Rury młodsze od tej, w którą ptak
+ * uderzył, wracają na poprzednie miejsce i tracą bity, a dopiero potem
+ * wyzwalacze są ustawiane i zgłaszane - wynik jest ten sam co w Simulation.
+ */
+void EntityWorld::moveObstacles(float dt, bool running, bool& over, EventQueue& events) {
+    static_assert(pipeRows <= 32, "Maski wierszy rur musza miescic sie w 32 bitach");
+    if (!running || over) return;
+    const std::size_t count = pipes.size();
+    std::array<Transform, pipeRows> before;
+    for (std::size_t i = 0; i < count; ++i) {
+        Transform& t = pipeTransforms[i];
+        before[i] = t;
+        t.x += t.vx * dt;
+        t.y += t.vy * dt;
+    }
+
+    std::uint32_t hit = noHit;
+    std::uint32_t coins = 0, passes = 0;
+    for (std::size_t b = 0; b < birds.size(); ++b) {
+        const Transform& bt = birdTransforms[b];
+        const Collider& bc = birdColliders[b];
+        const float left = bt.x + bc.left, top = bt.y + bc.top;
+        for (std::size_t i = 0; i < count; ++i) {
+            const Transform& t = pipeTransforms[i];
+            const Gap& gap = gaps[i];
+            const Collider& c = coinColliders[i];
+            if (Simulation::overlaps(left, top, bc.width, bc.height, t.x, t.y + gap.throat, gap.width, gap.height) ||
+                Simulation::overlaps(left, top, bc.width, bc.height, t.x, t.y - gap.throat, gap.width, gap.height)) {
+                if (spawnOrder[i] < hit) hit = spawnOrder[i];
+            }
+            if (!coinTriggers[i].fired &&
+                Simulation::overlaps(left, top, bc.width, bc.height, t.x + c.left, t.y + c.top, c.width, c.height)) {
+                coins |= 1u << i;
+            }
+            if (!passTriggers[i].fired && t.x + gap.width < left) {
+                passes |= 1u << i;
+            }
+        }
+    }
+
+    if (hit != noHit) {
+        for (std::size_t i = 0; i < count; ++i) {
+            if (spawnOrder[i] <= hit) continue;
+            pipeTransforms[i] = before[i];
+            coins &= ~(1u << i);
+            passes &= ~(1u << i);
+        }
+        over = true;
+        Metrics::increment(Metrics::get().deathsPipe);
+        events.emit(GameEventType::Hit);
+    }
+    for (std::size_t i = 0; (coins | passes) != 0; ++i) {
+        const std::uint32_t bit = 1u << i;
+        if (coins & bit) {
+            coinTriggers[i].fired = true;
+            events.emit(coinTriggers[i].event);
+        }
+        if (passes & bit) {
+            passTriggers[i].fired = true;
+            events.emit(passTriggers[i].event);
+        }
+        coins &= ~bit;
+        passes &= ~bit;
+    }
+}
+
+/**
+ * @brief Przechodzi do następnej klatki animacji
+ */
+void EntityWorld::animate() {
+    for (std::size_t i = 0; i < birds.size(); ++i) {
+        animations[i].frame = (float)(((int)animations[i].frame + 1) % Animation::frames);
+    }
+}
+
+/**
+ * @brief Zapisuje stan ptaka
+ *
+ * @param bird Encja ptaka
+ * @return Migawka stanu
+ */
+BirdState EntityWorld::saveBird(Entity bird) const {
+    std::uint32_t row = birds.rowOf(bird);
+    const Transform& t = birdTransforms[row];
+    return {t.y, t.vy, animations[row].frame, flights[row].dieReported};
+}
+
+/**
+ * @brief Przywraca stan ptaka
+ *
+ * @param bird Encja ptaka
+ * @param state Migawka stanu
+ */
+void EntityWorld::loadBird(Entity bird, const BirdState& state) {
+    std::uint32_t row = birds.rowOf(bird);
+    Transform& t = birdTransforms[row];
+    t.y = state.y;
+    t.vy = state.vel;
+    animations[row].frame = state.frame;
+    flights[row].dieReported = state.dieReported;
+}
+
+/**
+ * @brief Zapisuje stan rur
+ *
+ * Wiersze tabeli nie są w kolejności powstania, więc rury są najpierw
+ * układane według numerów kolejnych.
+ *
+ * @param pipes Tablica wynikowa
+ * @param max Pojemność tablicy
+ * @return Liczba zapisanych rur
+ */
+std::uint32_t EntityWorld::savePipes(PipeState* pipes, std::uint32_t max) const {
+    std::array<std::uint32_t, pipeRows> rows;
+    std::uint32_t sorted = 0;
+    for (std::uint32_t i = 0; i < this->pipes.size(); ++i) {
+        std::uint32_t j = sorted++;
+        for (; j > 0 && spawnOrder[rows[j - 1]] > spawnOrder[i]; --j) rows[j] = rows[j - 1];
+        rows[j] = i;
+    }
+
+    std::uint32_t count = 0;
+    for (; count < sorted && count < max; ++count) {
+        std::uint32_t row = rows[count];
+        const Transform& t = pipeTransforms[row];
+        pipes[count] = {t.x, t.y, gaps[row].throat, passTriggers[row].fired, !coinTriggers[row].fired};
+    }
+    return count;
+}
+
+/**
+ * @brief Zastępuje wszystkie rury rurami z migawki
+ *
+ * @param pipes Stany rur
+ * @param count Liczba rur
+ */
+void EntityWorld::loadPipes(const PipeState* pipes, std::uint32_t count) {
+    clearPipes();
+    for (std::uint32_t i = 0; i < count; ++i) {
+        Entity pipe = spawnPipe(pipes[i].x, pipes[i].y, pipes[i].throat, pipes[i].coinVisible);
+        if (pipe != noEntity) passTriggers[this->pipes.rowOf(pipe)].fired = pipes[i].scored;
+    }
+}
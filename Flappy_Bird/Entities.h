@@ -0,0 +1,356 @@
+/**
+ * @file Entities.h
+ * @brief Świat gry jako encje z komponentami przechowywanymi w gęstych tablicach.
+ */
+
+#pragma once
+#ifndef ENTITIES_H
+#define ENTITIES_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "DifficultyRules.h"
+#include "GameEvents.h"
+#include "PlayerModel.h"
+#include "Simulation.h"
+
+typedef std::uint32_t Entity; /**< Identyfikator encji. */
+constexpr Entity noEntity = UINT32_MAX; /**< Identyfikator oznaczający brak encji. */
+
+/**
+ * @brief Położenie i prędkość encji.
+ */
+struct Transform {
+    float x, y; /**< Pozycja lewego górnego rogu. */
+    float vx, vy; /**< Prędkość w pikselach na sekundę. */
+};
+
+/**
+ * @brief Prostokąt kolizji, względem położenia encji.
+ */
+struct Collider {
+    float left, top; /**< Przesunięcie prostokąta względem Transform. */
+    float width, height; /**< Rozmiar prostokąta. */
+};
+
+/**
+ * @brief Szczelina między górną a dolną rurą: przeszkoda złożona z dwóch prostokątów.
+ *
+ * Prostokąty mają lewy górny róg w (x, y + throat) i (x, y - throat), tak jak tekstury rur.
+ */
+struct Gap {
+    float throat; /**< Odległość górnej i dolnej rury od y. */
+    float width, height; /**< Rozmiar jednej rury. */
+};
+
+/**
+ * @brief Lot ptaka: grawitacja oraz śmierć na ziemi i pod sufitem.
+ */
+struct Flight {
+    bool dieReported; /**< Czy zdarzenie śmierci zostało już zgłoszone. */
+};
+
+/**
+ * @brief Stan animacji skrzydeł.
+ */
+struct Animation {
+    static constexpr int frames = 4; /**< Liczba klatek w cyklu (BirdAtlas::animationFrames). */
+
+    float frame; /**< Klatka w cyklu animacji, [0, frames). */
+    PlayerModel skin; /**< Model gracza. */
+};
+
+/**
+ * @brief Wyzwalacz zdarzenia wyniku, działający raz.
+ *
+ * Warunek zależy od tablicy, w której leży wyzwalacz: moneta działa, gdy jej
+ * prostokąt nachodzi na ptaka, a minięcie, gdy prawa krawędź rury jest na lewo od ptaka.
+ */
+struct Trigger {
+    GameEventType event; /**< Zdarzenie zgłaszane przy wyzwoleniu. */
+    bool fired; /**< Czy wyzwalacz już zadziałał; wyzwalacz utworzony jako zadziałany jest nieaktywny. */
+};
+
+/**
+ * @brief Gęsty indeks encji jednej tabeli (sparse set).
+ *
+ * Encje tabeli zajmują wiersze [0, size()) bez dziur, a tablica rows mapuje
+ * encję na jej wiersz. Wszystkie kolumny tabeli używają tych samych wierszy,
+ * więc systemy przechodzą po nich równolegle, bez szukania komponentów encji.
+ * Usunięcie przenosi ostatni wiersz na miejsce usuniętego, więc kolejność
+ * wierszy nie jest kolejnością dodania. Pamięć jest częścią obiektu.
+ *
+ * @tparam Ids Największy identyfikator encji plus jeden.
+ * @tparam Rows Największa liczba encji w tabeli.
+ */
+template<std::size_t Ids, std::size_t Rows>
+class DenseIndex {
+public:
+    static constexpr std::uint32_t npos = UINT32_MAX; /**< Wiersz oznaczający brak encji w tabeli. */
+
+    /**
+     * @brief Konstruktor klasy DenseIndex. Tworzy pusty indeks.
+     */
+    DenseIndex() : count(0) { rows.fill(npos); }
+
+    /**
+     * @brief Dodaje encję w nowym, ostatnim wierszu.
+     *
+     * @param entity Encja spoza tabeli.
+     * @return Wiersz encji lub npos, gdy tabela jest pełna.
+     */
+    std::uint32_t add(Entity entity) {
+        if (count == Rows) return npos;
+        rows[entity] = count;
+        owners[count] = entity;
+        return count++;
+    }
+
+    /**
+     * @brief Usuwa encję; jej miejsce zajmuje ostatni wiersz.
+     *
+     * Kolumny tabeli trzeba przenieść tak samo: wiersz size() (już po usunięciu)
+     * na zwrócony wiersz.
+     *
+     * @param entity Encja.
+     * @return Wiersz usuniętej encji lub npos, jeśli jej nie było w tabeli.
+     */
+    std::uint32_t remove(Entity entity) {
+        std::uint32_t row = rows[entity];
+        if (row == npos) return npos;
+        rows[entity] = npos;
+        count--;
+        if (row != count) {
+            owners[row] = owners[count];
+            rows[owners[row]] = row;
+        }
+        return row;
+    }
+
+    /**
+     * @brief Usuwa wszystkie encje.
+     */
+    void clear() {
+        for (std::uint32_t i = 0; i < count; ++i) rows[owners[i]] = npos;
+        count = 0;
+    }
+
+    bool has(Entity entity) const { return rows[entity] != npos; } /**< Czy encja jest w tabeli. */
+    std::uint32_t rowOf(Entity entity) const { return rows[entity]; } /**< Wiersz encji lub npos. */
+    std::size_t size() const { return count; } /**< Liczba wierszy. */
+    Entity owner(std::size_t row) const { return owners[row]; } /**< Encja w wierszu. */
+
+private:
+    std::uint32_t count; /**< Liczba wierszy; na początku, bo systemy czytają tylko ją. */
+    std::array<Entity, Rows> owners; /**< Encja każdego wiersza. */
+    std::array<std::uint32_t, Ids> rows; /**< Wiersz każdej encji lub npos. */
+};
+
+/**
+ * @brief Migawka stanu ptaka, kopiowana bez alokacji.
+ */
+struct BirdState {
+    float y; /**< Pozycja Y ptaka. */
+    float vel; /**< Prędkość pionowa ptaka. */
+    float frame; /**< Klatka animacji. */
+    bool dieReported; /**< Czy zdarzenie śmierci zostało już zgłoszone. */
+};
+
+/**
+ * @brief Encje gry (ptaki i rury z monetami) i systemy, które je aktualizują.
+ *
+ * Zamiast obiektów łączących geometrię, stan i zasoby każda cecha jest osobnym
+ * komponentem. Encje jednego rodzaju tworzą tabelę: ptaki mają położenie,
+ * prostokąt kolizji, lot i animację, a rury położenie, szczelinę, wyzwalacz
+ * minięcia oraz prostokąt i wyzwalacz monety (moneta jest częścią rury, jej
+ * prostokąt jest względem rury). Każdy komponent tabeli leży w osobnej tablicy,
+ * a wiersz i wszystkich tablic to ta sama encja, więc systemy przechodzą po
+ * wierszach [0, n) bez szukania komponentów. Nowy rodzaj przeszkody (np. rura
+ * ruchoma, z niezerowym vy) to inne wartości komponentów, a nie nowa klasa.
+ *
+ * Wszystkie tablice mają stały rozmiar i są częścią obiektu: świat nie alokuje
+ * pamięci, a jego kopia jest zwykłą kopią bajtów.
+ *
+ * Klasa nie zależy od SFML: tekstury i rysowanie zostają w silniku. Reguły kroku
+ * są takie jak w Simulation::stepWith, a po śmierci ptak, tak jak w grze, spada
+ * dalej aż do ziemi, choć rury już stoją.
+ */
+class EntityWorld {
+public:
+    static constexpr std::size_t capacity = 8; /**< Największa liczba encji: ptaki i rury. */
+    static constexpr std::size_t birdRows = 2; /**< Największa liczba ptaków. */
+    static constexpr std::size_t pipeRows = 6; /**< Największa liczba rur (silnik trzyma najwyżej 5). */
+
+    /**
+     * @brief Konstruktor klasy EntityWorld. Tworzy pusty świat.
+     */
+    EntityWorld();
+
+    /**
+     * @brief Tworzy ptaka w pozycji startowej.
+     *
+     * @param skin Model gracza.
+     * @return Encja ptaka.
+     */
+    Entity spawnBird(PlayerModel skin);
+
+    /**
+     * @brief Ustawia ptaka w pozycji startowej przed nową grą.
+     *
+     * @param bird Encja ptaka.
+     */
+    void resetBird(Entity bird);
+
+    /**
+     * @brief Tworzy rurę, z monetą lub bez.
+     *
+     * @param x Pozycja X rury.
+     * @param y Pozycja Y rury.
+     * @param throat Gardło rury.
+     * @param coin Czy rura ma monetę.
+     * @return Encja rury.
+     */
+    Entity spawnPipe(float x, float y, float throat, bool coin);
+
+    /**
+     * @brief Usuwa najstarszą rurę razem z jej monetą.
+     */
+    void destroyOldestPipe();
+
+    /**
+     * @brief Usuwa wszystkie rury i monety.
+     */
+    void clearPipes();
+
+    /**
+     * @brief Zwraca liczbę rur.
+     *
+     * @return Liczba wierszy tabeli rur.
+     */
+    std::size_t pipeCount() const { return pipes.size(); }
+
+    /**
+     * @brief Machnięcie skrzydłami ptaka, jeśli gra trwa.
+     *
+     * @param bird Encja ptaka.
+     * @param running Czy gra została rozpoczęta.
+     * @param over Czy gra jest zakończona.
+     * @param events Kolejka zdarzeń gry.
+     */
+    void flap(Entity bird, bool running, bool over, EventQueue& events);
+
+    /**
+     * @brief Wykonuje krok wszystkich systemów: lot oraz przeszkody z wyzwalaczami.
+     *
+     * @param dt Czas kroku w sekundach.
+     * @param running Czy gra została rozpoczęta.
+     * @param over Czy gra jest zakończona; ustawiane przy śmierci ptaka.
+     * @param events Kolejka zdarzeń gry.
+     */
+    void step(float dt, bool running, bool& over, EventQueue& events);
+
+    /**
+     * @brief Przechodzi do następnej klatki animacji wszystkich ptaków.
+     */
+    void animate();
+
+    /**
+     * @brief Zapisuje stan ptaka.
+     *
+     * @param bird Encja ptaka.
+     * @return Migawka stanu.
+     */
+    BirdState saveBird(Entity bird) const;
+
+    /**
+     * @brief Przywraca stan ptaka.
+     *
+     * @param bird Encja ptaka.
+     * @param state Migawka stanu.
+     */
+    void loadBird(Entity bird, const BirdState& state);
+
+    /**
+     * @brief Zapisuje stan rur, od najstarszej.
+     *
+     * @param pipes Tablica wynikowa.
+     * @param max Pojemność tablicy.
+     * @return Liczba zapisanych rur.
+     */
+    std::uint32_t savePipes(PipeState* pipes, std::uint32_t max) const;
+
+    /**
+     * @brief Zastępuje wszystkie rury rurami z migawki.
+     *
+     * Nowe rury dostają kolejne numery w kolejności migawki, więc najstarsza
+     * zostaje najstarszą.
+     *
+     * @param pipes Stany rur, od najstarszej.
+     * @param count Liczba rur.
+     */
+    void loadPipes(const PipeState* pipes, std::uint32_t count);
+
+    const Transform& getBirdTransform(Entity bird) const { return birdTransforms[birds.rowOf(bird)]; } /**< Położenie ptaka. */
+    const Animation& getBirdAnimation(Entity bird) const { return animations[birds.rowOf(bird)]; } /**< Animacja ptaka. */
+
+    // Kolumny rur: wiersze [0, pipeCount()) w dowolnej kolejności, ten sam wiersz to ta sama rura.
+    const std::array<Transform, pipeRows>& getPipeTransforms() const { return pipeTransforms; } /**< Położenia rur. */
+    const std::array<Gap, pipeRows>& getGaps() const { return gaps; } /**< Szczeliny rur. */
+    const std::array<Trigger, pipeRows>& getCoinTriggers() const { return coinTriggers; } /**< Monety; zadziałany wyzwalacz to moneta zebrana albo jej brak. */
+
+private:
+    static constexpr std::uint32_t npos = UINT32_MAX; /**< Brak wiersza, jak DenseIndex::npos. */
+    static constexpr std::uint32_t noHit = UINT32_MAX; /**< Numer kolejny oznaczający brak zderzenia z rurą. */
+
+    /**
+     * @brief Tworzy encję bez komponentów.
+     *
+     * @return Nowa encja lub noEntity.
+     */
+    Entity create();
+
+    /**
+     * @brief Usuwa encję i wszystkie jej komponenty.
+     *
+     * @param entity Encja.
+     */
+    void destroy(Entity entity);
+
+    /**
+     * @brief Zwraca wiersz najstarszej rury.
+     *
+     * @return Wiersz rury o najmniejszym numerze kolejnym lub npos.
+     */
+    std::uint32_t oldestPipe() const;
+
+    /**
+     * @brief System lotu: grawitacja, ziemia i sufit.
+     */
+    void fly(float dt, bool running, bool& over, EventQueue& events);
+
+    /**
+     * @brief System przeszkód i wyzwalaczy: ruch rur, zderzenia, monety i minięcia.
+     */
+    void moveObstacles(float dt, bool running, bool& over, EventQueue& events);
+
+    DenseIndex<capacity, birdRows> birds; /**< Wiersze ptaków. */
+    std::array<Transform, birdRows> birdTransforms{}; /**< Położenia ptaków. */
+    std::array<Collider, birdRows> birdColliders{}; /**< Prostokąty kolizji ptaków. */
+    std::array<Flight, birdRows> flights{}; /**< Lot ptaków. */
+    std::array<Animation, birdRows> animations{}; /**< Animacje ptaków. */
+
+    DenseIndex<capacity, pipeRows> pipes; /**< Wiersze rur. */
+    std::array<Transform, pipeRows> pipeTransforms{}; /**< Położenia rur. */
+    std::array<Gap, pipeRows> gaps{}; /**< Szczeliny rur. */
+    std::array<Trigger, pipeRows> passTriggers{}; /**< Wyzwalacze minięcia rur. */
+    std::array<Collider, pipeRows> coinColliders{}; /**< Prostokąty monet, względem rury. */
+    std::array<Trigger, pipeRows> coinTriggers{}; /**< Wyzwalacze zebrania monet. */
+    std::array<std::uint32_t, pipeRows> spawnOrder{}; /**< Numer kolejny rury; wiersze nie są w kolejności powstania. */
+    std::uint32_t nextOrder; /**< Numer kolejny następnej rury. */
+
+    std::array<Entity, capacity> freeEntities{}; /**< Wolne identyfikatory encji. */
+    std::uint32_t freeCount; /**< Liczba wolnych identyfikatorów. */
+};
+
+#endif
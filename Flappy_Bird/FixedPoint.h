@@ -0,0 +1,88 @@
+/**
+ * @file FixedPoint.h
+ * @brief Liczby stałoprzecinkowe Q16.16.
+ */
+
+#ifndef FLAPPY_BIRD_FIXEDPOINT_H
+#define FLAPPY_BIRD_FIXEDPOINT_H
+
+#include <cstdint>
+
+/**
+ * @brief Liczba stałoprzecinkowa w formacie Q16.16.
+ *
+ * Wszystkie działania są wykonywane na liczbach całkowitych, więc wynik nie
+ * zależy od kompilatora, poziomu optymalizacji ani łączenia działań w FMA.
+ * Zakres wynosi ±32768 z rozdzielczością 1/65536, co wystarcza dla
+ * współrzędnych ekranu i prędkości w grze.
+ */
+struct Fixed {
+    static constexpr int fractionBits = 16; /**< Liczba bitów części ułamkowej. */
+    static constexpr std::int32_t oneRaw = 1 << fractionBits; /**< Surowa wartość jedynki. */
+
+    std::int32_t raw; /**< Surowa wartość, równa wartości liczby razy 65536. */
+
+    /**
+     * @brief Tworzy liczbę z surowej wartości.
+     *
+     * @param raw Surowa wartość.
+     * @return Liczba stałoprzecinkowa.
+     */
+    static constexpr Fixed fromRaw(std::int32_t raw) { return Fixed{raw}; }
+
+    /**
+     * @brief Tworzy liczbę z liczby całkowitej.
+     *
+     * @param value Liczba całkowita.
+     * @return Liczba stałoprzecinkowa.
+     */
+    static constexpr Fixed fromInt(std::int32_t value) { return Fixed{value * oneRaw}; }
+
+    /**
+     * @brief Tworzy liczbę z liczby zmiennoprzecinkowej, zaokrąglając do najbliższej wartości.
+     *
+     * Mnożenie przez 65536 jest dokładne, więc wynik jest ten sam w każdej kompilacji.
+     * Służy do przeliczania stałych reguł gry, nie do obliczeń w pętli symulacji.
+     *
+     * @param value Liczba zmiennoprzecinkowa.
+     * @return Liczba stałoprzecinkowa.
+     */
+    static constexpr Fixed fromFloat(float value) {
+        float scaled = value * (float)oneRaw;
+        return Fixed{(std::int32_t)(scaled >= 0 ? scaled + 0.5f : scaled - 0.5f)};
+    }
+
+    /**
+     * @brief Zamienia liczbę na zmiennoprzecinkową (do wyświetlania i porównań).
+     *
+     * @return Wartość liczby.
+     */
+    constexpr float toFloat() const { return (float)raw / (float)oneRaw; }
+
+    /**
+     * @brief Dzieli liczbę przez liczbę całkowitą z zaokrągleniem do najbliższej wartości.
+     *
+     * @param divisor Dzielnik, większy od zera.
+     * @return Iloraz.
+     */
+    constexpr Fixed divInt(std::int32_t divisor) const {
+        return Fixed{raw >= 0 ? (raw + divisor / 2) / divisor : -((-raw + divisor / 2) / divisor)};
+    }
+
+    constexpr Fixed operator+(Fixed o) const { return Fixed{raw + o.raw}; } /**< Suma. */
+    constexpr Fixed operator-(Fixed o) const { return Fixed{raw - o.raw}; } /**< Różnica. */
+    constexpr Fixed operator-() const { return Fixed{-raw}; } /**< Liczba przeciwna. */
+    /** @brief Iloczyn, liczony na 64 bitach i obcinany w stronę minus nieskończoności. */
+    constexpr Fixed operator*(Fixed o) const { return Fixed{(std::int32_t)(((std::int64_t)raw * o.raw) >> fractionBits)}; }
+    Fixed& operator+=(Fixed o) { raw += o.raw; return *this; } /**< Dodanie w miejscu. */
+    Fixed& operator-=(Fixed o) { raw -= o.raw; return *this; } /**< Odjęcie w miejscu. */
+
+    constexpr bool operator<(Fixed o) const { return raw < o.raw; } /**< Porównanie "mniejsze". */
+    constexpr bool operator>(Fixed o) const { return raw > o.raw; } /**< Porównanie "większe". */
+    constexpr bool operator<=(Fixed o) const { return raw <= o.raw; } /**< Porównanie "mniejsze lub równe". */
+    constexpr bool operator>=(Fixed o) const { return raw >= o.raw; } /**< Porównanie "większe lub równe". */
+    constexpr bool operator==(Fixed o) const { return raw == o.raw; } /**< Równość. */
+    constexpr bool operator!=(Fixed o) const { return raw != o.raw; } /**< Nierówność. */
+};
+
+#endif //FLAPPY_BIRD_FIXEDPOINT_H
@@ -0,0 +1,93 @@
+/**
+ * @file FixedSimulation.cpp
+ * @brief Implementacja symulacji stałoprzecinkowej.
+ */
+
+#include "FixedSimulation.h"
+
+/**
+ * @brief Ustawia świat w stanie początkowym
+ *
+ * @param world Świat do ustawienia
+ * @param seed Ziarno generatora rur
+ */
+void FixedSimulation::reset(FixedWorld& world, std::uint32_t seed) {
+    world = FixedWorld{};
+    world.birdY = Fixed::fromFloat(Physics::birdStartY);
+    world.birdVel = Fixed{0};
+    world.rng = seed ? seed : 0x9e3779b9u;
+}
+
+/**
+ * @brief Zwraca indeks pierwszej rury, której ptak jeszcze nie minął
+ *
+ * @param world Świat
+ * @return Indeks rury lub -1
+ */
+int FixedSimulation::nextPipe(const FixedWorld& world) {
+    for (int i = 0; i < world.pipeCount; ++i) {
+        if (world.pipes[i].x + pipeWidth >= birdX) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Wykonuje jeden krok dla wielu światów, wybierając kernel raz na partię
+ *
+ * @param difficulty Poziom trudności
+ * @param worlds Tablica światów
+ * @param count Liczba światów
+ * @param flaps Decyzje o machnięciu
+ */
+void FixedSimulation::stepBatch(Difficulty difficulty, FixedWorld* worlds, std::size_t count, const std::uint8_t* flaps) {
+    switch (difficulty) {
+        case Difficulty::Easy:
+            stepBatch<Difficulty::Easy>(worlds, count, flaps);
+            break;
+        case Difficulty::Medium:
+            stepBatch<Difficulty::Medium>(worlds, count, flaps);
+            break;
+        case Difficulty::Hard:
+            stepBatch<Difficulty::Hard>(worlds, count, flaps);
+            break;
+        case Difficulty::Nightmare:
+            stepBatch<Difficulty::Nightmare>(worlds, count, flaps);
+            break;
+    }
+}
+
+/**
+ * @brief Zwraca skrót stanu świata
+ *
+ * Pola są haszowane pojedynczo, żeby wypełnienie struktur nie wpływało na wynik.
+ *
+ * @param world Świat
+ * @return Skrót FNV-1a
+ */
+std::uint64_t FixedSimulation::checksum(const FixedWorld& world) {
+    std::uint64_t hash = 0xcbf29ce484222325ull;
+    auto mix = [&hash](std::uint32_t value) {
+        for (int i = 0; i < 4; ++i) {
+            hash ^= (value >> (i * 8)) & 0xffu;
+            hash *= 0x100000001b3ull;
+        }
+    };
+    mix((std::uint32_t)world.birdY.raw);
+    mix((std::uint32_t)world.birdVel.raw);
+    mix((std::uint32_t)world.pipeCount);
+    for (int i = 0; i < world.pipeCount; ++i) {
+        const auto& pipe = world.pipes[i];
+        mix((std::uint32_t)pipe.x.raw);
+        mix((std::uint32_t)pipe.y.raw);
+        mix((std::uint32_t)pipe.throat.raw);
+        mix((pipe.scored ? 1u : 0u) | (pipe.coinVisible ? 2u : 0u));
+    }
+    mix(world.score);
+    mix(world.ticks);
+    mix(world.rng);
+    mix((std::uint32_t)world.spawnTimer.raw);
+    mix((world.running ? 1u : 0u) | (world.over ? 2u : 0u));
+    return hash;
+}
@@ -0,0 +1,228 @@
+/**
+ * @file FixedSimulation.h
+ * @brief Deterministyczna symulacja gry na liczbach stałoprzecinkowych.
+ */
+
+#ifndef FLAPPY_BIRD_FIXEDSIMULATION_H
+#define FLAPPY_BIRD_FIXEDSIMULATION_H
+
+#include <cstddef>
+#include <cstdint>
+#include "FixedPoint.h"
+#include "Simulation.h"
+
+/**
+ * @brief Stan pojedynczej rury w symulacji stałoprzecinkowej.
+ */
+struct FixedPipeState {
+    Fixed x; /**< Pozycja X rury. */
+    Fixed y; /**< Pozycja Y środka przerwy. */
+    Fixed throat; /**< Gardło rury w chwili jej powstania. */
+    bool scored; /**< Flaga informująca, czy ptak minął już rurę. */
+    bool coinVisible; /**< Flaga informująca, czy moneta jest widoczna. */
+};
+
+/**
+ * @brief Pełny stan jednej rozgrywki w symulacji stałoprzecinkowej.
+ *
+ * Odpowiednik World. Czas od powstania ostatniej rury jest liczony w krokach,
+ * a nie w sekundach, żeby nie sumować niedokładnej reprezentacji 1/60.
+ */
+struct FixedWorld {
+    Fixed birdY; /**< Pozycja Y ptaka. */
+    Fixed birdVel; /**< Prędkość pionowa ptaka, w pikselach na sekundę. */
+    FixedPipeState pipes[Physics::maxPipes]; /**< Rury, od najstarszej. */
+    std::int32_t pipeCount; /**< Liczba rur na ekranie. */
+    std::uint32_t score; /**< Wynik (zebrane monety). */
+    std::uint32_t ticks; /**< Liczba kroków symulacji od startu gry. */
+    std::uint32_t rng; /**< Stan generatora liczb losowych. */
+    Fixed spawnTimer; /**< Liczba kroków od chwili, w której powinna powstać ostatnia rura. */
+    bool running; /**< Flaga określająca, czy gra została rozpoczęta. */
+    bool over; /**< Flaga określająca, czy gra jest zakończona. */
+};
+
+/**
+ * @brief Symulacja gry na liczbach Q16.16, dająca identyczne wyniki w każdej kompilacji.
+ *
+ * Reguły są te same co w Simulation (StaticRules lub RuntimeRules) i są przeliczane
+ * na Q16.16 przy każdym kroku - dla StaticRules przeliczenie odbywa się w czasie
+ * kompilacji. Krok ma stałą długość 1/ticksPerSecond s, a mnożenie przez czas
+ * kroku jest dzieleniem całkowitym, więc nie ma błędu zaokrąglenia 1/60.
+ */
+namespace FixedSimulation {
+
+    constexpr std::int32_t ticksPerSecond = 60; /**< Liczba kroków symulacji na sekundę. */
+
+    constexpr Fixed birdX = Fixed::fromFloat(Physics::birdX); /**< Stała pozycja X ptaka. */
+    constexpr Fixed birdWidth = Fixed::fromFloat(Physics::birdWidth); /**< Szerokość ptaka. */
+    constexpr Fixed birdHeight = Fixed::fromFloat(Physics::birdHeight); /**< Wysokość ptaka. */
+    constexpr Fixed pipeWidth = Fixed::fromFloat(Physics::pipeWidth); /**< Szerokość rury. */
+    constexpr Fixed pipeHeight = Fixed::fromFloat(Physics::pipeHeight); /**< Wysokość rury. */
+    constexpr Fixed coinWidth = Fixed::fromFloat(Physics::coinWidth); /**< Szerokość monety. */
+    constexpr Fixed coinHeight = Fixed::fromFloat(Physics::coinHeight); /**< Wysokość monety. */
+    constexpr Fixed floorY = Fixed::fromFloat(Physics::floorY); /**< Poziom ziemi. */
+    constexpr Fixed pipeStep = Fixed::fromFloat(Physics::pipeSpeed).divInt(ticksPerSecond); /**< Przesunięcie rury w jednym kroku. */
+
+    /**
+     * @brief Sprawdza nachodzenie się prostokątów tak samo jak Simulation::overlaps.
+     *
+     * @return true jeśli część wspólna ma dodatnie pole.
+     */
+    inline bool overlaps(Fixed l1, Fixed t1, Fixed w1, Fixed h1, Fixed l2, Fixed t2, Fixed w2, Fixed h2) {
+        Fixed left = l1 > l2 ? l1 : l2;
+        Fixed right = l1 + w1 < l2 + w2 ? l1 + w1 : l2 + w2;
+        Fixed top = t1 > t2 ? t1 : t2;
+        Fixed bottom = t1 + h1 < t2 + h2 ? t1 + h1 : t2 + h2;
+        return left < right && top < bottom;
+    }
+
+    /**
+     * @brief Ustawia świat w stanie początkowym (ekran "Get Ready").
+     *
+     * @param world Świat do ustawienia.
+     * @param seed Ziarno generatora rur.
+     */
+    void reset(FixedWorld& world, std::uint32_t seed);
+
+    /**
+     * @brief Zwraca indeks pierwszej rury, której ptak jeszcze nie minął.
+     *
+     * @param world Świat.
+     * @return Indeks rury lub -1, gdy takiej rury nie ma.
+     */
+    int nextPipe(const FixedWorld& world);
+
+    /**
+     * @brief Dodaje nową rurę, usuwając najstarszą, gdy na ekranie są już cztery.
+     *
+     * @param world Świat.
+     * @param throat Gardło nowej rury.
+     * @param late Opóźnienie powstania rury w krokach (jak w Simulation::spawnPipe).
+     */
+    inline void spawnPipe(FixedWorld& world, Fixed throat, Fixed late = Fixed{0}) {
+        if (world.pipeCount == Physics::maxPipes) {
+            for (int i = 1; i < Physics::maxPipes; ++i) {
+                world.pipes[i - 1] = world.pipes[i];
+            }
+            world.pipeCount--;
+        }
+        auto roll = (int)(Simulation::nextRandom(world.rng) % Physics::pipeHeights);
+        world.pipes[world.pipeCount++] = {Fixed::fromFloat(Physics::pipeSpawnX) - pipeStep * late,
+                                          Fixed::fromFloat(Physics::pipeY(roll)), throat, false, true};
+    }
+
+    /**
+     * @brief Wykonuje jeden krok symulacji o długości 1/ticksPerSecond s.
+     *
+     * Kolejność i reguły są takie same jak w Simulation::stepWith.
+     *
+     * @tparam R Typ reguł (Simulation::StaticRules lub Simulation::RuntimeRules).
+     * @param world Świat.
+     * @param flap Czy gracz macha skrzydłami w tym kroku.
+     * @param rules Reguły gry.
+     */
+    template<class R>
+    inline void stepWith(FixedWorld& world, bool flap, const R& rules) {
+        const Fixed throat = Fixed::fromFloat(rules.throat());
+        if (flap && !world.over) {
+            if (!world.running) {
+                world.running = true;
+                world.spawnTimer = Fixed{0};
+                spawnPipe(world, throat);
+            }
+            world.birdVel = Fixed::fromFloat(rules.flapVelocity());
+        }
+        if (!world.running) return;
+
+        world.birdVel += Fixed::fromFloat(rules.gravity()).divInt(ticksPerSecond);
+        world.birdY += world.birdVel.divInt(ticksPerSecond);
+        if (world.birdY < Fixed{0} || world.birdY + birdHeight > floorY) {
+            world.over = true;
+        }
+        if (world.birdY + birdHeight > floorY) {
+            world.birdY = floorY - birdHeight;
+            world.birdVel = Fixed{0};
+        }
+        if (world.over) return;
+
+        for (int i = 0; i < world.pipeCount; ++i) {
+            auto& pipe = world.pipes[i];
+            pipe.x -= pipeStep;
+            if (overlaps(birdX, world.birdY, birdWidth, birdHeight, pipe.x, pipe.y + pipe.throat, pipeWidth, pipeHeight) ||
+                overlaps(birdX, world.birdY, birdWidth, birdHeight, pipe.x, pipe.y - pipe.throat, pipeWidth, pipeHeight)) {
+                world.over = true;
+            }
+            if (pipe.coinVisible &&
+                overlaps(birdX, world.birdY, birdWidth, birdHeight, pipe.x, pipe.y + pipe.throat.divInt(2), coinWidth, coinHeight)) {
+                pipe.coinVisible = false;
+                world.score++;
+            }
+            if (pipe.x + pipeWidth < birdX) {
+                pipe.scored = true;
+            }
+            if (world.over) break;
+        }
+        if (world.over) return;
+
+        world.ticks++;
+        // spawnTimer / 60 > spawnInterval, bez dzielenia.
+        const Fixed interval = Fixed::fromFloat(rules.spawnInterval()) * Fixed::fromInt(ticksPerSecond);
+        world.spawnTimer += Fixed::fromInt(1);
+        if (world.spawnTimer > interval) {
+            world.spawnTimer -= interval;
+            spawnPipe(world, throat, world.spawnTimer);
+        }
+    }
+
+    /**
+     * @brief Wykonuje jeden krok symulacji dla poziomu trudności znanego w czasie kompilacji.
+     *
+     * @tparam D Poziom trudności.
+     * @param world Świat.
+     * @param flap Czy gracz macha skrzydłami w tym kroku.
+     */
+    template<Difficulty D>
+    inline void step(FixedWorld& world, bool flap) {
+        stepWith(world, flap, Simulation::StaticRules<D>{});
+    }
+
+    /**
+     * @brief Wykonuje jeden krok dla wielu światów naraz. Zakończone światy są pomijane.
+     *
+     * Kernel nie zawiera działań zmiennoprzecinkowych, więc kompilator może go
+     * wektoryzować na liczbach całkowitych bez zmiany wyniku.
+     *
+     * @tparam D Poziom trudności.
+     * @param worlds Tablica światów.
+     * @param count Liczba światów.
+     * @param flaps Decyzje o machnięciu dla każdego świata (0 lub 1).
+     */
+    template<Difficulty D>
+    void stepBatch(FixedWorld* worlds, std::size_t count, const std::uint8_t* flaps) {
+        for (std::size_t i = 0; i < count; ++i) {
+            if (!worlds[i].over) {
+                step<D>(worlds[i], flaps[i] != 0);
+            }
+        }
+    }
+
+    /**
+     * @brief Wykonuje jeden krok dla wielu światów, wybierając wersję kernela raz na całą partię.
+     *
+     * @param difficulty Poziom trudności.
+     * @param worlds Tablica światów.
+     * @param count Liczba światów.
+     * @param flaps Decyzje o machnięciu dla każdego świata (0 lub 1).
+     */
+    void stepBatch(Difficulty difficulty, FixedWorld* worlds, std::size_t count, const std::uint8_t* flaps);
+
+    /**
+     * @brief Zwraca skrót stanu świata, do porównywania wyników między kompilacjami.
+     *
+     * @param world Świat.
+     * @return 64-bitowy skrót FNV-1a.
+     */
+    std::uint64_t checksum(const FixedWorld& world);
+}
+
+#endif //FLAPPY_BIRD_FIXEDSIMULATION_H
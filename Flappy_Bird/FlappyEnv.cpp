@@ -0,0 +1,175 @@
+/**
+ * @file FlappyEnv.cpp
+ * @brief Implementacja biblioteki libflappy_env.
+ */
+
+#include "FlappyEnv.h"
+#include <new>
+#include <vector>
+#include "Simulation.h"
+
+/**
+ * @brief Zbiór środowisk: światy symulacji i generatory ziaren kolejnych epizodów.
+ */
+struct FlappyEnv {
+    std::vector<World> worlds; /**< Światy środowisk. */
+    std::vector<std::uint32_t> episodeSeeds; /**< Generatory ziaren torów, po jednym na środowisko. */
+    Difficulty difficulty; /**< Poziom trudności. */
+};
+
+namespace {
+
+const float stepTime = 1.0f / 60.0f; /**< Czas kroku w sekundach. */
+
+/**
+ * @brief Rozpoczyna nowy epizod w jednym środowisku.
+ *
+ * Odpowiada Engine::restartGame: nowe ziarno, brak rur, wynik zero. Ekran
+ * "Get Ready" jest pomijany - gra startuje od razu z pierwszą rurą.
+ *
+ * @param env Zbiór środowisk.
+ * @param i Indeks środowiska.
+ */
+void beginEpisode(FlappyEnv& env, std::size_t i) {
+    World& world = env.worlds[i];
+    Simulation::reset(world, Simulation::nextRandom(env.episodeSeeds[i]));
+    Simulation::start(world, rulesFor(env.difficulty).throat);
+}
+
+/**
+ * @brief Zapisuje obserwację świata.
+ *
+ * @param world Świat.
+ * @param out Bufor FLAPPY_ENV_OBS_SIZE liczb.
+ */
+void observe(const World& world, float* out) {
+    out[0] = world.birdY;
+    out[1] = world.birdVel;
+    int next = Simulation::nextPipe(world);
+    if (next < 0) {
+        out[2] = Physics::pipeSpawnX - Physics::birdX;
+        out[3] = 0;
+        out[4] = Physics::floorY;
+        return;
+    }
+    const PipeState& pipe = world.pipes[next];
+    out[2] = pipe.x - Physics::birdX;
+    out[3] = pipe.y - pipe.throat + Physics::pipeHeight;
+    out[4] = pipe.y + pipe.throat;
+}
+
+/**
+ * @brief Wykonuje krok we wszystkich środowiskach dla poziomu trudności znanego w czasie kompilacji.
+ *
+ * @tparam D Poziom trudności.
+ */
+template<Difficulty D>
+void stepAll(FlappyEnv& env, const std::uint8_t* actions, float* observations, float* rewards, std::uint8_t* dones) {
+    const std::size_t count = env.worlds.size();
+    for (std::size_t i = 0; i < count; ++i) {
+        World& world = env.worlds[i];
+        const std::uint32_t scoreBefore = world.score;
+        Simulation::step<D>(world, stepTime, actions[i] != 0);
+
+        float reward = FLAPPY_ENV_REWARD_COIN * (float)(world.score - scoreBefore);
+        if (world.over) {
+            rewards[i] = reward + FLAPPY_ENV_REWARD_DEATH;
+            dones[i] = 1;
+            beginEpisode(env, i);
+        } else {
+            rewards[i] = reward + FLAPPY_ENV_REWARD_ALIVE;
+            dones[i] = 0;
+        }
+        observe(world, observations + i * FLAPPY_ENV_OBS_SIZE);
+    }
+}
+
+}
+
+/**
+ * @brief Tworzy zbiór środowisk
+ *
+ * @param n_envs Liczba środowisk
+ * @param seed Ziarno
+ * @param difficulty Poziom trudności
+ * @return Uchwyt lub NULL
+ */
+FlappyEnv* flappy_env_create(uint32_t n_envs, uint32_t seed, int difficulty) {
+    if (n_envs == 0 || difficulty < 0 || difficulty > static_cast<int>(Difficulty::Nightmare)) {
+        return nullptr;
+    }
+    auto* env = new (std::nothrow) FlappyEnv;
+    if (!env) return nullptr;
+    try {
+        env->worlds.resize(n_envs);
+        env->episodeSeeds.resize(n_envs);
+    } catch (const std::bad_alloc&) {
+        delete env;
+        return nullptr;
+    }
+    env->difficulty = static_cast<Difficulty>(difficulty);
+    for (std::uint32_t i = 0; i < n_envs; ++i) {
+        std::uint32_t s = seed ^ ((i + 1) * 0x9e3779b9u);
+        env->episodeSeeds[i] = s ? s : 1;
+        beginEpisode(*env, i);
+    }
+    return env;
+}
+
+/**
+ * @brief Zwalnia zbiór środowisk
+ *
+ * @param env Uchwyt
+ */
+void flappy_env_destroy(FlappyEnv* env) {
+    delete env;
+}
+
+/**
+ * @brief Zwraca liczbę środowisk
+ *
+ * @param env Uchwyt
+ * @return Liczba środowisk
+ */
+uint32_t flappy_env_count(const FlappyEnv* env) {
+    return (uint32_t)env->worlds.size();
+}
+
+/**
+ * @brief Rozpoczyna nowy epizod we wszystkich środowiskach
+ *
+ * @param env Uchwyt
+ * @param observations Bufor obserwacji
+ */
+void flappy_env_reset(FlappyEnv* env, float* observations) {
+    for (std::size_t i = 0; i < env->worlds.size(); ++i) {
+        beginEpisode(*env, i);
+        observe(env->worlds[i], observations + i * FLAPPY_ENV_OBS_SIZE);
+    }
+}
+
+/**
+ * @brief Wykonuje jeden krok we wszystkich środowiskach
+ *
+ * @param env Uchwyt
+ * @param actions Akcje
+ * @param observations Bufor obserwacji
+ * @param rewards Bufor nagród
+ * @param dones Bufor flag zakończenia
+ */
+void flappy_env_step(FlappyEnv* env, const uint8_t* actions, float* observations, float* rewards, uint8_t* dones) {
+    switch (env->difficulty) {
+        case Difficulty::Easy:
+            stepAll<Difficulty::Easy>(*env, actions, observations, rewards, dones);
+            break;
+        case Difficulty::Medium:
+            stepAll<Difficulty::Medium>(*env, actions, observations, rewards, dones);
+            break;
+        case Difficulty::Hard:
+            stepAll<Difficulty::Hard>(*env, actions, observations, rewards, dones);
+            break;
+        case Difficulty::Nightmare:
+            stepAll<Difficulty::Nightmare>(*env, actions, observations, rewards, dones);
+            break;
+    }
+}
@@ -0,0 +1,104 @@
+/**
+ * @file FlappyEnv.h
+ * @brief Interfejs C biblioteki libflappy_env: wiele środowisk gry krokowanych naraz.
+ *
+ * Biblioteka jest przeznaczona dla zewnętrznego kodu uczącego (np. przez ctypes lub cffi).
+ * Każde wywołanie flappy_env_step przesuwa wszystkie środowiska o jeden krok 1/60 s
+ * i zapisuje obserwacje, nagrody oraz flagi zakończenia do buforów należących do
+ * wywołującego. Krok nie alokuje pamięci i nie kopiuje danych pośrednich.
+ *
+ * Obserwacja jednego środowiska to FLAPPY_ENV_OBS_SIZE liczb float:
+ *   0 - pozycja Y ptaka,
+ *   1 - prędkość pionowa ptaka,
+ *   2 - odległość w poziomie od ptaka do lewej krawędzi najbliższej nieminiętej rury
+ *       (ujemna, gdy ptak jest już między rurami),
+ *   3 - górna krawędź przerwy tej rury (y - h_difference + wysokość rury),
+ *   4 - dolna krawędź przerwy tej rury (y + h_difference).
+ * Gdy przed ptakiem nie ma rury, przerwa obejmuje cały ekran (0 .. poziom ziemi).
+ */
+
+#ifndef FLAPPY_BIRD_FLAPPYENV_H
+#define FLAPPY_BIRD_FLAPPYENV_H
+
+#include <stdint.h>
+
+#if defined(_WIN32)
+#  ifdef FLAPPY_ENV_BUILD
+#    define FLAPPY_ENV_API __declspec(dllexport)
+#  else
+#    define FLAPPY_ENV_API __declspec(dllimport)
+#  endif
+#else
+#  define FLAPPY_ENV_API __attribute__((visibility("default")))
+#endif
+
+#define FLAPPY_ENV_OBS_SIZE 5 /**< Liczba wartości w obserwacji jednego środowiska. */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Nieprzezroczysty uchwyt zbioru środowisk.
+ */
+typedef struct FlappyEnv FlappyEnv;
+
+/**
+ * @brief Tworzy zbiór środowisk.
+ *
+ * @param n_envs Liczba środowisk.
+ * @param seed Ziarno, z którego wyprowadzane są tory wszystkich epizodów.
+ * @param difficulty Poziom trudności (0 - Easy, 1 - Medium, 2 - Hard, 3 - Nightmare).
+ * @return Uchwyt lub NULL przy błędnych argumentach.
+ */
+FLAPPY_ENV_API FlappyEnv* flappy_env_create(uint32_t n_envs, uint32_t seed, int difficulty);
+
+/**
+ * @brief Zwalnia zbiór środowisk.
+ *
+ * @param env Uchwyt (może być NULL).
+ */
+FLAPPY_ENV_API void flappy_env_destroy(FlappyEnv* env);
+
+/**
+ * @brief Zwraca liczbę środowisk w zbiorze.
+ *
+ * @param env Uchwyt.
+ * @return Liczba środowisk.
+ */
+FLAPPY_ENV_API uint32_t flappy_env_count(const FlappyEnv* env);
+
+/**
+ * @brief Rozpoczyna nowy epizod we wszystkich środowiskach.
+ *
+ * @param env Uchwyt.
+ * @param observations Bufor n_envs * FLAPPY_ENV_OBS_SIZE liczb na obserwacje początkowe.
+ */
+FLAPPY_ENV_API void flappy_env_reset(FlappyEnv* env, float* observations);
+
+/**
+ * @brief Wykonuje jeden krok we wszystkich środowiskach.
+ *
+ * Nagroda za krok to FLAPPY_ENV_REWARD_ALIVE za przetrwanie, FLAPPY_ENV_REWARD_COIN
+ * za każdą zebraną monetę i FLAPPY_ENV_REWARD_DEATH za zakończenie gry. Środowisko,
+ * w którym gra się zakończyła, ma ustawioną flagę done i jest od razu restartowane
+ * (jak Engine::restartGame, z nowym torem), więc jego obserwacja pochodzi już z nowego epizodu.
+ *
+ * @param env Uchwyt.
+ * @param actions n_envs bajtów: 1 - machnięcie, 0 - brak akcji.
+ * @param observations Bufor n_envs * FLAPPY_ENV_OBS_SIZE liczb.
+ * @param rewards Bufor n_envs liczb.
+ * @param dones Bufor n_envs bajtów.
+ */
+FLAPPY_ENV_API void flappy_env_step(FlappyEnv* env, const uint8_t* actions, float* observations,
+                                    float* rewards, uint8_t* dones);
+
+#define FLAPPY_ENV_REWARD_ALIVE 0.01f /**< Nagroda za każdy przetrwany krok. */
+#define FLAPPY_ENV_REWARD_COIN 1.0f /**< Nagroda za zebraną monetę. */
+#define FLAPPY_ENV_REWARD_DEATH (-1.0f) /**< Nagroda za zakończenie gry. */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //FLAPPY_BIRD_FLAPPYENV_H
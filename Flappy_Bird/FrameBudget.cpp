@@ -0,0 +1,62 @@
+/**
+ * @file FrameBudget.cpp
+ * @brief Implementacja budżetu czasu klatki.
+ */
+
+#include "FrameBudget.h"
+
+/**
+ * @brief Konstruktor klasy FrameBudget
+ *
+ * @param budgetUs Budżet czasu klatki w mikrosekundach
+ */
+FrameBudget::FrameBudget(std::uint64_t budgetUs) {
+    reset(budgetUs);
+}
+
+/**
+ * @brief Ustawia budżet i wraca do pełnej jakości
+ *
+ * @param budgetUs Budżet czasu klatki w mikrosekundach
+ */
+void FrameBudget::reset(std::uint64_t budgetUs) {
+    this->budgetUs = budgetUs;
+    averageUs = 0;
+    current = Full;
+    overruns = 0;
+    calmFrames = 0;
+    cooldown = 0;
+}
+
+/**
+ * @brief Zapisuje koszt klatki i w razie potrzeby zmienia poziom
+ *
+ * Pojedyncze przekroczenie (np. wczytanie zasobu) nie zmienia poziomu, dopiero
+ * overrunFrames z rzędu albo średnia ponad budżetem.
+ *
+ * @param costUs Koszt klatki w mikrosekundach
+ * @return Zmiana poziomu
+ */
+int FrameBudget::record(std::uint64_t costUs) {
+    if (budgetUs == 0) return 0;
+
+    averageUs += averageWeight * ((float)costUs - averageUs);
+    overruns = costUs > budgetUs ? overruns + 1 : 0;
+    calmFrames = averageUs < recoveryRatio * (float)budgetUs ? calmFrames + 1 : 0;
+    if (cooldown > 0) cooldown--;
+
+    if ((overruns >= overrunFrames || averageUs > (float)budgetUs) && cooldown == 0 && current + 1 < levels) {
+        current++;
+        overruns = 0;
+        calmFrames = 0;
+        cooldown = cooldownFrames;
+        return 1;
+    }
+    if (calmFrames >= recoveryFrames && current > Full) {
+        current--;
+        calmFrames = 0;
+        cooldown = cooldownFrames;
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,105 @@
+/**
+ * @file FrameBudget.h
+ * @brief Budżet czasu klatki i stopniowe ograniczanie pracy kosmetycznej.
+ */
+
+#pragma once
+#ifndef FRAMEBUDGET_H
+#define FRAMEBUDGET_H
+
+#include <cstdint>
+
+/**
+ * @brief Dobiera poziom jakości rysowania do zmierzonego kosztu klatek.
+ *
+ * Koszt klatki to czas obsługi zdarzeń, symulacji i rysowania, bez czekania
+ * na wyświetlenie. Gdy kilka klatek z rzędu przekracza budżet (albo średnia
+ * krocząca jest ponad budżetem), poziom rośnie o jeden i przez chwilę nie rośnie
+ * znowu, żeby było widać efekt poprzedniego kroku. Gdy średnia długo utrzymuje
+ * się wyraźnie poniżej budżetu, poziom spada o jeden, aż do pełnej jakości.
+ *
+ * Kolejne poziomy ograniczają pracę w ustalonej kolejności - każdy obejmuje
+ * również ograniczenia poprzednich. Fizyka, wejście i dźwięki nigdy nie są
+ * ograniczane.
+ */
+class FrameBudget {
+public:
+    /**
+     * @brief Poziomy ograniczenia, od pełnej jakości.
+     */
+    enum Level : std::uint32_t {
+        Full = 0, /**< Pełna jakość. */
+        SlowWings = 1, /**< Animacja skrzydeł z połową częstotliwości. */
+        CoarseGround = 2, /**< Ziemia przesuwana co drugą klatkę. */
+        NoCoins = 3, /**< Monety nie są rysowane. */
+        SlowHud = 4 /**< Tekst wyniku odświeżany rzadziej. */
+    };
+
+    static constexpr std::uint32_t levels = SlowHud + 1; /**< Liczba poziomów. */
+    static constexpr std::uint32_t overrunFrames = 3; /**< Liczba przekroczeń z rzędu, po której poziom rośnie. */
+    static constexpr std::uint32_t cooldownFrames = 30; /**< Liczba klatek po zmianie poziomu, zanim może znowu wzrosnąć. */
+    static constexpr std::uint32_t recoveryFrames = 120; /**< Liczba spokojnych klatek, po której poziom spada. */
+    static constexpr float recoveryRatio = 0.6f; /**< Ułamek budżetu, poniżej którego klatka jest spokojna. */
+    static constexpr float averageWeight = 0.1f; /**< Waga nowej klatki w średniej kroczącej. */
+
+    /**
+     * @brief Konstruktor klasy FrameBudget.
+     *
+     * @param budgetUs Budżet czasu klatki w mikrosekundach (0 - bez ograniczeń).
+     */
+    explicit FrameBudget(std::uint64_t budgetUs = 0);
+
+    /**
+     * @brief Ustawia budżet i wraca do pełnej jakości.
+     *
+     * @param budgetUs Budżet czasu klatki w mikrosekundach (0 - bez ograniczeń).
+     */
+    void reset(std::uint64_t budgetUs);
+
+    /**
+     * @brief Zapisuje koszt klatki i w razie potrzeby zmienia poziom.
+     *
+     * @param costUs Koszt klatki w mikrosekundach.
+     * @return Zmiana poziomu: +1, -1 albo 0.
+     */
+    int record(std::uint64_t costUs);
+
+    /**
+     * @brief Sprawdza, czy praca danego poziomu jest ograniczona.
+     *
+     * @param level Poziom.
+     * @return true jeśli bieżący poziom jest nie mniejszy niż level.
+     */
+    bool sheds(Level level) const { return current >= level; }
+
+    /**
+     * @brief Zwraca bieżący poziom.
+     *
+     * @return Poziom z zakresu [0, levels).
+     */
+    std::uint32_t level() const { return current; }
+
+    /**
+     * @brief Zwraca budżet.
+     *
+     * @return Budżet czasu klatki w mikrosekundach.
+     */
+    std::uint64_t budget() const { return budgetUs; }
+
+    /**
+     * @brief Zwraca średnią kroczącą kosztu klatki.
+     *
+     * @return Średni koszt w mikrosekundach.
+     */
+    float average() const { return averageUs; }
+
+private:
+    std::uint64_t budgetUs; /**< Budżet czasu klatki w mikrosekundach. */
+    float averageUs; /**< Średnia krocząca kosztu klatki. */
+    std::uint32_t current; /**< Bieżący poziom. */
+    std::uint32_t overruns; /**< Liczba przekroczeń budżetu z rzędu. */
+    std::uint32_t calmFrames; /**< Liczba spokojnych klatek z rzędu. */
+    std::uint32_t cooldown; /**< Liczba klatek, przez które poziom nie może wzrosnąć. */
+};
+
+#endif
@@ -0,0 +1,252 @@
+/**
+ * @file FrameCapture.cpp
+ * @brief Implementacja nagrywania klatek w tle.
+ */
+
+#include "FrameCapture.h"
+#include "Metrics.h"
+#include <SFML/OpenGL.hpp>
+#include <algorithm>
+#include <filesystem>
+
+namespace {
+
+/**
+ * @brief Sprawdza, czy napis kończy się podanym przyrostkiem.
+ *
+ * @param text Napis.
+ * @param suffix Przyrostek.
+ * @return true jeśli napis kończy się przyrostkiem.
+ */
+bool endsWith(const std::string& text, const char* suffix) {
+    std::string s(suffix);
+    return text.size() >= s.size() && text.compare(text.size() - s.size(), s.size(), s) == 0;
+}
+
+/**
+ * @brief Ogranicza wartość do zakresu bajtu.
+ *
+ * @param v Wartość.
+ * @return Wartość z zakresu 0-255.
+ */
+sf::Uint8 clampByte(int v) {
+    return (sf::Uint8)std::min(255, std::max(0, v));
+}
+
+}
+
+/**
+ * @brief Konstruktor klasy FrameCapture.
+ *
+ * @param target Plik .y4m lub katalog na sekwencję PNG.
+ * @param size Rozmiar nagrywanego okna.
+ * @param framerate Liczba klatek na sekundę w nagłówku Y4M.
+ * @param threads Liczba wątków kodujących.
+ * @param ringSize Liczba buforów klatek.
+ */
+FrameCapture::FrameCapture(const std::string& target, sf::Vector2u size, unsigned framerate,
+                           unsigned threads, std::size_t ringSize)
+        : target(target), width(size.x), height(size.y), y4m(endsWith(target, ".y4m")), open(false),
+          stream(nullptr), slots(std::max<std::size_t>(ringSize, 2)), head(0), reads(0), nextFrame(0), owed(0), queue(slots.size()),
+          queueHead(0), queueCount(0), stopping(false), nextWrite(0) {
+    const std::size_t chromaSize = (std::size_t)((width + 1) / 2) * ((height + 1) / 2);
+    for (auto& slot : slots) {
+        slot.pixels.resize((std::size_t)width * height * 4);
+        if (y4m) slot.yuv.resize((std::size_t)width * height + 2 * chromaSize);
+    }
+
+    if (y4m) {
+        stream = std::fopen(target.c_str(), "wb");
+        if (stream) {
+            std::fprintf(stream, "YUV4MPEG2 W%u H%u F%u:1 Ip A1:1 C420jpeg\n", width, height, framerate);
+        }
+        open = stream != nullptr;
+    } else {
+        std::error_code error;
+        std::filesystem::create_directories(target, error);
+        open = std::filesystem::is_directory(target, error);
+    }
+    if (!open) {
+        std::fprintf(stderr, "Nagrywanie: nie udalo sie otworzyc %s\n", target.c_str());
+        return;
+    }
+
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency() / 2);
+    }
+    for (unsigned i = 0; i < threads; ++i) {
+        workers.emplace_back(&FrameCapture::worker, this);
+    }
+}
+
+/**
+ * @brief Destruktor klasy FrameCapture.
+ */
+FrameCapture::~FrameCapture() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    queueReady.notify_all();
+    for (auto& thread : workers) {
+        thread.join();
+    }
+    if (stream) {
+        std::fclose(stream);
+    }
+    if (open) {
+        std::fprintf(stderr, "Nagrywanie %s: zapisano %llu klatek (z powtorzeniami), porzucono %llu\n", target.c_str(),
+                     (unsigned long long)written.load(), (unsigned long long)dropped.load());
+    }
+}
+
+/**
+ * @brief Odczytuje bieżącą zawartość okna i przekazuje ją do zakodowania.
+ *
+ * Porzucone klatki nagrania nie znikają z osi czasu: zajmuje je powtórzenie
+ * następnego udanego odczytu.
+ *
+ * @param window Okno źródłowe.
+ * @param copies Liczba kolejnych klatek nagrania zajmowanych przez tę klatkę gry.
+ * @return true jeśli klatka trafiła do kolejki.
+ */
+bool FrameCapture::capture(sf::RenderWindow& window, unsigned copies) {
+    if (!open || copies == 0) return false;
+
+    Slot& slot = slots[head];
+    auto size = window.getSize();
+    if (slot.busy.load(std::memory_order_acquire) || size.x != width || size.y != height) {
+        owed += copies;
+        dropped.fetch_add(copies, std::memory_order_relaxed);
+        Metrics::add(Metrics::get().captureDropped, copies);
+        return false;
+    }
+
+    // Odczyt trafia prosto do bufora przydzielonego z góry, bez pośredniego sf::Image.
+    window.setActive(true);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, (GLsizei)width, (GLsizei)height, GL_RGBA, GL_UNSIGNED_BYTE, slot.pixels.data());
+
+    slot.sequence = reads++;
+    slot.frame = nextFrame;
+    slot.copies = copies + owed;
+    nextFrame += slot.copies;
+    owed = 0;
+    captured.fetch_add(slot.copies, std::memory_order_relaxed);
+    slot.busy.store(true, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        queue[(queueHead + queueCount) % queue.size()] = head;
+        queueCount++;
+    }
+    queueReady.notify_one();
+    head = (head + 1) % slots.size();
+    Metrics::add(Metrics::get().captureFrames, slot.copies);
+    return true;
+}
+
+/**
+ * @brief Pętla wątku kodującego
+ */
+void FrameCapture::worker() {
+    while (true) {
+        std::size_t index;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueReady.wait(lock, [this] { return queueCount > 0 || stopping; });
+            if (queueCount == 0) return;
+            index = queue[queueHead];
+            queueHead = (queueHead + 1) % queue.size();
+            queueCount--;
+        }
+
+        Slot& slot = slots[index];
+        if (y4m) {
+            encodeY4m(slot);
+        } else {
+            encodePng(slot);
+        }
+        written.fetch_add(slot.copies, std::memory_order_relaxed);
+        slot.busy.store(false, std::memory_order_release);
+    }
+}
+
+/**
+ * @brief Zapisuje klatkę jako plik PNG
+ *
+ * Powtórzenia są kopiami pierwszego pliku, bez ponownej kompresji.
+ *
+ * @param slot Bufor klatki
+ */
+void FrameCapture::encodePng(Slot& slot) {
+    sf::Image image;
+    image.create(width, height, slot.pixels.data());
+    image.flipVertically();
+
+    char name[32];
+    std::snprintf(name, sizeof(name), "frame_%06llu.png", (unsigned long long)slot.frame);
+    const std::filesystem::path first = std::filesystem::path(target) / name;
+    image.saveToFile(first.string());
+    for (unsigned i = 1; i < slot.copies; ++i) {
+        std::snprintf(name, sizeof(name), "frame_%06llu.png", (unsigned long long)(slot.frame + i));
+        std::error_code error;
+        std::filesystem::copy_file(first, std::filesystem::path(target) / name,
+                                   std::filesystem::copy_options::overwrite_existing, error);
+    }
+}
+
+/**
+ * @brief Konwertuje klatkę do YUV 4:2:0 i dopisuje ją do strumienia Y4M
+ *
+ * Konwersja (BT.601, pełny zakres) odbywa się równolegle w wielu wątkach,
+ * a sam zapis czeka na swoją kolej, żeby klatki w pliku zachowały kolejność.
+ *
+ * @param slot Bufor klatki
+ */
+void FrameCapture::encodeY4m(Slot& slot) {
+    const unsigned chromaWidth = (width + 1) / 2, chromaHeight = (height + 1) / 2;
+    sf::Uint8* yPlane = slot.yuv.data();
+    sf::Uint8* uPlane = yPlane + (std::size_t)width * height;
+    sf::Uint8* vPlane = uPlane + (std::size_t)chromaWidth * chromaHeight;
+
+    // Wiersze z glReadPixels idą od dołu, a Y4M zapisuje je od góry.
+    auto pixel = [&](unsigned x, unsigned y) {
+        return slot.pixels.data() + ((std::size_t)(height - 1 - y) * width + x) * 4;
+    };
+    for (unsigned y = 0; y < height; ++y) {
+        for (unsigned x = 0; x < width; ++x) {
+            const sf::Uint8* p = pixel(x, y);
+            yPlane[(std::size_t)y * width + x] = clampByte((77 * p[0] + 150 * p[1] + 29 * p[2] + 128) >> 8);
+        }
+    }
+    for (unsigned cy = 0; cy < chromaHeight; ++cy) {
+        for (unsigned cx = 0; cx < chromaWidth; ++cx) {
+            int r = 0, g = 0, b = 0, n = 0;
+            for (unsigned dy = 0; dy < 2 && cy * 2 + dy < height; ++dy) {
+                for (unsigned dx = 0; dx < 2 && cx * 2 + dx < width; ++dx) {
+                    const sf::Uint8* p = pixel(cx * 2 + dx, cy * 2 + dy);
+                    r += p[0];
+                    g += p[1];
+                    b += p[2];
+                    n++;
+                }
+            }
+            r /= n;
+            g /= n;
+            b /= n;
+            std::size_t i = (std::size_t)cy * chromaWidth + cx;
+            uPlane[i] = clampByte(((-43 * r - 85 * g + 128 * b + 128) >> 8) + 128);
+            vPlane[i] = clampByte(((128 * r - 107 * g - 21 * b + 128) >> 8) + 128);
+        }
+    }
+
+    std::unique_lock<std::mutex> lock(writeMutex);
+    writeTurn.wait(lock, [this, &slot] { return nextWrite == slot.sequence; });
+    for (unsigned i = 0; i < slot.copies; ++i) {
+        std::fputs("FRAME\n", stream);
+        std::fwrite(slot.yuv.data(), 1, slot.yuv.size(), stream);
+    }
+    nextWrite++;
+    lock.unlock();
+    writeTurn.notify_all();
+}
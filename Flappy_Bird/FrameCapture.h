@@ -0,0 +1,162 @@
+/**
+ * @file FrameCapture.h
+ * @brief Nagrywanie klatek gry bez blokowania pętli gry.
+ */
+
+#pragma once
+#ifndef FRAMECAPTURE_H
+#define FRAMECAPTURE_H
+
+#include <SFML/Graphics.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Nagrywanie klatek do sekwencji PNG lub strumienia Y4M.
+ *
+ * Wątek gry jedynie odczytuje zawartość okna do wolnego bufora z pierścienia
+ * przydzielonego z góry i przekazuje go puli wątków kodujących. Kodowanie
+ * (kompresja PNG albo konwersja RGBA do YUV 4:2:0) i zapis na dysk odbywają się
+ * w tle. Jeśli wszystkie bufory są zajęte, klatka jest pomijana i liczona jako
+ * porzucona - gra nigdy nie czeka na koder.
+ *
+ * Nagranie ma stałe tempo: jedna klatka gry może zająć kilka kolejnych klatek
+ * nagrania (gdy gra działa wolniej niż nagranie), a czas porzuconych klatek
+ * wypełnia powtórzenie następnej odczytanej klatki, więc długość nagrania
+ * zgadza się z czasem gry.
+ *
+ * Plik docelowy kończący się na ".y4m" oznacza surowy strumień Y4M (klatki są
+ * zapisywane w kolejności mimo równoległego kodowania), każda inna ścieżka to
+ * katalog na pliki frame_000000.png.
+ */
+class FrameCapture {
+public:
+    static constexpr std::size_t defaultRingSize = 8; /**< Domyślna liczba buforów klatek. */
+
+    /**
+     * @brief Konstruktor klasy FrameCapture. Przydziela bufory i uruchamia wątki kodujące.
+     *
+     * @param target Plik .y4m lub katalog na sekwencję PNG.
+     * @param size Rozmiar nagrywanego okna.
+     * @param framerate Liczba klatek na sekundę zapisywana w nagłówku Y4M.
+     * @param threads Liczba wątków kodujących (0 - dobierana automatycznie).
+     * @param ringSize Liczba buforów klatek.
+     */
+    FrameCapture(const std::string& target, sf::Vector2u size, unsigned framerate = 60,
+                 unsigned threads = 0, std::size_t ringSize = defaultRingSize);
+
+    /**
+     * @brief Destruktor klasy FrameCapture. Czeka na zakodowanie zaległych klatek i wypisuje podsumowanie.
+     */
+    ~FrameCapture();
+
+    FrameCapture(const FrameCapture&) = delete;
+    FrameCapture& operator=(const FrameCapture&) = delete;
+
+    /**
+     * @brief Sprawdza, czy cel nagrania został otwarty.
+     *
+     * @return true jeśli nagrywanie działa.
+     */
+    bool isOpen() const { return open; }
+
+    /**
+     * @brief Odczytuje bieżącą zawartość okna i przekazuje ją do zakodowania.
+     *
+     * Musi być wywołana przed window.display(), gdy tylny bufor zawiera gotową klatkę.
+     * Nie alokuje pamięci.
+     *
+     * @param window Okno, z którego pobierana jest klatka.
+     * @param copies Liczba kolejnych klatek nagrania, które zajmuje ta klatka gry.
+     * @return true jeśli klatka trafiła do kolejki, false jeśli została porzucona.
+     */
+    bool capture(sf::RenderWindow& window, unsigned copies = 1);
+
+    /**
+     * @brief Zwraca liczbę klatek nagrania przyjętych do zakodowania, z powtórzeniami.
+     *
+     * @return Liczba klatek.
+     */
+    std::uint64_t getCaptured() const { return captured.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Zwraca liczbę klatek nagrania porzuconych z braku wolnego bufora.
+     *
+     * @return Liczba klatek.
+     */
+    std::uint64_t getDropped() const { return dropped.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Zwraca liczbę klatek zapisanych na dysk.
+     *
+     * @return Liczba klatek.
+     */
+    std::uint64_t getWritten() const { return written.load(std::memory_order_relaxed); }
+
+private:
+    /**
+     * @brief Bufor jednej klatki w pierścieniu.
+     */
+    struct Slot {
+        std::vector<sf::Uint8> pixels; /**< Piksele RGBA w kolejności OpenGL (od dolnego wiersza). */
+        std::vector<sf::Uint8> yuv; /**< Płaszczyzny Y, U i V klatki (tylko Y4M). */
+        std::uint64_t frame = 0; /**< Numer pierwszej klatki nagrania zajmowanej przez ten odczyt. */
+        std::uint64_t sequence = 0; /**< Numer odczytu, wyznacza kolejność zapisu Y4M. */
+        unsigned copies = 1; /**< Liczba klatek nagrania zajmowanych przez ten odczyt. */
+        std::atomic<bool> busy{false}; /**< Czy bufor czeka na zakodowanie. */
+    };
+
+    /**
+     * @brief Pętla wątku kodującego.
+     */
+    void worker();
+
+    /**
+     * @brief Zapisuje klatkę jako plik PNG.
+     *
+     * @param slot Bufor klatki.
+     */
+    void encodePng(Slot& slot);
+
+    /**
+     * @brief Konwertuje klatkę do YUV 4:2:0 i dopisuje ją do strumienia Y4M w kolejności numerów klatek.
+     *
+     * @param slot Bufor klatki.
+     */
+    void encodeY4m(Slot& slot);
+
+    std::string target; /**< Plik .y4m lub katalog sekwencji PNG. */
+    unsigned width, height; /**< Rozmiar klatki. */
+    bool y4m; /**< Czy nagranie trafia do strumienia Y4M. */
+    bool open; /**< Czy cel nagrania został otwarty. */
+    FILE* stream; /**< Plik strumienia Y4M. */
+
+    std::vector<Slot> slots; /**< Pierścień buforów klatek. */
+    std::size_t head; /**< Indeks następnego bufora do zapełnienia (tylko wątek gry). */
+    std::uint64_t reads; /**< Liczba odczytów przekazanych do zakodowania (tylko wątek gry). */
+    std::uint64_t nextFrame; /**< Numer następnej klatki nagrania (tylko wątek gry). */
+    unsigned owed; /**< Porzucone klatki nagrania, wypełniane powtórzeniem następnego odczytu (tylko wątek gry). */
+
+    std::vector<std::size_t> queue; /**< Kolejka cykliczna indeksów buforów do zakodowania. */
+    std::size_t queueHead, queueCount; /**< Początek i długość kolejki. */
+    bool stopping; /**< Czy wątki mają zakończyć pracę po opróżnieniu kolejki. */
+    std::mutex queueMutex; /**< Blokada kolejki. */
+    std::condition_variable queueReady; /**< Sygnał nowej pracy w kolejce. */
+
+    std::uint64_t nextWrite; /**< Numer odczytu, który jako następny trafi do strumienia Y4M. */
+    std::mutex writeMutex; /**< Blokada kolejności zapisu Y4M. */
+    std::condition_variable writeTurn; /**< Sygnał zapisania kolejnej klatki Y4M. */
+
+    std::vector<std::thread> workers; /**< Wątki kodujące. */
+    std::atomic<std::uint64_t> captured{0}; /**< Liczba klatek nagrania przyjętych do zakodowania. */
+    std::atomic<std::uint64_t> dropped{0}; /**< Liczba porzuconych klatek nagrania. */
+    std::atomic<std::uint64_t> written{0}; /**< Liczba zapisanych klatek nagrania. */
+};
+
+#endif
@@ -0,0 +1,248 @@
+/**
+ * @file GameCore.cpp
+ * @brief Implementacja klasy GameCore
+ */
+
+#include "GameCore.h"
+#include "DifficultyRules.h"
+#include "Metrics.h"
+
+/**
+ * @brief Konstruktor klasy GameCore
+ */
+GameCore::GameCore()
+        : chosenDifficulty(Difficulty::Medium), throatDifficulty(340), score(0), gameRunning(false),
+          gameOvered(false), gamePaused(false), seed(0), ticks(0), scoreRecorded(false), b_skin(PlayerModel::Blue),
+          spawnTimer(Scheduler::noTimer), animationTimer(Scheduler::noTimer), course(nullptr), upcoming{}, upcomingValid(false), ledger(nullptr) {
+    bird = entities.spawnBird(b_skin);
+    animationTimer = scheduler.schedule(animationPeriod, &GameCore::onAnimationTimer, this, animationPeriod);
+}
+
+/**
+ * @brief Ustawia ziarno rozgrywki i przewija tor
+ *
+ * @param newSeed Ziarno rozgrywki
+ */
+void GameCore::reseed(std::uint64_t newSeed) {
+    seed = newSeed;
+    course->restart(seed);
+    upcomingValid = false;
+    ticks = 0;
+    scoreRecorded = false;
+}
+
+/**
+ * @brief Wraca do stanu przed pierwszym machnięciem
+ *
+ * @param newSeed Ziarno nowej rozgrywki
+ */
+void GameCore::restart(std::uint64_t newSeed) {
+    entities.clearPipes();
+    cancelSpawn();
+    score = 0;
+    events.clear();
+    gameRunning = false;
+    gameOvered = false;
+    gamePaused = false;
+    reseed(newSeed);
+    Metrics::increment(Metrics::get().restarts);
+    entities.resetBird(bird);
+}
+
+/**
+ * @brief Zapisuje stan rozgrywki
+ *
+ * @param state Struktura, do której trafia stan
+ */
+void GameCore::saveState(State& state) const {
+    state.bird = entities.saveBird(bird);
+    state.pipeCount = entities.savePipes(state.pipes, (std::uint32_t)maxPipes);
+    state.score = score;
+    state.gameRunning = gameRunning;
+    state.gameOvered = gameOvered;
+    state.gamePaused = gamePaused;
+    state.scoreRecorded = scoreRecorded;
+    state.seed = seed;
+    state.ticks = ticks;
+    state.clock = scheduler.now();
+    state.spawnDue = scheduler.dueTime(spawnTimer);
+    state.animationDue = scheduler.dueTime(animationTimer);
+    state.coursePosition = course->tell();
+    state.upcoming = upcoming;
+    state.upcomingValid = upcomingValid;
+}
+
+/**
+ * @brief Przywraca stan rozgrywki
+ *
+ * @param state Zapisany stan
+ */
+void GameCore::loadState(const State& state) {
+    entities.loadBird(bird, state.bird);
+    entities.loadPipes(state.pipes, state.pipeCount);
+    score = state.score;
+    events.clear();
+    gameRunning = state.gameRunning;
+    gameOvered = state.gameOvered;
+    gamePaused = state.gamePaused;
+    scoreRecorded = state.scoreRecorded;
+    seed = state.seed;
+    ticks = state.ticks;
+    course->seek(state.coursePosition);
+    upcoming = state.upcoming;
+    upcomingValid = state.upcomingValid;
+
+    cancelSpawn();
+    scheduler.cancel(animationTimer);
+    scheduler.rewind(state.clock);
+    if (state.spawnDue >= 0) {
+        spawnTimer = scheduler.scheduleAt(state.spawnDue, &GameCore::onSpawnTimer, this);
+    }
+    animationTimer = scheduler.scheduleAt(state.animationDue, &GameCore::onAnimationTimer, this, animationPeriod);
+}
+
+/**
+ * @brief Tworzy encję następnej rury toru
+ *
+ * Na ekranie są najwyżej 4 rury z monetami, a EntityWorld ma pamięć na
+ * wszystkie komponenty przydzieloną z góry, więc liczba alokacji nie rośnie w trakcie gry.
+ *
+ * @param late Opóźnienie względem zdarzenia generowania rury
+ */
+void GameCore::spawnPipe(float late) {
+    if (!upcomingValid) return;
+    entities.spawnPipe(Physics::pipeSpawnX - Physics::pipeSpeed * late, upcoming.y, upcoming.throat, upcoming.coin);
+    if (entities.pipeCount() > 4) {
+        entities.destroyOldestPipe();
+    }
+
+    // Odstęp jest zapisany przy następnej rurze, więc trzeba ją pobrać już teraz.
+    // Po końcu toru rury przestają powstawać, a gra trwa do śmierci ptaka.
+    fetchPipe();
+    if (upcomingValid) {
+        scheduleSpawn(upcoming.spacing / Physics::pipeSpeed);
+    }
+}
+
+/**
+ * @brief Pobiera z toru następną rurę
+ */
+void GameCore::fetchPipe() {
+    upcoming = {rulesFor(chosenDifficulty).spawnInterval * Physics::pipeSpeed, Physics::pipeY(0), throatDifficulty, true};
+    upcomingValid = course->next(upcoming);
+}
+
+/**
+ * @brief Planuje generowanie następnej rury
+ *
+ * @param delay Czas do powstania rury
+ */
+void GameCore::scheduleSpawn(double delay) {
+    spawnTimer = scheduler.schedule(delay, &GameCore::onSpawnTimer, this);
+}
+
+/**
+ * @brief Przerywa generowanie rur
+ */
+void GameCore::cancelSpawn() {
+    scheduler.cancel(spawnTimer);
+    spawnTimer = Scheduler::noTimer;
+}
+
+/**
+ * @brief Machnięcie skrzydłami
+ */
+void GameCore::flap() {
+    if (!gameRunning) {
+        gameRunning = true;
+        fetchPipe();
+        spawnPipe();
+    }
+    entities.flap(bird, gameRunning, gameOvered, events);
+}
+
+/**
+ * @brief Wykonuje krok gry
+ *
+ * @param dt Czas kroku w sekundach
+ */
+void GameCore::update(float dt) {
+    events.setTick(ticks);
+    entities.step(dt, gameRunning, gameOvered, events);
+    handleGameEvents();
+    if (gameRunning && !gameOvered) {
+        ticks++;
+        Metrics::increment(Metrics::get().simTicks);
+    }
+    if (gameOvered) {
+        recordScore();
+        cancelSpawn();
+    }
+    // Zdarzenia są wywoływane po ruchu rur, w tej samej kolejności co w Simulation::stepWith.
+    if (!gamePaused) {
+        scheduler.advance(dt);
+    }
+}
+
+/**
+ * @brief Odbiera zdarzenia kroku symulacji
+ *
+ * Wynik jest liczony tutaj, a nie w systemach EntityWorld, więc dziennik wyników w update widzi
+ * już monety z bieżącego kroku.
+ */
+void GameCore::handleGameEvents() {
+    GameEvent event{};
+    while (events.pop(event)) {
+        if (event.type == GameEventType::Coin) {
+            score++;
+        }
+        onGameEvent(event);
+    }
+}
+
+/**
+ * @brief Zapisuje wynik zakończonej rozgrywki do dziennika
+ */
+void GameCore::recordScore() {
+    if (scoreRecorded) return;
+    ledger->append(seed, chosenDifficulty, b_skin, (std::uint32_t)score, ticks);
+    scoreRecorded = true;
+}
+
+/**
+ * @brief Zwraca stan gry jako świat symulacji
+ *
+ * @return Świat z pozycją ptaka, rurami i wynikiem
+ */
+World GameCore::toWorld() const {
+    World world{};
+    BirdState birdState = entities.saveBird(bird);
+    world.birdY = birdState.y;
+    world.birdVel = birdState.vel;
+    world.score = (std::uint32_t)score;
+    world.running = gameRunning;
+    world.over = gameOvered;
+    world.pipeCount = entities.savePipes(world.pipes, (std::uint32_t)Physics::maxPipes);
+    return world;
+}
+
+/**
+ * @brief Zdarzenie zegara: tworzy rurę i planuje następną
+ *
+ * Następna rura jest planowana od chwili zdarzenia, a nie od końca klatki.
+ *
+ * @param core Rozgrywka
+ */
+void GameCore::onSpawnTimer(void* core) {
+    auto* self = static_cast<GameCore*>(core);
+    self->spawnPipe((float)self->scheduler.lateness());
+}
+
+/**
+ * @brief Zdarzenie zegara: przełącza klatkę animacji ptaka
+ *
+ * @param core Rozgrywka
+ */
+void GameCore::onAnimationTimer(void* core) {
+    static_cast<GameCore*>(core)->animate();
+}
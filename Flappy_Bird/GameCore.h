@@ -0,0 +1,298 @@
+/**
+ * @file GameCore.h
+ * @brief Definicja klasy GameCore - części silnika gry bez okna, grafiki i dźwięku.
+ */
+
+#pragma once
+#ifndef GAMECORE_H
+#define GAMECORE_H
+
+#include <cstdint>
+#include "Course.h"
+#include "Difficulty.h"
+#include "Entities.h"
+#include "GameEvents.h"
+#include "PlayerModel.h"
+#include "Scheduler.h"
+#include "ScoreLedger.h"
+
+/**
+ * @brief Rozgrywka bez okna: encje, zegar, tor, wynik i dziennik wyników.
+ *
+ * Engine dziedziczy po tej klasie i dokłada okno, grafikę, dźwięk i sterowanie,
+ * a testy bez okna (alloc_cases) używają jej bezpośrednio, więc obie strony
+ * wykonują ten sam kod kroku gry, tworzenia rur, restartu i animacji.
+ *
+ * Tor i dziennik wyników należą do klasy pochodnej, która ustawia wskaźniki
+ * course i ledger przed pierwszym restartem.
+ */
+class GameCore {
+protected:
+    Difficulty chosenDifficulty; /**< Wybrany poziom trudności gry. */
+    float throatDifficulty; /**< Gardło rur dla wybranego poziomu trudności. */
+    int score; /**< Aktualny wynik gracza. */
+    bool gameRunning, gameOvered; /**< Flaga określająca, czy gra jest w trakcie działania lub zakończona. */
+    bool gamePaused; /**< Flaga pauzy: zegar gry stoi. */
+    std::uint64_t seed; /**< Ziarno generatora losowego bieżącej rozgrywki. */
+    std::uint32_t ticks; /**< Liczba kroków symulacji przetrwanych w bieżącej rozgrywce. */
+    bool scoreRecorded; /**< Flaga określająca, czy wynik bieżącej rozgrywki trafił już do dziennika. */
+
+    EntityWorld entities; /**< Encje gry: ptak, rury i monety. */
+    Entity bird; /**< Encja ptaka. */
+    PlayerModel b_skin; /**< Model gracza (postać gracza). */
+    EventQueue events; /**< Zdarzenia zgłaszane przez ptaka i rury, odbierane w handleGameEvents. */
+
+    static constexpr std::size_t maxPipes = 5; /**< Maksymalna liczba rur istniejących jednocześnie. */
+    static constexpr double animationPeriod = 0.25; /**< Czas wyświetlania jednej klatki animacji ptaka. */
+
+    Scheduler scheduler; /**< Zegar symulacji, który odmierza generowanie rur i animacje. */
+    Scheduler::TimerId spawnTimer; /**< Zdarzenie generowania następnej rury lub Scheduler::noTimer. */
+    Scheduler::TimerId animationTimer; /**< Okresowe zdarzenie animacji ptaka. */
+    Course* course; /**< Tor gry, ustawiany przez klasę pochodną. */
+    CoursePipe upcoming; /**< Następna rura toru, pobrana zawczasu, żeby znać jej odstęp. */
+    bool upcomingValid; /**< Czy upcoming zawiera rurę (false po końcu toru). */
+    ScoreLedger* ledger; /**< Dziennik wyników, ustawiany przez klasę pochodną. */
+
+public:
+    /**
+     * @brief Konstruktor klasy GameCore. Tworzy ptaka i uruchamia zegar animacji.
+     */
+    GameCore();
+
+    /**
+     * @brief Destruktor klasy GameCore.
+     */
+    virtual ~GameCore() = default;
+
+    GameCore(const GameCore&) = delete;
+    GameCore& operator=(const GameCore&) = delete;
+
+    /**
+     * @brief Ustawia nowe ziarno i przewija od niego tor na początek.
+     *
+     * @param newSeed Ziarno rozgrywki.
+     */
+    void reseed(std::uint64_t newSeed);
+
+    /**
+     * @brief Wraca do stanu przed pierwszym machnięciem, z nowym ziarnem.
+     *
+     * @param newSeed Ziarno nowej rozgrywki.
+     */
+    void restart(std::uint64_t newSeed);
+
+    /**
+     * @brief Migawka stanu rozgrywki.
+     *
+     * Struktura ma stały rozmiar i nie zawiera wskaźników, więc zapis i odtworzenie
+     * stanu to kopiowanie kilkuset bajtów, bez alokacji.
+     */
+    struct State {
+        BirdState bird; /**< Stan ptaka: położenie, prędkość, klatka animacji. */
+        PipeState pipes[maxPipes]; /**< Stany rur, od najstarszej. */
+        std::uint32_t pipeCount; /**< Liczba rur na ekranie. */
+        int score; /**< Wynik gracza. */
+        bool gameRunning; /**< Flaga działania gry. */
+        bool gameOvered; /**< Flaga zakończenia gry. */
+        bool gamePaused; /**< Flaga pauzy. */
+        bool scoreRecorded; /**< Czy wynik trafił już do dziennika. */
+        std::uint64_t seed; /**< Ziarno rozgrywki. */
+        std::uint32_t ticks; /**< Liczba przetrwanych kroków. */
+        double clock; /**< Czas zegara gry. */
+        double spawnDue; /**< Chwila powstania następnej rury (ujemna, gdy rury nie powstają). */
+        double animationDue; /**< Chwila następnej klatki animacji. */
+        std::uint64_t coursePosition; /**< Pozycja w torze (Course::tell). */
+        CoursePipe upcoming; /**< Następna rura toru. */
+        bool upcomingValid; /**< Czy następna rura istnieje. */
+    };
+
+    /**
+     * @brief Zapisuje stan rozgrywki.
+     *
+     * @param state Struktura, do której trafia stan.
+     */
+    void saveState(State& state) const;
+
+    /**
+     * @brief Przywraca stan rozgrywki zapisany przez saveState.
+     *
+     * Zegar gry wraca do zapisanej chwili, a zdarzenia rur i animacji są planowane
+     * na zapisane chwile, więc dalsza gra przebiega tak samo jak po zapisie.
+     * Komponenty encji mają pamięć przydzieloną z góry, a kolejka zegara ma już
+     * miejsce na oba zdarzenia, więc przywrócenie stanu nie alokuje pamięci.
+     *
+     * @param state Zapisany stan.
+     */
+    void loadState(const State& state);
+
+    /**
+     * @brief Tworzy encję następnej rury toru i planuje kolejną.
+     *
+     * @param late Opóźnienie względem zdarzenia generowania rury, w sekundach.
+     */
+    void spawnPipe(float late = 0);
+
+    /**
+     * @brief Pobiera z toru następną rurę do upcoming.
+     *
+     * Wartości, których tor nie określa, pochodzą z bieżącego poziomu trudności.
+     */
+    void fetchPipe();
+
+    /**
+     * @brief Planuje generowanie następnej rury.
+     *
+     * @param delay Czas do powstania rury.
+     */
+    void scheduleSpawn(double delay);
+
+    /**
+     * @brief Przerywa generowanie rur.
+     */
+    void cancelSpawn();
+
+    /**
+     * @brief Machnięcie skrzydłami; pierwsze rozpoczyna grę.
+     */
+    void flap();
+
+    /**
+     * @brief Wykonuje krok gry: encje, zdarzenia, wynik, dziennik i zegar.
+     *
+     * @param dt Czas kroku w sekundach.
+     */
+    void update(float dt);
+
+    /**
+     * @brief Odbiera zdarzenia kroku symulacji i liczy wynik z monet.
+     */
+    void handleGameEvents();
+
+    /**
+     * @brief Zapisuje wynik zakończonej rozgrywki do dziennika wyników.
+     */
+    void recordScore();
+
+    /**
+     * @brief Zwraca stan gry jako świat symulacji.
+     *
+     * @return Świat z pozycją ptaka, rurami i wynikiem.
+     */
+    World toWorld() const;
+
+    /**
+     * @brief Zdarzenie zegara: tworzy rurę i planuje następną.
+     *
+     * @param core Rozgrywka.
+     */
+    static void onSpawnTimer(void* core);
+
+    /**
+     * @brief Zdarzenie zegara: wywołuje animate.
+     *
+     * @param core Rozgrywka.
+     */
+    static void onAnimationTimer(void* core);
+
+    /**
+     * @brief Ustawia stan działania gry (uruchomiona lub zatrzymana).
+     *
+     * @param state Nowy stan gry.
+     */
+    void SetGameRunning(bool state) { gameRunning = state; }
+
+    /**
+     * @brief Ustawia stan zakończenia gry.
+     *
+     * @param state Nowy stan zakończenia gry.
+     */
+    void SetGameOvered(bool state) { gameOvered = state; }
+
+    /**
+     * @brief Sprawdza, czy gra jest uruchomiona.
+     *
+     * @return true jeśli gra jest uruchomiona.
+     * @return false jeśli gra nie jest uruchomiona.
+     */
+    bool isGameRunning() const { return gameRunning; }
+
+    /**
+     * @brief Sprawdza, czy gra jest zakończona.
+     *
+     * @return true jeśli gra jest zakończona.
+     * @return false jeśli gra nie jest zakończona.
+     */
+    bool isGameOvered() const { return gameOvered; }
+
+    /**
+     * @brief Zwraca stan pauzy gry.
+     *
+     * @return true jeśli gra jest w trybie pauzy.
+     * @return false jeśli gra nie jest w trybie pauzy.
+     */
+    bool GetGamePaused(){return gamePaused;};
+
+    /**
+     * @brief Ustawia stan pauzy gry.
+     *
+     * @param __paused Nowy stan pauzy gry.
+     */
+    void SetGamePaused(bool __paused){gamePaused = __paused;};
+
+    /**
+     * @brief Zwraca aktualny wynik gry.
+     *
+     * @return Aktualny wynik gracza.
+     */
+    int GetScore() const { return score; }
+
+    /**
+     * @brief Ustawia nowy wynik gry.
+     *
+     * @param __score Nowy wynik gracza.
+     */
+    void SetScore(int __score) { score = __score; }
+
+    /**
+     * @brief Ustawia poziom trudności gry.
+     *
+     * @param __diff Nowy poziom trudności.
+     */
+    void SetDifficulty(Difficulty __diff) { chosenDifficulty = __diff; }
+
+    /**
+     * @brief Zwraca aktualnie ustawiony poziom trudności gry.
+     *
+     * @return Aktualny poziom trudności gry.
+     */
+    Difficulty GetDifficulty() const { return chosenDifficulty; }
+
+    /**
+     * @brief Ustawia poziom trudności fizycznej przeszkód w grze.
+     *
+     * @param __throat Nowy poziom trudności fizycznej przeszkód.
+     */
+    void SetThroatDifficulty(float __throat) { throatDifficulty = __throat; }
+
+    /**
+     * @brief Zwraca aktualnie ustawiony poziom trudności fizycznej przeszkód w grze.
+     *
+     * @return Aktualny poziom trudności fizycznej przeszkód.
+     */
+    float GetThroatDifficulty() const { return throatDifficulty; }
+
+protected:
+    /**
+     * @brief Reaguje na jedno zdarzenie kroku; Engine odtwarza tu dźwięki.
+     *
+     * @param event Zdarzenie.
+     */
+    virtual void onGameEvent(const GameEvent& event) { (void)event; }
+
+    /**
+     * @brief Przechodzi do następnej klatki animacji ptaka; Engine może ją pominąć.
+     */
+    virtual void animate() { entities.animate(); }
+};
+
+#endif
@@ -0,0 +1,27 @@
+/**
+ * @file GameEvents.cpp
+ * @brief Implementacja kolejki zdarzeń gry.
+ */
+
+#include "GameEvents.h"
+
+/**
+ * @brief Konstruktor klasy EventQueue
+ *
+ * @param capacity Pojemność kolejki
+ */
+EventQueue::EventQueue(std::size_t capacity)
+        : tailIndex(0), cachedHead(0), currentTick(0), droppedCount(0), headIndex(0), cachedTail(0) {
+    std::size_t size = 1;
+    while (size < capacity) size <<= 1;
+    ring.resize(size);
+    mask = size - 1;
+}
+
+/**
+ * @brief Odrzuca wszystkie czekające zdarzenia
+ */
+void EventQueue::clear() {
+    cachedTail = tailIndex.load(std::memory_order_acquire);
+    headIndex.store(cachedTail, std::memory_order_release);
+}
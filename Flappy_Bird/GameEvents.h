@@ -0,0 +1,157 @@
+/**
+ * @file GameEvents.h
+ * @brief Zdarzenia gry i kolejka, przez którą symulacja przekazuje je dźwiękowi, wynikowi i zapisowi.
+ */
+
+#pragma once
+#ifndef GAMEEVENTS_H
+#define GAMEEVENTS_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Rodzaj zdarzenia gry.
+ */
+enum class GameEventType : std::uint8_t {
+    Flap,   /**< Skuteczne machnięcie skrzydłami. */
+    Coin,   /**< Zebranie monety (punkt). */
+    Pass,   /**< Minięcie rury. */
+    Hit,    /**< Zderzenie z rurą. */
+    Die     /**< Zderzenie z ziemią lub sufitem. */
+};
+
+/**
+ * @brief Zdarzenie gry.
+ */
+struct GameEvent {
+    GameEventType type; /**< Rodzaj zdarzenia. */
+    std::uint32_t tick; /**< Krok symulacji, w którym zdarzenie wystąpiło. */
+};
+
+/**
+ * @brief Kolejka zdarzeń jednego świata: jeden producent, jeden konsument, bez blokad.
+ *
+ * Producentem jest symulacja (EntityWorld albo Simulation::stepWith), konsumentem
+ * kod, który reaguje na zdarzenia we własnym tempie: dźwięk, wynik, dziennik
+ * wyników, zapis powtórki. Bufor jest przydzielany w konstruktorze i ma rozmiar
+ * będący potęgą dwójki, więc push i pop nie alokują pamięci i nie czekają.
+ * Producent i konsument mogą działać w różnych wątkach; ich indeksy leżą w osobnych
+ * liniach pamięci podręcznej, a każda strona trzyma kopię indeksu drugiej strony
+ * i odczytuje jej atomowy indeks dopiero wtedy, gdy kopia mówi, że kolejka jest
+ * pełna (albo pusta).
+ *
+ * Gdy kolejka jest pełna, zdarzenie przepada i jest liczone w dropped() -
+ * symulacja nigdy nie czeka na konsumenta.
+ */
+class EventQueue {
+public:
+    /**
+     * @brief Konstruktor klasy EventQueue.
+     *
+     * @param capacity Pojemność kolejki, zaokrąglana w górę do potęgi dwójki.
+     */
+    explicit EventQueue(std::size_t capacity = 256);
+
+    EventQueue(const EventQueue&) = delete;
+    EventQueue& operator=(const EventQueue&) = delete;
+
+    /**
+     * @brief Ustawia krok symulacji dopisywany do kolejnych zdarzeń. Wywołuje producent.
+     *
+     * @param tick Bieżący krok symulacji.
+     */
+    void setTick(std::uint32_t tick) { currentTick = tick; }
+
+    /**
+     * @brief Dodaje zdarzenie z bieżącym krokiem. Wywołuje producent.
+     *
+     * @param type Rodzaj zdarzenia.
+     * @return false, gdy kolejka była pełna i zdarzenie przepadło.
+     */
+    bool emit(GameEventType type) { return push({type, currentTick}); }
+
+    /**
+     * @brief Dodaje zdarzenie. Wywołuje producent.
+     *
+     * @param event Zdarzenie.
+     * @return false, gdy kolejka była pełna i zdarzenie przepadło.
+     */
+    bool push(const GameEvent& event) {
+        const std::size_t tail = tailIndex.load(std::memory_order_relaxed);
+        if (tail - cachedHead == ring.size()) {
+            cachedHead = headIndex.load(std::memory_order_acquire);
+            if (tail - cachedHead == ring.size()) {
+                droppedCount.store(droppedCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                return false;
+            }
+        }
+        ring[tail & mask] = event;
+        tailIndex.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Pobiera najstarsze zdarzenie. Wywołuje konsument.
+     *
+     * @param event Miejsce na zdarzenie.
+     * @return false, gdy kolejka jest pusta.
+     */
+    bool pop(GameEvent& event) {
+        const std::size_t head = headIndex.load(std::memory_order_relaxed);
+        if (head == cachedTail) {
+            cachedTail = tailIndex.load(std::memory_order_acquire);
+            if (head == cachedTail) return false;
+        }
+        event = ring[head & mask];
+        headIndex.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Odrzuca wszystkie czekające zdarzenia (restart, GameCore::loadState). Wywołuje konsument.
+     */
+    void clear();
+
+    /**
+     * @brief Zwraca liczbę zdarzeń, które przepadły z powodu pełnej kolejki.
+     *
+     * @return Liczba utraconych zdarzeń.
+     */
+    std::uint64_t dropped() const { return droppedCount.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Zwraca pojemność kolejki.
+     *
+     * @return Liczba zdarzeń mieszczących się w kolejce.
+     */
+    std::size_t capacity() const { return ring.size(); }
+
+private:
+    std::vector<GameEvent> ring; /**< Bufor pierścieniowy. */
+    std::size_t mask; /**< Maska indeksu (pojemność - 1). */
+
+    alignas(64) std::atomic<std::size_t> tailIndex; /**< Indeks następnego zapisu (producent). */
+    std::size_t cachedHead; /**< Ostatnio odczytany indeks konsumenta (kopia producenta). */
+    std::uint32_t currentTick; /**< Krok dopisywany przez emit (producent). */
+    std::atomic<std::uint64_t> droppedCount; /**< Liczba utraconych zdarzeń (producent). */
+
+    alignas(64) std::atomic<std::size_t> headIndex; /**< Indeks następnego odczytu (konsument). */
+    std::size_t cachedTail; /**< Ostatnio odczytany indeks producenta (kopia konsumenta). */
+};
+
+/**
+ * @brief Odbiorca zdarzeń, który je pomija.
+ *
+ * Domyślny odbiorca w Simulation::stepWith: symulacja bez okna, wsadowa
+ * i wielowątkowa nie płaci za zdarzenia, których nikt nie czyta - wywołania
+ * są puste i kompilator je usuwa.
+ */
+struct NoEvents {
+    void setTick(std::uint32_t) {} /**< Nic nie robi. */
+    bool emit(GameEventType) { return true; } /**< Nic nie robi. */
+};
+
+#endif
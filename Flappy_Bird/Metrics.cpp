@@ -0,0 +1,84 @@
+/**
+ * @file Metrics.cpp
+ * @brief Implementacja segmentu pamięci współdzielonej z metrykami gry.
+ */
+
+#include "Metrics.h"
+#include <new>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "Liczniki w pamieci wspoldzielonej musza byc bez blokad");
+
+MetricsBlock Metrics::localBlock{}; /**< Blok zastępczy */
+MetricsBlock* Metrics::block = &Metrics::localBlock; /**< Aktualny blok liczników */
+bool Metrics::shared = false; /**< Czy blok jest w pamięci współdzielonej */
+
+/**
+ * @brief Zwraca nazwę segmentu dla podanego procesu
+ *
+ * @param pid Identyfikator procesu
+ * @return Nazwa segmentu
+ */
+std::string Metrics::segmentName(std::uint64_t pid) {
+    return "/flappy_metrics." + std::to_string(pid);
+}
+
+/**
+ * @brief Tworzy i mapuje segment pamięci współdzielonej
+ *
+ * @return true jeśli segment został utworzony
+ */
+bool Metrics::open() {
+#ifdef _WIN32
+    return false;
+#else
+    if (shared) return true;
+
+    auto pid = (std::uint64_t)getpid();
+    auto name = segmentName(pid);
+    int fd = shm_open(name.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
+    if (fd < 0) return false;
+
+    if (ftruncate(fd, sizeof(MetricsBlock)) != 0) {
+        ::close(fd);
+        shm_unlink(name.c_str());
+        return false;
+    }
+
+    void* data = mmap(nullptr, sizeof(MetricsBlock), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        shm_unlink(name.c_str());
+        return false;
+    }
+
+    auto* mapped = new (data) MetricsBlock{};
+    mapped->size = sizeof(MetricsBlock);
+    mapped->pid = pid;
+    std::atomic_thread_fence(std::memory_order_release);
+    mapped->magic = MetricsBlock::magicValue;
+
+    block = mapped;
+    shared = true;
+    return true;
+#endif
+}
+
+/**
+ * @brief Odmapowuje i usuwa segment pamięci współdzielonej
+ */
+void Metrics::close() {
+#ifndef _WIN32
+    if (!shared) return;
+    auto name = segmentName(block->pid);
+    munmap(block, sizeof(MetricsBlock));
+    shm_unlink(name.c_str());
+#endif
+    block = &localBlock;
+    shared = false;
+}
@@ -0,0 +1,130 @@
+/**
+ * @file Metrics.h
+ * @brief Liczniki metryk gry udostępniane w pamięci współdzielonej.
+ */
+
+#pragma once
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Blok liczników umieszczany w nazwanym segmencie pamięci współdzielonej.
+ *
+ * Wszystkie pola są atomowe i bez blokad, więc silnik aktualizuje je zwykłym
+ * fetch_add, a zewnętrzny czytnik (Flappy_Bird_metrics) odczytuje je w dowolnej
+ * chwili bez zatrzymywania gry.
+ */
+struct MetricsBlock {
+    static constexpr std::uint32_t magicValue = 0x46424d31; /**< Sygnatura "FBM1". */
+    static constexpr std::uint32_t frameBuckets = 256; /**< Liczba przedziałów histogramu czasu klatki. */
+    static constexpr std::uint32_t bucketWidthUs = 250; /**< Szerokość przedziału histogramu w mikrosekundach. */
+
+    std::uint32_t magic; /**< Sygnatura bloku, ustawiana po inicjalizacji. */
+    std::uint32_t size; /**< Rozmiar struktury, do kontroli zgodności wersji. */
+    std::uint64_t pid; /**< Identyfikator procesu gry. */
+
+    std::atomic<std::uint64_t> frames; /**< Liczba wyrenderowanych klatek. */
+    std::atomic<std::uint64_t> frameTimeTotalUs; /**< Suma czasów klatek w mikrosekundach. */
+    std::atomic<std::uint64_t> lastFrameUs; /**< Czas ostatniej klatki w mikrosekundach. */
+    std::atomic<std::uint64_t> simTicks; /**< Liczba kroków symulacji w trakcie gry. */
+    std::atomic<std::uint64_t> restarts; /**< Liczba restartów gry. */
+    std::atomic<std::uint64_t> deathsGround; /**< Śmierci przez zderzenie z ziemią lub sufitem (system lotu EntityWorld). */
+    std::atomic<std::uint64_t> deathsPipe; /**< Śmierci przez zderzenie z rurą (system przeszkód EntityWorld). */
+    std::atomic<std::uint64_t> assetCacheHits; /**< Trafienia w pamięci podręcznej zasobów. */
+    std::atomic<std::uint64_t> assetCacheMisses; /**< Chybienia w pamięci podręcznej zasobów. */
+    std::atomic<std::uint64_t> captureFrames; /**< Klatki przekazane do nagrania (FrameCapture). */
+    std::atomic<std::uint64_t> captureDropped; /**< Klatki porzucone przez nagrywanie z braku wolnego bufora. */
+    std::atomic<std::uint64_t> timeScale; /**< Bieżące przyspieszenie gry (1 - czas rzeczywisty). */
+    std::atomic<std::uint64_t> simTicksPerSecond; /**< Kroki symulacji w ostatniej sekundzie czasu rzeczywistego. */
+    std::atomic<std::uint64_t> frameCostUs; /**< Koszt ostatniej klatki bez czekania na wyświetlenie (FrameBudget). */
+    std::atomic<std::uint64_t> frameBudgetUs; /**< Budżet czasu klatki (0 - bez ograniczeń). */
+    std::atomic<std::uint64_t> framesOverBudget; /**< Klatki, których koszt przekroczył budżet. */
+    std::atomic<std::uint64_t> qualityLevel; /**< Bieżący poziom ograniczenia pracy (FrameBudget::Level). */
+    std::atomic<std::uint64_t> qualityDrops; /**< Liczba podniesień poziomu ograniczenia. */
+    std::atomic<std::uint64_t> qualityRestores; /**< Liczba obniżeń poziomu ograniczenia. */
+    std::atomic<std::uint64_t> frameTimeHistogram[frameBuckets]; /**< Histogram czasów klatek; ostatni przedział zbiera przepełnienie. */
+};
+
+/**
+ * @brief Dostęp do bloku metryk bieżącego procesu.
+ *
+ * Segment jest tworzony raz przy starcie (Metrics::open). Kod gry korzysta
+ * wyłącznie z Metrics::get(), które zwraca referencję do już zmapowanego bloku,
+ * więc aktualizacja licznika to pojedyncza instrukcja atomowa, bez blokad
+ * i wywołań systemowych. Jeśli segmentu nie da się utworzyć, liczniki trafiają
+ * do lokalnego bloku w pamięci procesu.
+ */
+class Metrics {
+public:
+    /**
+     * @brief Tworzy i mapuje segment pamięci współdzielonej dla bieżącego procesu.
+     *
+     * @return true jeśli segment został utworzony.
+     */
+    static bool open();
+
+    /**
+     * @brief Odmapowuje i usuwa segment pamięci współdzielonej.
+     */
+    static void close();
+
+    /**
+     * @brief Zwraca blok liczników.
+     *
+     * @return Referencja do bloku liczników.
+     */
+    static MetricsBlock& get() { return *block; }
+
+    /**
+     * @brief Zwraca nazwę segmentu dla podanego procesu.
+     *
+     * @param pid Identyfikator procesu.
+     * @return Nazwa segmentu pamięci współdzielonej.
+     */
+    static std::string segmentName(std::uint64_t pid);
+
+    /**
+     * @brief Zapisuje czas klatki w licznikach i histogramie.
+     *
+     * @param frameUs Czas klatki w mikrosekundach.
+     */
+    static void recordFrame(std::uint64_t frameUs) {
+        auto& m = get();
+        m.frames.fetch_add(1, std::memory_order_relaxed);
+        m.frameTimeTotalUs.fetch_add(frameUs, std::memory_order_relaxed);
+        m.lastFrameUs.store(frameUs, std::memory_order_relaxed);
+        auto bucket = frameUs / MetricsBlock::bucketWidthUs;
+        if (bucket >= MetricsBlock::frameBuckets) bucket = MetricsBlock::frameBuckets - 1;
+        m.frameTimeHistogram[bucket].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Zwiększa licznik o jeden.
+     *
+     * @param counter Licznik z bloku metryk.
+     */
+    static void increment(std::atomic<std::uint64_t>& counter) {
+        counter.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Zwiększa licznik o podaną wartość.
+     *
+     * @param counter Licznik z bloku metryk.
+     * @param amount Przyrost.
+     */
+    static void add(std::atomic<std::uint64_t>& counter, std::uint64_t amount) {
+        counter.fetch_add(amount, std::memory_order_relaxed);
+    }
+
+private:
+    static MetricsBlock* block; /**< Aktualnie używany blok liczników. */
+    static MetricsBlock localBlock; /**< Blok zastępczy, gdy segment nie jest dostępny. */
+    static bool shared; /**< Flaga określająca, czy block wskazuje na segment współdzielony. */
+};
+
+#endif
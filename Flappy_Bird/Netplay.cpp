@@ -0,0 +1,283 @@
+/**
+ * @file Netplay.cpp
+ * @brief Implementacja sesji wyścigu z cofaniem stanu.
+ */
+
+#include "Netplay.h"
+#include <chrono>
+#include <cstring>
+
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+/**
+ * @brief Pakiet z wejściami gracza.
+ */
+struct InputPacket {
+    std::uint32_t magic; /**< Sygnatura "FBVS". */
+    std::uint32_t frame; /**< Ostatnia klatka, której wejście zawiera pakiet. */
+    std::uint32_t inputs; /**< Bit i - wejście dla klatki frame - i. */
+};
+
+const std::uint32_t packetMagic = 0x46425653;
+
+/**
+ * @brief Dołącza wartość do skrótu FNV-1a.
+ *
+ * @param hash Bieżący skrót.
+ * @param data Dane.
+ * @param size Rozmiar danych.
+ */
+void fnv(std::uint64_t& hash, const void* data, std::size_t size) {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ull;
+    }
+}
+
+}
+
+/**
+ * @brief Konstruktor klasy RollbackSession.
+ *
+ * @param localPlayer Indeks lokalnego gracza.
+ * @param seed Wspólne ziarno toru.
+ * @param difficulty Poziom trudności.
+ */
+RollbackSession::RollbackSession(int localPlayer, std::uint32_t seed, Difficulty difficulty)
+        : localPlayer(localPlayer), difficulty(difficulty), socketFd(-1), remotePort(0), peerSeen(false),
+          current{}, localInput{}, remoteInput{}, usedRemote{}, confirmedFrames(0),
+          rollbacks(0), resimulatedFrames(0), maxRollbackUs(0) {
+    for (auto& world : current.players) {
+        Simulation::reset(world, seed);
+        Simulation::start(world, rulesFor(difficulty).throat);
+    }
+    current.frame = 0;
+    for (auto& frame : remoteFrame) {
+        frame = UINT32_MAX;
+    }
+}
+
+/**
+ * @brief Destruktor klasy RollbackSession.
+ */
+RollbackSession::~RollbackSession() {
+#ifndef _WIN32
+    if (socketFd >= 0) {
+        close(socketFd);
+    }
+#endif
+}
+
+/**
+ * @brief Otwiera gniazdo UDP na adresie pętli zwrotnej.
+ *
+ * @param localPort Port lokalny.
+ * @param remotePort Port przeciwnika.
+ * @return true jeśli gniazdo zostało otwarte.
+ */
+bool RollbackSession::open(std::uint16_t localPort, std::uint16_t remotePort) {
+#ifdef _WIN32
+    return false;
+#else
+    this->remotePort = remotePort;
+    socketFd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (socketFd < 0) return false;
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(localPort);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(socketFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        close(socketFd);
+        socketFd = -1;
+        return false;
+    }
+    fcntl(socketFd, F_SETFL, fcntl(socketFd, F_GETFL, 0) | O_NONBLOCK);
+    return true;
+#endif
+}
+
+/**
+ * @brief Zwraca wejście gracza dla klatki
+ *
+ * @param frame Numer klatki
+ * @param player Indeks gracza
+ * @return Wejście gracza
+ */
+bool RollbackSession::inputFor(std::uint32_t frame, int player) const {
+    if (player == localPlayer) {
+        return localInput[frame % historySize] != 0;
+    }
+    // Machnięcie jest rzadkim impulsem, więc najlepszą predykcją jest jego brak.
+    return remoteKnown(frame) && remoteInput[frame % historySize] != 0;
+}
+
+/**
+ * @brief Wykonuje jeden krok obu światów
+ *
+ * @param state Stan wyścigu
+ * @param flap0 Wejście gracza 0
+ * @param flap1 Wejście gracza 1
+ */
+void RollbackSession::simulate(VersusState& state, bool flap0, bool flap1) const {
+    auto rules = Simulation::RuntimeRules::of(difficulty);
+    Simulation::stepWith(state.players[0], frameTime, flap0, rules);
+    Simulation::stepWith(state.players[1], frameTime, flap1, rules);
+    state.frame++;
+}
+
+/**
+ * @brief Wysyła wejścia z ostatnich 32 klatek
+ */
+void RollbackSession::send() {
+#ifndef _WIN32
+    if (socketFd < 0 || current.frame == 0) return;
+
+    InputPacket packet{};
+    packet.magic = packetMagic;
+    packet.frame = current.frame - 1;
+    for (std::uint32_t i = 0; i < 32 && i <= packet.frame; ++i) {
+        if (localInput[(packet.frame - i) % historySize]) {
+            packet.inputs |= 1u << i;
+        }
+    }
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(remotePort);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    sendto(socketFd, &packet, sizeof(packet), 0, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+#endif
+}
+
+/**
+ * @brief Odbiera pakiety przeciwnika
+ *
+ * @return Najwcześniejsza klatka z błędną predykcją lub current.frame
+ */
+std::uint32_t RollbackSession::receive() {
+    std::uint32_t earliest = current.frame;
+#ifndef _WIN32
+    if (socketFd < 0) return earliest;
+
+    InputPacket packet{};
+    while (recv(socketFd, &packet, sizeof(packet), 0) == (ssize_t)sizeof(packet)) {
+        if (packet.magic != packetMagic) continue;
+        peerSeen = true;
+        for (std::uint32_t i = 0; i < 32 && i <= packet.frame; ++i) {
+            std::uint32_t frame = packet.frame - i;
+            if (frame < confirmedFrames || remoteKnown(frame)) continue;
+
+            std::uint8_t input = (packet.inputs >> i) & 1u;
+            remoteInput[frame % historySize] = input;
+            remoteFrame[frame % historySize] = frame;
+            if (frame < current.frame && usedRemote[frame % historySize] != input && frame < earliest) {
+                earliest = frame;
+            }
+        }
+    }
+    while (remoteKnown(confirmedFrames)) {
+        confirmedFrames++;
+    }
+#endif
+    return earliest;
+}
+
+/**
+ * @brief Odbiera pakiety i cofa stan, jeśli któraś predykcja okazała się błędna
+ */
+void RollbackSession::rollbackIfNeeded() {
+    const int remotePlayer = 1 - localPlayer;
+    const std::uint32_t frame = current.frame;
+
+    std::uint32_t mispredicted = receive();
+    if (mispredicted >= frame) return;
+
+    auto start = std::chrono::steady_clock::now();
+    current = snapshots[mispredicted % historySize];
+    for (std::uint32_t f = mispredicted; f < frame; ++f) {
+        snapshots[f % historySize] = current;
+        bool remote = inputFor(f, remotePlayer);
+        usedRemote[f % historySize] = remote;
+        bool local = inputFor(f, localPlayer);
+        simulate(current, localPlayer == 0 ? local : remote, localPlayer == 0 ? remote : local);
+    }
+    auto us = (std::uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    if (us > maxRollbackUs) maxRollbackUs = us;
+    rollbacks++;
+    resimulatedFrames += frame - mispredicted;
+}
+
+/**
+ * @brief Odbiera pakiety i wysyła wejścia bez wykonywania nowej klatki
+ */
+void RollbackSession::poll() {
+    rollbackIfNeeded();
+    send();
+}
+
+/**
+ * @brief Wysyła wejścia, odbiera pakiety i wykonuje jedną klatkę
+ *
+ * @param localFlap Wejście lokalnego gracza
+ * @return true jeśli klatka została wykonana
+ */
+bool RollbackSession::advance(bool localFlap) {
+    rollbackIfNeeded();
+
+    const std::uint32_t frame = current.frame;
+    if (frame >= confirmedFrames + maxRollback) {
+        send();
+        return false;
+    }
+
+    localInput[frame % historySize] = localFlap ? 1 : 0;
+    snapshots[frame % historySize] = current;
+    bool remote = inputFor(frame, 1 - localPlayer);
+    usedRemote[frame % historySize] = remote;
+    simulate(current, localPlayer == 0 ? localFlap : remote, localPlayer == 0 ? remote : localFlap);
+    send();
+    return true;
+}
+
+/**
+ * @brief Zwraca sumę kontrolną stanu
+ *
+ * Pola są haszowane pojedynczo, żeby wypełnienie struktur nie wpływało na wynik.
+ *
+ * @param state Stan wyścigu
+ * @return Skrót FNV-1a
+ */
+std::uint64_t RollbackSession::checksum(const VersusState& state) {
+    std::uint64_t hash = 0xcbf29ce484222325ull;
+    fnv(hash, &state.frame, sizeof(state.frame));
+    for (const auto& w : state.players) {
+        fnv(hash, &w.birdY, sizeof(w.birdY));
+        fnv(hash, &w.birdVel, sizeof(w.birdVel));
+        fnv(hash, &w.pipeCount, sizeof(w.pipeCount));
+        for (int i = 0; i < w.pipeCount; ++i) {
+            const auto& p = w.pipes[i];
+            fnv(hash, &p.x, sizeof(p.x));
+            fnv(hash, &p.y, sizeof(p.y));
+            fnv(hash, &p.throat, sizeof(p.throat));
+            fnv(hash, &p.scored, sizeof(p.scored));
+            fnv(hash, &p.coinVisible, sizeof(p.coinVisible));
+        }
+        fnv(hash, &w.score, sizeof(w.score));
+        fnv(hash, &w.ticks, sizeof(w.ticks));
+        fnv(hash, &w.rng, sizeof(w.rng));
+        fnv(hash, &w.spawnTimer, sizeof(w.spawnTimer));
+        fnv(hash, &w.running, sizeof(w.running));
+        fnv(hash, &w.over, sizeof(w.over));
+    }
+    return hash;
+}
@@ -0,0 +1,205 @@
+/**
+ * @file Netplay.h
+ * @brief Tryb wyścigu dwóch graczy przez UDP z cofaniem stanu (rollback).
+ */
+
+#pragma once
+#ifndef NETPLAY_H
+#define NETPLAY_H
+
+#include <cstdint>
+#include "Difficulty.h"
+#include "Simulation.h"
+
+/**
+ * @brief Stan wyścigu: dwa ptaki na tym samym torze.
+ *
+ * Każdy gracz ma własny świat, ale oba światy startują z tym samym ziarnem,
+ * więc rury są identyczne. Stan nie zawiera wskaźników - migawka to kopia struktury.
+ */
+struct VersusState {
+    World players[2]; /**< Światy graczy. */
+    std::uint32_t frame; /**< Numer klatki, którą symulacja wykona jako następną. */
+};
+
+/**
+ * @brief Sesja wyścigu z przewidywaniem wejścia przeciwnika i cofaniem stanu.
+ *
+ * Każda klatka symulacji ma stały krok 1/60 s. Wejście lokalnego gracza jest
+ * stosowane od razu, a wejście przeciwnika, jeśli jeszcze nie dotarło, jest
+ * przewidywane jako "brak machnięcia". Gdy spóźniony pakiet pokaże inne wejście,
+ * sesja przywraca migawkę z klatki błędnej predykcji i symuluje ponownie do
+ * bieżącej klatki (najwyżej maxRollback klatek). Jeśli przeciwnik jest opóźniony
+ * o więcej niż maxRollback klatek, sesja czeka na jego pakiety.
+ *
+ * Każdy pakiet niesie wejścia z ostatnich 32 klatek, więc zgubione pakiety nie
+ * wymagają ponownego wysyłania.
+ */
+class RollbackSession {
+public:
+    static constexpr std::uint32_t maxRollback = 8; /**< Największe dopuszczalne cofnięcie, w klatkach. */
+    static constexpr std::uint32_t historySize = 64; /**< Rozmiar bufora historii (potęga dwójki). */
+    static constexpr float frameTime = 1.0f / 60.0f; /**< Krok symulacji w sekundach. */
+
+    /**
+     * @brief Konstruktor klasy RollbackSession.
+     *
+     * @param localPlayer Indeks lokalnego gracza (0 lub 1).
+     * @param seed Wspólne ziarno toru.
+     * @param difficulty Poziom trudności.
+     */
+    RollbackSession(int localPlayer, std::uint32_t seed, Difficulty difficulty);
+
+    /**
+     * @brief Destruktor klasy RollbackSession. Zamyka gniazdo.
+     */
+    ~RollbackSession();
+
+    RollbackSession(const RollbackSession&) = delete;
+    RollbackSession& operator=(const RollbackSession&) = delete;
+
+    /**
+     * @brief Otwiera gniazdo UDP na adresie pętli zwrotnej.
+     *
+     * @param localPort Port, na którym sesja odbiera pakiety.
+     * @param remotePort Port przeciwnika.
+     * @return true jeśli gniazdo zostało otwarte.
+     */
+    bool open(std::uint16_t localPort, std::uint16_t remotePort);
+
+    /**
+     * @brief Wysyła wejścia, odbiera pakiety przeciwnika i - jeśli to możliwe - wykonuje jedną klatkę.
+     *
+     * @param localFlap Czy lokalny gracz macha skrzydłami w tej klatce.
+     * @return true jeśli klatka została wykonana, false jeśli sesja czeka na przeciwnika.
+     */
+    bool advance(bool localFlap);
+
+    /**
+     * @brief Odbiera pakiety (cofając stan w razie potrzeby) i ponawia wysłanie wejść, bez nowej klatki.
+     *
+     * Służy do dokończenia wymiany wejść po ostatniej klatce wyścigu.
+     */
+    void poll();
+
+    /**
+     * @brief Zwraca liczbę początkowych klatek, dla których znane jest wejście przeciwnika.
+     *
+     * @return Liczba potwierdzonych klatek.
+     */
+    std::uint32_t getConfirmedFrames() const { return confirmedFrames; }
+
+    /**
+     * @brief Sprawdza, czy otrzymano już jakikolwiek pakiet od przeciwnika.
+     *
+     * @return true jeśli przeciwnik jest połączony.
+     */
+    bool connected() const { return peerSeen; }
+
+    /**
+     * @brief Zwraca bieżący stan wyścigu.
+     *
+     * @return Stan wyścigu.
+     */
+    const VersusState& getState() const { return current; }
+
+    /**
+     * @brief Zwraca indeks lokalnego gracza.
+     *
+     * @return Indeks gracza (0 lub 1).
+     */
+    int getLocalPlayer() const { return localPlayer; }
+
+    /**
+     * @brief Zwraca liczbę wykonanych cofnięć stanu.
+     *
+     * @return Liczba cofnięć.
+     */
+    std::uint64_t getRollbacks() const { return rollbacks; }
+
+    /**
+     * @brief Zwraca łączną liczbę klatek symulowanych ponownie.
+     *
+     * @return Liczba klatek.
+     */
+    std::uint64_t getResimulatedFrames() const { return resimulatedFrames; }
+
+    /**
+     * @brief Zwraca najdłuższy czas pojedynczego cofnięcia (przywrócenie i ponowna symulacja).
+     *
+     * @return Czas w mikrosekundach.
+     */
+    std::uint64_t getMaxRollbackUs() const { return maxRollbackUs; }
+
+    /**
+     * @brief Zwraca sumę kontrolną stanu, do porównania między procesami.
+     *
+     * @param state Stan wyścigu.
+     * @return 64-bitowy skrót FNV-1a.
+     */
+    static std::uint64_t checksum(const VersusState& state);
+
+private:
+    /**
+     * @brief Wykonuje jeden krok obu światów.
+     *
+     * @param state Stan wyścigu.
+     * @param flap0 Wejście gracza 0.
+     * @param flap1 Wejście gracza 1.
+     */
+    void simulate(VersusState& state, bool flap0, bool flap1) const;
+
+    /**
+     * @brief Odbiera pakiety i cofa stan, jeśli któraś predykcja okazała się błędna.
+     */
+    void rollbackIfNeeded();
+
+    /**
+     * @brief Wysyła wejścia z ostatnich 32 klatek.
+     */
+    void send();
+
+    /**
+     * @brief Odbiera pakiety przeciwnika.
+     *
+     * @return Najwcześniejsza klatka z błędną predykcją lub current.frame, gdy takiej nie ma.
+     */
+    std::uint32_t receive();
+
+    /**
+     * @brief Sprawdza, czy wejście przeciwnika dla klatki jest znane.
+     *
+     * @param frame Numer klatki.
+     * @return true jeśli wejście dotarło.
+     */
+    bool remoteKnown(std::uint32_t frame) const { return remoteFrame[frame % historySize] == frame; }
+
+    /**
+     * @brief Zwraca wejście gracza dla klatki (znane lub przewidziane).
+     *
+     * @param frame Numer klatki.
+     * @param player Indeks gracza.
+     * @return Wejście gracza.
+     */
+    bool inputFor(std::uint32_t frame, int player) const;
+
+    int localPlayer; /**< Indeks lokalnego gracza. */
+    Difficulty difficulty; /**< Poziom trudności wyścigu. */
+    int socketFd; /**< Deskryptor gniazda UDP. */
+    std::uint16_t remotePort; /**< Port przeciwnika. */
+    bool peerSeen; /**< Czy dotarł już pakiet od przeciwnika. */
+
+    VersusState current; /**< Bieżący stan wyścigu. */
+    VersusState snapshots[historySize]; /**< Stany sprzed symulacji kolejnych klatek. */
+    std::uint8_t localInput[historySize]; /**< Wejścia lokalnego gracza. */
+    std::uint8_t remoteInput[historySize]; /**< Otrzymane wejścia przeciwnika. */
+    std::uint32_t remoteFrame[historySize]; /**< Numer klatki, której dotyczy remoteInput w danym slocie. */
+    std::uint8_t usedRemote[historySize]; /**< Wejście przeciwnika użyte przy symulacji klatki. */
+    std::uint32_t confirmedFrames; /**< Liczba początkowych klatek z pełną wiedzą o wejściu przeciwnika. */
+
+    std::uint64_t rollbacks; /**< Liczba cofnięć stanu. */
+    std::uint64_t resimulatedFrames; /**< Liczba klatek symulowanych ponownie. */
+    std::uint64_t maxRollbackUs; /**< Najdłuższe cofnięcie w mikrosekundach. */
+};
+
+#endif
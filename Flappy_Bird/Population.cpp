@@ -0,0 +1,118 @@
+/**
+ * @file Population.cpp
+ * @brief Implementacja klasy Population.
+ */
+
+#include "Population.h"
+#include <cmath>
+
+/**
+ * @brief Konstruktor klasy Population.
+ *
+ * @param capacity Spodziewana liczba ptaków.
+ */
+Population::Population(std::size_t capacity) : atlas(BirdAtlas::get()) {
+    xs.reserve(capacity);
+    ys.reserve(capacity);
+    vels.reserve(capacity);
+    phases.reserve(capacity);
+    skins.reserve(capacity);
+    visibility.reserve(capacity);
+    vertices.reserve(capacity * 4);
+}
+
+/**
+ * @brief Dodaje ptaka do populacji.
+ *
+ * @param skin Model gracza.
+ * @param x Pozycja X ptaka.
+ * @param y Pozycja Y ptaka.
+ * @param vel Prędkość pionowa ptaka.
+ * @param phase Początkowa faza animacji.
+ * @return Indeks dodanego ptaka.
+ */
+std::size_t Population::add(PlayerModel skin, float x, float y, float vel, float phase) {
+    xs.push_back(x);
+    ys.push_back(y);
+    vels.push_back(vel);
+    phases.push_back(phase);
+    skins.push_back(static_cast<std::uint8_t>(skin));
+    visibility.push_back(true);
+    return ys.size() - 1;
+}
+
+/**
+ * @brief Przesuwa fazę animacji wszystkich ptaków.
+ *
+ * @param delta Czas od ostatniej aktualizacji.
+ */
+void Population::animate(float delta) {
+    const float step = delta * 4;
+    for (auto& phase : phases) {
+        phase += step;
+        while (phase >= BirdAtlas::animationFrames) {
+            phase -= BirdAtlas::animationFrames;
+        }
+    }
+}
+
+/**
+ * @brief Rysuje wszystkie widoczne ptaki jednym wywołaniem draw.
+ *
+ * Wierzchołki są liczone na CPU: narożniki klatki są obracane wokół lewego
+ * górnego rogu (tak jak sf::Sprite z domyślnym punktem odniesienia w Engine::drawBird)
+ * i przesuwane na pozycję ptaka.
+ *
+ * @param target Cel renderowania.
+ */
+void Population::draw(sf::RenderTarget& target) {
+    const auto size = atlas.getFrameSize();
+    const float w = (float)size.x;
+    const float h = (float)size.y;
+    const float degToRad = 3.14159265f / 180.0f;
+
+    vertices.resize(ys.size() * 4);
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < ys.size(); ++i) {
+        if (!visibility[i]) continue;
+
+        const float angle = 8 * (vels[i] / 400) * degToRad;
+        const float c = std::cos(angle);
+        const float s = std::sin(angle);
+        const float x = xs[i];
+        const float y = ys[i];
+
+        const auto rect = atlas.getFrameRect(static_cast<PlayerModel>(skins[i]), (int)phases[i]);
+        const float u0 = (float)rect.left;
+        const float v0 = (float)rect.top;
+        const float u1 = u0 + (float)rect.width;
+        const float v1 = v0 + (float)rect.height;
+
+        sf::Vertex* quad = &vertices[count * 4];
+        quad[0].position = {x, y};
+        quad[1].position = {x + w * c, y + w * s};
+        quad[2].position = {x + w * c - h * s, y + w * s + h * c};
+        quad[3].position = {x - h * s, y + h * c};
+        quad[0].texCoords = {u0, v0};
+        quad[1].texCoords = {u1, v0};
+        quad[2].texCoords = {u1, v1};
+        quad[3].texCoords = {u0, v1};
+        ++count;
+    }
+
+    if (count == 0) return;
+    sf::RenderStates states(&atlas.getTexture());
+    target.draw(vertices.data(), count * 4, sf::Quads, states);
+}
+
+/**
+ * @brief Usuwa wszystkie ptaki z populacji.
+ */
+void Population::clear() {
+    xs.clear();
+    ys.clear();
+    vels.clear();
+    phases.clear();
+    skins.clear();
+    visibility.clear();
+}
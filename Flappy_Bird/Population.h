@@ -0,0 +1,100 @@
+/**
+ * @file Population.h
+ * @brief Definicja klasy Population - wsadowego rysowania wielu ptaków.
+ */
+
+#pragma once
+#ifndef POPULATION_H
+#define POPULATION_H
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+#include "BirdAtlas.h"
+#include "PlayerModel.h"
+
+/**
+ * @brief Populacja ptaków rysowana jednym wywołaniem draw.
+ *
+ * Stan ptaków jest przechowywany w osobnych tablicach (pozycja, prędkość,
+ * faza animacji, model), a nie w osobnych obiektach ptaków. Przy rysowaniu wszystkie ptaki
+ * trafiają do jednej tablicy wierzchołków z teksturą BirdAtlas, z obrotem
+ * 8 * vel / 400 i klatką animacji liczonymi osobno dla każdego ptaka.
+ * Służy do podglądu populacji treningowych i powtórek wielu przejść naraz.
+ */
+class Population {
+public:
+    /**
+     * @brief Konstruktor klasy Population.
+     *
+     * @param capacity Spodziewana liczba ptaków, dla której rezerwowana jest pamięć.
+     */
+    explicit Population(std::size_t capacity = 0);
+
+    /**
+     * @brief Dodaje ptaka do populacji.
+     *
+     * @param skin Model gracza.
+     * @param x Pozycja X ptaka.
+     * @param y Pozycja Y ptaka.
+     * @param vel Prędkość pionowa ptaka.
+     * @param phase Początkowa faza animacji, z zakresu [0, BirdAtlas::animationFrames).
+     * @return Indeks dodanego ptaka.
+     */
+    std::size_t add(PlayerModel skin, float x, float y, float vel = 0, float phase = 0);
+
+    /**
+     * @brief Ustawia pozycję i prędkość ptaka, np. z zewnętrznej symulacji.
+     *
+     * @param idx Indeks ptaka.
+     * @param y Pozycja Y ptaka.
+     * @param vel Prędkość pionowa ptaka.
+     */
+    void set(std::size_t idx, float y, float vel) { ys[idx] = y; vels[idx] = vel; }
+
+    /**
+     * @brief Ustawia widoczność ptaka (np. po jego śmierci).
+     *
+     * @param idx Indeks ptaka.
+     * @param visible Nowa widoczność.
+     */
+    void setVisible(std::size_t idx, bool visible) { visibility[idx] = visible; }
+
+    /**
+     * @brief Przesuwa fazę animacji wszystkich ptaków.
+     *
+     * @param delta Czas od ostatniej aktualizacji.
+     */
+    void animate(float delta);
+
+    /**
+     * @brief Rysuje wszystkie widoczne ptaki jednym wywołaniem draw.
+     *
+     * @param target Cel renderowania.
+     */
+    void draw(sf::RenderTarget& target);
+
+    /**
+     * @brief Usuwa wszystkie ptaki z populacji.
+     */
+    void clear();
+
+    /**
+     * @brief Zwraca liczbę ptaków w populacji.
+     *
+     * @return Liczba ptaków.
+     */
+    std::size_t size() const { return ys.size(); }
+
+private:
+    const BirdAtlas& atlas; /**< Wspólny atlas klatek animacji. */
+    std::vector<float> xs; /**< Pozycje X ptaków. */
+    std::vector<float> ys; /**< Pozycje Y ptaków. */
+    std::vector<float> vels; /**< Prędkości pionowe ptaków. */
+    std::vector<float> phases; /**< Fazy animacji ptaków. */
+    std::vector<std::uint8_t> skins; /**< Modele graczy. */
+    std::vector<std::uint8_t> visibility; /**< Flagi widoczności ptaków. */
+    std::vector<sf::Vertex> vertices; /**< Bufor wierzchołków wsadu (4 na ptaka). */
+};
+
+#endif
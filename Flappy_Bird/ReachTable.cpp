@@ -0,0 +1,159 @@
+/**
+ * @file ReachTable.cpp
+ * @brief Implementacja wczytywania tablicy osiągalności i decyzji autopilota.
+ */
+
+#include "ReachTable.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const char reachMagic[8] = {'F', 'B', 'R', 'E', 'A', 'C', 'H', '1'};
+constexpr std::uint64_t tableAlignment = 4096; /**< Wyrównanie tablic w pliku, do granicy strony. */
+
+/**
+ * @brief Sprawdza, czy nagłówek pasuje do siatki stanów tej wersji gry.
+ */
+bool validHeader(const ReachHeader& header, std::uint64_t fileSize) {
+    if (std::memcmp(header.magic, reachMagic, sizeof(reachMagic)) != 0) return false;
+    if (header.tables != ReachTable::tables || header.ticks != ReachTable::periodTicks ||
+        header.velocities != ReachTable::velocities || header.heights != ReachTable::heights ||
+        header.tableBytes != ReachTable::tableBytes) {
+        return false;
+    }
+    for (int i = 0; i < ReachTable::tables; ++i) {
+        if (header.offsets[i] > fileSize || fileSize - header.offsets[i] < header.tableBytes) return false;
+    }
+    return true;
+}
+
+}
+
+/**
+ * @brief Konstruktor klasy ReachTable
+ *
+ * @param path Ścieżka do pliku
+ */
+ReachTable::ReachTable(const std::string& path) : open(false), throats{}, bits{} {
+    ReachHeader header{};
+#ifdef _WIN32
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) return;
+    _fseeki64(file, 0, SEEK_END);
+    buffer.resize((std::size_t)_ftelli64(file));
+    _fseeki64(file, 0, SEEK_SET);
+    bool read = std::fread(buffer.data(), 1, buffer.size(), file) == buffer.size();
+    std::fclose(file);
+    if (!read || buffer.size() < sizeof(header)) return;
+    const std::uint8_t* base = buffer.data();
+    std::uint64_t size = buffer.size();
+#else
+    data = nullptr;
+    mappedSize = 0;
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return;
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || (std::size_t)st.st_size < sizeof(header)) {
+        close(fd);
+        return;
+    }
+    void* mapped = mmap(nullptr, (std::size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) return;
+    data = mapped;
+    mappedSize = (std::size_t)st.st_size;
+    const auto* base = static_cast<const std::uint8_t*>(data);
+    std::uint64_t size = mappedSize;
+#endif
+    std::memcpy(&header, base, sizeof(header));
+    if (!validHeader(header, size)) return;
+    for (int i = 0; i < tables; ++i) {
+        throats[i] = header.throats[i];
+        bits[i] = base + header.offsets[i];
+    }
+    open = true;
+}
+
+/**
+ * @brief Destruktor klasy ReachTable
+ */
+ReachTable::~ReachTable() {
+#ifndef _WIN32
+    if (data) munmap(data, mappedSize);
+#endif
+}
+
+/**
+ * @brief Decyduje o machnięciu w bieżącym kroku
+ *
+ * @param world Świat
+ * @param flap Decyzja
+ * @return false, gdy stanu nie ma w tablicy
+ */
+bool ReachTable::decide(const World& world, bool& flap) const {
+    if (!open || !world.running || world.over) return false;
+    int next = Simulation::nextPipe(world);
+    if (next < 0) return false;
+    const PipeState& pipe = world.pipes[next];
+
+    const std::uint8_t* table = nullptr;
+    for (int i = 0; i < tables; ++i) {
+        if (std::fabs(pipe.throat - throats[i]) < 0.01f) table = bits[i];
+    }
+    // Tablica zakłada wysokości i odstępy rur toru generowanego.
+    if (!table || pipe.y < Physics::pipeY(0) - 0.5f || pipe.y > Physics::pipeY(Physics::pipeHeights - 1) + 0.5f) return false;
+    if (next + 1 < world.pipeCount && std::fabs(world.pipes[next + 1].x - pipe.x - spacing) > 2) return false;
+
+    // Przed pierwszą rurą stan odpowiada rurze oddalonej o pełne okresy, z wyobrażoną rurą wcześniej.
+    int tick = (int)((pipe.x + Physics::pipeWidth - Physics::birdX) / stepDistance) % periodTicks;
+    int velocity = (int)std::lround((world.birdVel - velocityMin) / velocityStep);
+    float height = std::floor((world.birdY - pipe.y - heightMin) / heightStep);
+    if (velocity < 0 || velocity >= velocities || height < 0 || height >= (float)heights) return false;
+
+    std::size_t bit = bitOf(tick, velocity, (int)height);
+    flap = (table[bit >> 3] >> (bit & 7)) & 1;
+    return true;
+}
+
+/**
+ * @brief Zapisuje tablice do pliku
+ *
+ * @param path Ścieżka do pliku
+ * @param bits Tablice w kolejności poziomów trudności
+ * @return true jeśli zapis się udał
+ */
+bool ReachTable::write(const std::string& path, const std::vector<std::uint8_t> bits[tables]) {
+    ReachHeader header{};
+    std::memcpy(header.magic, reachMagic, sizeof(reachMagic));
+    header.tables = tables;
+    header.ticks = periodTicks;
+    header.velocities = velocities;
+    header.heights = heights;
+    header.tableBytes = tableBytes;
+    const std::uint64_t stride = (tableBytes + tableAlignment - 1) / tableAlignment * tableAlignment;
+    for (int i = 0; i < tables; ++i) {
+        if (bits[i].size() != tableBytes) return false;
+        header.throats[i] = rulesFor(static_cast<Difficulty>(i)).throat;
+        header.offsets[i] = tableAlignment + (std::uint64_t)i * stride;
+    }
+
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) return false;
+    std::vector<std::uint8_t> padding(tableAlignment, 0);
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+              std::fwrite(padding.data(), 1, tableAlignment - sizeof(header), file) == tableAlignment - sizeof(header);
+    for (int i = 0; i < tables && ok; ++i) {
+        ok = std::fwrite(bits[i].data(), 1, tableBytes, file) == tableBytes &&
+             std::fwrite(padding.data(), 1, stride - tableBytes, file) == stride - tableBytes;
+    }
+    return std::fclose(file) == 0 && ok;
+}
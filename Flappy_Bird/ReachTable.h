@@ -0,0 +1,136 @@
+/**
+ * @file ReachTable.h
+ * @brief Tablica osiągalności: decyzje autopilota policzone z góry i wczytywane z pliku.
+ */
+
+#pragma once
+#ifndef REACHTABLE_H
+#define REACHTABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Difficulty.h"
+#include "DifficultyRules.h"
+#include "Simulation.h"
+
+/**
+ * @brief Nagłówek pliku tablicy osiągalności.
+ */
+struct ReachHeader {
+    char magic[8]; /**< Sygnatura pliku "FBREACH1". */
+    std::uint32_t tables; /**< Liczba tablic (po jednej na poziom trudności). */
+    std::uint32_t ticks; /**< Liczba kroków w okresie rur. */
+    std::uint32_t velocities; /**< Liczba prędkości. */
+    std::uint32_t heights; /**< Liczba przedziałów wysokości. */
+    std::uint64_t tableBytes; /**< Rozmiar jednej tablicy w bajtach. */
+    float throats[4]; /**< Gardło rur każdej tablicy. */
+    std::uint64_t offsets[4]; /**< Przesunięcie każdej tablicy w pliku. */
+};
+
+static_assert(sizeof(ReachHeader) == 80, "ReachHeader musi miec staly rozmiar w pliku");
+
+/**
+ * @brief Decyzje autopilota dla każdego stanu ptaka względem najbliższej rury.
+ *
+ * Stan to liczba kroków do minięcia najbliższej rury (modulo okres rur, 210 kroków
+ * po 1/60 s), prędkość ptaka i jego wysokość względem rury. Przy stałym kroku
+ * prędkość zmienia się o równe 20 px/s, więc oś prędkości jest dokładna; wysokość
+ * jest dzielona na przedziały po 2 px. Zakres wysokości obejmuje gardło rury
+ * przesunięte o największą zmianę wysokości kolejnej rury (200 px); sufit i ziemia
+ * zależą od wysokości rury i nie są częścią stanu - ptak prowadzony tablicą trzyma
+ * się z dala od nich (ponad 80 px), co sprawdza Flappy_Bird_reach check.
+ *
+ * Tablicę liczy z góry Flappy_Bird_reach: bit stanu mówi, czy machnąć, tak żeby
+ * ptak pozostał w zbiorze stanów, z których da się przetrwać dowolnie długo
+ * niezależnie od wysokości kolejnych rur. Jedna tablica ma ok. 480 KiB, więc
+ * mieści się w pamięci podręcznej L2, a decyzja to jeden odczyt bitu.
+ *
+ * Plik jest mapowany do pamięci (mmap) tylko do odczytu; na Windows jest czytany
+ * do bufora. Decyzje są dokładne przy stałym kroku 1/60 s (przyspieszona gra,
+ * symulacja bez okna); przy zmiennym czasie klatki są przybliżeniem.
+ */
+class ReachTable {
+public:
+    static constexpr float stepTime = 1.0f / 60.0f; /**< Krok symulacji, dla którego liczona jest tablica. */
+    static constexpr float stepDistance = Physics::pipeSpeed * stepTime; /**< Przesunięcie rury w jednym kroku. */
+    static constexpr float spacing = 350; /**< Odstęp rur toru generowanego (spawnInterval razy pipeSpeed). */
+    static constexpr int periodTicks = 210; /**< Liczba kroków między kolejnymi rurami. */
+    static constexpr int velocities = 64; /**< Liczba prędkości w tablicy. */
+    static constexpr float velocityMin = Physics::flapVelocity + Physics::gravity * stepTime; /**< Prędkość po kroku z machnięciem. */
+    static constexpr float velocityStep = Physics::gravity * stepTime; /**< Przyrost prędkości w kroku. */
+    static constexpr float heightStep = 2; /**< Wysokość przedziału w pikselach. */
+    static constexpr float heightMin = -80; /**< Najmniejsza wysokość ptaka względem rury. */
+    static constexpr float heightMax = 500; /**< Największa wysokość ptaka względem rury. */
+    static constexpr int heights = (int)((heightMax - heightMin) / heightStep); /**< Liczba przedziałów wysokości. */
+    static constexpr std::size_t tableBits = (std::size_t)periodTicks * velocities * heights; /**< Liczba stanów jednej tablicy. */
+    static constexpr std::size_t tableBytes = (tableBits + 7) / 8; /**< Rozmiar jednej tablicy. */
+    static constexpr int tables = 4; /**< Liczba tablic (poziomów trudności). */
+
+    /**
+     * @brief Zwraca numer bitu stanu.
+     *
+     * @param tick Liczba kroków do minięcia rury, [0, periodTicks).
+     * @param velocity Numer prędkości, [0, velocities).
+     * @param height Numer przedziału wysokości, [0, heights).
+     * @return Numer bitu w tablicy.
+     */
+    static std::size_t bitOf(int tick, int velocity, int height) {
+        return ((std::size_t)tick * velocities + (std::size_t)velocity) * heights + (std::size_t)height;
+    }
+
+    /**
+     * @brief Konstruktor klasy ReachTable. Otwiera i sprawdza plik tablicy.
+     *
+     * @param path Ścieżka do pliku.
+     */
+    explicit ReachTable(const std::string& path);
+
+    /**
+     * @brief Destruktor klasy ReachTable.
+     */
+    ~ReachTable();
+
+    ReachTable(const ReachTable&) = delete;
+    ReachTable& operator=(const ReachTable&) = delete;
+
+    /**
+     * @brief Sprawdza, czy tablica została poprawnie wczytana.
+     *
+     * @return true jeśli można podejmować decyzje.
+     */
+    bool isOpen() const { return open; }
+
+    /**
+     * @brief Decyduje o machnięciu w bieżącym kroku.
+     *
+     * @param world Świat.
+     * @param flap Decyzja.
+     * @return false, gdy stanu nie ma w tablicy (gra nie trwa, tor nie jest generowany
+     *         albo ptak jest poza zakresem) - wtedy trzeba zdecydować inaczej.
+     */
+    bool decide(const World& world, bool& flap) const;
+
+    /**
+     * @brief Zapisuje tablice do pliku.
+     *
+     * @param path Ścieżka do pliku.
+     * @param bits Tablice w kolejności poziomów trudności, każda po tableBytes bajtów.
+     * @return true jeśli zapis się udał.
+     */
+    static bool write(const std::string& path, const std::vector<std::uint8_t> bits[tables]);
+
+private:
+    bool open; /**< Czy plik jest poprawnie wczytany. */
+    float throats[tables]; /**< Gardło rur każdej tablicy. */
+    const std::uint8_t* bits[tables]; /**< Początki tablic. */
+#ifdef _WIN32
+    std::vector<std::uint8_t> buffer; /**< Wczytany plik. */
+#else
+    void* data; /**< Zmapowany plik. */
+    std::size_t mappedSize; /**< Rozmiar mapowania. */
+#endif
+};
+
+#endif
@@ -0,0 +1,213 @@
+/**
+ * @file RunLog.cpp
+ * @brief Implementacja zapisu i odczytu rozgrywek.
+ */
+
+#include "RunLog.h"
+#include <cstring>
+
+namespace {
+
+const char runMagic[8] = {'F', 'B', 'R', 'U', 'N', 'S', '0', '1'};
+const std::uint32_t maxFlapBytes = 64u << 20; /**< Większy zapis machnięć jest traktowany jako uszkodzenie. */
+
+}
+
+/**
+ * @brief Koduje chwile machnięć
+ *
+ * @param flaps Rosnące numery kroków
+ * @param count Liczba machnięć
+ * @param out Bufor wyjściowy
+ */
+void RunLog::encode(const std::uint32_t* flaps, std::size_t count, std::vector<std::uint8_t>& out) {
+    std::uint32_t previous = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        std::uint32_t delta = flaps[i] - previous;
+        previous = flaps[i];
+        while (delta >= 0x80) {
+            out.push_back((std::uint8_t)(delta | 0x80));
+            delta >>= 7;
+        }
+        out.push_back((std::uint8_t)delta);
+    }
+}
+
+/**
+ * @brief Dekoduje chwile machnięć
+ *
+ * @param data Zakodowane bajty
+ * @param size Liczba bajtów
+ * @param count Oczekiwana liczba machnięć
+ * @param flaps Wynik
+ * @return false jeśli dane są uszkodzone
+ */
+bool RunLog::decode(const std::uint8_t* data, std::size_t size, std::uint32_t count, std::vector<std::uint32_t>& flaps) {
+    flaps.clear();
+    if (count > size) return false;
+    flaps.reserve(count);
+    std::size_t pos = 0;
+    std::uint64_t tick = 0;
+    for (std::uint32_t i = 0; i < count; ++i) {
+        std::uint64_t delta = 0;
+        for (int shift = 0;; shift += 7) {
+            if (pos == size || shift > 28) return false;
+            std::uint8_t byte = data[pos++];
+            delta |= (std::uint64_t)(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) break;
+        }
+        // Pierwsze machnięcie może być w kroku 0, każde następne w późniejszym kroku.
+        if (i > 0 && delta == 0) return false;
+        tick += delta;
+        if (tick > UINT32_MAX) return false;
+        flaps.push_back((std::uint32_t)tick);
+    }
+    return pos == size;
+}
+
+/**
+ * @brief Konstruktor klasy RunWriter
+ *
+ * @param path Ścieżka pliku
+ */
+RunWriter::RunWriter(const std::string& path) : file(std::fopen(path.c_str(), "ab")) {
+    if (!file) return;
+    std::fseek(file, 0, SEEK_END);
+    if (std::ftell(file) == 0) {
+        std::fwrite(runMagic, 1, sizeof(runMagic), file);
+    }
+    encoded.reserve(4096);
+}
+
+/**
+ * @brief Destruktor klasy RunWriter
+ */
+RunWriter::~RunWriter() {
+    if (file) {
+        std::fclose(file);
+    }
+}
+
+/**
+ * @brief Dopisuje rozgrywkę
+ *
+ * @param seed Ziarno toru
+ * @param difficulty Poziom trudności
+ * @param skin Model gracza
+ * @param score Wynik
+ * @param ticks Krok końca gry
+ * @param flaps Chwile machnięć
+ */
+void RunWriter::append(std::uint64_t seed, Difficulty difficulty, PlayerModel skin, std::uint32_t score,
+                       std::uint32_t ticks, const std::vector<std::uint32_t>& flaps) {
+    if (!file) return;
+    encoded.clear();
+    RunLog::encode(flaps.data(), flaps.size(), encoded);
+    RunRecord run{};
+    run.seed = seed;
+    run.score = score;
+    run.ticks = ticks;
+    run.flapCount = (std::uint32_t)flaps.size();
+    run.flapBytes = (std::uint32_t)encoded.size();
+    run.difficulty = static_cast<std::uint8_t>(difficulty);
+    run.skin = static_cast<std::uint8_t>(skin);
+    std::fwrite(&run, sizeof(run), 1, file);
+    std::fwrite(encoded.data(), 1, encoded.size(), file);
+}
+
+/**
+ * @brief Zapisuje bufor stdio do pliku
+ */
+void RunWriter::flush() {
+    if (file) {
+        std::fflush(file);
+    }
+}
+
+/**
+ * @brief Konstruktor klasy RunReader
+ *
+ * @param path Ścieżka pliku
+ * @param bufferSize Rozmiar bufora odczytu
+ */
+RunReader::RunReader(const std::string& path, std::size_t bufferSize)
+        : file(std::fopen(path.c_str(), "rb")), buffer(bufferSize < 4096 ? 4096 : bufferSize), begin(0), end(0), corrupt(false) {
+    if (!file) return;
+    if (!fill(sizeof(runMagic)) || std::memcmp(buffer.data(), runMagic, sizeof(runMagic)) != 0) {
+        std::fclose(file);
+        file = nullptr;
+        return;
+    }
+    begin += sizeof(runMagic);
+}
+
+/**
+ * @brief Destruktor klasy RunReader
+ */
+RunReader::~RunReader() {
+    if (file) {
+        std::fclose(file);
+    }
+}
+
+/**
+ * @brief Zapewnia, że w buforze jest co najmniej size nieprzeczytanych bajtów
+ *
+ * @param size Potrzebna liczba bajtów
+ * @return false jeśli plik skończył się wcześniej
+ */
+bool RunReader::fill(std::size_t size) {
+    if (end - begin >= size) return true;
+    std::memmove(buffer.data(), buffer.data() + begin, end - begin);
+    end -= begin;
+    begin = 0;
+    if (buffer.size() < size) {
+        buffer.resize(size);
+    }
+    while (end < size) {
+        std::size_t got = std::fread(buffer.data() + end, 1, buffer.size() - end, file);
+        if (got == 0) return false;
+        end += got;
+    }
+    return true;
+}
+
+/**
+ * @brief Czyta następną rozgrywkę
+ *
+ * @param run Nagłówek rozgrywki
+ * @param flaps Chwile machnięć
+ * @return false na końcu pliku lub przy uszkodzonych danych
+ */
+bool RunReader::next(RunRecord& run, std::vector<std::uint32_t>& flaps) {
+    if (!file || corrupt) return false;
+    if (!fill(sizeof(RunRecord))) {
+        corrupt = end != begin;
+        return false;
+    }
+    std::memcpy(&run, buffer.data() + begin, sizeof(run));
+    if (run.flapBytes > maxFlapBytes || !fill(sizeof(RunRecord) + run.flapBytes) ||
+        !RunLog::decode(buffer.data() + begin + sizeof(RunRecord), run.flapBytes, run.flapCount, flaps)) {
+        corrupt = true;
+        return false;
+    }
+    begin += sizeof(RunRecord) + run.flapBytes;
+    return true;
+}
+
+/**
+ * @brief Czyta kolejne rozgrywki do partii
+ *
+ * @param batch Partia
+ * @param maxRuns Największa liczba rozgrywek
+ * @return false jeśli plik się skończył
+ */
+bool RunReader::read(RunBatch& batch, std::size_t maxRuns) {
+    batch.clear();
+    RunRecord run;
+    while (batch.size() < maxRuns) {
+        if (!next(run, scratch)) return false;
+        batch.add(run, scratch);
+    }
+    return true;
+}
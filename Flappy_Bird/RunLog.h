@@ -0,0 +1,269 @@
+/**
+ * @file RunLog.h
+ * @brief Zapis rozgrywek (ziarno i chwile machnięć) do odtworzenia symulacją.
+ */
+
+#pragma once
+#ifndef RUNLOG_H
+#define RUNLOG_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "Difficulty.h"
+#include "PlayerModel.h"
+#include "Simulation.h"
+
+/**
+ * @brief Nagłówek rozgrywki w pliku zapisu.
+ *
+ * Po nagłówku następuje flapBytes bajtów z chwilami machnięć: kroki symulacji,
+ * w których gracz machnął skrzydłami, zapisane jako rosnące różnice (pierwsza
+ * względem zera) w kodowaniu LEB128. Typowa rozgrywka zajmuje kilkaset bajtów.
+ */
+struct RunRecord {
+    std::uint64_t seed;       /**< Ziarno toru. */
+    std::uint32_t score;      /**< Wynik zgłoszony przez grę. */
+    std::uint32_t ticks;      /**< Krok, w którym gra się zakończyła. */
+    std::uint32_t flapCount;  /**< Liczba machnięć. */
+    std::uint32_t flapBytes;  /**< Rozmiar zakodowanych machnięć w bajtach. */
+    std::uint8_t difficulty;  /**< Poziom trudności (wartość Difficulty). */
+    std::uint8_t skin;        /**< Model gracza (wartość PlayerModel). */
+    std::uint8_t reserved[6]; /**< Wypełnienie do 32 bajtów, zawsze zera. */
+};
+
+static_assert(sizeof(RunRecord) == 32, "RunRecord musi miec staly rozmiar w pliku");
+
+/**
+ * @brief Funkcje formatu zapisu rozgrywek.
+ */
+namespace RunLog {
+    constexpr float stepTime = 1.0f / 60.0f; /**< Krok symulacji gry (Engine::fixedStep). */
+    constexpr std::uint32_t extraTicks = 600; /**< Ile kroków po zgłoszonym końcu odtwarzanie jeszcze czeka na zderzenie. */
+
+    /**
+     * @brief Koduje chwile machnięć.
+     *
+     * @param flaps Rosnące numery kroków.
+     * @param count Liczba machnięć.
+     * @param out Bufor, do którego dopisywane są bajty.
+     */
+    void encode(const std::uint32_t* flaps, std::size_t count, std::vector<std::uint8_t>& out);
+
+    /**
+     * @brief Dekoduje chwile machnięć.
+     *
+     * @param data Zakodowane bajty.
+     * @param size Liczba bajtów.
+     * @param count Oczekiwana liczba machnięć.
+     * @param flaps Wynik (zastępowany).
+     * @return false jeśli dane są uszkodzone lub kroki nie rosną.
+     */
+    bool decode(const std::uint8_t* data, std::size_t size, std::uint32_t count, std::vector<std::uint32_t>& flaps);
+
+    /**
+     * @brief Odtwarza rozgrywkę symulacją, wywołując visit po każdym kroku.
+     *
+     * Świat startuje z ziarna rozgrywki, a w krokach z listy ptak macha skrzydłami.
+     * Odtwarzanie kończy się zderzeniem albo extraTicks kroków po zgłoszonym końcu.
+     * Gra zaczyna się pierwszym machnięciem, w kroku 0; rozgrywka bez machnięć albo
+     * z pierwszym machnięciem później nie daje żadnego kroku. Limit liczy wykonane
+     * kroki, a nie world.ticks, więc żadne zgłoszenie nie odtwarza się w nieskończoność.
+     *
+     * @tparam E Odbiorca zdarzeń (EventQueue, NoEvents lub własny).
+     * @tparam V Funkcja wywoływana jako visit(const World&).
+     * @param run Nagłówek rozgrywki.
+     * @param flaps Rosnące numery kroków z machnięciem.
+     * @param count Liczba machnięć.
+     * @param world Świat, w którym toczy się odtworzenie.
+     * @param events Odbiorca zdarzeń.
+     * @param visit Funkcja wywoływana po każdym kroku.
+     * @return Liczba wykonanych kroków.
+     */
+    template<class E, class V>
+    std::uint64_t replay(const RunRecord& run, const std::uint32_t* flaps, std::size_t count, World& world, E& events, V&& visit) {
+        Simulation::reset(world, (std::uint32_t)run.seed);
+        if (count == 0 || flaps[0] != 0 || run.difficulty > static_cast<std::uint8_t>(Difficulty::Nightmare)) return 0;
+        const auto rules = Simulation::RuntimeRules::of(static_cast<Difficulty>(run.difficulty));
+        const std::uint64_t limit = (std::uint64_t)run.ticks + extraTicks;
+        std::uint64_t steps = 0;
+        std::size_t next = 0;
+        while (!world.over && steps <= limit) {
+            bool flap = next < count && flaps[next] == world.ticks;
+            if (flap) next++;
+            Simulation::stepWith(world, stepTime, flap, rules, events);
+            visit(static_cast<const World&>(world));
+            steps++;
+        }
+        return steps;
+    }
+}
+
+/**
+ * @brief Partia rozgrywek w ciągłej pamięci, do przekazywania między wątkami.
+ *
+ * Bufory zachowują pojemność między partiami, więc wielokrotnie używana partia
+ * po pierwszym wypełnieniu nie alokuje pamięci.
+ */
+struct RunBatch {
+    std::vector<RunRecord> runs; /**< Nagłówki rozgrywek. */
+    std::vector<std::uint32_t> flaps; /**< Machnięcia wszystkich rozgrywek, jedne za drugimi. */
+    std::vector<std::size_t> offsets; /**< Początek machnięć i-tej rozgrywki; ostatni element to koniec. */
+
+    /**
+     * @brief Opróżnia partię, zachowując pojemność buforów.
+     */
+    void clear() {
+        runs.clear();
+        flaps.clear();
+        offsets.assign(1, 0);
+    }
+
+    /**
+     * @brief Dodaje rozgrywkę.
+     *
+     * @param run Nagłówek.
+     * @param runFlaps Machnięcia.
+     */
+    void add(const RunRecord& run, const std::vector<std::uint32_t>& runFlaps) {
+        if (offsets.empty()) offsets.push_back(0);
+        runs.push_back(run);
+        flaps.insert(flaps.end(), runFlaps.begin(), runFlaps.end());
+        offsets.push_back(flaps.size());
+    }
+
+    std::size_t size() const { return runs.size(); } /**< Liczba rozgrywek. */
+    const std::uint32_t* flapsOf(std::size_t i) const { return flaps.data() + offsets[i]; } /**< Machnięcia i-tej rozgrywki. */
+    std::size_t flapCountOf(std::size_t i) const { return offsets[i + 1] - offsets[i]; } /**< Liczba machnięć i-tej rozgrywki. */
+};
+
+/**
+ * @brief Dopisuje rozgrywki do pliku zapisu.
+ *
+ * Plik zaczyna się 8-bajtową sygnaturą "FBRUNS01", po której następują rozgrywki
+ * jedna za drugą. Zapis idzie przez bufor stdio - rozgrywka kończy się raz na
+ * kilka sekund, więc bez fsync, inaczej niż w ScoreLedger.
+ */
+class RunWriter {
+public:
+    /**
+     * @brief Konstruktor klasy RunWriter. Otwiera (lub tworzy) plik do dopisywania.
+     *
+     * @param path Ścieżka pliku.
+     */
+    explicit RunWriter(const std::string& path);
+
+    /**
+     * @brief Destruktor klasy RunWriter. Zamyka plik.
+     */
+    ~RunWriter();
+
+    RunWriter(const RunWriter&) = delete;
+    RunWriter& operator=(const RunWriter&) = delete;
+
+    /**
+     * @brief Sprawdza, czy plik jest otwarty.
+     *
+     * @return true jeśli można zapisywać.
+     */
+    bool isOpen() const { return file != nullptr; }
+
+    /**
+     * @brief Dopisuje rozgrywkę.
+     *
+     * @param seed Ziarno toru.
+     * @param difficulty Poziom trudności.
+     * @param skin Model gracza.
+     * @param score Wynik.
+     * @param ticks Krok, w którym gra się zakończyła.
+     * @param flaps Rosnące numery kroków z machnięciem.
+     */
+    void append(std::uint64_t seed, Difficulty difficulty, PlayerModel skin, std::uint32_t score, std::uint32_t ticks,
+                const std::vector<std::uint32_t>& flaps);
+
+    /**
+     * @brief Zapisuje bufor stdio do pliku.
+     */
+    void flush();
+
+private:
+    std::FILE* file; /**< Plik zapisu. */
+    std::vector<std::uint8_t> encoded; /**< Bufor kodowania machnięć. */
+};
+
+/**
+ * @brief Czyta rozgrywki z pliku zapisu strumieniowo, w stałej pamięci.
+ *
+ * Plik jest czytany porcjami do bufora o stałym rozmiarze (powiększanego tylko
+ * dla pojedynczej rozgrywki dłuższej niż bufor), więc czytanie pliku z dziesiątkami
+ * milionów rozgrywek nie zależy od jego rozmiaru.
+ */
+class RunReader {
+public:
+    /**
+     * @brief Konstruktor klasy RunReader.
+     *
+     * @param path Ścieżka pliku.
+     * @param bufferSize Rozmiar bufora odczytu.
+     */
+    explicit RunReader(const std::string& path, std::size_t bufferSize = 1 << 20);
+
+    /**
+     * @brief Destruktor klasy RunReader. Zamyka plik.
+     */
+    ~RunReader();
+
+    RunReader(const RunReader&) = delete;
+    RunReader& operator=(const RunReader&) = delete;
+
+    /**
+     * @brief Sprawdza, czy plik jest otwarty i ma poprawną sygnaturę.
+     *
+     * @return true jeśli można czytać.
+     */
+    bool isOpen() const { return file != nullptr; }
+
+    /**
+     * @brief Czyta następną rozgrywkę.
+     *
+     * @param run Nagłówek rozgrywki.
+     * @param flaps Chwile machnięć (zastępowane).
+     * @return false na końcu pliku lub przy uszkodzonych danych (wtedy isCorrupt()).
+     */
+    bool next(RunRecord& run, std::vector<std::uint32_t>& flaps);
+
+    /**
+     * @brief Czyta kolejne rozgrywki do partii (zastępując jej zawartość).
+     *
+     * @param batch Partia.
+     * @param maxRuns Największa liczba rozgrywek.
+     * @return false jeśli plik się skończył; partia może wtedy zawierać ostatnie rozgrywki.
+     */
+    bool read(RunBatch& batch, std::size_t maxRuns);
+
+    /**
+     * @brief Sprawdza, czy czytanie zatrzymało się na uszkodzonych danych.
+     *
+     * @return true jeśli plik jest uszkodzony lub ucięty w środku rozgrywki.
+     */
+    bool isCorrupt() const { return corrupt; }
+
+private:
+    /**
+     * @brief Zapewnia, że w buforze jest co najmniej size nieprzeczytanych bajtów.
+     *
+     * @param size Potrzebna liczba bajtów.
+     * @return false jeśli plik skończył się wcześniej.
+     */
+    bool fill(std::size_t size);
+
+    std::FILE* file; /**< Czytany plik. */
+    std::vector<std::uint8_t> buffer; /**< Bufor odczytu. */
+    std::size_t begin; /**< Pierwszy nieprzeczytany bajt bufora. */
+    std::size_t end; /**< Koniec danych w buforze. */
+    bool corrupt; /**< Czy napotkano uszkodzone dane. */
+    std::vector<std::uint32_t> scratch; /**< Machnięcia bieżącej rozgrywki dla read. */
+};
+
+#endif
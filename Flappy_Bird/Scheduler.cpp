@@ -0,0 +1,180 @@
+/**
+ * @file Scheduler.cpp
+ * @brief Implementacja zegara symulacji.
+ */
+
+#include "Scheduler.h"
+#include <utility>
+
+/**
+ * @brief Konstruktor klasy Scheduler.
+ *
+ * @param capacity Początkowa pojemność kolejki.
+ */
+Scheduler::Scheduler(std::size_t capacity) : time(0), stepEnd(0), nextId(1), nextOrder(0) {
+    heap.reserve(capacity);
+}
+
+/**
+ * @brief Planuje zdarzenie
+ *
+ * @param delay Czas do pierwszego wywołania
+ * @param callback Funkcja wywoływana przez zdarzenie
+ * @param context Argument funkcji
+ * @param period Okres powtarzania
+ * @return Identyfikator zdarzenia
+ */
+Scheduler::TimerId Scheduler::schedule(double delay, Callback callback, void* context, double period) {
+    return scheduleAt(time + delay, callback, context, period);
+}
+
+/**
+ * @brief Planuje zdarzenie na podaną chwilę
+ *
+ * @param due Chwila pierwszego wywołania
+ * @param callback Funkcja wywoływana przez zdarzenie
+ * @param context Argument funkcji
+ * @param period Okres powtarzania
+ * @return Identyfikator zdarzenia
+ */
+Scheduler::TimerId Scheduler::scheduleAt(double due, Callback callback, void* context, double period) {
+    TimerId id = nextId++;
+    if (nextId == noTimer) nextId = 1;
+    push({due, period, callback, context, id, nextOrder++});
+    return id;
+}
+
+/**
+ * @brief Odwołuje zdarzenie
+ *
+ * @param id Identyfikator zdarzenia
+ */
+void Scheduler::cancel(TimerId id) {
+    std::size_t index = find(id);
+    if (index < heap.size()) {
+        removeAt(index);
+    }
+}
+
+/**
+ * @brief Sprawdza, czy zdarzenie czeka na wywołanie
+ *
+ * @param id Identyfikator zdarzenia
+ * @return true jeśli zdarzenie jest zaplanowane
+ */
+bool Scheduler::isScheduled(TimerId id) const {
+    return find(id) < heap.size();
+}
+
+/**
+ * @brief Zwraca czas do najbliższego wywołania zdarzenia
+ *
+ * @param id Identyfikator zdarzenia
+ * @return Czas w sekundach lub -1
+ */
+double Scheduler::remaining(TimerId id) const {
+    std::size_t index = find(id);
+    return index < heap.size() ? heap[index].due - time : -1;
+}
+
+/**
+ * @brief Zwraca chwilę najbliższego wywołania zdarzenia
+ *
+ * @param id Identyfikator zdarzenia
+ * @return Chwila w sekundach lub -1
+ */
+double Scheduler::dueTime(TimerId id) const {
+    std::size_t index = find(id);
+    return index < heap.size() ? heap[index].due : -1;
+}
+
+/**
+ * @brief Ustawia bieżący czas symulacji
+ *
+ * @param now Nowy czas w sekundach
+ */
+void Scheduler::rewind(double now) {
+    time = now;
+    stepEnd = now;
+}
+
+/**
+ * @brief Przesuwa zegar i wywołuje zdarzenia
+ *
+ * Zdarzenie jest wywoływane, gdy koniec kroku przekracza jego chwilę.
+ *
+ * @param dt Czas kroku w sekundach
+ */
+void Scheduler::advance(double dt) {
+    stepEnd = time + dt;
+    while (!heap.empty() && heap.front().due < stepEnd) {
+        Timer timer = heap.front();
+        removeAt(0);
+        time = timer.due;
+        if (timer.period > 0) {
+            // Zdarzenie wraca do kolejki przed wywołaniem, żeby mogło się samo odwołać.
+            timer.due += timer.period;
+            timer.order = nextOrder++;
+            push(timer);
+        }
+        timer.callback(timer.context);
+    }
+    time = stepEnd;
+}
+
+/**
+ * @brief Wstawia zdarzenie do kopca
+ *
+ * @param timer Zdarzenie
+ */
+void Scheduler::push(const Timer& timer) {
+    heap.push_back(timer);
+    std::size_t i = heap.size() - 1;
+    while (i > 0) {
+        std::size_t parent = (i - 1) / 2;
+        if (!before(heap[i], heap[parent])) break;
+        std::swap(heap[i], heap[parent]);
+        i = parent;
+    }
+}
+
+/**
+ * @brief Usuwa element kopca o danym indeksie
+ *
+ * @param index Indeks w kopcu
+ */
+void Scheduler::removeAt(std::size_t index) {
+    heap[index] = heap.back();
+    heap.pop_back();
+    if (index >= heap.size()) return;
+
+    // Przeniesiony element może wymagać przesunięcia w górę albo w dół.
+    std::size_t i = index;
+    while (i > 0 && before(heap[i], heap[(i - 1) / 2])) {
+        std::swap(heap[i], heap[(i - 1) / 2]);
+        i = (i - 1) / 2;
+    }
+    while (true) {
+        std::size_t smallest = i, left = 2 * i + 1, right = 2 * i + 2;
+        if (left < heap.size() && before(heap[left], heap[smallest])) smallest = left;
+        if (right < heap.size() && before(heap[right], heap[smallest])) smallest = right;
+        if (smallest == i) break;
+        std::swap(heap[i], heap[smallest]);
+        i = smallest;
+    }
+}
+
+/**
+ * @brief Zwraca indeks zdarzenia w kopcu
+ *
+ * Kolejka zawiera kilka zdarzeń, więc przeszukanie liniowe jest najtańsze.
+ *
+ * @param id Identyfikator zdarzenia
+ * @return Indeks lub heap.size()
+ */
+std::size_t Scheduler::find(TimerId id) const {
+    for (std::size_t i = 0; i < heap.size(); ++i) {
+        if (heap[i].id == id) return i;
+    }
+    return heap.size();
+}
@@ -0,0 +1,178 @@
+/**
+ * @file Scheduler.h
+ * @brief Zegar symulacji z kolejką priorytetową zdarzeń.
+ */
+
+#pragma once
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Zegar czasu symulacji i kolejka zdarzeń uporządkowana według chwili wywołania.
+ *
+ * Czas płynie tylko wtedy, gdy wywoływana jest advance, więc pauza, spadki liczby
+ * klatek i przyspieszona symulacja nie zmieniają odstępów między zdarzeniami.
+ * Zdarzenia są wywoływane dokładnie w swoich chwilach: w trakcie wywołania now()
+ * zwraca chwilę zdarzenia, a lateness() - o ile koniec bieżącego kroku ją przekracza.
+ * Zdarzenie okresowe jest ponownie planowane na chwilę poprzedniego wywołania
+ * plus okres, bez kumulowania opóźnień.
+ *
+ * Kolejka jest kopcem binarnym o pojemności ustalonej w konstruktorze, a sprawdzenie
+ * w advance, że nic nie jest jeszcze do wywołania, to jedno porównanie - nieaktywne
+ * liczniki nic nie kosztują.
+ */
+class Scheduler {
+public:
+    typedef void (*Callback)(void* context); /**< Funkcja wywoływana przez zdarzenie. */
+    typedef std::uint32_t TimerId; /**< Identyfikator zaplanowanego zdarzenia. */
+    static constexpr TimerId noTimer = 0; /**< Identyfikator oznaczający brak zdarzenia. */
+
+    /**
+     * @brief Konstruktor klasy Scheduler.
+     *
+     * @param capacity Początkowa pojemność kolejki.
+     */
+    explicit Scheduler(std::size_t capacity = 16);
+
+    /**
+     * @brief Planuje zdarzenie.
+     *
+     * @param delay Czas do pierwszego wywołania, w sekundach.
+     * @param callback Funkcja wywoływana przez zdarzenie.
+     * @param context Argument funkcji.
+     * @param period Okres powtarzania w sekundach (0 - zdarzenie jednorazowe).
+     * @return Identyfikator zdarzenia.
+     */
+    TimerId schedule(double delay, Callback callback, void* context, double period = 0);
+
+    /**
+     * @brief Planuje zdarzenie na podaną chwilę czasu symulacji.
+     *
+     * @param due Chwila pierwszego wywołania, w sekundach.
+     * @param callback Funkcja wywoływana przez zdarzenie.
+     * @param context Argument funkcji.
+     * @param period Okres powtarzania w sekundach (0 - zdarzenie jednorazowe).
+     * @return Identyfikator zdarzenia.
+     */
+    TimerId scheduleAt(double due, Callback callback, void* context, double period = 0);
+
+    /**
+     * @brief Odwołuje zdarzenie. Nieznany identyfikator jest ignorowany.
+     *
+     * @param id Identyfikator zdarzenia.
+     */
+    void cancel(TimerId id);
+
+    /**
+     * @brief Sprawdza, czy zdarzenie czeka na wywołanie.
+     *
+     * @param id Identyfikator zdarzenia.
+     * @return true jeśli zdarzenie jest zaplanowane.
+     */
+    bool isScheduled(TimerId id) const;
+
+    /**
+     * @brief Zwraca czas do najbliższego wywołania zdarzenia.
+     *
+     * @param id Identyfikator zdarzenia.
+     * @return Czas w sekundach lub -1, gdy zdarzenie nie jest zaplanowane.
+     */
+    double remaining(TimerId id) const;
+
+    /**
+     * @brief Zwraca chwilę najbliższego wywołania zdarzenia.
+     *
+     * W odróżnieniu od remaining wynik nie zależy od bieżącego czasu, więc
+     * scheduleAt po rewind odtwarza zdarzenie dokładnie, bez błędów zaokrągleń.
+     *
+     * @param id Identyfikator zdarzenia.
+     * @return Chwila w sekundach lub -1, gdy zdarzenie nie jest zaplanowane.
+     */
+    double dueTime(TimerId id) const;
+
+    /**
+     * @brief Ustawia bieżący czas symulacji bez wywoływania zdarzeń, np. przy wczytaniu stanu gry.
+     *
+     * Zaplanowane zdarzenia zachowują swoje chwile wywołania.
+     *
+     * @param now Nowy czas w sekundach.
+     */
+    void rewind(double now);
+
+    /**
+     * @brief Przesuwa zegar i wywołuje wszystkie zdarzenia, których chwila minęła.
+     *
+     * @param dt Czas kroku w sekundach.
+     */
+    void advance(double dt);
+
+    /**
+     * @brief Zwraca bieżący czas symulacji.
+     *
+     * @return Czas w sekundach.
+     */
+    double now() const { return time; }
+
+    /**
+     * @brief Zwraca, o ile koniec bieżącego kroku wyprzedza wywoływane zdarzenie.
+     *
+     * Poza wywołaniem zdarzenia zwraca 0.
+     *
+     * @return Opóźnienie w sekundach.
+     */
+    double lateness() const { return stepEnd - time; }
+
+private:
+    /**
+     * @brief Zaplanowane zdarzenie.
+     */
+    struct Timer {
+        double due; /**< Chwila wywołania. */
+        double period; /**< Okres powtarzania (0 - jednorazowe). */
+        Callback callback; /**< Funkcja wywoływana przez zdarzenie. */
+        void* context; /**< Argument funkcji. */
+        TimerId id; /**< Identyfikator zdarzenia. */
+        std::uint64_t order; /**< Kolejność zaplanowania, rozstrzyga remisy. */
+    };
+
+    /**
+     * @brief Sprawdza, czy zdarzenie a ma być wywołane przed b.
+     */
+    static bool before(const Timer& a, const Timer& b) {
+        return a.due < b.due || (a.due == b.due && a.order < b.order);
+    }
+
+    /**
+     * @brief Wstawia zdarzenie do kopca.
+     *
+     * @param timer Zdarzenie.
+     */
+    void push(const Timer& timer);
+
+    /**
+     * @brief Usuwa element kopca o danym indeksie.
+     *
+     * @param index Indeks w kopcu.
+     */
+    void removeAt(std::size_t index);
+
+    /**
+     * @brief Zwraca indeks zdarzenia w kopcu.
+     *
+     * @param id Identyfikator zdarzenia.
+     * @return Indeks lub heap.size(), gdy zdarzenia nie ma.
+     */
+    std::size_t find(TimerId id) const;
+
+    std::vector<Timer> heap; /**< Kopiec zdarzeń, najwcześniejsze na początku. */
+    double time; /**< Bieżący czas symulacji. */
+    double stepEnd; /**< Koniec bieżącego kroku advance. */
+    TimerId nextId; /**< Następny wolny identyfikator. */
+    std::uint64_t nextOrder; /**< Licznik kolejności planowania. */
+};
+
+#endif
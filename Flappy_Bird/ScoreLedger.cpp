@@ -0,0 +1,418 @@
+/**
+ * @file ScoreLedger.cpp
+ * @brief Implementacja klasy ScoreLedger.
+ */
+
+#include "ScoreLedger.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+
+#ifdef _WIN32
+#include <io.h>
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+/**
+ * @brief Nagłówek pliku dziennika.
+ */
+struct LedgerHeader {
+    char magic[8];             /**< Sygnatura pliku "FBLEDGR1". */
+    std::uint32_t recordSize;  /**< Rozmiar rekordu w bajtach. */
+    std::uint32_t reserved;    /**< Zarezerwowane, zawsze zero. */
+};
+
+const char ledgerMagic[8] = {'F', 'B', 'L', 'E', 'D', 'G', 'R', '1'};
+
+/**
+ * @brief Wymusza zapis danych pliku na nośnik.
+ *
+ * @param file Plik do zsynchronizowania.
+ */
+void syncFile(std::FILE* file) {
+    std::fflush(file);
+#ifdef _WIN32
+    _commit(_fileno(file));
+#else
+    fsync(fileno(file));
+#endif
+}
+
+/**
+ * @brief Sprawdza, czy nagłówek pliku jest poprawny.
+ *
+ * @param header Wczytany nagłówek.
+ * @return true jeśli plik jest dziennikiem w obsługiwanym formacie.
+ */
+bool validHeader(const LedgerHeader& header) {
+    return std::memcmp(header.magic, ledgerMagic, sizeof(ledgerMagic)) == 0 && header.recordSize == sizeof(ScoreRecord);
+}
+
+/**
+ * @brief Skraca plik do podanej długości.
+ *
+ * @param file Otwarty plik.
+ * @param size Nowa długość w bajtach.
+ * @return true jeśli się udało.
+ */
+bool truncateFile(std::FILE* file, std::uint64_t size) {
+    std::fflush(file);
+#ifdef _WIN32
+    return _chsize_s(_fileno(file), (long long)size) == 0;
+#else
+    return ftruncate(fileno(file), (off_t)size) == 0;
+#endif
+}
+
+}
+
+/**
+ * @brief Konstruktor klasy ScoreLedger.
+ *
+ * @param path Ścieżka do pliku dziennika.
+ * @param batchSize Liczba wpisów zbieranych przed zapisem na dysk.
+ * @param topK Liczba najlepszych wyników przechowywanych w indeksie.
+ */
+ScoreLedger::ScoreLedger(const std::string& path, std::size_t batchSize, std::size_t topK)
+        : path(path), batchSize(std::max<std::size_t>(batchSize, 1)), topK(topK), file(nullptr),
+          flushRequested(0), flushCompleted(0), stopping(false) {
+    pending.reserve(this->batchSize * queuedBatches);
+    writing.reserve(this->batchSize * queuedBatches);
+    for (auto& shard : shards) {
+        shard.best.reserve(topK + 1);
+        for (auto& hist : shard.histogram) {
+            hist.reserve(1024);
+        }
+        std::fill(std::begin(shard.games), std::end(shard.games), 0);
+    }
+
+    file = std::fopen(path.c_str(), "ab");
+    if (file) {
+        // Partie są zapisywane jednym fwrite, więc bufor stdio tylko kopiowałby dane.
+        std::setvbuf(file, nullptr, _IONBF, 0);
+        std::fseek(file, 0, SEEK_END);
+    }
+    long size = file ? std::ftell(file) : -1;
+    if (size == 0) {
+        LedgerHeader header{};
+        std::memcpy(header.magic, ledgerMagic, sizeof(ledgerMagic));
+        header.recordSize = sizeof(ScoreRecord);
+        std::fwrite(&header, sizeof(header), 1, file);
+        syncFile(file);
+    } else if (size > 0) {
+        LedgerHeader header{};
+        std::FILE* in = std::fopen(path.c_str(), "rb");
+        bool valid = in && std::fread(&header, sizeof(header), 1, in) == 1 && validHeader(header);
+        if (in) std::fclose(in);
+        // Dopisywanie za obcym nagłówkiem albo za niepełnym rekordem (przerwany zapis)
+        // przesunęłoby wszystkie kolejne rekordy, więc plik jest najpierw wyrównywany
+        // do granicy rekordu, a pliku w nieznanym formacie nie wolno rozszerzać.
+        std::uint64_t aligned = valid ? sizeof(LedgerHeader) + ((std::uint64_t)size - sizeof(LedgerHeader)) / sizeof(ScoreRecord) * sizeof(ScoreRecord) : 0;
+        if (!valid || (aligned != (std::uint64_t)size && !truncateFile(file, aligned))) {
+            std::fprintf(stderr, "Dziennik %s jest uszkodzony albo ma nieznany format - wyniki nie beda zapisywane\n", path.c_str());
+            std::fclose(file);
+            file = nullptr;
+        }
+    }
+    flusher = std::thread(&ScoreLedger::flushLoop, this);
+    rebuildIndex();
+}
+
+/**
+ * @brief Destruktor klasy ScoreLedger.
+ */
+ScoreLedger::~ScoreLedger() {
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    flusher.join();
+    if (file) {
+        std::fclose(file);
+    }
+}
+
+/**
+ * @brief Dopisuje wynik do dziennika.
+ *
+ * @param seed Ziarno generatora użyte w rozgrywce.
+ * @param difficulty Poziom trudności.
+ * @param skin Model gracza.
+ * @param score Zdobyty wynik.
+ * @param ticks Liczba przetrwanych kroków symulacji.
+ */
+void ScoreLedger::append(std::uint64_t seed, Difficulty difficulty, PlayerModel skin, std::uint32_t score, std::uint32_t ticks) {
+    ScoreRecord record{};
+    record.seed = seed;
+    record.score = score;
+    record.ticks = ticks;
+    record.difficulty = static_cast<std::uint8_t>(difficulty);
+    record.skin = static_cast<std::uint8_t>(skin);
+    append(record);
+}
+
+/**
+ * @brief Dopisuje gotowy rekord do dziennika.
+ *
+ * Rekord trafia do fragmentu indeksu wątku i do bufora. Pełną partię przejmuje
+ * wątek zapisujący, więc wywołujący nie czeka na write ani fsync. Czeka dopiero
+ * wtedy, gdy dysk nie nadąża i bufor mieści już queuedBatches partii - bufor
+ * nie rośnie, więc dopisywanie nie alokuje pamięci.
+ *
+ * @param record Rekord do zapisania.
+ */
+void ScoreLedger::append(const ScoreRecord& record) {
+    Shard& shard = localShard();
+    // Rekord jest wstawiany do bufora pod blokadą fragmentu, żeby rebuildIndex
+    // (który blokuje wszystkie fragmenty) nie zgubił rekordu już zaindeksowanego.
+    std::lock_guard<std::mutex> index(shard.mutex);
+    indexRecord(shard, record);
+
+    bool full;
+    {
+        std::unique_lock<std::mutex> lock(pendingMutex);
+        if (pending.size() == pending.capacity()) {
+            wake.notify_one();
+            flushed.wait(lock, [&] { return pending.size() < pending.capacity(); });
+        }
+        pending.push_back(record);
+        full = pending.size() >= batchSize;
+    }
+    if (full) {
+        wake.notify_one();
+    }
+}
+
+/**
+ * @brief Zapisuje bieżącą partię na dysk i wykonuje fsync.
+ */
+void ScoreLedger::flush() {
+    std::unique_lock<std::mutex> lock(pendingMutex);
+    const std::uint64_t request = ++flushRequested;
+    wake.notify_one();
+    flushed.wait(lock, [&] { return flushCompleted >= request; });
+}
+
+/**
+ * @brief Pętla wątku zapisującego.
+ *
+ * Wątek czeka na pełną partię, żądanie flush albo koniec pracy, przejmuje bufor
+ * i zapisuje go poza blokadą, więc append może w tym czasie dopisywać do nowego bufora.
+ */
+void ScoreLedger::flushLoop() {
+    std::unique_lock<std::mutex> lock(pendingMutex);
+    for (;;) {
+        wake.wait(lock, [&] { return stopping || pending.size() >= batchSize || flushCompleted != flushRequested; });
+        const std::uint64_t request = flushRequested;
+        const bool last = stopping;
+        writing.swap(pending);
+        lock.unlock();
+        writeBatch(writing);
+        writing.clear();
+        lock.lock();
+        flushCompleted = request;
+        flushed.notify_all();
+        if (last && pending.empty()) return;
+    }
+}
+
+/**
+ * @brief Zapisuje podaną partię na dysk.
+ *
+ * @param batch Rekordy do zapisania.
+ */
+void ScoreLedger::writeBatch(const std::vector<ScoreRecord>& batch) {
+    if (!file || batch.empty()) return;
+    std::fwrite(batch.data(), sizeof(ScoreRecord), batch.size(), file);
+    syncFile(file);
+}
+
+/**
+ * @brief Zwraca fragment indeksu bieżącego wątku.
+ *
+ * Wątki dostają kolejne fragmenty przy pierwszym wywołaniu, więc do
+ * shardCount wątków dopisuje bez wspólnej blokady.
+ *
+ * @return Fragment indeksu.
+ */
+ScoreLedger::Shard& ScoreLedger::localShard() {
+    static std::atomic<std::size_t> nextShard{0};
+    thread_local const std::size_t shard = nextShard.fetch_add(1, std::memory_order_relaxed) % shardCount;
+    return shards[shard];
+}
+
+/**
+ * @brief Dodaje rekord do fragmentu indeksu.
+ *
+ * @param shard Fragment indeksu.
+ * @param record Rekord do zaindeksowania.
+ */
+void ScoreLedger::indexRecord(Shard& shard, const ScoreRecord& record) {
+    if (record.difficulty >= difficultyCount) return;
+
+    // Wynik pochodzi z pliku, więc jest ograniczany - uszkodzony rekord nie może wymusić ogromnego histogramu.
+    auto& hist = shard.histogram[record.difficulty];
+    std::uint32_t bucket = std::min(record.score, maxHistogramScore);
+    if (hist.size() <= bucket) {
+        hist.resize(bucket + 1, 0);
+    }
+    ++hist[bucket];
+    ++shard.games[record.difficulty];
+
+    auto& best = shard.best;
+    if (topK == 0) return;
+    if (best.size() == topK && best.back().score >= record.score) return;
+
+    auto pos = std::upper_bound(best.begin(), best.end(), record, [](const ScoreRecord& a, const ScoreRecord& b) {
+        return a.score > b.score;
+    });
+    best.insert(pos, record);
+    if (best.size() > topK) {
+        best.pop_back();
+    }
+}
+
+/**
+ * @brief Odbudowuje indeks top-K i histogramy z zawartości pliku.
+ *
+ * @return Liczba wczytanych rekordów.
+ */
+std::size_t ScoreLedger::rebuildIndex() {
+    // Kolejność blokad: fragmenty od pierwszego, potem bufor - taka sama jak w append().
+    // Zablokowane fragmenty wstrzymują append, więc po flush cały dziennik jest w pliku.
+    std::unique_lock<std::mutex> locks[shardCount];
+    for (std::size_t i = 0; i < shardCount; ++i) {
+        locks[i] = std::unique_lock<std::mutex>(shards[i].mutex);
+    }
+    flush();
+
+    for (auto& shard : shards) {
+        shard.best.clear();
+        for (std::size_t i = 0; i < difficultyCount; ++i) {
+            shard.histogram[i].clear();
+            shard.games[i] = 0;
+        }
+    }
+    Shard& loadedShard = shards[0];
+
+    std::size_t loaded = 0;
+#ifdef _WIN32
+    std::ifstream in(path, std::ios::binary);
+    LedgerHeader header{};
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) || !validHeader(header)) return 0;
+    ScoreRecord record{};
+    while (in.read(reinterpret_cast<char*>(&record), sizeof(record))) {
+        indexRecord(loadedShard, record);
+        ++loaded;
+    }
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return 0;
+
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || (std::size_t)st.st_size < sizeof(LedgerHeader)) {
+        close(fd);
+        return 0;
+    }
+
+    auto size = (std::size_t)st.st_size;
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return 0;
+    madvise(data, size, MADV_SEQUENTIAL);
+
+    const auto* header = static_cast<const LedgerHeader*>(data);
+    if (validHeader(*header)) {
+        // Niepełny rekord na końcu pliku (przerwany zapis) jest pomijany.
+        loaded = (size - sizeof(LedgerHeader)) / sizeof(ScoreRecord);
+        const auto* records = reinterpret_cast<const ScoreRecord*>(static_cast<const char*>(data) + sizeof(LedgerHeader));
+        for (std::size_t i = 0; i < loaded; ++i) {
+            indexRecord(loadedShard, records[i]);
+        }
+    }
+    munmap(data, size);
+#endif
+    return loaded;
+}
+
+/**
+ * @brief Zwraca najlepsze wyniki, od najwyższego.
+ *
+ * @return Najlepsze wyniki ze wszystkich fragmentów indeksu.
+ */
+std::vector<ScoreRecord> ScoreLedger::top() const {
+    std::vector<ScoreRecord> merged;
+    merged.reserve(topK * shardCount);
+    for (auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        merged.insert(merged.end(), shard.best.begin(), shard.best.end());
+    }
+    std::stable_sort(merged.begin(), merged.end(), [](const ScoreRecord& a, const ScoreRecord& b) {
+        return a.score > b.score;
+    });
+    if (merged.size() > topK) {
+        merged.resize(topK);
+    }
+    return merged;
+}
+
+/**
+ * @brief Zwraca percentyl wyników dla danego poziomu trudności.
+ *
+ * @param difficulty Poziom trudności.
+ * @param percentile Percentyl z zakresu [0, 100].
+ * @return Najmniejszy wynik, którego nie przekracza co najmniej percentile% gier.
+ */
+std::uint32_t ScoreLedger::percentile(Difficulty difficulty, float percentile) const {
+    auto idx = static_cast<std::size_t>(difficulty);
+    if (idx >= difficultyCount) return 0;
+
+    // Wszystkie fragmenty są blokowane naraz, żeby liczba gier i histogram pochodziły z tej samej chwili.
+    std::unique_lock<std::mutex> locks[shardCount];
+    std::uint64_t total = 0;
+    std::size_t buckets = 0;
+    for (std::size_t i = 0; i < shardCount; ++i) {
+        locks[i] = std::unique_lock<std::mutex>(shards[i].mutex);
+        total += shards[i].games[idx];
+        buckets = std::max(buckets, shards[i].histogram[idx].size());
+    }
+    if (total == 0) return 0;
+
+    auto p = std::min(std::max(percentile, 0.0f), 100.0f);
+    auto needed = (std::uint64_t)std::ceil(p / 100.0f * (float)total);
+    std::uint64_t seen = 0;
+    for (std::size_t s = 0; s < buckets; ++s) {
+        for (auto& shard : shards) {
+            const auto& hist = shard.histogram[idx];
+            if (s < hist.size()) seen += hist[s];
+        }
+        if (seen >= needed && seen > 0) return (std::uint32_t)s;
+    }
+    return (std::uint32_t)(buckets - 1);
+}
+
+/**
+ * @brief Zwraca liczbę gier zapisanych dla danego poziomu trudności.
+ *
+ * @param difficulty Poziom trudności.
+ * @return Liczba gier.
+ */
+std::uint64_t ScoreLedger::count(Difficulty difficulty) const {
+    auto idx = static_cast<std::size_t>(difficulty);
+    if (idx >= difficultyCount) return 0;
+    std::uint64_t total = 0;
+    for (auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        total += shard.games[idx];
+    }
+    return total;
+}
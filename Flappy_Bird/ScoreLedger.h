@@ -0,0 +1,207 @@
+/**
+ * @file ScoreLedger.h
+ * @brief Definicja klasy ScoreLedger - trwałego dziennika wyników gier.
+ */
+
+#pragma once
+#ifndef SCORELEDGER_H
+#define SCORELEDGER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Difficulty.h"
+#include "PlayerModel.h"
+
+/**
+ * @brief Pojedynczy wpis dziennika wyników.
+ *
+ * Rekord ma stały rozmiar i jest zapisywany do pliku bez żadnej konwersji,
+ * dzięki czemu cały dziennik można odczytać przez mmap jako tablicę rekordów.
+ */
+struct ScoreRecord {
+    std::uint64_t seed;       /**< Ziarno generatora użyte w rozgrywce. */
+    std::uint32_t score;      /**< Zdobyty wynik. */
+    std::uint32_t ticks;      /**< Liczba kroków symulacji przetrwanych przez ptaka. */
+    std::uint8_t difficulty;  /**< Poziom trudności (wartość Difficulty). */
+    std::uint8_t skin;        /**< Model gracza (wartość PlayerModel). */
+    std::uint8_t reserved[6]; /**< Wypełnienie do 24 bajtów, zawsze zera. */
+};
+
+static_assert(sizeof(ScoreRecord) == 24, "ScoreRecord musi miec staly rozmiar w pliku");
+
+/**
+ * @brief Dziennik wyników zapisywany wyłącznie przez dopisywanie.
+ *
+ * Wpisy trafiają najpierw do bufora w pamięci. Pełną partię przejmuje wątek
+ * zapisujący i zapisuje ją na dysk (jeden write i jeden fsync na partię), więc
+ * append nigdy nie czeka na dysk. Obok pliku utrzymywany jest indeks w pamięci:
+ * top-K najlepszych wyników oraz histogram wyników dla każdego poziomu
+ * trudności, z którego liczone są percentyle. Indeks jest podzielony na
+ * fragmenty: każdy wątek dopisuje do swojego fragmentu, pod jego własną
+ * blokadą, a top(), percentile() i count() łączą fragmenty przy zapytaniu.
+ * Indeks można szybko odbudować z pliku funkcją rebuildIndex().
+ *
+ * Przy otwarciu plik jest skracany do ostatniego pełnego rekordu, a do pliku
+ * z niepoprawnym nagłówkiem nic nie jest dopisywane.
+ *
+ * Wszystkie metody publiczne są bezpieczne wątkowo, więc wiele równoległych
+ * gier może zapisywać wyniki do jednego dziennika.
+ */
+class ScoreLedger {
+public:
+    /**
+     * @brief Konstruktor klasy ScoreLedger.
+     *
+     * Otwiera (lub tworzy) plik dziennika i odbudowuje indeks z jego zawartości.
+     *
+     * @param path Ścieżka do pliku dziennika.
+     * @param batchSize Liczba wpisów zbieranych przed zapisem na dysk.
+     * @param topK Liczba najlepszych wyników przechowywanych w indeksie.
+     */
+    explicit ScoreLedger(const std::string& path, std::size_t batchSize = 256, std::size_t topK = 10);
+
+    /**
+     * @brief Destruktor klasy ScoreLedger. Zapisuje niezapisane wpisy i kończy wątek zapisujący.
+     */
+    ~ScoreLedger();
+
+    ScoreLedger(const ScoreLedger&) = delete;
+    ScoreLedger& operator=(const ScoreLedger&) = delete;
+
+    /**
+     * @brief Dopisuje wynik do dziennika.
+     *
+     * @param seed Ziarno generatora użyte w rozgrywce.
+     * @param difficulty Poziom trudności.
+     * @param skin Model gracza.
+     * @param score Zdobyty wynik.
+     * @param ticks Liczba przetrwanych kroków symulacji.
+     */
+    void append(std::uint64_t seed, Difficulty difficulty, PlayerModel skin, std::uint32_t score, std::uint32_t ticks);
+
+    /**
+     * @brief Dopisuje gotowy rekord do dziennika.
+     *
+     * @param record Rekord do zapisania.
+     */
+    void append(const ScoreRecord& record);
+
+    /**
+     * @brief Zapisuje bieżącą partię na dysk i wykonuje fsync.
+     *
+     * Zapis wykonuje wątek zapisujący; funkcja czeka, aż wszystkie wpisy dopisane
+     * przed jej wywołaniem będą na dysku.
+     */
+    void flush();
+
+    /**
+     * @brief Odbudowuje indeks top-K i histogramy z zawartości pliku.
+     *
+     * Plik jest mapowany do pamięci (mmap) i przeglądany jako tablica rekordów.
+     *
+     * @return Liczba wczytanych rekordów.
+     */
+    std::size_t rebuildIndex();
+
+    /**
+     * @brief Sprawdza, czy dziennik przyjmuje nowe wyniki.
+     *
+     * @return false, gdy pliku nie udało się otworzyć albo jest uszkodzony.
+     */
+    bool isOpen() const { return file != nullptr; }
+
+    /**
+     * @brief Zwraca najlepsze wyniki, od najwyższego.
+     *
+     * @return Najlepsze wyniki ze wszystkich fragmentów indeksu.
+     */
+    std::vector<ScoreRecord> top() const;
+
+    /**
+     * @brief Zwraca percentyl wyników dla danego poziomu trudności.
+     *
+     * @param difficulty Poziom trudności.
+     * @param percentile Percentyl z zakresu [0, 100].
+     * @return Najmniejszy wynik, którego nie przekracza co najmniej percentile% gier;
+     *         wyniki powyżej maxHistogramScore są liczone jako maxHistogramScore.
+     */
+    std::uint32_t percentile(Difficulty difficulty, float percentile) const;
+
+    /**
+     * @brief Zwraca liczbę gier zapisanych dla danego poziomu trudności.
+     *
+     * @param difficulty Poziom trudności.
+     * @return Liczba gier.
+     */
+    std::uint64_t count(Difficulty difficulty) const;
+
+private:
+    static constexpr std::size_t difficultyCount = 4; /**< Liczba poziomów trudności. */
+    static constexpr std::uint32_t maxHistogramScore = 65535; /**< Ostatni przedział histogramu, zbiera też wszystkie wyższe wyniki. */
+    static constexpr std::size_t shardCount = 8; /**< Liczba fragmentów indeksu. */
+    static constexpr std::size_t queuedBatches = 4; /**< Liczba partii, które mieszczą się w buforze, zanim append poczeka na dysk. */
+
+    /**
+     * @brief Fragment indeksu, do którego dopisują wątki o tym samym numerze fragmentu.
+     *
+     * Fragmenty są wyrównane do linii pamięci podręcznej, żeby wątki dopisujące
+     * do sąsiednich fragmentów nie unieważniały sobie nawzajem linii.
+     */
+    struct alignas(64) Shard {
+        std::mutex mutex; /**< Chroni fragment. */
+        std::vector<ScoreRecord> best; /**< Najlepsze wyniki fragmentu, posortowane malejąco. */
+        std::vector<std::uint64_t> histogram[difficultyCount]; /**< Liczba gier dla każdego wyniku, osobno dla trudności. */
+        std::uint64_t games[difficultyCount]; /**< Liczba gier dla każdego poziomu trudności. */
+    };
+
+    /**
+     * @brief Zwraca fragment indeksu bieżącego wątku.
+     *
+     * @return Fragment indeksu.
+     */
+    Shard& localShard();
+
+    /**
+     * @brief Dodaje rekord do fragmentu indeksu. Wymaga blokady fragmentu.
+     *
+     * @param shard Fragment indeksu.
+     * @param record Rekord do zaindeksowania.
+     */
+    void indexRecord(Shard& shard, const ScoreRecord& record);
+
+    /**
+     * @brief Zapisuje podaną partię na dysk. Wywołuje tylko wątek zapisujący.
+     *
+     * @param batch Rekordy do zapisania.
+     */
+    void writeBatch(const std::vector<ScoreRecord>& batch);
+
+    /**
+     * @brief Pętla wątku zapisującego: przejmuje pełne partie i żądania flush.
+     */
+    void flushLoop();
+
+    std::string path; /**< Ścieżka do pliku dziennika. */
+    std::size_t batchSize; /**< Rozmiar partii zapisu. */
+    std::size_t topK; /**< Rozmiar indeksu najlepszych wyników. */
+    std::FILE* file; /**< Plik dziennika otwarty do dopisywania. */
+
+    mutable Shard shards[shardCount]; /**< Fragmenty indeksu. */
+
+    std::mutex pendingMutex; /**< Chroni bufor pending i stan wątku zapisującego. */
+    std::condition_variable wake; /**< Budzi wątek zapisujący: pełna partia, flush albo koniec. */
+    std::condition_variable flushed; /**< Budzi wątki czekające w flush. */
+    std::vector<ScoreRecord> pending; /**< Wpisy oczekujące na zapis. */
+    std::vector<ScoreRecord> writing; /**< Partia zapisywana na dysk, należy do wątku zapisującego. */
+    std::uint64_t flushRequested; /**< Numer ostatniego żądania flush. */
+    std::uint64_t flushCompleted; /**< Numer żądania flush, po którym wpisy są już na dysku. */
+    bool stopping; /**< Czy wątek zapisujący ma zapisać resztę i zakończyć się. */
+    std::thread flusher; /**< Wątek zapisujący. */
+};
+
+#endif
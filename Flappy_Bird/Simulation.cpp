@@ -0,0 +1,60 @@
+/**
+ * @file Simulation.cpp
+ * @brief Implementacja symulacji gry bez okna.
+ */
+
+#include "Simulation.h"
+
+/**
+ * @brief Ustawia świat w stanie początkowym
+ *
+ * @param world Świat do ustawienia
+ * @param seed Ziarno generatora rur
+ */
+void Simulation::reset(World& world, std::uint32_t seed) {
+    world = World{};
+    world.birdY = Physics::birdStartY;
+    world.birdVel = 0;
+    world.rng = seed ? seed : 0x9e3779b9u;
+}
+
+/**
+ * @brief Zwraca indeks pierwszej rury, której ptak jeszcze nie minął
+ *
+ * @param world Świat
+ * @return Indeks rury lub -1
+ */
+int Simulation::nextPipe(const World& world) {
+    for (int i = 0; i < world.pipeCount; ++i) {
+        if (world.pipes[i].x + Physics::pipeWidth >= Physics::birdX) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Wykonuje jeden krok dla wielu światów, wybierając kernel raz na partię
+ *
+ * @param difficulty Poziom trudności
+ * @param worlds Tablica światów
+ * @param count Liczba światów
+ * @param dt Czas kroku w sekundach
+ * @param flaps Decyzje o machnięciu
+ */
+void Simulation::stepBatch(Difficulty difficulty, World* worlds, std::size_t count, float dt, const std::uint8_t* flaps) {
+    switch (difficulty) {
+        case Difficulty::Easy:
+            stepBatch<Difficulty::Easy>(worlds, count, dt, flaps);
+            break;
+        case Difficulty::Medium:
+            stepBatch<Difficulty::Medium>(worlds, count, dt, flaps);
+            break;
+        case Difficulty::Hard:
+            stepBatch<Difficulty::Hard>(worlds, count, dt, flaps);
+            break;
+        case Difficulty::Nightmare:
+            stepBatch<Difficulty::Nightmare>(worlds, count, dt, flaps);
+            break;
+    }
+}
@@ -0,0 +1,300 @@
+/**
+ * @file Simulation.h
+ * @brief Symulacja gry bez okna, grafiki i dźwięku.
+ */
+
+#ifndef FLAPPY_BIRD_SIMULATION_H
+#define FLAPPY_BIRD_SIMULATION_H
+
+#include <cstddef>
+#include <cstdint>
+#include "Difficulty.h"
+#include "DifficultyRules.h"
+#include "GameEvents.h"
+
+/**
+ * @brief Stan pojedynczej rury w symulacji.
+ */
+struct PipeState {
+    float x; /**< Pozycja X rury. */
+    float y; /**< Pozycja Y środka przerwy. */
+    float throat; /**< Gardło rury w chwili jej powstania. */
+    bool scored; /**< Flaga informująca, czy ptak minął już rurę. */
+    bool coinVisible; /**< Flaga informująca, czy moneta jest widoczna. */
+};
+
+/**
+ * @brief Pełny stan jednej rozgrywki w symulacji.
+ *
+ * Struktura nie zawiera wskaźników, więc można ją kopiować jak zwykłe dane.
+ */
+struct World {
+    float birdY; /**< Pozycja Y ptaka. */
+    float birdVel; /**< Prędkość pionowa ptaka. */
+    PipeState pipes[Physics::maxPipes]; /**< Rury, od najstarszej. */
+    std::int32_t pipeCount; /**< Liczba rur na ekranie. */
+    std::uint32_t score; /**< Wynik (zebrane monety). */
+    std::uint32_t ticks; /**< Liczba kroków symulacji od startu gry. */
+    std::uint32_t rng; /**< Stan generatora liczb losowych. */
+    float spawnTimer; /**< Czas od chwili, w której powinna powstać ostatnia rura. */
+    bool running; /**< Flaga określająca, czy gra została rozpoczęta. */
+    bool over; /**< Flaga określająca, czy gra jest zakończona. */
+};
+
+/**
+ * @brief Funkcje symulacji gry, zgodne z regułami EntityWorld::step i Engine::update.
+ */
+namespace Simulation {
+
+    /**
+     * @brief Reguły poziomu trudności znanego w czasie kompilacji.
+     *
+     * @tparam D Poziom trudności.
+     */
+    template<Difficulty D>
+    struct StaticRules {
+        static constexpr float throat() { return RulesOf<D>::throat; } /**< Gardło rury. */
+        static constexpr float spawnInterval() { return RulesOf<D>::spawnInterval; } /**< Odstęp między rurami. */
+        static constexpr float gravity() { return Physics::gravity; } /**< Grawitacja. */
+        static constexpr float flapVelocity() { return Physics::flapVelocity; } /**< Prędkość po machnięciu. */
+    };
+
+    /**
+     * @brief Reguły odczytywane w czasie działania, np. przy strojeniu parametrów gry.
+     */
+    struct RuntimeRules {
+        float throatValue; /**< Gardło rury. */
+        float spawnIntervalValue; /**< Odstęp między rurami. */
+        float gravityValue; /**< Grawitacja. */
+        float flapVelocityValue; /**< Prędkość po machnięciu. */
+
+        /**
+         * @brief Tworzy reguły odpowiadające poziomowi trudności.
+         *
+         * @param difficulty Poziom trudności.
+         * @return Reguły.
+         */
+        static RuntimeRules of(Difficulty difficulty) {
+            const auto& r = rulesFor(difficulty);
+            return {r.throat, r.spawnInterval, Physics::gravity, Physics::flapVelocity};
+        }
+
+        float throat() const { return throatValue; } /**< Gardło rury. */
+        float spawnInterval() const { return spawnIntervalValue; } /**< Odstęp między rurami. */
+        float gravity() const { return gravityValue; } /**< Grawitacja. */
+        float flapVelocity() const { return flapVelocityValue; } /**< Prędkość po machnięciu. */
+    };
+
+    /**
+     * @brief Sprawdza nachodzenie się prostokątów tak samo jak sf::FloatRect::intersects.
+     *
+     * @return true jeśli część wspólna ma dodatnie pole.
+     */
+    inline bool overlaps(float l1, float t1, float w1, float h1, float l2, float t2, float w2, float h2) {
+        float left = l1 > l2 ? l1 : l2;
+        float right = l1 + w1 < l2 + w2 ? l1 + w1 : l2 + w2;
+        float top = t1 > t2 ? t1 : t2;
+        float bottom = t1 + h1 < t2 + h2 ? t1 + h1 : t2 + h2;
+        return left < right && top < bottom;
+    }
+
+    /**
+     * @brief Zwraca następną liczbę losową (xorshift32).
+     *
+     * @param state Stan generatora, różny od zera.
+     * @return Liczba losowa.
+     */
+    inline std::uint32_t nextRandom(std::uint32_t& state) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+    /**
+     * @brief Ustawia świat w stanie początkowym (ekran "Get Ready").
+     *
+     * @param world Świat do ustawienia.
+     * @param seed Ziarno generatora rur.
+     */
+    void reset(World& world, std::uint32_t seed);
+
+    /**
+     * @brief Zwraca indeks pierwszej rury, której ptak jeszcze nie minął.
+     *
+     * @param world Świat.
+     * @return Indeks rury lub -1, gdy takiej rury nie ma.
+     */
+    int nextPipe(const World& world);
+
+    /**
+     * @brief Dodaje nową rurę, usuwając najstarszą, gdy na ekranie są już cztery.
+     *
+     * Rura spóźniona względem swojej chwili o late sekund jest od razu przesuwana
+     * o tyle, ile przejechałaby w tym czasie, więc odstęp między rurami nie zależy
+     * od długości kroku.
+     *
+     * @param world Świat.
+     * @param throat Gardło nowej rury.
+     * @param late Opóźnienie powstania rury w sekundach.
+     */
+    inline void spawnPipe(World& world, float throat, float late = 0) {
+        if (world.pipeCount == Physics::maxPipes) {
+            for (int i = 1; i < Physics::maxPipes; ++i) {
+                world.pipes[i - 1] = world.pipes[i];
+            }
+            world.pipeCount--;
+        }
+        auto roll = (int)(nextRandom(world.rng) % Physics::pipeHeights);
+        world.pipes[world.pipeCount++] = {Physics::pipeSpawnX - Physics::pipeSpeed * late, Physics::pipeY(roll), throat, false, true};
+    }
+
+    /**
+     * @brief Rozpoczyna grę: ustawia flagę running i tworzy pierwszą rurę.
+     *
+     * @param world Świat.
+     * @param throat Gardło pierwszej rury.
+     */
+    inline void start(World& world, float throat) {
+        world.running = true;
+        world.spawnTimer = 0;
+        spawnPipe(world, throat);
+    }
+
+    /**
+     * @brief Wykonuje jeden krok symulacji i zgłasza jego zdarzenia.
+     *
+     * Kolejność jest taka sama jak w grze: machnięcie (Engine::handleEvent),
+     * ptak (EntityWorld::fly), rury (EntityWorld::moveObstacles), nowa rura (Engine::update).
+     * Die jest zgłaszane raz, w kroku, w którym ziemia lub sufit kończy grę; po zderzeniu
+     * z rurą (Hit) już nie.
+     *
+     * @tparam R Typ reguł (StaticRules lub RuntimeRules).
+     * @tparam E Odbiorca zdarzeń (EventQueue lub NoEvents).
+     * @param world Świat.
+     * @param dt Czas kroku w sekundach.
+     * @param flap Czy gracz macha skrzydłami w tym kroku.
+     * @param rules Reguły gry.
+     * @param events Odbiorca zdarzeń kroku.
+     */
+    template<class R, class E>
+    inline void stepWith(World& world, float dt, bool flap, const R& rules, E& events) {
+        events.setTick(world.ticks);
+        if (flap && !world.over) {
+            if (!world.running) {
+                start(world, rules.throat());
+            }
+            world.birdVel = rules.flapVelocity();
+            events.emit(GameEventType::Flap);
+        }
+        if (!world.running) return;
+
+        world.birdVel += dt * rules.gravity();
+        world.birdY += world.birdVel * dt;
+        if (world.birdY < 0 || world.birdY + Physics::birdHeight > Physics::floorY) {
+            // Martwy ptak dalej spada na ziemię, więc bez warunku Die byłoby zgłaszane w każdym kroku.
+            if (!world.over) {
+                events.emit(GameEventType::Die);
+            }
+            world.over = true;
+        }
+        if (world.birdY + Physics::birdHeight > Physics::floorY) {
+            world.birdY = Physics::floorY - Physics::birdHeight;
+            world.birdVel = 0;
+        }
+        if (world.over) return;
+
+        for (int i = 0; i < world.pipeCount; ++i) {
+            auto& pipe = world.pipes[i];
+            pipe.x -= Physics::pipeSpeed * dt;
+            if (overlaps(Physics::birdX, world.birdY, Physics::birdWidth, Physics::birdHeight,
+                         pipe.x, pipe.y + pipe.throat, Physics::pipeWidth, Physics::pipeHeight) ||
+                overlaps(Physics::birdX, world.birdY, Physics::birdWidth, Physics::birdHeight,
+                         pipe.x, pipe.y - pipe.throat, Physics::pipeWidth, Physics::pipeHeight)) {
+                world.over = true;
+                events.emit(GameEventType::Hit);
+            }
+            // Tak jak w EntityWorld::fireTriggers moneta jest sprawdzana także w kroku zderzenia.
+            if (pipe.coinVisible &&
+                overlaps(Physics::birdX, world.birdY, Physics::birdWidth, Physics::birdHeight,
+                         pipe.x, pipe.y + pipe.throat / 2, Physics::coinWidth, Physics::coinHeight)) {
+                pipe.coinVisible = false;
+                world.score++;
+                events.emit(GameEventType::Coin);
+            }
+            if (!pipe.scored && pipe.x + Physics::pipeWidth < Physics::birdX) {
+                pipe.scored = true;
+                events.emit(GameEventType::Pass);
+            }
+            if (world.over) break;
+        }
+        if (world.over) return;
+
+        world.ticks++;
+        // Tak jak Scheduler w grze: nadwyżka ponad odstęp przechodzi na następną rurę.
+        world.spawnTimer += dt;
+        if (world.spawnTimer > rules.spawnInterval()) {
+            world.spawnTimer -= rules.spawnInterval();
+            spawnPipe(world, rules.throat(), world.spawnTimer);
+        }
+    }
+
+    /**
+     * @brief Wykonuje jeden krok symulacji bez zgłaszania zdarzeń.
+     *
+     * @tparam R Typ reguł (StaticRules lub RuntimeRules).
+     * @param world Świat.
+     * @param dt Czas kroku w sekundach.
+     * @param flap Czy gracz macha skrzydłami w tym kroku.
+     * @param rules Reguły gry.
+     */
+    template<class R>
+    inline void stepWith(World& world, float dt, bool flap, const R& rules) {
+        NoEvents events;
+        stepWith(world, dt, flap, rules, events);
+    }
+
+    /**
+     * @brief Wykonuje jeden krok symulacji dla poziomu trudności znanego w czasie kompilacji.
+     *
+     * @tparam D Poziom trudności.
+     * @param world Świat.
+     * @param dt Czas kroku w sekundach.
+     * @param flap Czy gracz macha skrzydłami w tym kroku.
+     */
+    template<Difficulty D>
+    inline void step(World& world, float dt, bool flap) {
+        stepWith(world, dt, flap, StaticRules<D>{});
+    }
+
+    /**
+     * @brief Wykonuje jeden krok dla wielu światów naraz. Zakończone światy są pomijane.
+     *
+     * @tparam D Poziom trudności.
+     * @param worlds Tablica światów.
+     * @param count Liczba światów.
+     * @param dt Czas kroku w sekundach.
+     * @param flaps Decyzje o machnięciu dla każdego świata (0 lub 1).
+     */
+    template<Difficulty D>
+    void stepBatch(World* worlds, std::size_t count, float dt, const std::uint8_t* flaps) {
+        for (std::size_t i = 0; i < count; ++i) {
+            if (!worlds[i].over) {
+                step<D>(worlds[i], dt, flaps[i] != 0);
+            }
+        }
+    }
+
+    /**
+     * @brief Wykonuje jeden krok dla wielu światów, wybierając wersję kernela raz na całą partię.
+     *
+     * @param difficulty Poziom trudności.
+     * @param worlds Tablica światów.
+     * @param count Liczba światów.
+     * @param dt Czas kroku w sekundach.
+     * @param flaps Decyzje o machnięciu dla każdego świata (0 lub 1).
+     */
+    void stepBatch(Difficulty difficulty, World* worlds, std::size_t count, float dt, const std::uint8_t* flaps);
+}
+
+#endif //FLAPPY_BIRD_SIMULATION_H
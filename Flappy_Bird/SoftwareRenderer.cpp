@@ -0,0 +1,574 @@
+/**
+ * @file SoftwareRenderer.cpp
+ * @brief Implementacja rysowania klatek gry na procesorze.
+ */
+
+#include "SoftwareRenderer.h"
+#include "BirdAtlas.h"
+#include "DifficultyRules.h"
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#ifdef FLAPPY_RASTER_FREETYPE
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#endif
+
+namespace {
+
+constexpr int scoreCharacterSize = 30; /**< Rozmiar czcionki wyniku, domyślny dla sf::Text. */
+constexpr float groundRectangleY = Physics::floorY + 28; /**< Górna krawędź pasa pod ziemią. */
+
+/**
+ * @brief Miesza kanał źródła z kanałem celu: (s * a + d * (255 - a)) / 255, zaokrąglone.
+ *
+ * @param s Kanał źródła.
+ * @param d Kanał celu.
+ * @param a Alfa źródła.
+ * @return Kanał wyniku.
+ */
+inline std::uint8_t blendChannel(unsigned s, unsigned d, unsigned a) {
+    unsigned t = s * a + d * (255 - a) + 128;
+    return (std::uint8_t)((t + (t >> 8)) >> 8);
+}
+
+/**
+ * @brief Nakłada wiersz pikseli źródła na wiersz celu z mieszaniem alfa.
+ *
+ * Alfa wyniku jest zawsze 255, tak jak w nieprzezroczystym oknie gry.
+ *
+ * @param dst Wiersz celu (RGBA).
+ * @param src Wiersz źródła (RGBA).
+ * @param count Liczba pikseli.
+ */
+void blendRow(std::uint8_t* dst, const std::uint8_t* src, int count) {
+    int i = 0;
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i alphaMask = _mm_set1_epi32((int)0xFF000000u);
+    const __m128i full = _mm_set1_epi16(255);
+    const __m128i half = _mm_set1_epi16(128);
+    auto blendHalf = [&](__m128i s, __m128i d) {
+        __m128i a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+        __m128i t = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(s, a), _mm_mullo_epi16(d, _mm_sub_epi16(full, a))), half);
+        return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+    };
+    for (; i + 4 <= count; i += 4) {
+        __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+        __m128i alpha = _mm_and_si128(s, alphaMask);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(alpha, alphaMask)) == 0xFFFF) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), s);
+            continue;
+        }
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(alpha, zero)) == 0xFFFF) continue;
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i * 4));
+        __m128i lo = blendHalf(_mm_unpacklo_epi8(s, zero), _mm_unpacklo_epi8(d, zero));
+        __m128i hi = blendHalf(_mm_unpackhi_epi8(s, zero), _mm_unpackhi_epi8(d, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), _mm_or_si128(_mm_packus_epi16(lo, hi), alphaMask));
+    }
+#endif
+    for (; i < count; ++i) {
+        const std::uint8_t* s = src + i * 4;
+        std::uint8_t* d = dst + i * 4;
+        unsigned a = s[3];
+        if (a == 0) continue;
+        d[0] = blendChannel(s[0], d[0], a);
+        d[1] = blendChannel(s[1], d[1], a);
+        d[2] = blendChannel(s[2], d[2], a);
+        d[3] = 255;
+    }
+}
+
+/**
+ * @brief Dodaje bajty wiersza do 16-bitowych sum.
+ *
+ * @param sums Sumy, po jednej na bajt wiersza.
+ * @param row Wiersz.
+ * @param count Liczba bajtów.
+ */
+void accumulateRow(std::uint16_t* sums, const std::uint8_t* row, int count) {
+    int i = 0;
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= count; i += 16) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i));
+        auto* lo = reinterpret_cast<__m128i*>(sums + i);
+        auto* hi = reinterpret_cast<__m128i*>(sums + i + 8);
+        _mm_storeu_si128(lo, _mm_add_epi16(_mm_loadu_si128(lo), _mm_unpacklo_epi8(bytes, zero)));
+        _mm_storeu_si128(hi, _mm_add_epi16(_mm_loadu_si128(hi), _mm_unpackhi_epi8(bytes, zero)));
+    }
+#endif
+    for (; i < count; ++i) {
+        sums[i] = (std::uint16_t)(sums[i] + row[i]);
+    }
+}
+
+}
+
+#ifdef FLAPPY_RASTER_FREETYPE
+
+/**
+ * @brief Glify czcionki gry potrzebne do napisu z wynikiem.
+ */
+struct SoftwareRenderer::Font {
+    /**
+     * @brief Wyrenderowany glif.
+     */
+    struct Glyph {
+        bool present = false; /**< Czy glif został wczytany. */
+        int left = 0; /**< Przesunięcie bitmapy w prawo od pióra. */
+        int top = 0; /**< Przesunięcie górnej krawędzi bitmapy w górę od linii bazowej. */
+        int width = 0; /**< Szerokość bitmapy. */
+        int rows = 0; /**< Wysokość bitmapy. */
+        float advance = 0; /**< Przesunięcie pióra po glifie. */
+        std::vector<std::uint8_t> coverage; /**< Pokrycie pikseli (alfa białego tekstu). */
+    };
+
+    FT_Library library = nullptr; /**< Biblioteka FreeType. */
+    FT_Face face = nullptr; /**< Czcionka. */
+    Glyph glyphs[128]; /**< Glify znaków ASCII napisu z wynikiem. */
+
+    /**
+     * @brief Zwalnia czcionkę i bibliotekę FreeType.
+     */
+    ~Font() {
+        if (face) FT_Done_Face(face);
+        if (library) FT_Done_FreeType(library);
+    }
+
+    /**
+     * @brief Zwraca odstęp między parą znaków, jak sf::Font::getKerning.
+     */
+    float kerning(char first, char second) const {
+        if (!FT_HAS_KERNING(face)) return 0;
+        FT_Vector kerning{};
+        FT_Get_Kerning(face, FT_Get_Char_Index(face, (FT_ULong)first), FT_Get_Char_Index(face, (FT_ULong)second),
+                       FT_KERNING_UNFITTED, &kerning);
+        return std::round((float)kerning.x / 64.0f);
+    }
+};
+
+#else
+
+/**
+ * @brief Pusta czcionka, gdy FreeType nie jest dostępny.
+ */
+struct SoftwareRenderer::Font {};
+
+#endif
+
+/**
+ * @brief Konstruktor klasy SoftwareRenderer
+ */
+SoftwareRenderer::SoftwareRenderer() : ready(true), target(nullptr), font(nullptr) {
+    for (int d = 0; d < 4; ++d) {
+        ready &= load(backgrounds[d], rulesFor(static_cast<Difficulty>(d)).background);
+    }
+    ready &= load(upperPipe, "res/textures/pipe.png");
+    ready &= load(lowerPipe, "res/textures/pipe.png", true);
+    ready &= load(coin, "res/textures/coin.png");
+    ready &= load(ground, "res/textures/ground.png");
+    ready &= load(getReady[0], "res/textures/get_ready/1.png");
+    ready &= load(getReady[1], "res/textures/get_ready/2.png");
+    ready &= load(gameover, "res/textures/gameover.png");
+    ready &= load(restart, "res/textures/restart.png");
+
+    // Klatki każdego modelu leżą obok siebie, tak jak wiersz BirdAtlas.
+    for (int skin = 0; skin < BirdAtlas::skinCount; ++skin) {
+        pathModel paths = BirdAtlas::getPathModel(static_cast<PlayerModel>(skin));
+        Bitmap poses[BirdAtlas::wingPoses];
+        ready &= load(poses[0], paths.wingUp) && load(poses[1], paths.wingParallel) && load(poses[2], paths.wingDown);
+        if (!ready) break;
+        Bitmap& row = birds[skin];
+        row.width = poses[0].width * BirdAtlas::wingPoses;
+        row.height = poses[0].height;
+        row.pixels.resize((std::size_t)row.width * row.height * 4);
+        for (int pose = 0; pose < BirdAtlas::wingPoses; ++pose) {
+            for (int y = 0; y < row.height && y < poses[pose].height; ++y) {
+                std::memcpy(&row.pixels[((std::size_t)y * row.width + pose * poses[0].width) * 4],
+                            &poses[pose].pixels[(std::size_t)y * poses[pose].width * 4],
+                            (std::size_t)std::min(poses[0].width, poses[pose].width) * 4);
+            }
+        }
+        // Zakresy wierszy obejmują wszystkie klatki naraz, więc są tylko przybliżeniem - ptak jest mały.
+        row.spanBegin.assign(row.height, 0);
+        row.spanEnd.assign(row.height, row.width);
+        row.spanOpaque.assign(row.height, 0);
+    }
+    if (!ready) {
+        std::fprintf(stderr, "SoftwareRenderer: nie udalo sie wczytac tekstur z res/textures\n");
+    }
+
+#ifdef FLAPPY_RASTER_FREETYPE
+    font = new Font();
+    if (FT_Init_FreeType(&font->library) != 0 || FT_New_Face(font->library, "res/fonts/04B_19__.TTF", 0, &font->face) != 0 ||
+        FT_Set_Pixel_Sizes(font->face, 0, scoreCharacterSize) != 0) {
+        std::fprintf(stderr, "SoftwareRenderer: nie udalo sie wczytac czcionki, wynik nie bedzie rysowany\n");
+        delete font;
+        font = nullptr;
+        return;
+    }
+    // Te same ustawienia co sf::Font::loadGlyph.
+    for (char c : std::string("Score: 0123456789")) {
+        Font::Glyph& glyph = font->glyphs[(int)c];
+        if (glyph.present) continue;
+        if (FT_Load_Char(font->face, (FT_ULong)c, FT_LOAD_TARGET_NORMAL | FT_LOAD_FORCE_AUTOHINT | FT_LOAD_RENDER) != 0) continue;
+        FT_GlyphSlot slot = font->face->glyph;
+        glyph.present = true;
+        glyph.left = slot->bitmap_left;
+        glyph.top = slot->bitmap_top;
+        glyph.width = (int)slot->bitmap.width;
+        glyph.rows = (int)slot->bitmap.rows;
+        glyph.advance = std::round((float)slot->metrics.horiAdvance / 64.0f);
+        glyph.coverage.resize((std::size_t)glyph.width * glyph.rows);
+        for (int y = 0; y < glyph.rows; ++y) {
+            const unsigned char* line = slot->bitmap.buffer + (std::ptrdiff_t)y * slot->bitmap.pitch;
+            for (int x = 0; x < glyph.width; ++x) {
+                glyph.coverage[(std::size_t)y * glyph.width + x] =
+                        slot->bitmap.pixel_mode == FT_PIXEL_MODE_MONO ? ((line[x / 8] >> (7 - x % 8)) & 1) * 255 : line[x];
+            }
+        }
+    }
+#endif
+}
+
+/**
+ * @brief Destruktor klasy SoftwareRenderer
+ */
+SoftwareRenderer::~SoftwareRenderer() {
+    delete font;
+}
+
+/**
+ * @brief Wczytuje teksturę z pliku i wyznacza zakresy wierszy
+ *
+ * @param bitmap Tekstura do wypełnienia
+ * @param path Ścieżka pliku
+ * @param flip Czy odwrócić teksturę w pionie
+ * @return true jeśli plik został wczytany
+ */
+bool SoftwareRenderer::load(Bitmap& bitmap, const std::string& path, bool flip) {
+    sf::Image image;
+    if (!image.loadFromFile(path)) return false;
+    if (flip) image.flipVertically();
+
+    bitmap.width = (int)image.getSize().x;
+    bitmap.height = (int)image.getSize().y;
+    const std::uint8_t* pixels = image.getPixelsPtr();
+    bitmap.pixels.assign(pixels, pixels + (std::size_t)bitmap.width * bitmap.height * 4);
+
+    bitmap.spanBegin.assign(bitmap.height, 0);
+    bitmap.spanEnd.assign(bitmap.height, 0);
+    bitmap.spanOpaque.assign(bitmap.height, 0);
+    for (int y = 0; y < bitmap.height; ++y) {
+        const std::uint8_t* row = &bitmap.pixels[(std::size_t)y * bitmap.width * 4];
+        int begin = 0, end = bitmap.width;
+        while (begin < end && row[begin * 4 + 3] == 0) begin++;
+        while (end > begin && row[(end - 1) * 4 + 3] == 0) end--;
+        bool opaque = true;
+        for (int x = begin; x < end && opaque; ++x) {
+            opaque = row[x * 4 + 3] == 255;
+        }
+        bitmap.spanBegin[y] = begin;
+        bitmap.spanEnd[y] = end;
+        bitmap.spanOpaque[y] = opaque ? 1 : 0;
+    }
+    bitmap.opaqueRows = 0;
+    while (bitmap.opaqueRows < bitmap.height && bitmap.spanOpaque[bitmap.opaqueRows] &&
+           bitmap.spanBegin[bitmap.opaqueRows] == 0 && bitmap.spanEnd[bitmap.opaqueRows] == bitmap.width) {
+        bitmap.opaqueRows++;
+    }
+    return true;
+}
+
+/**
+ * @brief Rysuje klatkę w pełnej rozdzielczości
+ *
+ * Kolejność jest taka sama jak w Engine::draw.
+ *
+ * @param scene Scena
+ * @param rgba Bufor width * height * 4 bajtów
+ */
+void SoftwareRenderer::render(const RenderScene& scene, std::uint8_t* rgba) {
+    target = rgba;
+    const World& world = *scene.world;
+    const DifficultyRules& rules = rulesFor(scene.difficulty);
+
+    // Okno jest czyszczone na czarno, ale tylko poniżej wierszy, które tło zakrywa w całości.
+    const Bitmap& background = backgrounds[static_cast<int>(scene.difficulty)];
+    const int covered = background.width >= width ? background.opaqueRows : 0;
+    fill(0, covered, width, height - covered, 0, 0, 0);
+    blit(background, 0, 0);
+
+    for (int i = 0; i < world.pipeCount; ++i) {
+        const PipeState& pipe = world.pipes[i];
+        blit(upperPipe, pipe.x, pipe.y + pipe.throat);
+        blit(lowerPipe, pipe.x, pipe.y - pipe.throat);
+        if (pipe.coinVisible) {
+            blit(coin, pipe.x, pipe.y + pipe.throat / rules.coinOffsetDivisor);
+        }
+    }
+
+    blit(ground, scene.groundOffset, Physics::floorY);
+    if (scene.showGetReady) {
+        const Bitmap& screen = getReady[scene.getReadyFrame != 0 ? 1 : 0];
+        blit(screen, width / 2 - (float)screen.width / 2, height / 2 - (float)screen.height / 2);
+    }
+    fill(0, (int)groundRectangleY, width, height - (int)groundRectangleY, 245, 228, 138);
+
+    const Bitmap& bird = birds[static_cast<int>(scene.skin)];
+    const int frameWidth = bird.width / BirdAtlas::wingPoses;
+    const int column = BirdAtlas::frameColumns[std::min(std::max(scene.birdFrame, 0), BirdAtlas::animationFrames - 1)];
+    float degrees = 8 * (world.birdVel / 400);
+    if (degrees == 0) {
+        blit(bird, Physics::birdX, world.birdY, column * frameWidth, frameWidth);
+    } else {
+        blitRotated(bird, column * frameWidth, frameWidth, Physics::birdX, world.birdY, degrees);
+    }
+
+    if (scene.showScore) {
+        drawScore(world.score);
+    }
+    if (scene.showGameOver) {
+        blit(gameover, width / 2 - (float)gameover.width / 2, height / 4 - (float)gameover.height / 4);
+        blit(restart, width / 2 - (float)restart.width / 2, height / 2 - (float)restart.height / 2);
+    }
+    target = nullptr;
+}
+
+/**
+ * @brief Rysuje klatkę i zmniejsza ją do obrazu w skali szarości
+ *
+ * @param scene Scena
+ * @param gray Bufor outWidth * outHeight bajtów
+ * @param outWidth Szerokość wyniku
+ * @param outHeight Wysokość wyniku
+ */
+void SoftwareRenderer::renderGray(const RenderScene& scene, std::uint8_t* gray, int outWidth, int outHeight) {
+    frame.resize((std::size_t)width * height * 4);
+    columnSums.resize((std::size_t)width * 4);
+    if (grayColumns.size() != (std::size_t)outWidth + 1) {
+        grayColumns.resize((std::size_t)outWidth + 1);
+        for (int ox = 0; ox <= outWidth; ++ox) {
+            grayColumns[ox] = ox * width / outWidth;
+        }
+    }
+    render(scene, frame.data());
+
+    // Najpierw sumowane są kanały w pionie, szesnaście bajtów naraz,
+    // a dopiero sumy kolumn są ważone wagami jasności (razem 256).
+    for (int oy = 0; oy < outHeight; ++oy) {
+        const int y0 = oy * height / outHeight, y1 = (oy + 1) * height / outHeight;
+        std::fill(columnSums.begin(), columnSums.end(), 0);
+        for (int y = y0; y < y1; ++y) {
+            accumulateRow(columnSums.data(), &frame[(std::size_t)y * width * 4], width * 4);
+        }
+        for (int ox = 0; ox < outWidth; ++ox) {
+            std::uint64_t r = 0, g = 0, b = 0;
+            for (int x = grayColumns[ox]; x < grayColumns[ox + 1]; ++x) {
+                r += columnSums[x * 4];
+                g += columnSums[x * 4 + 1];
+                b += columnSums[x * 4 + 2];
+            }
+            const auto count = (std::uint64_t)((grayColumns[ox + 1] - grayColumns[ox]) * (y1 - y0)) * 256;
+            gray[(std::size_t)oy * outWidth + ox] = (std::uint8_t)((77 * r + 150 * g + 29 * b + count / 2) / count);
+        }
+    }
+}
+
+/**
+ * @brief Wypełnia prostokąt jednolitym, kryjącym kolorem
+ *
+ * @param x Lewa krawędź
+ * @param y Górna krawędź
+ * @param w Szerokość
+ * @param h Wysokość
+ * @param r Składowa czerwona
+ * @param g Składowa zielona
+ * @param b Składowa niebieska
+ */
+void SoftwareRenderer::fill(int x, int y, int w, int h, std::uint8_t r, std::uint8_t g, std::uint8_t b) {
+    const int x0 = std::max(x, 0), x1 = std::min(x + w, width);
+    const int y0 = std::max(y, 0), y1 = std::min(y + h, height);
+    if (x0 >= x1 || y0 >= y1) return;
+    std::uint8_t* first = target + ((std::size_t)y0 * width + x0) * 4;
+    for (int i = 0; i < x1 - x0; ++i) {
+        first[i * 4] = r;
+        first[i * 4 + 1] = g;
+        first[i * 4 + 2] = b;
+        first[i * 4 + 3] = 255;
+    }
+    for (int row = y0 + 1; row < y1; ++row) {
+        std::memcpy(target + ((std::size_t)row * width + x0) * 4, first, (std::size_t)(x1 - x0) * 4);
+    }
+}
+
+/**
+ * @brief Rysuje teksturę bez obrotu w pozycji sprite'a SFML
+ *
+ * Piksel okna należy do sprite'a, gdy jego środek leży w prostokącie sprite'a,
+ * więc pierwszy zakryty piksel to ceil(x - 0.5).
+ *
+ * @param bitmap Tekstura
+ * @param x Pozycja X sprite'a
+ * @param y Pozycja Y sprite'a
+ * @param srcX Lewa krawędź fragmentu tekstury
+ * @param srcWidth Szerokość fragmentu tekstury
+ */
+void SoftwareRenderer::blit(const Bitmap& bitmap, float x, float y, int srcX, int srcWidth) {
+    if (srcWidth == 0) srcWidth = bitmap.width;
+    const int ix = (int)std::ceil(x - 0.5f), iy = (int)std::ceil(y - 0.5f);
+    const int rowBegin = std::max(0, -iy), rowEnd = std::min(bitmap.height, height - iy);
+    for (int r = rowBegin; r < rowEnd; ++r) {
+        const int begin = std::max({bitmap.spanBegin[r] - srcX, 0, -ix});
+        const int end = std::min({bitmap.spanEnd[r] - srcX, srcWidth, width - ix});
+        if (begin >= end) continue;
+        const std::uint8_t* src = &bitmap.pixels[((std::size_t)r * bitmap.width + srcX + begin) * 4];
+        std::uint8_t* dst = target + ((std::size_t)(iy + r) * width + ix + begin) * 4;
+        if (bitmap.spanOpaque[r]) {
+            std::memcpy(dst, src, (std::size_t)(end - begin) * 4);
+        } else {
+            blendRow(dst, src, end - begin);
+        }
+    }
+}
+
+/**
+ * @brief Rysuje fragment tekstury obrócony wokół lewego górnego rogu
+ *
+ * Dla każdego piksela w obszarze obróconego prostokąta środek piksela jest
+ * przekształcany z powrotem do układu tekstury i próbkowany najbliższy teksel.
+ *
+ * @param bitmap Tekstura
+ * @param srcX Lewa krawędź fragmentu tekstury
+ * @param srcWidth Szerokość fragmentu tekstury
+ * @param x Pozycja X sprite'a
+ * @param y Pozycja Y sprite'a
+ * @param degrees Kąt obrotu w stopniach
+ */
+void SoftwareRenderer::blitRotated(const Bitmap& bitmap, int srcX, int srcWidth, float x, float y, float degrees) {
+    const float angle = degrees * 3.14159265f / 180.0f;
+    const float c = std::cos(angle), s = std::sin(angle);
+    const float w = (float)srcWidth, h = (float)bitmap.height;
+
+    // Obszar obróconego prostokąta w oknie.
+    const float cornersX[4] = {0, w * c, -h * s, w * c - h * s};
+    const float cornersY[4] = {0, w * s, h * c, w * s + h * c};
+    const int left = std::max(0, (int)std::floor(x + *std::min_element(cornersX, cornersX + 4)));
+    const int right = std::min(width, (int)std::ceil(x + *std::max_element(cornersX, cornersX + 4)));
+    const int top = std::max(0, (int)std::floor(y + *std::min_element(cornersY, cornersY + 4)));
+    const int bottom = std::min(height, (int)std::ceil(y + *std::max_element(cornersY, cornersY + 4)));
+
+    for (int py = top; py < bottom; ++py) {
+        const float dy = (float)py + 0.5f - y;
+        std::uint8_t* dst = target + ((std::size_t)py * width) * 4;
+        for (int px = left; px < right; ++px) {
+            const float dx = (float)px + 0.5f - x;
+            const float u = dx * c + dy * s;
+            const float v = dy * c - dx * s;
+            if (u < 0 || v < 0 || u >= w || v >= h) continue;
+            const std::uint8_t* texel = &bitmap.pixels[((std::size_t)v * bitmap.width + srcX + (int)u) * 4];
+            blendRow(dst + px * 4, texel, 1);
+        }
+    }
+}
+
+/**
+ * @brief Rysuje wynik tak jak Engine::updateScoreText
+ *
+ * Napis jest wyśrodkowany według szerokości obszaru glifów, jak getLocalBounds,
+ * a jego linia bazowa leży characterSize pikseli pod górną krawędzią tekstu.
+ *
+ * @param score Wynik
+ */
+void SoftwareRenderer::drawScore(std::uint32_t score) {
+#ifdef FLAPPY_RASTER_FREETYPE
+    if (!font) return;
+    char text[32];
+    int length = std::snprintf(text, sizeof(text), "Score: %u", score);
+
+    // Pierwsze przejście: położenia glifów i szerokość napisu.
+    float pens[32];
+    float pen = 0, minX = 1e9f, maxX = -1e9f;
+    for (int i = 0; i < length; ++i) {
+        if (i > 0) pen += font->kerning(text[i - 1], text[i]);
+        pens[i] = pen;
+        const Font::Glyph& glyph = font->glyphs[(int)text[i]];
+        if (text[i] != ' ' && glyph.width > 0) {
+            minX = std::min(minX, pen + (float)glyph.left);
+            maxX = std::max(maxX, pen + (float)(glyph.left + glyph.width));
+        }
+        pen += glyph.advance;
+    }
+    if (maxX < minX) return;
+    const int originX = (int)std::lround(width / 2 - (maxX - minX) / 2);
+    const int baseline = 5 + scoreCharacterSize;
+
+    // Biały tekst: pokrycie glifu jest alfą koloru (255, 255, 255).
+    for (int i = 0; i < length; ++i) {
+        const Font::Glyph& glyph = font->glyphs[(int)text[i]];
+        const int gx = originX + (int)pens[i] + glyph.left, gy = baseline - glyph.top;
+        for (int r = std::max(0, -gy); r < glyph.rows && gy + r < height; ++r) {
+            std::uint8_t* dst = target + ((std::size_t)(gy + r) * width) * 4;
+            for (int col = std::max(0, -gx); col < glyph.width && gx + col < width; ++col) {
+                unsigned a = glyph.coverage[(std::size_t)r * glyph.width + col];
+                if (a == 0) continue;
+                std::uint8_t* d = dst + (gx + col) * 4;
+                d[0] = blendChannel(255, d[0], a);
+                d[1] = blendChannel(255, d[1], a);
+                d[2] = blendChannel(255, d[2], a);
+            }
+        }
+    }
+#else
+    (void)score;
+#endif
+}
+
+/**
+ * @brief Zapisuje obraz RGBA do pliku PNG
+ *
+ * @param path Ścieżka pliku
+ * @param rgba Piksele
+ * @param imageWidth Szerokość obrazu
+ * @param imageHeight Wysokość obrazu
+ * @return true jeśli zapis się powiódł
+ */
+bool SoftwareRenderer::savePng(const std::string& path, const std::uint8_t* rgba, int imageWidth, int imageHeight) {
+    sf::Image image;
+    image.create((unsigned)imageWidth, (unsigned)imageHeight, rgba);
+    return image.saveToFile(path);
+}
+
+/**
+ * @brief Porównuje dwa obrazy RGBA
+ *
+ * @param a Pierwszy obraz
+ * @param b Drugi obraz
+ * @param pixels Liczba pikseli
+ * @param tolerance Największa dopuszczalna różnica kanału
+ * @return Podsumowanie różnic
+ */
+ImageDiff SoftwareRenderer::compare(const std::uint8_t* a, const std::uint8_t* b, std::size_t pixels, int tolerance) {
+    ImageDiff diff{pixels, 0, 0, 0};
+    std::uint64_t total = 0;
+    for (std::size_t i = 0; i < pixels; ++i) {
+        int worst = 0;
+        for (int channel = 0; channel < 3; ++channel) {
+            int d = std::abs((int)a[i * 4 + channel] - (int)b[i * 4 + channel]);
+            worst = std::max(worst, d);
+            total += (std::uint64_t)d;
+        }
+        diff.maxDifference = std::max(diff.maxDifference, worst);
+        if (worst > tolerance) diff.differing++;
+    }
+    diff.meanDifference = pixels ? (double)total / (double)(pixels * 3) : 0;
+    return diff;
+}
@@ -0,0 +1,229 @@
+/**
+ * @file SoftwareRenderer.h
+ * @brief Rysowanie klatek gry na procesorze, bez okna i bez OpenGL.
+ */
+
+#pragma once
+#ifndef SOFTWARERENDERER_H
+#define SOFTWARERENDERER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Difficulty.h"
+#include "PlayerModel.h"
+#include "Simulation.h"
+
+/**
+ * @brief Wszystko, co trzeba wiedzieć o klatce poza stanem świata.
+ */
+struct RenderScene {
+    const World* world; /**< Świat do narysowania. */
+    Difficulty difficulty; /**< Poziom trudności (tło i położenie monet). */
+    PlayerModel skin; /**< Model ptaka. */
+    int birdFrame; /**< Klatka animacji skrzydeł, z zakresu [0, BirdAtlas::animationFrames). */
+    float groundOffset; /**< Przesunięcie ziemi, z zakresu (-24, 0]. */
+    bool showScore; /**< Czy rysować wynik. */
+    bool showGetReady; /**< Czy rysować ekran "Get Ready". */
+    int getReadyFrame; /**< Tekstura ekranu "Get Ready" (0 lub 1). */
+    bool showGameOver; /**< Czy rysować napis końca gry i przycisk restartu. */
+
+    /**
+     * @brief Zwraca scenę tak, jak narysowałaby ją gra dla danego świata.
+     *
+     * @param world Świat.
+     * @param difficulty Poziom trudności.
+     * @return Scena z niebieskim ptakiem, wynikiem w trakcie gry i napisem końca gry po zderzeniu.
+     */
+    static RenderScene of(const World& world, Difficulty difficulty) {
+        return {&world, difficulty, PlayerModel::Blue, 0, 0, world.running, !world.running, 0, world.over};
+    }
+};
+
+/**
+ * @brief Różnice między dwoma obrazami RGBA.
+ */
+struct ImageDiff {
+    std::size_t pixels; /**< Liczba porównanych pikseli. */
+    std::size_t differing; /**< Liczba pikseli, w których któryś kanał różni się o więcej niż tolerancja. */
+    int maxDifference; /**< Największa różnica kanału. */
+    double meanDifference; /**< Średnia różnica kanału. */
+};
+
+/**
+ * @brief Rysuje klatki gry do pamięci, piksel w piksel tak jak Engine::draw.
+ *
+ * Tekstury z res/textures są dekodowane raz (sf::Image działa bez okna
+ * i kontekstu OpenGL) i trzymane jako zwykłe tablice RGBA. Klatka powstaje tak
+ * samo jak w Engine::draw: tło, rury, monety, ziemia, pas pod ziemią, ptak, wynik,
+ * napisy. Sprite'y bez obrotu są kopiowane w całych pikselach (SFML z wyłączonym
+ * wygładzaniem tekstur próbkuje najbliższy teksel, więc wynik jest ten sam),
+ * a obrócony ptak jest próbkowany przez odwrócenie przekształcenia sprite'a.
+ *
+ * Mieszanie alfa przetwarza cztery piksele naraz (SSE2, a bez SSE2 ta sama
+ * arytmetyka na pojedynczych pikselach). Dla każdego wiersza tekstury zapamiętany
+ * jest zakres nieprzezroczystych pikseli i to, czy jest w całości kryjący, więc
+ * rury i ziemia są kopiowane bez mieszania, a przezroczyste brzegi pomijane.
+ *
+ * Wynik rysowany jest czcionką gry przez FreeType, z tymi samymi ustawieniami
+ * co sf::Font. Bez FreeType (FLAPPY_RASTER_FREETYPE niezdefiniowane) wynik
+ * nie jest rysowany. Menu główne nie jest obsługiwane - scena opisuje tylko grę.
+ *
+ * Obiekt nie jest bezpieczny dla wątków, ale każdy wątek może mieć własny.
+ */
+class SoftwareRenderer {
+public:
+    static constexpr int width = 450; /**< Szerokość klatki, jak okna gry. */
+    static constexpr int height = 700; /**< Wysokość klatki, jak okna gry. */
+
+    /**
+     * @brief Konstruktor klasy SoftwareRenderer. Wczytuje tekstury i czcionkę.
+     */
+    SoftwareRenderer();
+
+    /**
+     * @brief Destruktor klasy SoftwareRenderer.
+     */
+    ~SoftwareRenderer();
+
+    SoftwareRenderer(const SoftwareRenderer&) = delete;
+    SoftwareRenderer& operator=(const SoftwareRenderer&) = delete;
+
+    /**
+     * @brief Sprawdza, czy wszystkie tekstury zostały wczytane.
+     *
+     * @return true jeśli można rysować.
+     */
+    bool isReady() const { return ready; }
+
+    /**
+     * @brief Rysuje klatkę w pełnej rozdzielczości.
+     *
+     * @param scene Scena.
+     * @param rgba Bufor width * height * 4 bajtów, wiersze od góry.
+     */
+    void render(const RenderScene& scene, std::uint8_t* rgba);
+
+    /**
+     * @brief Rysuje klatkę i zmniejsza ją do obrazu w skali szarości.
+     *
+     * Piksel wyniku jest średnią jasności pikseli klatki, których środki leżą
+     * w jego obszarze (np. 84x84 jako obserwacja dla agenta).
+     *
+     * @param scene Scena.
+     * @param gray Bufor outWidth * outHeight bajtów.
+     * @param outWidth Szerokość wyniku, nie większa niż width.
+     * @param outHeight Wysokość wyniku, od 3 (sumy kanałów są 16-bitowe) do height.
+     */
+    void renderGray(const RenderScene& scene, std::uint8_t* gray, int outWidth, int outHeight);
+
+    /**
+     * @brief Zapisuje obraz RGBA do pliku PNG.
+     *
+     * @param path Ścieżka pliku.
+     * @param rgba Piksele, wiersze od góry.
+     * @param imageWidth Szerokość obrazu.
+     * @param imageHeight Wysokość obrazu.
+     * @return true jeśli zapis się powiódł.
+     */
+    static bool savePng(const std::string& path, const std::uint8_t* rgba, int imageWidth, int imageHeight);
+
+    /**
+     * @brief Porównuje dwa obrazy RGBA tej samej wielkości.
+     *
+     * @param a Pierwszy obraz.
+     * @param b Drugi obraz.
+     * @param pixels Liczba pikseli.
+     * @param tolerance Największa różnica kanału, przy której piksele uznawane są za równe.
+     * @return Podsumowanie różnic kanałów RGB (alfa okna zależy od sterownika i jest pomijana).
+     */
+    static ImageDiff compare(const std::uint8_t* a, const std::uint8_t* b, std::size_t pixels, int tolerance);
+
+private:
+    /**
+     * @brief Zdekodowana tekstura.
+     */
+    struct Bitmap {
+        int width = 0; /**< Szerokość w pikselach. */
+        int height = 0; /**< Wysokość w pikselach. */
+        std::vector<std::uint8_t> pixels; /**< Piksele RGBA, wiersze od góry. */
+        std::vector<std::int32_t> spanBegin; /**< Pierwszy nieprzezroczysty piksel wiersza. */
+        std::vector<std::int32_t> spanEnd; /**< Koniec nieprzezroczystych pikseli wiersza (0 - wiersz pusty). */
+        std::vector<std::uint8_t> spanOpaque; /**< Czy zakres wiersza jest w całości kryjący. */
+        int opaqueRows = 0; /**< Liczba początkowych wierszy kryjących na całej szerokości. */
+    };
+
+    /**
+     * @brief Wczytuje teksturę z pliku i wyznacza zakresy wierszy.
+     *
+     * @param bitmap Tekstura do wypełnienia.
+     * @param path Ścieżka pliku.
+     * @param flip Czy odwrócić teksturę w pionie.
+     * @return true jeśli plik został wczytany.
+     */
+    static bool load(Bitmap& bitmap, const std::string& path, bool flip = false);
+
+    /**
+     * @brief Wypełnia prostokąt jednolitym, kryjącym kolorem.
+     *
+     * @param x Lewa krawędź.
+     * @param y Górna krawędź.
+     * @param w Szerokość.
+     * @param h Wysokość.
+     * @param r Składowa czerwona.
+     * @param g Składowa zielona.
+     * @param b Składowa niebieska.
+     */
+    void fill(int x, int y, int w, int h, std::uint8_t r, std::uint8_t g, std::uint8_t b);
+
+    /**
+     * @brief Rysuje teksturę bez obrotu w pozycji sprite'a SFML.
+     *
+     * @param bitmap Tekstura.
+     * @param x Pozycja X sprite'a.
+     * @param y Pozycja Y sprite'a.
+     * @param srcX Lewa krawędź fragmentu tekstury.
+     * @param srcWidth Szerokość fragmentu tekstury (0 - cała szerokość).
+     */
+    void blit(const Bitmap& bitmap, float x, float y, int srcX = 0, int srcWidth = 0);
+
+    /**
+     * @brief Rysuje fragment tekstury obrócony wokół lewego górnego rogu.
+     *
+     * @param bitmap Tekstura.
+     * @param srcX Lewa krawędź fragmentu tekstury.
+     * @param srcWidth Szerokość fragmentu tekstury.
+     * @param x Pozycja X sprite'a.
+     * @param y Pozycja Y sprite'a.
+     * @param degrees Kąt obrotu w stopniach, zgodnie z ruchem wskazówek zegara.
+     */
+    void blitRotated(const Bitmap& bitmap, int srcX, int srcWidth, float x, float y, float degrees);
+
+    /**
+     * @brief Rysuje wynik tak jak Engine::updateScoreText.
+     *
+     * @param score Wynik.
+     */
+    void drawScore(std::uint32_t score);
+
+    bool ready; /**< Czy tekstury zostały wczytane. */
+    Bitmap backgrounds[4]; /**< Tła, indeksowane poziomem trudności. */
+    Bitmap upperPipe; /**< Rura górna. */
+    Bitmap lowerPipe; /**< Rura dolna (odwrócona). */
+    Bitmap coin; /**< Moneta. */
+    Bitmap ground; /**< Ziemia. */
+    Bitmap birds[3]; /**< Klatki ptaka, wiersz modelu: trzy pozycje skrzydeł obok siebie. */
+    Bitmap getReady[2]; /**< Ekrany "Get Ready". */
+    Bitmap gameover; /**< Napis końca gry. */
+    Bitmap restart; /**< Przycisk restartu. */
+    std::vector<std::uint8_t> frame; /**< Klatka pełnej rozdzielczości dla renderGray. */
+    std::vector<std::uint16_t> columnSums; /**< Sumy kanałów kolumn klatki w pasie wiersza wyniku. */
+    std::vector<int> grayColumns; /**< Granice kolumn klatki przypadających na kolumny wyniku. */
+    std::uint8_t* target; /**< Bufor rysowanej klatki. */
+
+    struct Font;
+    Font* font; /**< Czcionka wyniku lub nullptr bez FreeType. */
+};
+
+#endif
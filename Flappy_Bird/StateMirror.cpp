@@ -0,0 +1,133 @@
+/**
+ * @file StateMirror.cpp
+ * @brief Implementacja segmentu pamięci współdzielonej ze stanem gry.
+ */
+
+#include "StateMirror.h"
+#include <cstring>
+#include <new>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "Slowa w pamieci wspoldzielonej musza byc bez blokad");
+
+StateMirrorBlock StateMirror::localBlock{}; /**< Blok zastępczy */
+StateMirrorBlock* StateMirror::block = &StateMirror::localBlock; /**< Aktualny blok */
+bool StateMirror::shared = false; /**< Czy blok jest w pamięci współdzielonej */
+
+/**
+ * @brief Zwraca nazwę segmentu dla podanego procesu
+ *
+ * @param pid Identyfikator procesu
+ * @return Nazwa segmentu
+ */
+std::string StateMirror::segmentName(std::uint64_t pid) {
+    return "/flappy_state." + std::to_string(pid);
+}
+
+/**
+ * @brief Tworzy i mapuje segment pamięci współdzielonej
+ *
+ * @return true jeśli segment został utworzony
+ */
+bool StateMirror::open() {
+#ifdef _WIN32
+    return false;
+#else
+    if (shared) return true;
+
+    auto pid = (std::uint64_t)getpid();
+    auto name = segmentName(pid);
+    int fd = shm_open(name.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
+    if (fd < 0) return false;
+
+    if (ftruncate(fd, sizeof(StateMirrorBlock)) != 0) {
+        ::close(fd);
+        shm_unlink(name.c_str());
+        return false;
+    }
+
+    void* data = mmap(nullptr, sizeof(StateMirrorBlock), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        shm_unlink(name.c_str());
+        return false;
+    }
+
+    auto* mapped = new (data) StateMirrorBlock{};
+    mapped->size = sizeof(StateMirrorBlock);
+    mapped->pid = pid;
+    std::atomic_thread_fence(std::memory_order_release);
+    mapped->magic = StateMirrorBlock::magicValue;
+
+    block = mapped;
+    shared = true;
+    return true;
+#endif
+}
+
+/**
+ * @brief Odmapowuje i usuwa segment pamięci współdzielonej
+ */
+void StateMirror::close() {
+#ifndef _WIN32
+    if (!shared) return;
+    auto name = segmentName(block->pid);
+    munmap(block, sizeof(StateMirrorBlock));
+    shm_unlink(name.c_str());
+#endif
+    block = &localBlock;
+    shared = false;
+}
+
+/**
+ * @brief Publikuje migawkę stanu
+ *
+ * @param state Migawka
+ */
+void StateMirror::publish(const MirrorState& state) {
+    std::uint64_t words[StateMirrorBlock::words];
+    std::memcpy(words, &state, sizeof(state));
+
+    auto& b = *block;
+    std::uint64_t sequence = b.sequence.load(std::memory_order_relaxed);
+    b.sequence.store(sequence + 1, std::memory_order_relaxed);
+    // Nieparzysty licznik musi być widoczny przed którymkolwiek słowem nowej migawki.
+    std::atomic_thread_fence(std::memory_order_release);
+    for (std::size_t i = 0; i < StateMirrorBlock::words; ++i) {
+        b.data[i].store(words[i], std::memory_order_relaxed);
+    }
+    b.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+/**
+ * @brief Odczytuje spójną migawkę z bloku
+ *
+ * @param block Blok
+ * @param state Wynik
+ * @param sequence Licznik sekwencji odczytanej migawki
+ * @param maxAttempts Największa liczba prób
+ * @return false jeśli każda próba trafiła na zapis
+ */
+bool StateMirror::read(const StateMirrorBlock& block, MirrorState& state, std::uint64_t& sequence, unsigned maxAttempts) {
+    std::uint64_t words[StateMirrorBlock::words];
+    for (unsigned attempt = 0; attempt < maxAttempts; ++attempt) {
+        std::uint64_t before = block.sequence.load(std::memory_order_acquire);
+        if (before & 1) continue;
+        for (std::size_t i = 0; i < StateMirrorBlock::words; ++i) {
+            words[i] = block.data[i].load(std::memory_order_relaxed);
+        }
+        // Słowa migawki muszą zostać odczytane przed ponownym sprawdzeniem licznika.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (block.sequence.load(std::memory_order_relaxed) == before) {
+            std::memcpy(&state, words, sizeof(state));
+            sequence = before;
+            return true;
+        }
+    }
+    return false;
+}
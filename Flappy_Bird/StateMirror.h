@@ -0,0 +1,133 @@
+/**
+ * @file StateMirror.h
+ * @brief Stan gry publikowany w pamięci współdzielonej dla zewnętrznych podglądów.
+ */
+
+#pragma once
+#ifndef STATEMIRROR_H
+#define STATEMIRROR_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+/**
+ * @brief Rura w publikowanym stanie gry.
+ */
+struct MirrorPipe {
+    float x; /**< Pozycja X rury. */
+    float y; /**< Pozycja Y rury (jak w PipeState). */
+    float throat; /**< Gardło rury: odległość górnej i dolnej rury od y. */
+    std::uint8_t scored; /**< Czy rura została minięta. */
+    std::uint8_t coinVisible; /**< Czy moneta jest widoczna. */
+    std::uint8_t reserved[2]; /**< Wypełnienie, zawsze zera. */
+};
+
+/**
+ * @brief Migawka stanu gry publikowana co krok.
+ */
+struct MirrorState {
+    static constexpr std::uint32_t maxPipes = 5; /**< Pojemność tablicy rur (Engine::maxPipes). */
+
+    /**
+     * @brief Flagi ekranów i stanu rozgrywki.
+     */
+    enum Flags : std::uint8_t {
+        MainMenu = 1, /**< Menu główne. */
+        GetReady = 2, /**< Ekran "Get Ready". */
+        Paused = 4, /**< Pauza. */
+        Running = 8, /**< Gra rozpoczęta. */
+        GameOver = 16 /**< Gra zakończona. */
+    };
+
+    std::uint64_t seed; /**< Ziarno rozgrywki. */
+    std::uint32_t ticks; /**< Kroki symulacji od startu rozgrywki. */
+    std::int32_t score; /**< Wynik. */
+    float birdY; /**< Pozycja Y ptaka. */
+    float birdVel; /**< Prędkość pionowa ptaka. */
+    std::uint32_t pipeCount; /**< Liczba rur. */
+    std::uint8_t difficulty; /**< Poziom trudności (wartość Difficulty). */
+    std::uint8_t flags; /**< Suma flag Flags. */
+    std::uint8_t reserved[2]; /**< Wypełnienie, zawsze zera. */
+    MirrorPipe pipes[maxPipes]; /**< Rury, od najstarszej. */
+};
+
+static_assert(std::is_trivially_copyable<MirrorState>::value, "MirrorState jest kopiowany slowami");
+static_assert(sizeof(MirrorState) % sizeof(std::uint64_t) == 0, "MirrorState musi miec rozmiar podzielny przez 8");
+
+/**
+ * @brief Blok z migawką stanu chronioną blokadą sekwencyjną (seqlock).
+ *
+ * Jedynym piszącym jest silnik: nieparzysty licznik sekwencji oznacza trwający
+ * zapis. Czytelnik kopiuje migawkę i sprawdza, czy licznik przed i po kopii jest
+ * ten sam i parzysty - jeśli nie, kopiuje jeszcze raz. Zapis nigdy nie czeka na
+ * czytelników, więc podgląd nie wpływa na czas klatki gry, a czytelnik nie
+ * potrzebuje blokad ani wywołań systemowych. Migawka jest przechowywana jako
+ * słowa atomowe, żeby równoczesny zapis i odczyt nie były wyścigiem danych.
+ */
+struct StateMirrorBlock {
+    static constexpr std::uint32_t magicValue = 0x46425331; /**< Sygnatura "FBS1". */
+    static constexpr std::size_t words = sizeof(MirrorState) / sizeof(std::uint64_t); /**< Rozmiar migawki w słowach. */
+
+    std::uint32_t magic; /**< Sygnatura bloku, ustawiana po inicjalizacji. */
+    std::uint32_t size; /**< Rozmiar struktury, do kontroli zgodności wersji. */
+    std::uint64_t pid; /**< Identyfikator procesu gry. */
+
+    alignas(64) std::atomic<std::uint64_t> sequence; /**< Licznik sekwencji; nieparzysty w trakcie zapisu. */
+    std::atomic<std::uint64_t> data[words]; /**< Migawka MirrorState. */
+};
+
+/**
+ * @brief Publikowanie stanu gry bieżącego procesu i jego odczyt.
+ *
+ * Tak jak Metrics: segment jest tworzony raz przy starcie (StateMirror::open),
+ * a gdy nie da się go utworzyć, stan trafia do lokalnego bloku w pamięci procesu.
+ */
+class StateMirror {
+public:
+    /**
+     * @brief Tworzy i mapuje segment pamięci współdzielonej dla bieżącego procesu.
+     *
+     * @return true jeśli segment został utworzony.
+     */
+    static bool open();
+
+    /**
+     * @brief Odmapowuje i usuwa segment pamięci współdzielonej.
+     */
+    static void close();
+
+    /**
+     * @brief Zwraca nazwę segmentu dla podanego procesu.
+     *
+     * @param pid Identyfikator procesu.
+     * @return Nazwa segmentu pamięci współdzielonej.
+     */
+    static std::string segmentName(std::uint64_t pid);
+
+    /**
+     * @brief Publikuje migawkę stanu. Nie blokuje i nie wywołuje funkcji systemowych.
+     *
+     * @param state Migawka.
+     */
+    static void publish(const MirrorState& state);
+
+    /**
+     * @brief Odczytuje spójną migawkę z bloku.
+     *
+     * @param block Blok (zwykle zmapowany z innego procesu).
+     * @param state Wynik.
+     * @param sequence Licznik sekwencji odczytanej migawki (rośnie o 2 z każdą publikacją).
+     * @param maxAttempts Największa liczba prób; zapis trwa ułamek mikrosekundy, więc kilka wystarcza.
+     * @return false jeśli w maxAttempts próbach każda trafiła na zapis.
+     */
+    static bool read(const StateMirrorBlock& block, MirrorState& state, std::uint64_t& sequence, unsigned maxAttempts = 1000);
+
+private:
+    static StateMirrorBlock* block; /**< Aktualnie używany blok. */
+    static StateMirrorBlock localBlock; /**< Blok zastępczy, gdy segment nie jest dostępny. */
+    static bool shared; /**< Flaga określająca, czy block wskazuje na segment współdzielony. */
+};
+
+#endif
@@ -0,0 +1,138 @@
+/**
+ * @file WorkStealingPool.cpp
+ * @brief Implementacja puli wątków z podkradaniem zadań.
+ */
+
+#include "WorkStealingPool.h"
+#include <algorithm>
+
+namespace {
+
+thread_local int workerIndex = -1; /**< Numer wątku puli, -1 poza pulą. */
+
+}
+
+/**
+ * @brief Konstruktor klasy WorkStealingPool
+ *
+ * @param threads Liczba wątków
+ */
+WorkStealingPool::WorkStealingPool(unsigned threads)
+        : threadCount(threads ? threads : std::max(1u, std::thread::hardware_concurrency())),
+          queues(new Queue[threadCount]), nextQueue(0), pending(0), steals(0), stopping(false) {
+    for (unsigned i = 0; i < threadCount; ++i) {
+        this->threads.emplace_back(&WorkStealingPool::work, this, i);
+    }
+}
+
+/**
+ * @brief Destruktor klasy WorkStealingPool
+ */
+WorkStealingPool::~WorkStealingPool() {
+    wait();
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    delete[] queues;
+}
+
+/**
+ * @brief Zwraca numer bieżącego wątku puli
+ *
+ * @return Numer wątku lub -1
+ */
+int WorkStealingPool::currentWorker() {
+    return workerIndex;
+}
+
+/**
+ * @brief Zleca zadanie
+ *
+ * @param task Zadanie
+ */
+void WorkStealingPool::submit(std::function<void()> task) {
+    pending.fetch_add(1);
+    unsigned target = workerIndex >= 0 ? (unsigned)workerIndex : nextQueue.fetch_add(1) % threadCount;
+    {
+        std::lock_guard<std::mutex> lock(queues[target].mutex);
+        queues[target].tasks.push_back(std::move(task));
+    }
+    // Blokada stateMutex zapewnia, że wątek zasypiający w work() nie przegapi powiadomienia.
+    { std::lock_guard<std::mutex> lock(stateMutex); }
+    wakeUp.notify_one();
+}
+
+/**
+ * @brief Czeka na zakończenie wszystkich zadań
+ */
+void WorkStealingPool::wait() {
+    std::unique_lock<std::mutex> lock(stateMutex);
+    idle.wait(lock, [this] { return pending.load() == 0; });
+}
+
+/**
+ * @brief Pobiera zadanie z własnej kolejki albo podkrada je innemu wątkowi
+ *
+ * @param index Numer wątku
+ * @param task Miejsce na zadanie
+ * @return true jeśli znaleziono zadanie
+ */
+bool WorkStealingPool::take(unsigned index, std::function<void()>& task) {
+    {
+        Queue& own = queues[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+    for (unsigned i = 1; i < threadCount; ++i) {
+        Queue& victim = queues[(index + i) % threadCount];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            steals.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Pętla wątku
+ *
+ * @param index Numer wątku
+ */
+void WorkStealingPool::work(unsigned index) {
+    workerIndex = (int)index;
+    std::function<void()> task;
+    while (true) {
+        if (take(index, task)) {
+            task();
+            task = nullptr;
+            if (pending.fetch_sub(1) == 1) {
+                { std::lock_guard<std::mutex> lock(stateMutex); }
+                idle.notify_all();
+            }
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(stateMutex);
+        if (stopping) return;
+        // Zadanie mogło zostać zlecone między take() a zablokowaniem stateMutex.
+        bool queued = false;
+        for (unsigned i = 0; i < threadCount && !queued; ++i) {
+            std::lock_guard<std::mutex> queueLock(queues[i].mutex);
+            queued = !queues[i].tasks.empty();
+        }
+        if (!queued) {
+            wakeUp.wait(lock);
+        }
+    }
+}
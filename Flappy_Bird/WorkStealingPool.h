@@ -0,0 +1,121 @@
+/**
+ * @file WorkStealingPool.h
+ * @brief Pula wątków z podkradaniem zadań.
+ */
+
+#pragma once
+#ifndef WORKSTEALINGPOOL_H
+#define WORKSTEALINGPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Pula wątków, w której bezczynny wątek podkrada zadania innym.
+ *
+ * Każdy wątek ma własną kolejkę. Zadania zlecane z zewnątrz trafiają do kolejek
+ * po kolei, a zadania zlecane z wnętrza zadania - do kolejki bieżącego wątku.
+ * Wątek bierze zadania z końca własnej kolejki (ostatnio dodane, z ciepłą pamięcią
+ * podręczną), a gdy jest pusta, podkrada z początku kolejki innego wątku. Dzięki temu
+ * zadania o bardzo różnym czasie (krótkie i długie rozgrywki) nie zostawiają
+ * bezczynnych rdzeni, gdy reszta pracy czeka w jednej kolejce.
+ *
+ * Kolejki są chronione osobnymi blokadami, więc wątki konkurują o blokadę tylko
+ * przy podkradaniu. Zadania powinny być na tyle duże (np. partia rozgrywek), żeby
+ * koszt blokady był pomijalny.
+ */
+class WorkStealingPool {
+public:
+    /**
+     * @brief Konstruktor klasy WorkStealingPool. Uruchamia wątki.
+     *
+     * @param threads Liczba wątków (0 - po jednym na rdzeń).
+     */
+    explicit WorkStealingPool(unsigned threads = 0);
+
+    /**
+     * @brief Destruktor klasy WorkStealingPool. Czeka na wszystkie zadania i zatrzymuje wątki.
+     */
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    /**
+     * @brief Zleca zadanie.
+     *
+     * @param task Zadanie.
+     */
+    void submit(std::function<void()> task);
+
+    /**
+     * @brief Czeka, aż wszystkie zlecone zadania się zakończą.
+     */
+    void wait();
+
+    /**
+     * @brief Zwraca liczbę wątków.
+     *
+     * @return Liczba wątków.
+     */
+    unsigned size() const { return threadCount; }
+
+    /**
+     * @brief Zwraca numer bieżącego wątku puli.
+     *
+     * @return Numer z zakresu [0, size()) albo -1 poza wątkami puli.
+     */
+    static int currentWorker();
+
+    /**
+     * @brief Zwraca liczbę zadań podkradzionych z cudzych kolejek.
+     *
+     * @return Liczba podkradzionych zadań.
+     */
+    std::uint64_t getSteals() const { return steals.load(std::memory_order_relaxed); }
+
+private:
+    /**
+     * @brief Kolejka zadań jednego wątku.
+     */
+    struct Queue {
+        std::mutex mutex; /**< Chroni zadania. */
+        std::deque<std::function<void()>> tasks; /**< Zadania. */
+    };
+
+    /**
+     * @brief Pętla wątku.
+     *
+     * @param index Numer wątku.
+     */
+    void work(unsigned index);
+
+    /**
+     * @brief Pobiera zadanie z własnej kolejki albo podkrada je innemu wątkowi.
+     *
+     * @param index Numer wątku.
+     * @param task Miejsce na zadanie.
+     * @return true jeśli znaleziono zadanie.
+     */
+    bool take(unsigned index, std::function<void()>& task);
+
+    unsigned threadCount; /**< Liczba wątków. */
+    Queue* queues; /**< Kolejki wątków. */
+    std::vector<std::thread> threads; /**< Wątki. */
+    std::atomic<unsigned> nextQueue; /**< Kolejka następnego zadania zleconego z zewnątrz. */
+
+    std::mutex stateMutex; /**< Chroni stopping, służy do usypiania wątków. */
+    std::condition_variable wakeUp; /**< Budzi wątki, gdy pojawia się zadanie. */
+    std::condition_variable idle; /**< Budzi wait(), gdy nie ma już zadań. */
+    std::atomic<std::uint64_t> pending; /**< Zadania zlecone i jeszcze niezakończone. */
+    std::atomic<std::uint64_t> steals; /**< Liczba podkradzionych zadań. */
+    bool stopping; /**< Czy wątki mają się zakończyć. */
+};
+
+#endif
@@ -0,0 +1,133 @@
+/**
+ * @file alloc_cases.cpp
+ * @brief Sprawdzenie, że pętla gry po rozgrzewce nie alokuje pamięci.
+ *
+ * Użycie: Flappy_Bird_alloc_cases [katalog_roboczy]
+ *
+ * Program gra bez okna i dźwięku na GameCore - tej samej części silnika, z której
+ * korzysta Engine: EntityWorld, kolejka zdarzeń, Scheduler z zegarami rur
+ * i animacji, GeneratedCourse, ScoreLedger i Metrics. Bot gra kolejne gry
+ * (machnięcia, rury, monety, śmierć, zapis wyniku, restart), a AllocTracker zlicza
+ * alokacje. Po rozgrzewce każda alokacja jest błędem; program zwraca wtedy 1
+ * i wypisuje pierwszą klatkę, w której do niej doszło. Rysowanie sprawdza
+ * draw_alloc_cases.
+ */
+
+#include <cstdio>
+#include <string>
+#include "AllocTracker.h"
+#include "Bots.h"
+#include "Course.h"
+#include "DifficultyRules.h"
+#include "GameCore.h"
+#include "ScoreLedger.h"
+
+namespace {
+
+constexpr float frameTime = 1.0f / 60.0f; /**< Czas klatki. */
+constexpr int warmupFrames = 3600; /**< Klatki rozgrzewki (jak allocWarmupFrames w Engine, z zapasem na kilka gier). */
+constexpr int checkedFrames = 60 * 60 * 5; /**< Klatki sprawdzane po rozgrzewce. */
+constexpr Difficulty difficulty = Difficulty::Hard; /**< Poziom trudności, na którym bot ginie co kilkanaście sekund. */
+
+/**
+ * @brief Gra bez okna sterowana botem, jak Engine z FLAPPY_BOT.
+ */
+class HeadlessGame : public GameCore {
+public:
+    /**
+     * @brief Konstruktor klasy HeadlessGame.
+     *
+     * @param ledgerPath Ścieżka dziennika wyników.
+     */
+    explicit HeadlessGame(const std::string& ledgerPath)
+            : scores(ledgerPath, 4), bot(Bots::casual, 11), games(0), restartTimer(Scheduler::noTimer) {
+        course = &generated;
+        ledger = &scores;
+        SetDifficulty(difficulty);
+        SetThroatDifficulty(rulesFor(difficulty).throat);
+        reseed(1);
+    }
+
+    /**
+     * @brief Wykonuje jedną klatkę: decyzję bota i krok gry, jak Engine::steerBot i Engine::update.
+     */
+    void frame() {
+        if (gameOvered) {
+            if (restartTimer == Scheduler::noTimer) {
+                restartTimer = scheduler.schedule(1.0, &HeadlessGame::onRestartTimer, this);
+            }
+        } else if (!gameRunning || bot(toWorld())) {
+            flap();
+        }
+        const bool wasRecorded = scoreRecorded;
+        update(frameTime);
+        if (scoreRecorded && !wasRecorded) games++;
+    }
+
+    std::uint32_t finishedGames() const { return games; } /**< Liczba zakończonych gier. */
+    bool writing() const { return scores.isOpen(); } /**< Czy dziennik przyjmuje wyniki. */
+
+private:
+    GeneratedCourse generated; /**< Tor. */
+    ScoreLedger scores; /**< Dziennik wyników. */
+    Bots::Human bot; /**< Gracz. */
+    std::uint32_t games; /**< Liczba zakończonych gier. */
+    Scheduler::TimerId restartTimer; /**< Zegar restartu. */
+
+    static void onRestartTimer(void* game) {
+        auto* self = static_cast<HeadlessGame*>(game);
+        self->restartTimer = Scheduler::noTimer;
+        self->restart(self->seed + 1);
+    }
+};
+
+}
+
+/**
+ * @brief Punkt wejścia narzędzia.
+ *
+ * @param argc Liczba argumentów.
+ * @param argv Argumenty wywołania.
+ * @return 0 jeśli po rozgrzewce nie było żadnej alokacji.
+ */
+int main(int argc, char** argv) {
+    if (!AllocTracker::enabled()) {
+        std::fprintf(stderr, "Program zbudowano bez FLAPPY_TRACK_ALLOCS\n");
+        return 1;
+    }
+    const std::string dir = argc > 1 ? argv[1] : ".";
+    const std::string ledgerPath = dir + "/alloc_cases.bin";
+    std::remove(ledgerPath.c_str());
+
+    HeadlessGame game(ledgerPath);
+    if (!game.writing()) {
+        std::fprintf(stderr, "Nie udalo sie otworzyc %s\n", ledgerPath.c_str());
+        return 1;
+    }
+    for (int i = 0; i < warmupFrames; ++i) game.frame();
+    const std::uint32_t warmupGames = game.finishedGames();
+
+    std::uint64_t allocations = 0;
+    int firstFrame = -1;
+    for (int i = 0; i < checkedFrames; ++i) {
+        std::uint64_t before = AllocTracker::allocations();
+        game.frame();
+        std::uint64_t frameAllocations = AllocTracker::allocations() - before;
+        if (frameAllocations && firstFrame < 0) firstFrame = i;
+        allocations += frameAllocations;
+    }
+    const std::uint32_t checkedGames = game.finishedGames() - warmupGames;
+
+    std::printf("%d klatek po rozgrzewce, %u gier, %llu alokacji\n", checkedFrames, checkedGames,
+                (unsigned long long)allocations);
+    if (allocations) {
+        std::fprintf(stderr, "Pierwsza alokacja w klatce %d po rozgrzewce\n", firstFrame);
+        return 1;
+    }
+    // Bez kilku restartów test nie sprawdzałby zapisu wyniku ani powrotu do menu.
+    if (warmupGames < 1 || checkedGames < 2) {
+        std::fprintf(stderr, "Bot nie zakonczyl dosc gier (%u w rozgrzewce, %u po niej)\n", warmupGames, checkedGames);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,310 @@
+/**
+ * @file arena_load.cpp
+ * @brief Generator obciążenia serwera areny.
+ *
+ * Użycie:
+ *   Flappy_Bird_arena_load [--socket ścieżka] [--sessions N] [--games G] [--seconds S] [--threads T] [--difficulty 0-3]
+ *
+ * Program otwiera N połączeń (sesji botów, domyślnie 1000), w każdej G gier,
+ * i przez S sekund wysyła żądania Step, każde zaraz po odpowiedzi na poprzednie.
+ * Akcje wybiera bot podobny do Bots::casual (cel z losowym błędem do 30 pikseli)
+ * na podstawie obserwacji z odpowiedzi, więc gry się kończą i zaczynają od nowa.
+ * Na końcu wypisuje liczbę kroków gier i zakończonych gier na sekundę oraz rozkład
+ * czasu odpowiedzi na Step (od wysłania żądania do odebrania całej odpowiedzi).
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Arena.h"
+#include "Simulation.h"
+
+#ifdef __linux__
+#include <cerrno>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief Ustawienia generatora.
+ */
+struct Options {
+    std::string socket = Arena::defaultSocket; /**< Ścieżka gniazda serwera. */
+    unsigned sessions = 1000; /**< Liczba połączeń. */
+    unsigned games = 16; /**< Liczba gier w sesji. */
+    double seconds = 10; /**< Czas pomiaru. */
+    unsigned threads = 2; /**< Liczba wątków klienta. */
+    int difficulty = 1; /**< Poziom trudności. */
+};
+
+/**
+ * @brief Połączenie z serwerem i jego bufory.
+ */
+struct Session {
+    int fd = -1; /**< Gniazdo. */
+    std::uint32_t sequence = 0; /**< Numer ostatniego żądania. */
+    std::uint32_t rng = 1; /**< Stan generatora błędu celowania. */
+    Clock::time_point sentAt; /**< Chwila wysłania ostatniego żądania. */
+    std::vector<std::uint8_t> request; /**< Żądanie Step. */
+    std::vector<std::uint8_t> response; /**< Odbierana odpowiedź. */
+    std::size_t received = 0; /**< Liczba odebranych bajtów odpowiedzi. */
+};
+
+/**
+ * @brief Wynik jednego wątku klienta.
+ */
+struct ThreadResult {
+    std::vector<std::uint32_t> latenciesUs; /**< Czasy odpowiedzi na Step. */
+    std::uint64_t gameSteps = 0; /**< Kroki gier. */
+    std::uint64_t gamesFinished = 0; /**< Zakończone gry. */
+    bool failed = false; /**< Czy wystąpił błąd połączenia lub protokołu. */
+};
+
+#ifdef __linux__
+
+/**
+ * @brief Łączy się z serwerem.
+ *
+ * @param path Ścieżka gniazda.
+ * @return Deskryptor lub -1.
+ */
+int connectTo(const std::string& path) {
+    sockaddr_un addr{};
+    if (path.size() >= sizeof(addr.sun_path)) return -1;
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -1;
+    if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/**
+ * @brief Wysyła całe żądanie sesji.
+ *
+ * @param session Sesja.
+ * @param size Rozmiar żądania.
+ * @return false przy błędzie.
+ */
+bool sendRequest(Session& session, std::size_t size) {
+    session.sentAt = Clock::now();
+    std::size_t sent = 0;
+    while (sent < size) {
+        ssize_t n = send(session.fd, session.request.data() + sent, size - sent, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        sent += (std::size_t)n;
+    }
+    return true;
+}
+
+/**
+ * @brief Wybiera akcje bota na podstawie obserwacji z odpowiedzi i zapisuje je w żądaniu Step.
+ *
+ * @param session Sesja z kompletną odpowiedzią.
+ * @param games Liczba gier.
+ */
+void chooseActions(Session& session, unsigned games) {
+    const std::uint8_t* observations = session.response.data() + sizeof(ArenaHeader);
+    std::uint8_t* actions = session.request.data() + sizeof(ArenaHeader);
+    for (unsigned i = 0; i < games; ++i) {
+        float obs[FLAPPY_ENV_OBS_SIZE];
+        std::memcpy(obs, observations + i * sizeof(obs), sizeof(obs));
+        float target = (obs[3] + obs[4]) / 2 + (float)(Simulation::nextRandom(session.rng) % 61) - 30;
+        actions[i] = obs[1] >= 0 && obs[0] + Physics::birdHeight / 2 > target + 10;
+    }
+    ArenaHeader header{ArenaHeader::magicValue, static_cast<std::uint8_t>(ArenaMessage::Step), 0,
+                       (std::uint16_t)games, ++session.sequence};
+    std::memcpy(session.request.data(), &header, sizeof(header));
+}
+
+/**
+ * @brief Prowadzi sesje jednego wątku: Open, a potem Step do upływu czasu.
+ *
+ * @param options Ustawienia.
+ * @param sessions Sesje wątku (już połączone).
+ * @param warmupEnd Koniec rozgrzewki - pomiar obejmuje tylko późniejsze odpowiedzi.
+ * @param end Koniec pomiaru.
+ * @param result Wynik wątku.
+ */
+void drive(const Options& options, std::vector<Session>& sessions, Clock::time_point warmupEnd,
+           Clock::time_point end, ThreadResult& result) {
+    int epollFd = epoll_create1(EPOLL_CLOEXEC);
+    const std::size_t responseSize = sizeof(ArenaHeader) + Arena::resultSize(options.games);
+    for (std::size_t i = 0; i < sessions.size(); ++i) {
+        Session& session = sessions[i];
+        session.rng = (std::uint32_t)(i * 2654435761u) | 1u;
+        session.request.assign(sizeof(ArenaHeader) + options.games, 0);
+        session.response.assign(responseSize, 0);
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.u64 = i;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, session.fd, &event);
+
+        ArenaHeader open{ArenaHeader::magicValue, static_cast<std::uint8_t>(ArenaMessage::Open),
+                         (std::uint8_t)options.difficulty, (std::uint16_t)options.games, (std::uint32_t)(i * 7919 + 1)};
+        std::memcpy(session.request.data(), &open, sizeof(open));
+        if (!sendRequest(session, sizeof(open))) {
+            result.failed = true;
+        }
+    }
+
+    epoll_event events[256];
+    std::size_t active = sessions.size();
+    while (active > 0 && !result.failed) {
+        int n = epoll_wait(epollFd, events, 256, 1000);
+        for (int e = 0; e < n; ++e) {
+            Session& session = sessions[events[e].data.u64];
+            ssize_t got = recv(session.fd, session.response.data() + session.received,
+                               session.response.size() - session.received, MSG_DONTWAIT);
+            if (got < 0 && (errno == EAGAIN || errno == EINTR)) continue;
+            if (got <= 0) {
+                result.failed = true;
+                break;
+            }
+            session.received += (std::size_t)got;
+            if (session.received < sizeof(ArenaHeader)) continue;
+
+            ArenaHeader header;
+            std::memcpy(&header, session.response.data(), sizeof(header));
+            if (header.arg != static_cast<std::uint8_t>(ArenaStatus::Ok)) {
+                std::fprintf(stderr, "Serwer odrzucil zadanie: status %u\n", header.arg);
+                result.failed = true;
+                break;
+            }
+            if (session.received < responseSize) continue;
+            session.received = 0;
+
+            Clock::time_point now = Clock::now();
+            if (header.type == static_cast<std::uint8_t>(ArenaMessage::Step) && now > warmupEnd) {
+                auto us = std::chrono::duration_cast<std::chrono::microseconds>(now - session.sentAt).count();
+                result.latenciesUs.push_back((std::uint32_t)us);
+                result.gameSteps += options.games;
+                const std::uint8_t* dones = session.response.data() + responseSize - options.games;
+                for (unsigned i = 0; i < options.games; ++i) {
+                    result.gamesFinished += dones[i];
+                }
+            }
+            if (now >= end) {
+                epoll_ctl(epollFd, EPOLL_CTL_DEL, session.fd, nullptr);
+                active--;
+                continue;
+            }
+            chooseActions(session, options.games);
+            if (!sendRequest(session, session.request.size())) {
+                result.failed = true;
+                break;
+            }
+        }
+    }
+    close(epollFd);
+}
+
+#endif
+
+/**
+ * @brief Zwraca kwantyl posortowanych czasów.
+ *
+ * @param sorted Posortowane czasy.
+ * @param q Kwantyl z zakresu [0, 1].
+ * @return Czas w mikrosekundach.
+ */
+std::uint32_t quantile(const std::vector<std::uint32_t>& sorted, double q) {
+    if (sorted.empty()) return 0;
+    return sorted[std::min(sorted.size() - 1, (std::size_t)(q * (double)sorted.size()))];
+}
+
+}
+
+/**
+ * @brief Punkt wejścia generatora.
+ *
+ * @param argc Liczba argumentów.
+ * @param argv Argumenty wywołania.
+ * @return Kod zakończenia programu.
+ */
+int main(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--socket") == 0) options.socket = argv[i + 1];
+        else if (std::strcmp(argv[i], "--sessions") == 0) options.sessions = (unsigned)std::strtoul(argv[i + 1], nullptr, 10);
+        else if (std::strcmp(argv[i], "--games") == 0) options.games = (unsigned)std::strtoul(argv[i + 1], nullptr, 10);
+        else if (std::strcmp(argv[i], "--seconds") == 0) options.seconds = std::atof(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--threads") == 0) options.threads = (unsigned)std::strtoul(argv[i + 1], nullptr, 10);
+        else if (std::strcmp(argv[i], "--difficulty") == 0) options.difficulty = std::atoi(argv[i + 1]);
+    }
+    options.sessions = std::max(1u, options.sessions);
+    options.games = std::min<unsigned>(std::max(1u, options.games), Arena::maxGames);
+    options.threads = std::min(std::max(1u, options.threads), options.sessions);
+
+#ifndef __linux__
+    std::fprintf(stderr, "Generator obciazenia wymaga Linuksa (epoll)\n");
+    return 1;
+#else
+    std::vector<std::vector<Session>> perThread(options.threads);
+    for (unsigned i = 0; i < options.sessions; ++i) {
+        Session session;
+        session.fd = connectTo(options.socket);
+        if (session.fd < 0) {
+            std::fprintf(stderr, "Nie udalo sie polaczyc z %s (sesja %u)\n", options.socket.c_str(), i);
+            for (auto& sessions : perThread) {
+                for (auto& s : sessions) close(s.fd);
+            }
+            return 1;
+        }
+        perThread[i % options.threads].push_back(std::move(session));
+    }
+
+    // Pierwsza sekunda jest rozgrzewką: wszystkie sesje wysyłają Open naraz.
+    Clock::time_point warmupEnd = Clock::now() + std::chrono::seconds(1);
+    Clock::time_point end = warmupEnd + std::chrono::microseconds((std::int64_t)(options.seconds * 1e6));
+    std::vector<ThreadResult> results(options.threads);
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < options.threads; ++t) {
+        threads.emplace_back([&, t] { drive(options, perThread[t], warmupEnd, end, results[t]); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (auto& sessions : perThread) {
+        for (auto& session : sessions) close(session.fd);
+    }
+
+    std::vector<std::uint32_t> latencies;
+    std::uint64_t gameSteps = 0, gamesFinished = 0;
+    bool failed = false;
+    for (const auto& result : results) {
+        latencies.insert(latencies.end(), result.latenciesUs.begin(), result.latenciesUs.end());
+        gameSteps += result.gameSteps;
+        gamesFinished += result.gamesFinished;
+        failed = failed || result.failed;
+    }
+    std::sort(latencies.begin(), latencies.end());
+
+    std::printf("sesje %u x %u gier, %.1f s\n", options.sessions, options.games, options.seconds);
+    std::printf("zadania Step:     %10.0f/s\n", (double)latencies.size() / options.seconds);
+    std::printf("kroki gier:       %10.0f/s\n", (double)gameSteps / options.seconds);
+    std::printf("zakonczone gry:   %10.0f/s\n", (double)gamesFinished / options.seconds);
+    std::printf("czas odpowiedzi:  p50 %u us, p99 %u us, maks. %u us\n",
+                quantile(latencies, 0.5), quantile(latencies, 0.99), latencies.empty() ? 0 : latencies.back());
+    if (failed) {
+        std::fprintf(stderr, "Blad polaczenia lub protokolu - wyniki niepelne\n");
+        return 1;
+    }
+    return 0;
+#endif
+}
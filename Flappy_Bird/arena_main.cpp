@@ -0,0 +1,89 @@
+/**
+ * @file arena_main.cpp
+ * @brief Serwer areny dla botów w osobnych procesach.
+ *
+ * Użycie:
+ *   Flappy_Bird_arena [--socket ścieżka] [--workers N]
+ *
+ * Serwer działa do SIGINT lub SIGTERM i wypisuje co 5 sekund liczbę kroków
+ * i zakończonych gier. Protokół jest opisany w Arena.h; obciążenie można
+ * sprawdzić programem Flappy_Bird_arena_load.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include "Arena.h"
+
+namespace {
+
+ArenaServer* server = nullptr; /**< Serwer zatrzymywany przez obsługę sygnału. */
+
+/**
+ * @brief Obsługa SIGINT i SIGTERM.
+ */
+void onSignal(int) {
+    if (server) server->requestStop();
+}
+
+}
+
+/**
+ * @brief Punkt wejścia serwera.
+ *
+ * @param argc Liczba argumentów.
+ * @param argv Argumenty wywołania.
+ * @return Kod zakończenia programu.
+ */
+int main(int argc, char** argv) {
+    std::string path = Arena::defaultSocket;
+    unsigned workers = 0;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--socket") == 0) path = argv[i + 1];
+        else if (std::strcmp(argv[i], "--workers") == 0) workers = (unsigned)std::strtoul(argv[i + 1], nullptr, 10);
+    }
+
+    ArenaServer arena(workers);
+    if (!arena.start(path)) {
+        std::fprintf(stderr, "Nie udalo sie uruchomic serwera na %s\n", path.c_str());
+        return 1;
+    }
+    server = &arena;
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+    std::printf("Arena nasluchuje na %s\n", path.c_str());
+    std::fflush(stdout);
+
+    std::atomic<bool> reporting{true};
+    std::thread report([&arena, &reporting] {
+        std::uint64_t lastSteps = 0;
+        auto last = std::chrono::steady_clock::now();
+        while (true) {
+            for (int i = 0; i < 50 && reporting; ++i) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            }
+            if (!reporting) return;
+            auto now = std::chrono::steady_clock::now();
+            std::uint64_t steps = arena.getGameSteps();
+            std::chrono::duration<double> elapsed = now - last;
+            std::printf("kroki gier: %llu (%.0f/s), zakonczone gry: %llu\n", (unsigned long long)steps,
+                        (double)(steps - lastSteps) / elapsed.count(), (unsigned long long)arena.getGamesFinished());
+            std::fflush(stdout);
+            lastSteps = steps;
+            last = now;
+        }
+    });
+
+    arena.run();
+    reporting = false;
+    report.join();
+    std::printf("kroki gier: %llu, zakonczone gry: %llu\n", (unsigned long long)arena.getGameSteps(),
+                (unsigned long long)arena.getGamesFinished());
+    arena.stop();
+    return 0;
+}
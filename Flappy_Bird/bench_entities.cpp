@@ -0,0 +1,515 @@
+/**
+ * @file bench_entities.cpp
+ * @brief Pomiar kroku gry: dawne obiekty Bird/Pipe za wskaźnikami a komponenty EntityWorld.
+ *
+ * Użycie: Flappy_Bird_bench_entities [liczba_gier] [liczba_kroków] [powtórzenia]
+ *
+ * Każda gra ma własne obiekty, tak jak silnik: w wersji dawnej ptak, pula pięciu
+ * rur i tekstury są osobnymi obiektami na stercie, a krok przechodzi po wektorze
+ * wskaźników na rury i przy każdym prostokącie kolizji odczytuje rozmiar tekstury
+ * przez wskaźnik (tak jak Bird::getRect i Pipe::getUpperRect); w wersji nowej
+ * krok to systemy EntityWorld. Obie wersje dostają te same, policzone z góry
+ * machnięcia (bot Human nad Simulation::stepWith), więc wykonują tę samą grę - sumy
+ * wyników i liczby restartów są porównywane po każdym pomiarze.
+ *
+ * Wypisywana jest mediana kroków na sekundę z kilku powtórzeń oraz, na Linuksie,
+ * liczba chybień pamięci podręcznej na krok z liczników sprzętowych (perf_event_open).
+ * Gdy liczniki są niedostępne (brak uprawnień, maszyna wirtualna), w ich miejscu
+ * jest "-". Rdzeń warto przypiąć z zewnątrz, np. taskset -c 2.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "Bots.h"
+#include "Entities.h"
+#include "Metrics.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr float stepTime = 1.0f / 60.0f; /**< Krok symulacji. */
+constexpr int pipePool = 5; /**< Pula rur dawnego silnika (Engine::maxPipes). */
+
+/**
+ * @brief Rodzaj licznika chybień.
+ */
+enum class MissKind {
+    L1Read, /**< Chybienia odczytu w L1D. */
+    LastLevel /**< Chybienia ostatniego poziomu pamięci podręcznej. */
+};
+
+/**
+ * @brief Licznik sprzętowy chybień pamięci podręcznej bieżącego wątku.
+ */
+class CacheCounter {
+public:
+    /**
+     * @brief Konstruktor klasy CacheCounter. Otwiera licznik, jeśli system na to pozwala.
+     *
+     * @param kind Rodzaj chybień.
+     */
+    explicit CacheCounter(MissKind kind) : fd(-1) {
+#ifdef __linux__
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        if (kind == MissKind::L1Read) {
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        } else {
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        }
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#else
+        (void)kind;
+#endif
+    }
+
+    /**
+     * @brief Destruktor klasy CacheCounter.
+     */
+    ~CacheCounter() {
+#ifdef __linux__
+        if (fd >= 0) close(fd);
+#endif
+    }
+
+    CacheCounter(const CacheCounter&) = delete;
+    CacheCounter& operator=(const CacheCounter&) = delete;
+
+    bool available() const { return fd >= 0; } /**< Czy licznik działa. */
+
+    /**
+     * @brief Zeruje i włącza licznik.
+     */
+    void start() {
+#ifdef __linux__
+        if (fd < 0) return;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+
+    /**
+     * @brief Wyłącza licznik i zwraca jego wartość.
+     *
+     * @return Liczba zdarzeń od start.
+     */
+    std::uint64_t stop() {
+        std::uint64_t value = 0;
+#ifdef __linux__
+        if (fd < 0) return 0;
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(fd, &value, sizeof(value)) != (ssize_t)sizeof(value)) value = 0;
+#endif
+        return value;
+    }
+
+private:
+    int fd; /**< Deskryptor licznika lub -1. */
+};
+
+/**
+ * @brief Obiekty w układzie sprzed EntityWorld, odtworzone na potrzeby pomiaru.
+ */
+namespace Legacy {
+    /**
+     * @brief Zastępnik sf::Texture: rozmiar i uchwyt, jak w SFML.
+     */
+    struct Texture {
+        unsigned width, height; /**< Rozmiar tekstury. */
+        std::uint8_t handle[56]; /**< Pozostałe pola tekstury (uchwyt OpenGL, flagi). */
+    };
+
+    /**
+     * @brief Zastępnik BirdAtlas: tekstura i rozmiar klatki.
+     */
+    struct Atlas {
+        Texture texture; /**< Tekstura atlasu. */
+        unsigned frameWidth, frameHeight; /**< Rozmiar klatki. */
+    };
+
+    /**
+     * @brief Ptak w układzie dawnej klasy Bird.
+     */
+    struct Bird {
+        PlayerModel skin; /**< Model gracza. */
+        const Atlas& atlas; /**< Atlas klatek. */
+        float y, vel, frame; /**< Pozycja, prędkość i klatka animacji. */
+        EventQueue& events; /**< Kolejka zdarzeń gry. */
+        bool dieReported; /**< Czy zgłoszono śmierć. */
+
+        Bird(const Atlas& atlas, EventQueue& events)
+                : skin(PlayerModel::Blue), atlas(atlas), y(Physics::birdStartY), vel(0), frame(0), events(events), dieReported(false) {}
+
+        void update(float delta, const Texture* background, bool running, bool& over) {
+            if (!running) return;
+            vel += delta * Physics::gravity;
+            y += vel * delta;
+            if (y < 0 || y + (float)atlas.frameHeight > (float)background->height) {
+                if (!dieReported) {
+                    events.emit(GameEventType::Die);
+                    dieReported = true;
+                }
+                if (!over) Metrics::increment(Metrics::get().deathsGround);
+                over = true;
+            }
+            if (y + (float)atlas.frameHeight > (float)background->height) {
+                y = (float)background->height - (float)atlas.frameHeight;
+                vel = 0;
+            }
+        }
+    };
+
+    /**
+     * @brief Rura w układzie dawnej klasy Pipe.
+     */
+    struct Pipe {
+        float x, y, throat; /**< Pozycja i gardło rury. */
+        bool scored, coinVisible; /**< Czy minięta i czy moneta jest widoczna. */
+        EventQueue& events; /**< Kolejka zdarzeń gry. */
+        const Texture* upperPipe; /**< Tekstura rury górnej. */
+        const Texture* lowerPipe; /**< Tekstura rury dolnej. */
+        const Texture* coin; /**< Tekstura monety. */
+
+        Pipe(EventQueue& events, const Texture* upper, const Texture* lower, const Texture* coin)
+                : x(0), y(0), throat(0), scored(false), coinVisible(true), events(events), upperPipe(upper), lowerPipe(lower), coin(coin) {}
+
+        void update(const Bird* bird, float delta, bool running, bool& over) {
+            if (!running || over) return;
+            x -= Physics::pipeSpeed * delta;
+            const float bw = (float)bird->atlas.frameWidth, bh = (float)bird->atlas.frameHeight;
+            if (Simulation::overlaps(Physics::birdX, bird->y, bw, bh, x, y + throat, (float)upperPipe->width, (float)upperPipe->height) ||
+                Simulation::overlaps(Physics::birdX, bird->y, bw, bh, x, y - throat, (float)lowerPipe->width, (float)lowerPipe->height)) {
+                over = true;
+                Metrics::increment(Metrics::get().deathsPipe);
+                events.emit(GameEventType::Hit);
+            }
+            if (coinVisible && Simulation::overlaps(Physics::birdX, bird->y, bw, bh, x, y + throat / 2, (float)coin->width, (float)coin->height)) {
+                coinVisible = false;
+                events.emit(GameEventType::Coin);
+            }
+            if (!scored && x + (float)upperPipe->width < Physics::birdX) {
+                scored = true;
+                events.emit(GameEventType::Pass);
+            }
+        }
+    };
+}
+
+/**
+ * @brief Wspólna część gry: ziarno, tor, zegar rur, flagi i wynik.
+ */
+struct Driver {
+    std::uint32_t nextSeed; /**< Ziarno następnej gry. */
+    std::uint32_t rng; /**< Generator wysokości rur. */
+    float spawnTimer; /**< Czas od ostatniej rury. */
+    bool running, over; /**< Flagi gry. */
+    std::uint32_t score; /**< Wynik bieżącej gry. */
+    EventQueue* events; /**< Kolejka zdarzeń gry. */
+};
+
+/**
+ * @brief Gra w układzie dawnym.
+ */
+struct LegacyGame {
+    Legacy::Texture* upper; /**< Tekstura rury górnej. */
+    Legacy::Texture* lower; /**< Tekstura rury dolnej. */
+    Legacy::Texture* coin; /**< Tekstura monety. */
+    Legacy::Texture* background; /**< Tekstura tła (wysokość to poziom ziemi). */
+    Legacy::Atlas* atlas; /**< Atlas ptaka. */
+    Legacy::Bird* bird; /**< Ptak. */
+    std::vector<Legacy::Pipe*> pipes; /**< Rury na ekranie, od najstarszej. */
+    std::vector<Legacy::Pipe*> pool; /**< Nieużywane rury. */
+};
+
+/**
+ * @brief Gra na komponentach.
+ */
+struct EntityGame {
+    EntityWorld world; /**< Encje gry. */
+    Entity bird; /**< Encja ptaka. */
+};
+
+/**
+ * @brief Wynik jednego pomiaru.
+ */
+struct Sample {
+    double ticksPerSecond; /**< Kroki na sekundę. */
+    double l1Misses; /**< Chybienia L1D na krok lub -1. */
+    double cacheMisses; /**< Chybienia ostatniego poziomu na krok lub -1. */
+    std::uint64_t checksum; /**< Suma wyników i restartów, do porównania wersji. */
+};
+
+/**
+ * @brief Liczy z góry machnięcia wszystkich gier.
+ *
+ * @param games Liczba gier.
+ * @param steps Liczba kroków.
+ * @param rules Reguły gry.
+ * @return Bity machnięć, krok po kroku dla kolejnych gier.
+ */
+std::vector<std::uint8_t> planFlaps(std::size_t games, int steps, const Simulation::RuntimeRules& rules) {
+    std::vector<std::uint8_t> flaps((std::size_t)steps * games);
+    for (std::size_t g = 0; g < games; ++g) {
+        std::uint32_t seed = (std::uint32_t)g + 1;
+        World world;
+        Simulation::reset(world, seed);
+        Bots::Human bot(Bots::casual, seed);
+        for (int s = 0; s < steps; ++s) {
+            if (world.over) {
+                seed += (std::uint32_t)games;
+                Simulation::reset(world, seed);
+                bot = Bots::Human(Bots::casual, seed);
+            }
+            bool flap = !world.running || bot(world);
+            flaps[(std::size_t)s * games + g] = flap;
+            Simulation::stepWith(world, stepTime, flap, rules);
+        }
+    }
+    return flaps;
+}
+
+/**
+ * @brief Zaczyna nową grę we wspólnej części.
+ */
+void restartDriver(Driver& d, std::uint32_t seed) {
+    World world;
+    Simulation::reset(world, seed);
+    d.rng = world.rng;
+    d.spawnTimer = 0;
+    d.running = false;
+    d.over = false;
+    d.score = 0;
+    d.events->clear();
+}
+
+/**
+ * @brief Wykonuje wszystkie gry przez zadaną liczbę kroków.
+ *
+ * @tparam Game Typ gry.
+ * @tparam Restart Funkcja restart(game).
+ * @tparam Spawn Funkcja spawn(game, y, throat, late).
+ * @tparam Flap Funkcja flap(game, driver).
+ * @tparam Step Funkcja step(game, driver).
+ */
+template<class Game, class Restart, class Spawn, class Flap, class Step>
+Sample run(std::vector<Game*>& games, std::vector<Driver>& drivers, const std::vector<std::uint8_t>& flaps, int steps,
+           const Simulation::RuntimeRules& rules, Restart restart, Spawn spawn, Flap flap, Step step) {
+    const std::size_t count = games.size();
+    std::uint64_t checksum = 0;
+    for (std::size_t g = 0; g < count; ++g) {
+        drivers[g].nextSeed = (std::uint32_t)g + 1;
+        restartDriver(drivers[g], drivers[g].nextSeed);
+        restart(*games[g]);
+    }
+    auto newPipe = [&](Game& game, Driver& d, float late) {
+        int roll = (int)(Simulation::nextRandom(d.rng) % Physics::pipeHeights);
+        spawn(game, Physics::pipeY(roll), rules.throat(), late);
+    };
+
+    CacheCounter l1(MissKind::L1Read);
+    CacheCounter llc(MissKind::LastLevel);
+    l1.start();
+    llc.start();
+    auto begin = std::chrono::steady_clock::now();
+    for (int s = 0; s < steps; ++s) {
+        const std::uint8_t* row = flaps.data() + (std::size_t)s * count;
+        for (std::size_t g = 0; g < count; ++g) {
+            Game& game = *games[g];
+            Driver& d = drivers[g];
+            if (d.over) {
+                checksum += d.score + 1;
+                d.nextSeed += (std::uint32_t)count;
+                restartDriver(d, d.nextSeed);
+                restart(game);
+            }
+            if (row[g] && !d.over) {
+                if (!d.running) {
+                    d.running = true;
+                    d.spawnTimer = 0;
+                    newPipe(game, d, 0);
+                }
+                flap(game, d);
+            }
+            if (d.running) step(game, d);
+            GameEvent event;
+            while (d.events->pop(event)) {
+                if (event.type == GameEventType::Coin) d.score++;
+            }
+            if (d.running && !d.over) {
+                d.spawnTimer += stepTime;
+                if (d.spawnTimer > rules.spawnInterval()) {
+                    d.spawnTimer -= rules.spawnInterval();
+                    newPipe(game, d, d.spawnTimer);
+                }
+            }
+        }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+    std::uint64_t l1Count = l1.stop(), llcCount = llc.stop();
+    for (const auto& d : drivers) checksum += d.score;
+
+    const double ticks = (double)steps * (double)count;
+    return {ticks / elapsed.count(), l1.available() ? (double)l1Count / ticks : -1,
+            llc.available() ? (double)llcCount / ticks : -1, checksum};
+}
+
+/**
+ * @brief Mediana próbek.
+ */
+double median(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    return values[values.size() / 2];
+}
+
+/**
+ * @brief Wypisuje wiersz wyników jednej wersji.
+ */
+void report(const char* name, const std::vector<Sample>& samples) {
+    std::vector<double> speed, l1, llc;
+    for (const auto& sample : samples) {
+        speed.push_back(sample.ticksPerSecond);
+        l1.push_back(sample.l1Misses);
+        llc.push_back(sample.cacheMisses);
+    }
+    std::printf("%-12s %14.0f", name, median(speed));
+    if (l1[0] < 0) std::printf(" %12s", "-");
+    else std::printf(" %12.3f", median(l1));
+    if (llc[0] < 0) std::printf(" %12s\n", "-");
+    else std::printf(" %12.3f\n", median(llc));
+}
+
+}
+
+/**
+ * @brief Punkt wejścia narzędzia.
+ *
+ * @param argc Liczba argumentów.
+ * @param argv Argumenty wywołania.
+ * @return 0 jeśli obie wersje rozegrały te same gry.
+ */
+int main(int argc, char** argv) {
+    const std::size_t count = argc > 1 ? (std::size_t)std::strtoul(argv[1], nullptr, 10) : 4096;
+    const int steps = argc > 2 ? std::atoi(argv[2]) : 2000;
+    const int repeats = argc > 3 ? std::atoi(argv[3]) : 5;
+    if (count == 0 || steps <= 0 || repeats <= 0) {
+        std::fprintf(stderr, "Uzycie: %s [liczba_gier] [liczba_krokow] [powtorzenia]\n", argv[0]);
+        return 2;
+    }
+    const auto rules = Simulation::RuntimeRules::of(Difficulty::Medium);
+    const std::vector<std::uint8_t> flaps = planFlaps(count, steps, rules);
+
+    std::vector<Driver> drivers(count);
+    for (auto& d : drivers) d.events = new EventQueue(64);
+
+    // Obiekty dawnej gry powstają po kolei dla każdej gry, więc leżą na stercie przemieszane tak jak w silniku.
+    std::vector<LegacyGame*> legacy(count);
+    for (std::size_t g = 0; g < count; ++g) {
+        auto* game = new LegacyGame;
+        game->upper = new Legacy::Texture{(unsigned)Physics::pipeWidth, (unsigned)Physics::pipeHeight, {}};
+        game->lower = new Legacy::Texture{(unsigned)Physics::pipeWidth, (unsigned)Physics::pipeHeight, {}};
+        game->coin = new Legacy::Texture{(unsigned)Physics::coinWidth, (unsigned)Physics::coinHeight, {}};
+        game->background = new Legacy::Texture{450, (unsigned)Physics::floorY, {}};
+        game->atlas = new Legacy::Atlas{{}, (unsigned)Physics::birdWidth, (unsigned)Physics::birdHeight};
+        game->bird = new Legacy::Bird(*game->atlas, *drivers[g].events);
+        game->pipes.reserve(pipePool);
+        for (int i = 0; i < pipePool; ++i) {
+            game->pool.push_back(new Legacy::Pipe(*drivers[g].events, game->upper, game->lower, game->coin));
+        }
+        legacy[g] = game;
+    }
+    std::vector<EntityGame*> entities(count);
+    for (std::size_t g = 0; g < count; ++g) {
+        entities[g] = new EntityGame;
+        entities[g]->bird = entities[g]->world.spawnBird(PlayerModel::Blue);
+    }
+
+    auto runLegacy = [&]() {
+        return run(legacy, drivers, flaps, steps, rules,
+                   [](LegacyGame& game) {
+                       for (auto* pipe : game.pipes) game.pool.push_back(pipe);
+                       game.pipes.clear();
+                       game.bird->y = Physics::birdStartY;
+                       game.bird->vel = 0;
+                       game.bird->frame = 0;
+                       game.bird->dieReported = false;
+                   },
+                   [](LegacyGame& game, float y, float throat, float late) {
+                       if (game.pipes.size() == (std::size_t)Physics::maxPipes) {
+                           game.pool.push_back(game.pipes.front());
+                           game.pipes.erase(game.pipes.begin());
+                       }
+                       Legacy::Pipe* pipe = game.pool.back();
+                       game.pool.pop_back();
+                       pipe->x = Physics::pipeSpawnX - Physics::pipeSpeed * late;
+                       pipe->y = y;
+                       pipe->throat = throat;
+                       pipe->scored = false;
+                       pipe->coinVisible = true;
+                       game.pipes.push_back(pipe);
+                   },
+                   [&](LegacyGame& game, Driver& d) {
+                       game.bird->vel = rules.flapVelocity();
+                       d.events->emit(GameEventType::Flap);
+                   },
+                   [](LegacyGame& game, Driver& d) {
+                       game.bird->update(stepTime, game.background, d.running, d.over);
+                       for (auto* pipe : game.pipes) pipe->update(game.bird, stepTime, d.running, d.over);
+                   });
+    };
+    auto runEntities = [&]() {
+        return run(entities, drivers, flaps, steps, rules,
+                   [](EntityGame& game) {
+                       game.world.clearPipes();
+                       game.world.resetBird(game.bird);
+                   },
+                   [](EntityGame& game, float y, float throat, float late) {
+                       if (game.world.pipeCount() == (std::size_t)Physics::maxPipes) game.world.destroyOldestPipe();
+                       game.world.spawnPipe(Physics::pipeSpawnX - Physics::pipeSpeed * late, y, throat, true);
+                   },
+                   [](EntityGame& game, Driver& d) { game.world.flap(game.bird, d.running, d.over, *d.events); },
+                   [](EntityGame& game, Driver& d) { game.world.step(stepTime, d.running, d.over, *d.events); });
+    };
+
+    // Pierwszy przebieg rozgrzewa pamięć podręczną i alokacje wektorów komponentów.
+    runLegacy();
+    runEntities();
+    std::vector<Sample> legacySamples, entitySamples;
+    for (int r = 0; r < repeats; ++r) {
+        legacySamples.push_back(runLegacy());
+        entitySamples.push_back(runEntities());
+    }
+
+    std::printf("%zu gier x %d krokow, %d powtorzen (mediana)\n", count, steps, repeats);
+    std::printf("%-12s %14s %12s %12s\n", "uklad", "krokow/s", "L1D/krok", "LLC/krok");
+    report("Pipe*/Bird*", legacySamples);
+    report("EntityWorld", entitySamples);
+
+    int failures = 0;
+    for (int r = 0; r < repeats; ++r) {
+        if (legacySamples[r].checksum != legacySamples[0].checksum || entitySamples[r].checksum != legacySamples[0].checksum) {
+            failures++;
+        }
+    }
+    if (failures) {
+        std::fprintf(stderr, "Wersje rozegraly rozne gry (suma kontrolna %llu i %llu)\n",
+                     (unsigned long long)legacySamples[0].checksum, (unsigned long long)entitySamples[0].checksum);
+        return 1;
+    }
+    std::printf("suma kontrolna %llu\n", (unsigned long long)legacySamples[0].checksum);
+    return 0;
+}
@@ -0,0 +1,189 @@
+/**
+ * @file bench_simulation.cpp
+ * @brief Pomiar przepustowości wsadowej symulacji gry.
+ *
+ * Użycie: Flappy_Bird_bench [liczba_światów] [liczba_kroków] [powtórzenia]
+ *
+ * Dla każdego poziomu trudności ta sama partia światów jest symulowana dwoma
+ * kernelami. Kernel ogólny to ścieżka, której używają odtwarzanie RunLog,
+ * reach_tool i verify_cases: Simulation::stepWith z regułami
+ * RuntimeRules::of(poziom), gdzie poziom trudności jest znany dopiero w czasie
+ * działania. Kernel wyspecjalizowany to Simulation::stepBatch, który raz na
+ * partię wybiera Simulation::step<D>. Decyzje bota są liczone przed krokiem,
+ * poza kernelem, więc oba kernele dostają te same dane i grają te same gry;
+ * program sprawdza to, porównując sumy wyników.
+ *
+ * Oba kernele są uruchamiane na zmianę kilka razy, na Linuksie na jednym,
+ * przypiętym rdzeniu. Wypisywana jest mediana kroków na sekundę oraz rozrzut
+ * pomiarów (najwolniejszy i najszybszy względem mediany) - różnica median
+ * mniejsza niż rozrzut to szum.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "Bots.h"
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+/**
+ * @brief Mediana i rozrzut pomiarów jednego kernela.
+ */
+struct Measurement {
+    double median; /**< Mediana kroków na sekundę. */
+    double low; /**< Najwolniejszy pomiar względem mediany. */
+    double high; /**< Najszybszy pomiar względem mediany. */
+};
+
+/**
+ * @brief Przypina wątek do rdzenia, na którym właśnie działa.
+ *
+ * @return Numer rdzenia lub -1, gdy przypięcie nie jest możliwe.
+ */
+static int pinToCurrentCpu() {
+#ifdef __linux__
+    int cpu = sched_getcpu();
+    if (cpu < 0) return -1;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0 ? cpu : -1;
+#else
+    return -1;
+#endif
+}
+
+/**
+ * @brief Wynik jednego pomiaru.
+ */
+struct Run {
+    double ticksPerSecond; /**< Liczba kroków na sekundę. */
+    std::uint64_t scoreSum; /**< Suma wyników zakończonych gier - ta sama dla obu kerneli. */
+};
+
+/**
+ * @brief Symuluje partię światów i mierzy liczbę kroków na sekundę.
+ *
+ * @tparam Kernel Funkcja wykonująca jeden krok dla całej partii.
+ * @param worlds Światy do symulacji.
+ * @param flaps Bufor decyzji o machnięciu.
+ * @param steps Liczba kroków.
+ * @param kernel Funkcja kroku partii.
+ * @return Pomiar.
+ */
+template<class Kernel>
+static Run run(std::vector<World>& worlds, std::vector<std::uint8_t>& flaps, int steps, Kernel kernel) {
+    const float dt = 1.0f / 60.0f;
+    std::uint32_t seed = 1;
+    for (auto& w : worlds) {
+        Simulation::reset(w, seed++);
+    }
+
+    std::uint64_t total = 0, scores = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int s = 0; s < steps; ++s) {
+        for (std::size_t i = 0; i < worlds.size(); ++i) {
+            World& w = worlds[i];
+            if (w.over) {
+                scores += w.score;
+                Simulation::reset(w, seed++);
+            }
+            flaps[i] = Bots::center(w);
+        }
+        kernel(worlds.data(), worlds.size(), dt, flaps.data());
+        total += worlds.size();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return {(double)total / elapsed.count(), scores};
+}
+
+/**
+ * @brief Zwraca medianę i rozrzut pomiarów.
+ *
+ * @param samples Pomiary kroków na sekundę.
+ * @return Mediana i rozrzut.
+ */
+static Measurement summarize(std::vector<double> samples) {
+    std::sort(samples.begin(), samples.end());
+    double median = samples[samples.size() / 2];
+    return {median, samples.front() / median - 1, samples.back() / median - 1};
+}
+
+/**
+ * @brief Porównuje oba kernele dla jednego poziomu trudności.
+ *
+ * @param name Nazwa poziomu trudności.
+ * @param difficulty Poziom trudności.
+ * @param worlds Światy do symulacji.
+ * @param flaps Bufor decyzji o machnięciu.
+ * @param steps Liczba kroków.
+ * @param repeats Liczba pomiarów każdego kernela.
+ * @return false jeśli kernele zagrały różne gry.
+ */
+static bool compare(const char* name, Difficulty difficulty, std::vector<World>& worlds, std::vector<std::uint8_t>& flaps, int steps, int repeats) {
+    const auto rules = Simulation::RuntimeRules::of(difficulty);
+    auto runtime = [&rules](World* batch, std::size_t count, float dt, const std::uint8_t* decisions) {
+        for (std::size_t i = 0; i < count; ++i) {
+            if (!batch[i].over) {
+                Simulation::stepWith(batch[i], dt, decisions[i] != 0, rules);
+            }
+        }
+    };
+    auto specialized = [difficulty](World* batch, std::size_t count, float dt, const std::uint8_t* decisions) {
+        Simulation::stepBatch(difficulty, batch, count, dt, decisions);
+    };
+
+    // Pierwszy przebieg rozgrzewa pamięć podręczną i zegar procesora; pomiary są przeplatane,
+    // więc zmiany częstotliwości w trakcie dotykają obu kerneli po równo.
+    const Run runtimeWarmup = run(worlds, flaps, steps, runtime);
+    const Run specializedWarmup = run(worlds, flaps, steps, specialized);
+    if (runtimeWarmup.scoreSum != specializedWarmup.scoreSum) {
+        std::fprintf(stderr, "%s: kernele zagraly rozne gry (suma wynikow %llu i %llu)\n", name,
+                     (unsigned long long)runtimeWarmup.scoreSum, (unsigned long long)specializedWarmup.scoreSum);
+        return false;
+    }
+    std::vector<double> runtimeSamples, specializedSamples;
+    for (int r = 0; r < repeats; ++r) {
+        runtimeSamples.push_back(run(worlds, flaps, steps, runtime).ticksPerSecond);
+        specializedSamples.push_back(run(worlds, flaps, steps, specialized).ticksPerSecond);
+    }
+    Measurement before = summarize(runtimeSamples);
+    Measurement after = summarize(specializedSamples);
+    std::printf("%-10s stepWith %7.2f Mticks/s (%+5.1f%%/%+5.1f%%)   stepBatch %7.2f Mticks/s (%+5.1f%%/%+5.1f%%)   x%.3f\n",
+                name, before.median / 1e6, before.low * 100, before.high * 100,
+                after.median / 1e6, after.low * 100, after.high * 100, after.median / before.median);
+    return true;
+}
+
+/**
+ * @brief Punkt wejścia programu.
+ *
+ * @param argc Liczba argumentów.
+ * @param argv Argumenty wywołania.
+ * @return Kod zakończenia programu.
+ */
+int main(int argc, char** argv) {
+    std::size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 4096;
+    int steps = argc > 2 ? std::atoi(argv[2]) : 2000;
+    int repeats = argc > 3 ? std::atoi(argv[3]) : 7;
+    if (count == 0 || steps <= 0 || repeats <= 0) {
+        std::fprintf(stderr, "Uzycie: %s [liczba_swiatow] [liczba_krokow] [powtorzenia]\n", argv[0]);
+        return 2;
+    }
+    std::vector<World> worlds(count);
+    std::vector<std::uint8_t> flaps(count);
+
+    int cpu = pinToCurrentCpu();
+    if (cpu >= 0) std::printf("Przypiety do CPU %d, %d pomiarow, mediana (rozrzut min/max)\n", cpu, repeats);
+    else std::printf("Bez przypiecia do CPU, %d pomiarow, mediana (rozrzut min/max)\n", repeats);
+
+    const char* names[] = {"Easy", "Medium", "Hard", "Nightmare"};
+    for (int d = 0; d < 4; ++d) {
+        if (!compare(names[d], static_cast<Difficulty>(d), worlds, flaps, steps, repeats)) return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,268 @@
+/**
+ * @file calibrate.cpp
+ * @brief Kalibracja poziomów trudności metodą Monte Carlo.
+ *
+ * Użycie:
+ *   Flappy_Bird_calibrate [--games N] [--threads T] [--max-seconds S] [--targets E,M,H,N] [--out plik.csv]
+ *
+ * Program przeszukuje siatkę parametrów (gardło rury, odstęp między rurami,
+ * grawitacja, prędkość machnięcia). Dla każdego punktu siatki i każdego
+ * referencyjnego bota rozgrywa N gier bez okna, równolegle na wszystkich rdzeniach.
+ * Każdy punkt jest od razu dopisywany do pliku CSV: rozkład wyniku (kwantyle)
+ * i krzywa przeżycia (odsetek gier trwających dłużej niż 10, 20, ... sekund).
+ *
+ * Wszystkie punkty siatki używają tych samych ziaren torów i botów, więc różnice
+ * między punktami nie wynikają z losowania. Na końcu dla każdego poziomu trudności
+ * wypisywany jest punkt, w którym mediana wyniku bota "casual" jest najbliższa
+ * docelowej, obok mediany dla obecnej tabeli DifficultyRules.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Bots.h"
+
+namespace {
+
+constexpr int survivalPoints = 12; /**< Liczba punktów krzywej przeżycia. */
+constexpr float survivalStep = 10.0f; /**< Odstęp punktów krzywej przeżycia w sekundach. */
+constexpr float stepTime = 1.0f / 60.0f; /**< Czas kroku symulacji. */
+
+const Bots::Skill skills[] = {Bots::expert, Bots::casual}; /**< Referencyjne boty. */
+constexpr int skillCount = sizeof(skills) / sizeof(skills[0]); /**< Liczba referencyjnych botów. */
+constexpr int referenceSkill = 1; /**< Bot, według którego dobierane są poziomy trudności. */
+
+/**
+ * @brief Wynik jednego punktu siatki dla jednego bota.
+ */
+struct Outcome {
+    float p10, median, p90, mean; /**< Kwantyle i średnia wyniku. */
+    float survival[survivalPoints]; /**< Odsetek gier trwających dłużej niż (i + 1) * survivalStep sekund. */
+};
+
+/**
+ * @brief Punkt siatki parametrów i jego wyniki.
+ */
+struct GridPoint {
+    Simulation::RuntimeRules rules; /**< Parametry gry. */
+    Outcome outcomes[skillCount]; /**< Wyniki dla każdego bota. */
+};
+
+/**
+ * @brief Ustawienia kalibracji.
+ */
+struct Options {
+    std::uint32_t games = 2000; /**< Liczba gier na punkt siatki i bota. */
+    unsigned threads = 0; /**< Liczba wątków (0 - wszystkie rdzenie). */
+    float maxSeconds = 120; /**< Najdłuższa rozgrywka w sekundach gry. */
+    float targets[4] = {20, 10, 5, 2}; /**< Docelowe mediany wyniku dla Easy, Medium, Hard i Nightmare. */
+    std::string out = "calibration.csv"; /**< Plik wynikowy. */
+};
+
+/**
+ * @brief Zwraca kwantyl posortowanego rozkładu.
+ *
+ * @param sorted Posortowane wartości.
+ * @param q Kwantyl z zakresu [0, 1].
+ * @return Wartość kwantyla.
+ */
+float quantile(const std::vector<std::uint32_t>& sorted, float q) {
+    return (float)sorted[std::min(sorted.size() - 1, (std::size_t)(q * (float)sorted.size()))];
+}
+
+/**
+ * @brief Rozgrywa serię gier jednym botem i podsumowuje wyniki.
+ *
+ * @param rules Parametry gry.
+ * @param skill Wprawa bota.
+ * @param options Ustawienia kalibracji.
+ * @param scores Bufor roboczy na wyniki gier.
+ * @return Podsumowanie wyników.
+ */
+Outcome play(const Simulation::RuntimeRules& rules, const Bots::Skill& skill, const Options& options,
+             std::vector<std::uint32_t>& scores) {
+    const auto maxTicks = (std::uint32_t)(options.maxSeconds / stepTime);
+    std::uint32_t alive[survivalPoints] = {};
+    double total = 0;
+
+    scores.resize(options.games);
+    for (std::uint32_t g = 0; g < options.games; ++g) {
+        World world;
+        Simulation::reset(world, g + 1);
+        Simulation::start(world, rules.throat());
+        Bots::Human bot(skill, (g + 1) * 2654435761u);
+        while (!world.over && world.ticks < maxTicks) {
+            Simulation::stepWith(world, stepTime, bot(world), rules);
+        }
+        scores[g] = world.score;
+        total += world.score;
+        for (int i = 0; i < survivalPoints; ++i) {
+            if ((float)world.ticks * stepTime > (float)(i + 1) * survivalStep) alive[i]++;
+        }
+    }
+
+    std::sort(scores.begin(), scores.end());
+    Outcome outcome{};
+    outcome.p10 = quantile(scores, 0.1f);
+    outcome.median = quantile(scores, 0.5f);
+    outcome.p90 = quantile(scores, 0.9f);
+    outcome.mean = (float)(total / options.games);
+    for (int i = 0; i < survivalPoints; ++i) {
+        outcome.survival[i] = (float)alive[i] / (float)options.games;
+    }
+    return outcome;
+}
+
+/**
+ * @brief Buduje siatkę parametrów wokół obecnych wartości.
+ *
+ * @return Punkty siatki.
+ */
+std::vector<GridPoint> buildGrid() {
+    std::vector<GridPoint> grid;
+    for (float gravity : {1000.0f, 1200.0f, 1400.0f}) {
+        for (float flap : {-380.0f, -420.0f, -460.0f}) {
+            for (float interval : {3.0f, 3.5f, 4.0f}) {
+                for (float throat = 300; throat <= 400; throat += 10) {
+                    grid.push_back({{throat, interval, gravity, flap}, {}});
+                }
+            }
+        }
+    }
+    return grid;
+}
+
+/**
+ * @brief Zapisuje punkt siatki jako wiersze CSV, po jednym na bota.
+ *
+ * @param out Plik wynikowy.
+ * @param point Punkt siatki.
+ */
+void writeCsv(FILE* out, const GridPoint& point) {
+    for (int s = 0; s < skillCount; ++s) {
+        const Outcome& o = point.outcomes[s];
+        std::fprintf(out, "%g,%g,%g,%g,%s,%g,%g,%g,%.3f", point.rules.throat(), point.rules.spawnInterval(),
+                     point.rules.gravity(), point.rules.flapVelocity(), skills[s].name, o.p10, o.median, o.p90, o.mean);
+        for (float alive : o.survival) {
+            std::fprintf(out, ",%.4f", alive);
+        }
+        std::fputc('\n', out);
+    }
+    std::fflush(out);
+}
+
+/**
+ * @brief Odczytuje ustawienia z argumentów wywołania.
+ *
+ * @param argc Liczba argumentów.
+ * @param argv Argumenty.
+ * @return Ustawienia.
+ */
+Options parse(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--games") == 0) options.games = (std::uint32_t)std::strtoul(argv[i + 1], nullptr, 10);
+        else if (std::strcmp(argv[i], "--threads") == 0) options.threads = (unsigned)std::strtoul(argv[i + 1], nullptr, 10);
+        else if (std::strcmp(argv[i], "--max-seconds") == 0) options.maxSeconds = std::strtof(argv[i + 1], nullptr);
+        else if (std::strcmp(argv[i], "--out") == 0) options.out = argv[i + 1];
+        else if (std::strcmp(argv[i], "--targets") == 0) {
+            std::sscanf(argv[i + 1], "%f,%f,%f,%f", &options.targets[0], &options.targets[1],
+                        &options.targets[2], &options.targets[3]);
+        }
+    }
+    options.games = std::max(options.games, 1u);
+    return options;
+}
+
+}
+
+/**
+ * @brief Punkt wejścia programu.
+ *
+ * @param argc Liczba argumentów.
+ * @param argv Argumenty wywołania.
+ * @return Kod zakończenia programu.
+ */
+int main(int argc, char** argv) {
+    Options options = parse(argc, argv);
+    std::vector<GridPoint> grid = buildGrid();
+
+    // Obecna tabela DifficultyRules jest liczona tymi samymi botami, dla porównania.
+    const Difficulty difficulties[] = {Difficulty::Easy, Difficulty::Medium, Difficulty::Hard, Difficulty::Nightmare};
+    const char* names[] = {"Easy", "Medium", "Hard", "Nightmare"};
+    for (Difficulty d : difficulties) {
+        grid.push_back({Simulation::RuntimeRules::of(d), {}});
+    }
+    const std::size_t currentBase = grid.size() - 4;
+
+    FILE* out = std::fopen(options.out.c_str(), "w");
+    if (!out) {
+        std::fprintf(stderr, "Nie udalo sie otworzyc %s\n", options.out.c_str());
+        return 1;
+    }
+    std::fprintf(out, "throat,spawn_interval,gravity,flap_velocity,bot,score_p10,score_median,score_p90,score_mean");
+    for (int i = 0; i < survivalPoints; ++i) {
+        std::fprintf(out, ",alive_%gs", (float)(i + 1) * survivalStep);
+    }
+    std::fputc('\n', out);
+
+    unsigned threads = options.threads ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+    std::atomic<std::size_t> next{0};
+    std::atomic<std::size_t> done{0};
+    std::mutex outMutex;
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([&] {
+            std::vector<std::uint32_t> scores;
+            for (std::size_t i = next++; i < grid.size(); i = next++) {
+                for (int s = 0; s < skillCount; ++s) {
+                    grid[i].outcomes[s] = play(grid[i].rules, skills[s], options, scores);
+                }
+                std::lock_guard<std::mutex> lock(outMutex);
+                writeCsv(out, grid[i]);
+                if (++done % 10 == 0 || done == grid.size()) {
+                    std::fprintf(stderr, "\r%zu/%zu punktow siatki", done.load(), grid.size());
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    std::fclose(out);
+    std::fprintf(stderr, "\n");
+
+    std::printf("Dobor wg bota \"%s\", %u gier na punkt, wyniki w %s\n", skills[referenceSkill].name, options.games, options.out.c_str());
+    for (int d = 0; d < 4; ++d) {
+        const GridPoint& current = grid[currentBase + d];
+        const GridPoint* best = nullptr;
+        const GridPoint* bestSamePhysics = nullptr;
+        auto error = [&](const GridPoint& p) {
+            return std::fabs(p.outcomes[referenceSkill].median - options.targets[d]);
+        };
+        for (std::size_t i = 0; i < currentBase; ++i) {
+            const GridPoint& p = grid[i];
+            if (!best || error(p) < error(*best)) best = &p;
+            if (p.rules.gravity() == Physics::gravity && p.rules.flapVelocity() == Physics::flapVelocity &&
+                (!bestSamePhysics || error(p) < error(*bestSamePhysics))) {
+                bestSamePhysics = &p;
+            }
+        }
+        std::printf("%-10s cel %.0f | obecnie gardlo %.0f odstep %.1f -> mediana %.0f | "
+                    "zalecane gardlo %.0f odstep %.1f -> mediana %.0f | "
+                    "z fizyka: gardlo %.0f odstep %.1f grawitacja %.0f machniecie %.0f -> mediana %.0f\n",
+                    names[d], options.targets[d],
+                    current.rules.throat(), current.rules.spawnInterval(), current.outcomes[referenceSkill].median,
+                    bestSamePhysics->rules.throat(), bestSamePhysics->rules.spawnInterval(), bestSamePhysics->outcomes[referenceSkill].median,
+                    best->rules.throat(), best->rules.spawnInterval(), best->rules.gravity(), best->rules.flapVelocity(),
+                    best->outcomes[referenceSkill].median);
+    }
+    return 0;
+}
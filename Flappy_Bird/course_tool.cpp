@@ -0,0 +1,159 @@
+/**
+ * @file course_tool.cpp
+ * @brief Tworzenie i sprawdzanie plików torów (FileCourse).
+ *
+ * Użycie:
+ *   Flappy_Bird_course generate plik.fbc [--pipes N] [--seed S] [--difficulty 0-3]
+ *   Flappy_Bird_course import tor.csv plik.fbc
+ *   Flappy_Bird_course info plik.fbc
+ *
+ * generate zapisuje tor losowy taki, jaki wylosowałaby gra z danym ziarnem.
+ * import przepisuje ręcznie przygotowany tor z pliku CSV o wierszach
+ * "odstęp,y,gardło,moneta" (moneta 0 lub 1; wiersze od # są pomijane).
+ * info odtwarza cały tor przez FileCourse, sprawdzając skróty fragmentów,
+ * i wypisuje jego długość oraz największe zużycie pamięci procesu.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "Course.h"
+#include "Simulation.h"
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+/**
+ * @brief Zapisuje tor losowy.
+ *
+ * @param out Plik wynikowy.
+ * @param pipes Liczba rur.
+ * @param seed Ziarno toru.
+ * @param difficulty Poziom trudności.
+ * @return Kod zakończenia programu.
+ */
+static int generate(const char* out, std::uint64_t pipes, std::uint64_t seed, Difficulty difficulty) {
+    const DifficultyRules& rules = rulesFor(difficulty);
+    GeneratedCourse course;
+    course.restart(seed);
+    CourseWriter writer(out);
+    for (std::uint64_t i = 0; i < pipes; ++i) {
+        CoursePipe pipe{rules.spawnInterval * Physics::pipeSpeed, 0, rules.throat, true};
+        course.next(pipe);
+        if (!writer.add(pipe)) break;
+    }
+    if (!writer.finish()) {
+        std::fprintf(stderr, "Nie udalo sie zapisac %s\n", out);
+        return 1;
+    }
+    std::printf("%s: %llu rur\n", out, (unsigned long long)pipes);
+    return 0;
+}
+
+/**
+ * @brief Przepisuje tor z pliku CSV.
+ *
+ * @param in Plik CSV.
+ * @param out Plik wynikowy.
+ * @return Kod zakończenia programu.
+ */
+static int import(const char* in, const char* out) {
+    std::FILE* csv = std::fopen(in, "r");
+    if (!csv) {
+        std::fprintf(stderr, "Nie udalo sie otworzyc %s\n", in);
+        return 1;
+    }
+    CourseWriter writer(out);
+    char line[256];
+    std::uint64_t pipes = 0, lineNumber = 0;
+    bool ok = true;
+    while (ok && std::fgets(line, sizeof(line), csv)) {
+        lineNumber++;
+        if (line[0] == '#' || line[0] == '\n' || line[0] == '\r') continue;
+        CoursePipe pipe{};
+        int coin = 1;
+        if (std::sscanf(line, "%f,%f,%f,%d", &pipe.spacing, &pipe.y, &pipe.throat, &coin) < 3) {
+            std::fprintf(stderr, "%s:%llu: oczekiwano \"odstep,y,gardlo[,moneta]\"\n", in, (unsigned long long)lineNumber);
+            ok = false;
+            break;
+        }
+        pipe.coin = coin != 0;
+        ok = writer.add(pipe);
+        pipes++;
+    }
+    std::fclose(csv);
+    if (!writer.finish() || !ok) {
+        std::fprintf(stderr, "Nie udalo sie zapisac %s\n", out);
+        return 1;
+    }
+    std::printf("%s: %llu rur\n", out, (unsigned long long)pipes);
+    return 0;
+}
+
+/**
+ * @brief Odtwarza cały tor i wypisuje jego podsumowanie.
+ *
+ * @param path Plik toru.
+ * @return Kod zakończenia programu.
+ */
+static int info(const char* path) {
+    FileCourse course(path);
+    if (!course.isOpen()) {
+        std::fprintf(stderr, "%s nie jest poprawnym plikiem toru\n", path);
+        return 1;
+    }
+    double length = 0;
+    std::uint64_t read = 0, coins = 0;
+    CoursePipe pipe{};
+    while (course.next(pipe)) {
+        length += pipe.spacing;
+        coins += pipe.coin ? 1 : 0;
+        read++;
+    }
+    std::printf("%s: %llu rur w %llu fragmentach, %llu monet, dlugosc %.0f px (%.1f min gry)\n", path,
+                (unsigned long long)course.size(), (unsigned long long)course.chunks(), (unsigned long long)coins,
+                length, length / Physics::pipeSpeed / 60.0);
+#ifndef _WIN32
+    struct rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    std::printf("najwieksze zuzycie pamieci: %ld KiB\n", usage.ru_maxrss);
+#endif
+    if (read != course.size()) {
+        std::fprintf(stderr, "tor urywa sie po %llu rurach\n", (unsigned long long)read);
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Punkt wejścia narzędzia.
+ *
+ * @param argc Liczba argumentów.
+ * @param argv Argumenty wywołania.
+ * @return Kod zakończenia programu.
+ */
+int main(int argc, char** argv) {
+    if (argc >= 3 && std::strcmp(argv[1], "generate") == 0) {
+        std::uint64_t pipes = 1000, seed = 1;
+        int difficulty = 1;
+        for (int i = 3; i + 1 < argc; i += 2) {
+            if (std::strcmp(argv[i], "--pipes") == 0) pipes = std::strtoull(argv[i + 1], nullptr, 10);
+            else if (std::strcmp(argv[i], "--seed") == 0) seed = std::strtoull(argv[i + 1], nullptr, 10);
+            else if (std::strcmp(argv[i], "--difficulty") == 0) difficulty = std::atoi(argv[i + 1]);
+        }
+        if (difficulty < 0 || difficulty > 3) difficulty = 1;
+        return generate(argv[2], pipes, seed, static_cast<Difficulty>(difficulty));
+    }
+    if (argc == 4 && std::strcmp(argv[1], "import") == 0) {
+        return import(argv[2], argv[3]);
+    }
+    if (argc == 3 && std::strcmp(argv[1], "info") == 0) {
+        return info(argv[2]);
+    }
+    std::fprintf(stderr, "Uzycie:\n"
+                         "  %s generate plik.fbc [--pipes N] [--seed S] [--difficulty 0-3]\n"
+                         "  %s import tor.csv plik.fbc\n"
+                         "  %s info plik.fbc\n", argv[0], argv[0], argv[0]);
+    return 2;
+}
@@ -0,0 +1,133 @@
+/**
+ * @file draw_alloc_cases.cpp
+ * @brief Sprawdzenie, że klatka Engine (update i draw) po rozgrzewce nie alokuje pamięci.
+ *
+ * Użycie: Flappy_Bird_draw_alloc_cases
+ *
+ * Program tworzy prawdziwy Engine bez okna: rysuje on na sf::RenderTexture, a
+ * klatki są wykonywane przez Engine::frame, tak jak w Engine::Play, tylko bez
+ * zdarzeń okna. Bot Human gra kolejne gry (menu, machnięcia, rury, monety, śmierć,
+ * dziennik wyników, restart), a AllocTracker zlicza alokacje każdej klatki. Po
+ * rozgrzewce każda alokacja jest błędem; program zwraca wtedy 1 i wypisuje
+ * pierwszą klatkę, w której do niej doszło.
+ *
+ * Tekstury są wczytywane z res/, więc program trzeba uruchamiać w katalogu
+ * budowania. Bez ekranu (pusta zmienna DISPLAY na Linuksie) nie da się utworzyć
+ * kontekstu OpenGL dla tekstury; program zwraca wtedy 77, co CTest liczy jako
+ * test pominięty.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include "AllocTracker.h"
+#include "Bots.h"
+#include "Engine.h"
+
+namespace {
+
+constexpr float frameTime = 1.0f / 60.0f; /**< Czas klatki. */
+constexpr int warmupFrames = 3600; /**< Klatki rozgrzewki (jak w alloc_cases). */
+constexpr int checkedFrames = 60 * 60 * 3; /**< Klatki sprawdzane po rozgrzewce. */
+constexpr int skipped = 77; /**< Kod zakończenia testu pominiętego (SKIP_RETURN_CODE). */
+
+/**
+ * @brief Engine rysujący poza ekranem, sterowany botem Human zamiast FLAPPY_BOT.
+ *
+ * Bot jest ten sam co w alloc_cases, bo Bots::center, którego używa Engine::steerBot,
+ * gra zbyt dobrze, żeby test doczekał się restartów.
+ */
+class OffscreenEngine : public Engine {
+public:
+    /**
+     * @brief Konstruktor klasy OffscreenEngine.
+     */
+    OffscreenEngine() : Engine(false), bot(Bots::casual, 11), games(0) {
+        updateDifficulty(Difficulty::Hard);
+    }
+
+    /**
+     * @brief Sprawdza, czy udało się utworzyć teksturę do rysowania.
+     *
+     * @return true jeśli silnik może rysować.
+     */
+    bool ready() const { return offscreen && offscreen->getSize().x != 0; }
+
+    /**
+     * @brief Wykonuje jedną klatkę: decyzję bota, krok gry i rysowanie.
+     */
+    void step() {
+        if (inMainMenu || inGetReady) {
+            inMainMenu = false;
+            setGetReady(false);
+        }
+        if (gameOvered) {
+            if (restartTimer == Scheduler::noTimer) {
+                restartTimer = scheduler.schedule(1.0, &Engine::onRestartTimer, this);
+            }
+        } else if (!gameRunning || bot(toWorld())) {
+            flap();
+        }
+        const bool wasRecorded = scoreRecorded;
+        frame(frameTime);
+        if (scoreRecorded && !wasRecorded) games++;
+    }
+
+    std::uint32_t finishedGames() const { return games; } /**< Liczba zakończonych gier. */
+
+private:
+    Bots::Human bot; /**< Gracz. */
+    std::uint32_t games; /**< Liczba zakończonych gier. */
+};
+
+}
+
+/**
+ * @brief Punkt wejścia narzędzia.
+ *
+ * @return 0 jeśli po rozgrzewce nie było żadnej alokacji, 77 bez ekranu.
+ */
+int main() {
+    if (!AllocTracker::enabled()) {
+        std::fprintf(stderr, "Program zbudowano bez FLAPPY_TRACK_ALLOCS\n");
+        return 1;
+    }
+#if defined(__linux__)
+    const char* display = std::getenv("DISPLAY");
+    if (!display || !*display) {
+        std::fprintf(stderr, "Brak ekranu (DISPLAY), test pominiety\n");
+        return skipped;
+    }
+#endif
+
+    OffscreenEngine engine;
+    if (!engine.ready()) {
+        std::fprintf(stderr, "Nie udalo sie utworzyc tekstury do rysowania, test pominiety\n");
+        return skipped;
+    }
+    for (int i = 0; i < warmupFrames; ++i) engine.step();
+    const std::uint32_t warmupGames = engine.finishedGames();
+
+    std::uint64_t allocations = 0;
+    int firstFrame = -1;
+    for (int i = 0; i < checkedFrames; ++i) {
+        std::uint64_t before = AllocTracker::allocations();
+        engine.step();
+        std::uint64_t frameAllocations = AllocTracker::allocations() - before;
+        if (frameAllocations && firstFrame < 0) firstFrame = i;
+        allocations += frameAllocations;
+    }
+    const std::uint32_t checkedGames = engine.finishedGames() - warmupGames;
+
+    std::printf("%d klatek po rozgrzewce, %u gier, %llu alokacji\n", checkedFrames, checkedGames,
+                (unsigned long long)allocations);
+    if (allocations) {
+        std::fprintf(stderr, "Pierwsza alokacja w klatce %d po rozgrzewce\n", firstFrame);
+        return 1;
+    }
+    // Bez restartu test nie sprawdzałby rysowania ekranu końca gry ani menu.
+    if (checkedGames < 1) {
+        std::fprintf(stderr, "Bot nie zakonczyl gry po rozgrzewce\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,177 @@
+/**
+ * @file entities_cases.cpp
+ * @brief Sprawdzenie, że EntityWorld liczy grę tak samo jak Simulation::stepWith.
+ *
+ * Użycie: Flappy_Bird_entities_cases [liczba_gier]
+ *
+ * Dla każdego poziomu trudności bot gra kolejne gry jednocześnie w World
+ * (Simulation::stepWith) i w EntityWorld z rurami tworzonymi tak jak w
+ * Simulation. Co krok porównywane są położenie i prędkość ptaka, rury (w kolejności
+ * powstania, z flagami minięcia i monety), wynik z monet i koniec gry. Bot co
+ * jakiś czas zmienia decyzję, żeby gry kończyły się także na rurach, a nie tylko
+ * na ziemi. Program zwraca 1 przy pierwszej różnicy w którejkolwiek grze.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include "Bots.h"
+#include "Entities.h"
+
+namespace {
+
+constexpr float stepTime = 1.0f / 60.0f; /**< Czas kroku. */
+constexpr int maxSteps = 30000; /**< Limit kroków jednej gry. */
+
+/**
+ * @brief Gra w EntityWorld z rurami tworzonymi tak jak w Simulation::stepWith.
+ */
+class EntityGame {
+public:
+    /**
+     * @brief Konstruktor klasy EntityGame.
+     *
+     * @param rules Reguły poziomu trudności.
+     * @param rng Stan generatora rur (World::rng po Simulation::reset).
+     */
+    EntityGame(const Simulation::RuntimeRules& rules, std::uint32_t rng)
+            : rules(rules), rng(rng), spawnTimer(0), coins(0), running(false), over(false) {
+        bird = entities.spawnBird(PlayerModel::Blue);
+    }
+
+    /**
+     * @brief Wykonuje jeden krok gry.
+     *
+     * @param flap Czy ptak machnął skrzydłami.
+     */
+    void step(bool flap) {
+        if (flap && !over) {
+            if (!running) {
+                running = true;
+                spawnPipe(0);
+            }
+            entities.flap(bird, running, over, events);
+        }
+        if (!running) return;
+        entities.step(stepTime, running, over, events);
+        GameEvent event{};
+        while (events.pop(event)) {
+            if (event.type == GameEventType::Coin) coins++;
+        }
+        if (over) return;
+        spawnTimer += stepTime;
+        if (spawnTimer > rules.spawnInterval()) {
+            spawnTimer -= rules.spawnInterval();
+            spawnPipe(spawnTimer);
+        }
+    }
+
+    /**
+     * @brief Porównuje stan gry ze światem symulacji.
+     *
+     * @param world Świat po tym samym kroku.
+     * @return true, jeśli stany są zgodne.
+     */
+    bool matches(const World& world) const {
+        PipeState pipes[EntityWorld::pipeRows];
+        std::uint32_t count = entities.savePipes(pipes, (std::uint32_t)EntityWorld::pipeRows);
+        BirdState state = entities.saveBird(bird);
+        if (count != (std::uint32_t)world.pipeCount || state.y != world.birdY || state.vel != world.birdVel ||
+            coins != world.score || over != world.over) {
+            return false;
+        }
+        for (std::uint32_t i = 0; i < count; ++i) {
+            const PipeState& pipe = world.pipes[i];
+            if (pipes[i].x != pipe.x || pipes[i].y != pipe.y || pipes[i].scored != pipe.scored ||
+                pipes[i].coinVisible != pipe.coinVisible) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Wypisuje różnicę stanu gry i świata symulacji.
+     *
+     * @param world Świat po tym samym kroku.
+     */
+    void report(const World& world) const {
+        BirdState state = entities.saveBird(bird);
+        std::fprintf(stderr, "  rury %u/%d, y %g/%g, v %g/%g, wynik %u/%u, koniec %d/%d\n",
+                     (unsigned)entities.pipeCount(), world.pipeCount, state.y, world.birdY, state.vel, world.birdVel,
+                     coins, world.score, over, world.over);
+    }
+
+private:
+    /**
+     * @brief Tworzy rurę, jak Simulation::stepWith.
+     *
+     * @param late Spóźnienie rury względem zegara w sekundach.
+     */
+    void spawnPipe(float late) {
+        if (entities.pipeCount() == (std::size_t)Physics::maxPipes) {
+            entities.destroyOldestPipe();
+        }
+        int roll = (int)(Simulation::nextRandom(rng) % Physics::pipeHeights);
+        entities.spawnPipe(Physics::pipeSpawnX - Physics::pipeSpeed * late, Physics::pipeY(roll), rules.throat(), true);
+    }
+
+    Simulation::RuntimeRules rules; /**< Reguły poziomu trudności. */
+    EntityWorld entities; /**< Encje gry. */
+    Entity bird; /**< Encja ptaka. */
+    EventQueue events; /**< Zdarzenia kroku. */
+    std::uint32_t rng; /**< Stan generatora rur. */
+    float spawnTimer; /**< Czas od ostatniej rury. */
+    std::uint32_t coins; /**< Zebrane monety. */
+    bool running, over; /**< Flagi gry. */
+};
+
+}
+
+/**
+ * @brief Punkt wejścia narzędzia.
+ *
+ * @param argc Liczba argumentów.
+ * @param argv Argumenty wywołania.
+ * @return 0 jeśli wszystkie gry przebiegły tak samo.
+ */
+int main(int argc, char** argv) {
+    const long games = argc > 1 ? std::strtol(argv[1], nullptr, 10) : 250;
+    if (games <= 0) {
+        std::fprintf(stderr, "Uzycie: %s [liczba_gier]\n", argv[0]);
+        return 2;
+    }
+
+    std::uint64_t steps = 0, deaths = 0, pipeDeaths = 0;
+    for (int d = 0; d < 4; ++d) {
+        const auto rules = Simulation::RuntimeRules::of((Difficulty)d);
+        for (std::uint32_t game = 0; game < (std::uint32_t)games; ++game) {
+            World world;
+            Simulation::reset(world, game * 2654435761u + 7);
+            EntityGame entities(rules, world.rng);
+            std::uint32_t noise = game + 1;
+            for (int t = 0; t < maxSteps && !world.over; ++t) {
+                bool flap = Bots::center(world);
+                if (Simulation::nextRandom(noise) % 113 == 0) flap = !flap;
+                Simulation::stepWith(world, stepTime, flap, rules);
+                entities.step(flap);
+                steps++;
+                if (!entities.matches(world)) {
+                    std::fprintf(stderr, "Rozbieznosc: trudnosc %d, gra %u, krok %d\n", d, game, t);
+                    entities.report(world);
+                    return 1;
+                }
+            }
+            deaths += world.over;
+            pipeDeaths += world.over && world.birdY >= 0 && world.birdY + Physics::birdHeight < Physics::floorY;
+        }
+    }
+
+    std::printf("%ld gier na poziom, %llu krokow, %llu smierci (%llu na rurach)\n", games,
+                (unsigned long long)steps, (unsigned long long)deaths, (unsigned long long)pipeDeaths);
+    // Bez śmierci na rurach test nie sprawdzałby cofania rur i wyzwalaczy po zderzeniu.
+    if (pipeDeaths == 0) {
+        std::fprintf(stderr, "Zadna gra nie skonczyla sie na rurze\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,200 @@
+/**
+ * @file fixed_crosscheck.cpp
+ * @brief Porównanie symulacji zmiennoprzecinkowej i stałoprzecinkowej.
+ *
+ * Użycie: Flappy_Bird_crosscheck [liczba_torów] [maks_kroków]
+ *
+ * Dla każdego poziomu trudności i każdego ziarna oba modele fizyki dostają te
+ * same decyzje bota, podejmowane na podstawie świata stałoprzecinkowego.
+ * Program zgłasza pierwszy krok, w którym modele różnią się wynikiem dyskretnym
+ * (koniec gry, moneta, nowa rura), oraz największy rozjazd pozycji ptaka na
+ * torach, które się nie rozeszły. Na końcu wypisuje skrót końcowych stanów
+ * stałoprzecinkowych - musi być taki sam w każdej kompilacji i na każdej maszynie.
+ *
+ * Pozycje ptaka i krawędzie rur często wypadają dokładnie na tej samej wartości
+ * (prędkości i przyspieszenie dają ułamki o mianowniku 3), więc o wyniku zderzenia
+ * decyduje zaokrąglenie. Takie remisy są głównym źródłem rozbieżności.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "FixedSimulation.h"
+
+/**
+ * @brief Rodzaj rozbieżności między modelami.
+ */
+enum class Divergence {
+    None,       /**< Modele zgodne do końca toru. */
+    GameOver,   /**< Tylko jeden model zakończył grę. */
+    Score,      /**< Różna liczba zebranych monet. */
+    Spawn       /**< Nowa rura powstała w innym kroku. */
+};
+
+/**
+ * @brief Wynik porównania jednego toru.
+ */
+struct CourseResult {
+    Divergence kind; /**< Rodzaj pierwszej rozbieżności. */
+    std::uint32_t tick; /**< Krok pierwszej rozbieżności lub długość toru. */
+    float maxDrift; /**< Największa różnica pozycji ptaka przed rozbieżnością, w pikselach. */
+    float floatY; /**< Pozycja ptaka w modelu zmiennoprzecinkowym w kroku rozbieżności. */
+    float fixedY; /**< Pozycja ptaka w modelu stałoprzecinkowym w kroku rozbieżności. */
+    std::uint64_t checksum; /**< Skrót końcowego stanu stałoprzecinkowego. */
+};
+
+/**
+ * @brief Bot sterujący ptakiem, z progiem losowo przesuwanym dla różnorodności torów.
+ *
+ * Decyzje zależą tylko od świata stałoprzecinkowego, więc są takie same w każdej kompilacji.
+ *
+ * @param world Świat stałoprzecinkowy.
+ * @param rng Stan generatora bota.
+ * @return true jeśli bot macha skrzydłami.
+ */
+static bool botFlap(const FixedWorld& world, std::uint32_t& rng) {
+    int next = FixedSimulation::nextPipe(world);
+    Fixed target = next < 0 ? Fixed::fromInt(300) : world.pipes[next].y + FixedSimulation::pipeHeight.divInt(2);
+    target -= Fixed::fromInt((std::int32_t)(Simulation::nextRandom(rng) % 24));
+    return world.birdVel >= Fixed{0} && world.birdY + FixedSimulation::birdHeight.divInt(2) > target + Fixed::fromInt(10);
+}
+
+/**
+ * @brief Rozgrywa jeden tor w obu modelach naraz.
+ *
+ * @tparam D Poziom trudności.
+ * @param seed Ziarno toru.
+ * @param maxTicks Największa liczba kroków.
+ * @return Wynik porównania.
+ */
+template<Difficulty D>
+static CourseResult runCourse(std::uint32_t seed, std::uint32_t maxTicks) {
+    const float dt = 1.0f / (float)FixedSimulation::ticksPerSecond;
+    World f;
+    FixedWorld q;
+    Simulation::reset(f, seed);
+    FixedSimulation::reset(q, seed);
+    std::uint32_t rng = seed * 2654435761u + 1;
+
+    CourseResult result{Divergence::None, 0, 0, 0, 0, 0};
+    for (std::uint32_t t = 0; t < maxTicks && !(f.over && q.over); ++t) {
+        bool flap = botFlap(q, rng);
+        Simulation::step<D>(f, dt, flap);
+        FixedSimulation::step<D>(q, flap);
+
+        Divergence kind = Divergence::None;
+        if (f.over != q.over) kind = Divergence::GameOver;
+        else if (f.score != q.score) kind = Divergence::Score;
+        else if (f.pipeCount != q.pipeCount || f.rng != q.rng) kind = Divergence::Spawn;
+        if (kind != Divergence::None) {
+            result.kind = kind;
+            result.tick = t;
+            result.floatY = f.birdY;
+            result.fixedY = q.birdY.toFloat();
+            break;
+        }
+        result.maxDrift = std::max(result.maxDrift, std::fabs(f.birdY - q.birdY.toFloat()));
+        result.tick = t + 1;
+    }
+    result.checksum = FixedSimulation::checksum(q);
+    return result;
+}
+
+/**
+ * @brief Porównuje modele na wielu torach jednego poziomu trudności i wypisuje raport.
+ *
+ * @tparam D Poziom trudności.
+ * @param name Nazwa poziomu trudności.
+ * @param courses Liczba torów.
+ * @param maxTicks Największa liczba kroków na tor.
+ * @param checksum Skrót zbiorczy, do którego dołączane są wyniki.
+ */
+template<Difficulty D>
+static void crossCheck(const char* name, std::uint32_t courses, std::uint32_t maxTicks, std::uint64_t& checksum) {
+    std::uint32_t byKind[4] = {};
+    std::vector<std::uint32_t> divergenceTicks;
+    float maxDrift = 0;
+    std::uint32_t firstSeed = 0, firstTick = UINT32_MAX;
+    CourseResult first{};
+    std::uint64_t ticks = 0;
+
+    for (std::uint32_t seed = 1; seed <= courses; ++seed) {
+        CourseResult r = runCourse<D>(seed, maxTicks);
+        byKind[static_cast<int>(r.kind)]++;
+        ticks += r.tick;
+        checksum = (checksum ^ r.checksum) * 0x100000001b3ull;
+        maxDrift = std::max(maxDrift, r.maxDrift);
+        if (r.kind != Divergence::None) {
+            divergenceTicks.push_back(r.tick);
+            if (r.tick < firstTick) {
+                firstTick = r.tick;
+                firstSeed = seed;
+                first = r;
+            }
+        }
+    }
+
+    std::printf("%-10s tory %u  kroki %llu  zgodne %u  rozbiezne %u (koniec gry %u, monety %u, rury %u)  maks. dryf %.4f px\n",
+                name, courses, (unsigned long long)ticks, byKind[0], courses - byKind[0],
+                byKind[1], byKind[2], byKind[3], maxDrift);
+    if (!divergenceTicks.empty()) {
+        std::sort(divergenceTicks.begin(), divergenceTicks.end());
+        std::printf("           pierwsza rozbieznosc: ziarno %u, krok %u, ptak y %.6f / %.6f;  mediana kroku rozbieznosci %u\n",
+                    firstSeed, firstTick, first.floatY, first.fixedY, divergenceTicks[divergenceTicks.size() / 2]);
+    }
+}
+
+/**
+ * @brief Mierzy przepustowość wsadowego kernela stałoprzecinkowego.
+ *
+ * @param count Liczba światów.
+ * @param steps Liczba kroków.
+ * @return Liczba kroków na sekundę.
+ */
+static double fixedThroughput(std::size_t count, int steps) {
+    std::vector<FixedWorld> worlds(count);
+    std::vector<std::uint8_t> flaps(count);
+    std::uint32_t seed = 1, rng = 1;
+    for (auto& w : worlds) {
+        FixedSimulation::reset(w, seed++);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (int s = 0; s < steps; ++s) {
+        for (std::size_t i = 0; i < count; ++i) {
+            FixedWorld& w = worlds[i];
+            if (w.over) {
+                FixedSimulation::reset(w, seed++);
+            }
+            flaps[i] = botFlap(w, rng);
+        }
+        FixedSimulation::stepBatch(Difficulty::Medium, worlds.data(), count, flaps.data());
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return (double)count * steps / elapsed.count();
+}
+
+/**
+ * @brief Punkt wejścia programu.
+ *
+ * @param argc Liczba argumentów.
+ * @param argv Argumenty wywołania.
+ * @return Kod zakończenia programu.
+ */
+int main(int argc, char** argv) {
+    auto courses = (std::uint32_t)(argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 2000);
+    auto maxTicks = (std::uint32_t)(argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 20000);
+
+    std::uint64_t checksum = 0xcbf29ce484222325ull;
+    crossCheck<Difficulty::Easy>("Easy", courses, maxTicks, checksum);
+    crossCheck<Difficulty::Medium>("Medium", courses, maxTicks, checksum);
+    crossCheck<Difficulty::Hard>("Hard", courses, maxTicks, checksum);
+    crossCheck<Difficulty::Nightmare>("Nightmare", courses, maxTicks, checksum);
+
+    std::printf("skrot stanow staloprzecinkowych: %016llx\n", (unsigned long long)checksum);
+    std::printf("przepustowosc kernela staloprzecinkowego: %.2f Mticks/s\n", fixedThroughput(4096, 2000) / 1e6);
+    return 0;
+}
@@ -0,0 +1,493 @@
+/**
+ * @file heatmap.cpp
+ * @brief Mapy cieplne miejsc śmierci ptaka z zapisanych rozgrywek.
+ *
+ * Użycie:
+ *   Flappy_Bird_heatmap [runs.bin ...] [--generate N] [--difficulty 0-3] [--save runs.bin] [--threads T] [--out prefiks]
+ *
+ * Każda rozgrywka z plików zapisu (RunLog) jest odtwarzana symulacją gry,
+ * a każdy jej krok trafia do histogramu 2D: pozycja Y ptaka względem odległości
+ * w poziomie do najbliższej nieminiętej rury. Histogramy są osobne dla każdej
+ * przyczyny śmierci (ziemia, sufit, rura), więc pokazują, którędy leciały
+ * rozgrywki zakończone w dany sposób; osobny histogram zbiera same miejsca śmierci.
+ * Dla każdej przyczyny liczony jest też rozkład prędkości ptaka w chwili śmierci
+ * i wysokości przerwy rury, przed którą zginął.
+ *
+ * --generate N dokłada N rozgrywek bota "casual" na losowych torach (np. do
+ * sprawdzenia przepustowości), a --save zapisuje je do pliku zapisu.
+ *
+ * Pliki są czytane strumieniowo przez jeden wątek do stałej puli partii,
+ * a rozgrywki odtwarzają wątki robocze, każdy do własnych histogramów. Na końcu
+ * histogramy są sumowane równolegle (każdy wątek sumuje swój zakres komórek)
+ * i zapisywane jako obrazy PNG (prefiks_przyczyna_visits.png i _deaths.png)
+ * oraz prefiks.csv (niezerowe komórki) i prefiks_deaths.csv (prędkości i przerwy).
+ * Pamięć nie zależy od liczby rozgrywek.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <SFML/Graphics.hpp>
+#include "Bots.h"
+#include "RunLog.h"
+
+namespace {
+
+constexpr int binSize = 4; /**< Bok komórki histogramu w pikselach. */
+constexpr float minDx = -Physics::pipeWidth; /**< Najmniejsza odległość do nieminiętej rury. */
+constexpr float maxDx = Physics::pipeSpawnX - Physics::birdX; /**< Największa odległość do rury. */
+constexpr int xBins = (int)((maxDx - minDx) / binSize) + 1; /**< Liczba kolumn histogramu. */
+constexpr int yBins = (int)(Physics::floorY / binSize) + 1; /**< Liczba wierszy histogramu. */
+constexpr int cells = xBins * yBins; /**< Liczba komórek histogramu jednej przyczyny. */
+
+constexpr float minVelocity = Physics::flapVelocity; /**< Dolna granica histogramu prędkości. */
+constexpr float velocityBinWidth = 25; /**< Szerokość przedziału prędkości. */
+constexpr int velocityBins = 64; /**< Liczba przedziałów prędkości (ostatni zbiera przepełnienie). */
+constexpr int gapBins = Physics::pipeHeights + 1; /**< Wysokości przerw i "brak rury". */
+
+constexpr std::size_t batchRuns = 4096; /**< Liczba rozgrywek w partii. */
+constexpr std::uint32_t maxGeneratedTicks = 60 * 60 * 10; /**< Najdłuższa generowana rozgrywka (10 minut). */
+
+/**
+ * @brief Przyczyna śmierci.
+ */
+enum Cause { Ground, Ceiling, PipeHit, causeCount };
+
+const char* causeNames[causeCount] = {"ground", "ceiling", "pipe"}; /**< Nazwy przyczyn w plikach wynikowych. */
+
+/**
+ * @brief Odbiorca zdarzeń odróżniający zderzenie z rurą od zderzenia z ziemią lub sufitem.
+ */
+struct DeathProbe {
+    bool hit = false; /**< Czy wystąpiło zderzenie z rurą. */
+    void setTick(std::uint32_t) {} /**< Nic nie robi. */
+    bool emit(GameEventType type) { hit = hit || type == GameEventType::Hit; return true; } /**< Zapamiętuje zderzenie z rurą. */
+};
+
+/**
+ * @brief Histogramy jednego wątku.
+ */
+struct Heatmap {
+    std::vector<std::uint64_t> visits; /**< Kroki rozgrywek, [przyczyna][y][x]. */
+    std::vector<std::uint64_t> deaths; /**< Miejsca śmierci, [przyczyna][y][x]. */
+    std::vector<std::uint64_t> deathVelocity; /**< Prędkość w chwili śmierci, [przyczyna][przedział]. */
+    std::vector<std::uint64_t> deathGap; /**< Wysokość przerwy najbliższej rury, [przyczyna][wysokość]. */
+    std::uint64_t runs = 0; /**< Odtworzone rozgrywki zakończone śmiercią. */
+    std::uint64_t unfinished = 0; /**< Rozgrywki, które w odtworzeniu nie zakończyły się śmiercią. */
+    std::uint64_t steps = 0; /**< Odtworzone kroki. */
+
+    std::vector<std::uint32_t> trail; /**< Komórki bieżącej rozgrywki. */
+    float lastVelocity = 0; /**< Prędkość ptaka po poprzednim kroku. */
+    DeathProbe probe; /**< Zdarzenia bieżącej rozgrywki. */
+
+    Heatmap()
+            : visits((std::size_t)causeCount * cells), deaths((std::size_t)causeCount * cells),
+              deathVelocity((std::size_t)causeCount * velocityBins), deathGap((std::size_t)causeCount * gapBins) {
+        trail.reserve(1 << 16);
+    }
+
+    /**
+     * @brief Zwraca komórkę ptaka lub -1, gdy przed ptakiem nie ma rury.
+     */
+    static int cellOf(const World& world) {
+        int next = Simulation::nextPipe(world);
+        if (next < 0) return -1;
+        int x = (int)((world.pipes[next].x - Physics::birdX - minDx) / binSize);
+        int y = (int)(world.birdY / binSize);
+        x = std::min(std::max(x, 0), xBins - 1);
+        y = std::min(std::max(y, 0), yBins - 1);
+        return y * xBins + x;
+    }
+
+    /**
+     * @brief Rozpoczyna rozgrywkę.
+     */
+    void begin() {
+        trail.clear();
+        lastVelocity = 0;
+        probe.hit = false;
+    }
+
+    /**
+     * @brief Zapisuje krok rozgrywki.
+     */
+    void visit(const World& world) {
+        if (!world.over) {
+            lastVelocity = world.birdVel;
+        }
+        int cell = cellOf(world);
+        if (cell >= 0) {
+            trail.push_back((std::uint32_t)cell);
+        }
+    }
+
+    /**
+     * @brief Kończy rozgrywkę i dodaje jej kroki do histogramów jej przyczyny śmierci.
+     */
+    void finish(const World& world) {
+        steps += world.ticks;
+        if (!world.over) {
+            unfinished++;
+            return;
+        }
+        runs++;
+        Cause cause = probe.hit ? PipeHit : world.birdY < 0 ? Ceiling : Ground;
+        std::uint64_t* causeVisits = visits.data() + (std::size_t)cause * cells;
+        for (std::uint32_t cell : trail) {
+            causeVisits[cell]++;
+        }
+        int cell = cellOf(world);
+        if (cell >= 0) {
+            deaths[(std::size_t)cause * cells + cell]++;
+        }
+
+        // Przy zderzeniu z ziemią symulacja zeruje prędkość - liczy się ta sprzed zderzenia.
+        float velocity = cause == Ground ? lastVelocity + Physics::gravity * RunLog::stepTime : world.birdVel;
+        int v = (int)((velocity - minVelocity) / velocityBinWidth);
+        deathVelocity[(std::size_t)cause * velocityBins + std::min(std::max(v, 0), velocityBins - 1)]++;
+
+        int gap = Physics::pipeHeights;
+        int next = Simulation::nextPipe(world);
+        for (int roll = 0; next >= 0 && roll < Physics::pipeHeights; ++roll) {
+            if (Physics::pipeY(roll) == world.pipes[next].y) gap = roll;
+        }
+        deathGap[(std::size_t)cause * gapBins + gap]++;
+    }
+};
+
+/**
+ * @brief Ograniczona kolejka partii: wolne partie wracają do czytającego, pełne idą do wątków.
+ */
+struct BatchQueue {
+    std::mutex mutex; /**< Chroni kolejki. */
+    std::condition_variable changed; /**< Sygnalizuje zmianę kolejek. */
+    std::vector<RunBatch*> free; /**< Partie do wypełnienia. */
+    std::vector<RunBatch*> full; /**< Partie do odtworzenia. */
+    bool finished = false; /**< Czy czytający skończył. */
+};
+
+/**
+ * @brief Ustawienia narzędzia.
+ */
+struct Options {
+    std::vector<std::string> inputs; /**< Pliki zapisu. */
+    std::uint64_t generate = 0; /**< Liczba generowanych rozgrywek. */
+    Difficulty difficulty = Difficulty::Medium; /**< Poziom trudności generowanych rozgrywek. */
+    std::string save; /**< Plik zapisu generowanych rozgrywek. */
+    unsigned threads = 0; /**< Liczba wątków (0 - wszystkie rdzenie). */
+    std::string out = "heatmap"; /**< Prefiks plików wynikowych. */
+};
+
+/**
+ * @brief Odtwarza rozgrywki jednej partii.
+ */
+void replayBatch(const RunBatch& batch, Heatmap& heatmap) {
+    World world;
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        heatmap.begin();
+        RunLog::replay(batch.runs[i], batch.flapsOf(i), batch.flapCountOf(i),
+                       world, heatmap.probe, [&heatmap](const World& w) { heatmap.visit(w); });
+        heatmap.finish(world);
+    }
+}
+
+/**
+ * @brief Zwraca ziarno toru generowanej rozgrywki.
+ *
+ * @param index Numer rozgrywki.
+ * @return Ziarno różne od zera.
+ */
+std::uint32_t generatedSeed(std::uint64_t index) {
+    return (std::uint32_t)(index * 0x9e3779b97f4a7c15ull >> 32) | 1u;
+}
+
+/**
+ * @brief Rozgrywa i zapisuje do histogramów jedną rozgrywkę bota.
+ *
+ * @param index Numer rozgrywki, z którego wyprowadzane są ziarna toru i bota.
+ * @param difficulty Poziom trudności.
+ * @param heatmap Histogramy wątku.
+ * @param flaps Bufor machnięć (wypełniany, gdy rozgrywki są zapisywane).
+ * @return Świat po zakończeniu rozgrywki.
+ */
+World playGenerated(std::uint64_t index, Difficulty difficulty, Heatmap& heatmap, std::vector<std::uint32_t>* flaps) {
+    std::uint32_t seed = generatedSeed(index);
+    World world;
+    Simulation::reset(world, seed);
+    Bots::Human bot(Bots::casual, seed ^ 0x5bd1e995u);
+    const auto rules = Simulation::RuntimeRules::of(difficulty);
+    heatmap.begin();
+    if (flaps) flaps->clear();
+    while (!world.over && world.ticks < maxGeneratedTicks) {
+        // Gra zaczyna się od machnięcia, tak jak z ekranu "Get Ready".
+        bool flap = !world.running || bot(world);
+        if (flap && flaps) flaps->push_back(world.ticks);
+        Simulation::stepWith(world, RunLog::stepTime, flap, rules, heatmap.probe);
+        heatmap.visit(world);
+    }
+    heatmap.finish(world);
+    return world;
+}
+
+/**
+ * @brief Zamienia wartość z zakresu [0, 1] na kolor mapy cieplnej (czarny, fiolet, pomarańcz, żółty, biel).
+ */
+void colorOf(float t, std::uint8_t* rgba) {
+    static const float stops[5][3] = {{0, 0, 0}, {90, 20, 120}, {230, 90, 30}, {250, 220, 40}, {255, 255, 255}};
+    float scaled = std::min(std::max(t, 0.0f), 1.0f) * 4;
+    int i = std::min((int)scaled, 3);
+    float f = scaled - (float)i;
+    for (int c = 0; c < 3; ++c) {
+        rgba[c] = (std::uint8_t)(stops[i][c] + (stops[i + 1][c] - stops[i][c]) * f);
+    }
+    rgba[3] = 255;
+}
+
+/**
+ * @brief Zapisuje histogram jako obraz PNG w skali logarytmicznej, 2 piksele na komórkę.
+ */
+bool saveImage(const std::string& path, const std::uint64_t* histogram) {
+    const int scale = 2;
+    std::uint64_t peak = *std::max_element(histogram, histogram + cells);
+    double norm = peak ? std::log1p((double)peak) : 1;
+    std::vector<std::uint8_t> rgba((std::size_t)xBins * scale * yBins * scale * 4);
+    for (int y = 0; y < yBins * scale; ++y) {
+        for (int x = 0; x < xBins * scale; ++x) {
+            double value = std::log1p((double)histogram[(y / scale) * xBins + x / scale]) / norm;
+            colorOf((float)value, &rgba[((std::size_t)y * xBins * scale + x) * 4]);
+        }
+    }
+    sf::Image image;
+    image.create((unsigned)(xBins * scale), (unsigned)(yBins * scale), rgba.data());
+    return image.saveToFile(path);
+}
+
+/**
+ * @brief Zapisuje wyniki: obrazy i pliki CSV.
+ */
+bool writeResults(const Options& options, const Heatmap& total) {
+    bool ok = true;
+    for (int c = 0; c < causeCount; ++c) {
+        std::string base = options.out + "_" + causeNames[c];
+        ok = saveImage(base + "_visits.png", total.visits.data() + (std::size_t)c * cells) && ok;
+        ok = saveImage(base + "_deaths.png", total.deaths.data() + (std::size_t)c * cells) && ok;
+    }
+
+    FILE* csv = std::fopen((options.out + ".csv").c_str(), "w");
+    if (!csv) return false;
+    std::fprintf(csv, "cause,dx,y,visits,deaths\n");
+    for (int c = 0; c < causeCount; ++c) {
+        for (int cell = 0; cell < cells; ++cell) {
+            std::size_t i = (std::size_t)c * cells + cell;
+            if (total.visits[i] == 0 && total.deaths[i] == 0) continue;
+            std::fprintf(csv, "%s,%d,%d,%llu,%llu\n", causeNames[c], (int)minDx + (cell % xBins) * binSize,
+                         (cell / xBins) * binSize, (unsigned long long)total.visits[i], (unsigned long long)total.deaths[i]);
+        }
+    }
+    std::fclose(csv);
+
+    csv = std::fopen((options.out + "_deaths.csv").c_str(), "w");
+    if (!csv) return false;
+    std::fprintf(csv, "cause,kind,value,deaths\n");
+    for (int c = 0; c < causeCount; ++c) {
+        for (int v = 0; v < velocityBins; ++v) {
+            std::uint64_t n = total.deathVelocity[(std::size_t)c * velocityBins + v];
+            if (n) std::fprintf(csv, "%s,velocity,%g,%llu\n", causeNames[c], minVelocity + (float)v * velocityBinWidth, (unsigned long long)n);
+        }
+        for (int g = 0; g < gapBins; ++g) {
+            std::uint64_t n = total.deathGap[(std::size_t)c * gapBins + g];
+            if (!n) continue;
+            if (g < Physics::pipeHeights) std::fprintf(csv, "%s,gap_y,%g,%llu\n", causeNames[c], Physics::pipeY(g), (unsigned long long)n);
+            else std::fprintf(csv, "%s,gap_y,none,%llu\n", causeNames[c], (unsigned long long)n);
+        }
+    }
+    std::fclose(csv);
+    return ok;
+}
+
+}
+
+/**
+ * @brief Punkt wejścia narzędzia.
+ *
+ * @param argc Liczba argumentów.
+ * @param argv Argumenty wywołania.
+ * @return Kod zakończenia programu.
+ */
+int main(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        if (argv[i][0] != '-') {
+            options.inputs.push_back(argv[i]);
+        } else if (i + 1 < argc) {
+            if (std::strcmp(argv[i], "--generate") == 0) options.generate = std::strtoull(argv[i + 1], nullptr, 10);
+            else if (std::strcmp(argv[i], "--difficulty") == 0) {
+                int d = std::atoi(argv[i + 1]);
+                options.difficulty = static_cast<Difficulty>(d < 0 || d > 3 ? 1 : d);
+            }
+            else if (std::strcmp(argv[i], "--save") == 0) options.save = argv[i + 1];
+            else if (std::strcmp(argv[i], "--threads") == 0) options.threads = (unsigned)std::strtoul(argv[i + 1], nullptr, 10);
+            else if (std::strcmp(argv[i], "--out") == 0) options.out = argv[i + 1];
+            ++i;
+        }
+    }
+    if (options.inputs.empty() && options.generate == 0) {
+        std::fprintf(stderr, "Uzycie: %s [runs.bin ...] [--generate N] [--difficulty 0-3] [--save runs.bin] "
+                             "[--threads T] [--out prefiks]\n", argv[0]);
+        return 2;
+    }
+
+    const unsigned threads = options.threads ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+    std::vector<Heatmap> heatmaps(threads);
+    auto start = std::chrono::steady_clock::now();
+
+    // Rozgrywki generowane: każdy wątek bierze kolejne numery z licznika.
+    if (options.generate > 0) {
+        RunWriter* writer = options.save.empty() ? nullptr : new RunWriter(options.save);
+        if (writer && !writer->isOpen()) {
+            std::fprintf(stderr, "Nie udalo sie otworzyc %s\n", options.save.c_str());
+            delete writer;
+            return 1;
+        }
+        std::atomic<std::uint64_t> next{0};
+        std::mutex writerMutex;
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                std::vector<std::uint32_t> flaps;
+                for (std::uint64_t i = next++; i < options.generate; i = next++) {
+                    World world = playGenerated(i, options.difficulty, heatmaps[t], writer ? &flaps : nullptr);
+                    if (writer) {
+                        std::lock_guard<std::mutex> lock(writerMutex);
+                        writer->append(generatedSeed(i), options.difficulty, PlayerModel::Blue, world.score, world.ticks, flaps);
+                    }
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        delete writer;
+    }
+
+    // Pliki zapisu: jeden wątek czyta partie, pozostałe je odtwarzają.
+    bool corrupt = false;
+    if (!options.inputs.empty()) {
+        BatchQueue queue;
+        std::vector<RunBatch> batches(2 * threads);
+        for (auto& batch : batches) {
+            batch.runs.reserve(batchRuns);
+            batch.offsets.reserve(batchRuns + 1);
+            queue.free.push_back(&batch);
+        }
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                while (true) {
+                    RunBatch* batch;
+                    {
+                        std::unique_lock<std::mutex> lock(queue.mutex);
+                        queue.changed.wait(lock, [&] { return !queue.full.empty() || queue.finished; });
+                        if (queue.full.empty()) return;
+                        batch = queue.full.back();
+                        queue.full.pop_back();
+                    }
+                    replayBatch(*batch, heatmaps[t]);
+                    {
+                        std::lock_guard<std::mutex> lock(queue.mutex);
+                        queue.free.push_back(batch);
+                    }
+                    queue.changed.notify_all();
+                }
+            });
+        }
+
+        for (const auto& input : options.inputs) {
+            RunReader reader(input);
+            if (!reader.isOpen()) {
+                std::fprintf(stderr, "Nie udalo sie otworzyc %s\n", input.c_str());
+                corrupt = true;
+                continue;
+            }
+            bool more = true;
+            while (more) {
+                RunBatch* batch;
+                {
+                    std::unique_lock<std::mutex> lock(queue.mutex);
+                    queue.changed.wait(lock, [&] { return !queue.free.empty(); });
+                    batch = queue.free.back();
+                    queue.free.pop_back();
+                }
+                more = reader.read(*batch, batchRuns);
+                {
+                    std::lock_guard<std::mutex> lock(queue.mutex);
+                    (batch->size() == 0 ? queue.free : queue.full).push_back(batch);
+                }
+                queue.changed.notify_all();
+            }
+            if (reader.isCorrupt()) {
+                std::fprintf(stderr, "Plik %s jest uszkodzony - przeczytano tylko poczatek\n", input.c_str());
+                corrupt = true;
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.finished = true;
+        }
+        queue.changed.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    // Sumowanie: każdy wątek dodaje swój zakres komórek ze wszystkich histogramów do pierwszego.
+    Heatmap& total = heatmaps[0];
+    const std::size_t totalCells = total.visits.size();
+    std::vector<std::thread> mergers;
+    for (unsigned t = 0; t < threads; ++t) {
+        mergers.emplace_back([&, t] {
+            std::size_t from = totalCells * t / threads, to = totalCells * (t + 1) / threads;
+            for (unsigned h = 1; h < threads; ++h) {
+                for (std::size_t i = from; i < to; ++i) {
+                    total.visits[i] += heatmaps[h].visits[i];
+                    total.deaths[i] += heatmaps[h].deaths[i];
+                }
+            }
+        });
+    }
+    for (auto& merger : mergers) {
+        merger.join();
+    }
+    for (unsigned h = 1; h < threads; ++h) {
+        for (std::size_t i = 0; i < total.deathVelocity.size(); ++i) total.deathVelocity[i] += heatmaps[h].deathVelocity[i];
+        for (std::size_t i = 0; i < total.deathGap.size(); ++i) total.deathGap[i] += heatmaps[h].deathGap[i];
+        total.runs += heatmaps[h].runs;
+        total.unfinished += heatmaps[h].unfinished;
+        total.steps += heatmaps[h].steps;
+    }
+
+    std::printf("rozgrywki: %llu (bez smierci: %llu), kroki: %llu, %.1f s, %.0f rozgrywek/s, %.1f mln krokow/s\n",
+                (unsigned long long)total.runs, (unsigned long long)total.unfinished, (unsigned long long)total.steps,
+                elapsed.count(), (double)(total.runs + total.unfinished) / elapsed.count(),
+                (double)total.steps / elapsed.count() / 1e6);
+    for (int c = 0; c < causeCount; ++c) {
+        std::uint64_t deaths = 0;
+        for (int g = 0; g < gapBins; ++g) deaths += total.deathGap[(std::size_t)c * gapBins + g];
+        std::printf("  %-8s %llu smierci\n", causeNames[c], (unsigned long long)deaths);
+    }
+    if (!writeResults(options, total)) {
+        std::fprintf(stderr, "Nie udalo sie zapisac wynikow %s*\n", options.out.c_str());
+        return 1;
+    }
+    return corrupt ? 1 : 0;
+}
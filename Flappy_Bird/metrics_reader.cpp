@@ -0,0 +1,221 @@
+/**
+ * @file metrics_reader.cpp
+ * @brief Narzędzie wypisujące metryki działających procesów gry.
+ *
+ * Użycie: Flappy_Bird_metrics [pid...] [--watch] [--prometheus]
+ *
+ * Bez podanego pid odczytywane są wszystkie segmenty /dev/shm/flappy_metrics.*.
+ * Opcja --watch odświeża wynik co sekundę, a --prometheus wypisuje metryki
+ * w formacie tekstowym Prometheusa.
+ */
+
+#include "Metrics.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/**
+ * @brief Zmapowany do odczytu blok metryk jednego procesu.
+ */
+struct Source {
+    std::uint64_t pid; /**< Identyfikator procesu gry. */
+    const MetricsBlock* block; /**< Zmapowany blok liczników. */
+    std::uint64_t lastFrames; /**< Liczba klatek przy poprzednim odczycie (tryb --watch). */
+};
+
+/**
+ * @brief Mapuje segment metryk procesu tylko do odczytu.
+ *
+ * @param pid Identyfikator procesu.
+ * @return Wskaźnik na blok lub nullptr, gdy segment nie istnieje lub jest niezgodny.
+ */
+static const MetricsBlock* attach(std::uint64_t pid) {
+    auto name = Metrics::segmentName(pid);
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) return nullptr;
+    void* data = mmap(nullptr, sizeof(MetricsBlock), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return nullptr;
+
+    auto* block = static_cast<const MetricsBlock*>(data);
+    if (block->magic != MetricsBlock::magicValue || block->size != sizeof(MetricsBlock)) {
+        munmap(data, sizeof(MetricsBlock));
+        return nullptr;
+    }
+    return block;
+}
+
+/**
+ * @brief Wyszukuje identyfikatory procesów, które opublikowały metryki.
+ *
+ * @return Lista identyfikatorów procesów.
+ */
+static std::vector<std::uint64_t> discover() {
+    std::vector<std::uint64_t> pids;
+    DIR* dir = opendir("/dev/shm");
+    if (!dir) return pids;
+    const char prefix[] = "flappy_metrics.";
+    while (auto* entry = readdir(dir)) {
+        if (std::strncmp(entry->d_name, prefix, sizeof(prefix) - 1) == 0) {
+            pids.push_back(std::strtoull(entry->d_name + sizeof(prefix) - 1, nullptr, 10));
+        }
+    }
+    closedir(dir);
+    return pids;
+}
+
+/**
+ * @brief Wyznacza percentyl czasu klatki z histogramu.
+ *
+ * @param m Blok metryk.
+ * @param p Percentyl z zakresu (0, 1].
+ * @return Górna granica przedziału w milisekundach.
+ */
+static double framePercentileMs(const MetricsBlock& m, double p) {
+    std::uint64_t counts[MetricsBlock::frameBuckets];
+    std::uint64_t total = 0;
+    for (std::uint32_t i = 0; i < MetricsBlock::frameBuckets; ++i) {
+        counts[i] = m.frameTimeHistogram[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+    if (total == 0) return 0.0;
+
+    auto needed = (std::uint64_t)(p * (double)total);
+    std::uint64_t seen = 0;
+    for (std::uint32_t i = 0; i < MetricsBlock::frameBuckets; ++i) {
+        seen += counts[i];
+        if (seen >= needed && seen > 0) {
+            return (double)((i + 1) * MetricsBlock::bucketWidthUs) / 1000.0;
+        }
+    }
+    return (double)(MetricsBlock::frameBuckets * MetricsBlock::bucketWidthUs) / 1000.0;
+}
+
+/**
+ * @brief Wypisuje metryki procesu w formacie czytelnym dla człowieka.
+ *
+ * @param s Źródło metryk.
+ * @param fps Liczba klatek na sekundę do wypisania.
+ */
+static void printHuman(const Source& s, double fps) {
+    const auto& m = *s.block;
+    std::printf("pid %llu: fps %.1f  frame p50 %.2fms p95 %.2fms p99 %.2fms  last %.2fms\n",
+                (unsigned long long)s.pid, fps,
+                framePercentileMs(m, 0.50), framePercentileMs(m, 0.95), framePercentileMs(m, 0.99),
+                (double)m.lastFrameUs.load(std::memory_order_relaxed) / 1000.0);
+    std::printf("    frames %llu  ticks %llu  restarts %llu  deaths ground %llu pipe %llu  cache hit %llu miss %llu  capture %llu dropped %llu\n",
+                (unsigned long long)m.frames.load(std::memory_order_relaxed),
+                (unsigned long long)m.simTicks.load(std::memory_order_relaxed),
+                (unsigned long long)m.restarts.load(std::memory_order_relaxed),
+                (unsigned long long)m.deathsGround.load(std::memory_order_relaxed),
+                (unsigned long long)m.deathsPipe.load(std::memory_order_relaxed),
+                (unsigned long long)m.assetCacheHits.load(std::memory_order_relaxed),
+                (unsigned long long)m.assetCacheMisses.load(std::memory_order_relaxed),
+                (unsigned long long)m.captureFrames.load(std::memory_order_relaxed),
+                (unsigned long long)m.captureDropped.load(std::memory_order_relaxed));
+    std::printf("    speed x%llu  %llu ticks/s\n",
+                (unsigned long long)m.timeScale.load(std::memory_order_relaxed),
+                (unsigned long long)m.simTicksPerSecond.load(std::memory_order_relaxed));
+    std::printf("    budget %.2fms  cost %.2fms  over budget %llu  quality level %llu (drops %llu restores %llu)\n",
+                (double)m.frameBudgetUs.load(std::memory_order_relaxed) / 1000.0,
+                (double)m.frameCostUs.load(std::memory_order_relaxed) / 1000.0,
+                (unsigned long long)m.framesOverBudget.load(std::memory_order_relaxed),
+                (unsigned long long)m.qualityLevel.load(std::memory_order_relaxed),
+                (unsigned long long)m.qualityDrops.load(std::memory_order_relaxed),
+                (unsigned long long)m.qualityRestores.load(std::memory_order_relaxed));
+}
+
+/**
+ * @brief Wypisuje metryki procesu w formacie tekstowym Prometheusa.
+ *
+ * @param s Źródło metryk.
+ */
+static void printPrometheus(const Source& s) {
+    const auto& m = *s.block;
+    auto pid = (unsigned long long)s.pid;
+    auto counter = [pid](const char* name, const std::atomic<std::uint64_t>& value, const char* labels = "") {
+        std::printf("flappy_%s{pid=\"%llu\"%s} %llu\n", name, pid, labels,
+                    (unsigned long long)value.load(std::memory_order_relaxed));
+    };
+    counter("frames_total", m.frames);
+    counter("frame_time_us_total", m.frameTimeTotalUs);
+    counter("sim_ticks_total", m.simTicks);
+    counter("restarts_total", m.restarts);
+    counter("deaths_total", m.deathsGround, ",cause=\"ground\"");
+    counter("deaths_total", m.deathsPipe, ",cause=\"pipe\"");
+    counter("asset_cache_hits_total", m.assetCacheHits);
+    counter("asset_cache_misses_total", m.assetCacheMisses);
+    counter("capture_frames_total", m.captureFrames);
+    counter("capture_dropped_total", m.captureDropped);
+    counter("time_scale", m.timeScale);
+    counter("sim_ticks_per_second", m.simTicksPerSecond);
+    counter("frame_budget_us", m.frameBudgetUs);
+    counter("frame_cost_us", m.frameCostUs);
+    counter("frames_over_budget_total", m.framesOverBudget);
+    counter("quality_level", m.qualityLevel);
+    counter("quality_changes_total", m.qualityDrops, ",direction=\"drop\"");
+    counter("quality_changes_total", m.qualityRestores, ",direction=\"restore\"");
+    for (double q : {0.5, 0.95, 0.99}) {
+        std::printf("flappy_frame_time_ms{pid=\"%llu\",quantile=\"%g\"} %.3f\n", pid, q, framePercentileMs(m, q));
+    }
+}
+
+/**
+ * @brief Punkt wejścia narzędzia.
+ *
+ * @param argc Liczba argumentów.
+ * @param argv Argumenty wywołania.
+ * @return Kod zakończenia programu.
+ */
+int main(int argc, char** argv) {
+    bool watch = false;
+    bool prometheus = false;
+    std::vector<std::uint64_t> pids;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--watch") == 0) watch = true;
+        else if (std::strcmp(argv[i], "--prometheus") == 0) prometheus = true;
+        else pids.push_back(std::strtoull(argv[i], nullptr, 10));
+    }
+    if (pids.empty()) pids = discover();
+
+    std::vector<Source> sources;
+    for (auto pid : pids) {
+        if (auto* block = attach(pid)) {
+            sources.push_back({pid, block, block->frames.load(std::memory_order_relaxed)});
+        }
+    }
+    if (sources.empty()) {
+        std::fprintf(stderr, "Nie znaleziono metryk zadnego procesu gry.\n");
+        return 1;
+    }
+
+    do {
+        if (watch) std::this_thread::sleep_for(std::chrono::seconds(1));
+        for (auto& s : sources) {
+            if (prometheus) {
+                printPrometheus(s);
+                continue;
+            }
+            double fps;
+            auto frames = s.block->frames.load(std::memory_order_relaxed);
+            if (watch) {
+                fps = (double)(frames - s.lastFrames);
+                s.lastFrames = frames;
+            } else {
+                auto totalUs = s.block->frameTimeTotalUs.load(std::memory_order_relaxed);
+                fps = totalUs ? (double)frames * 1e6 / (double)totalUs : 0.0;
+            }
+            printHuman(s, fps);
+        }
+        std::fflush(stdout);
+    } while (watch);
+
+    return 0;
+}
@@ -0,0 +1,74 @@
+/**
+ * @file population_demo.cpp
+ * @brief Podgląd dużej populacji ptaków rysowanej klasą Population.
+ *
+ * Użycie: Flappy_Bird_population [liczba_ptaków]
+ *
+ * Każdy ptak ma własną prostą fizykę (grawitacja i losowe machnięcia, jak
+ * w systemie lotu EntityWorld i EntityWorld::flap). Liczba klatek na sekundę jest wyświetlana
+ * w tytule okna.
+ */
+
+#include <SFML/Graphics.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include "Population.h"
+
+/**
+ * @brief Punkt wejścia programu.
+ *
+ * @param argc Liczba argumentów.
+ * @param argv Argumenty wywołania.
+ * @return Kod zakończenia programu.
+ */
+int main(int argc, char** argv) {
+    std::size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000;
+
+    sf::RenderWindow window(sf::VideoMode(450, 700), "Flappy Bird - populacja");
+    sf::Texture background;
+    background.loadFromFile("res/textures/background/day.png");
+    const float floor = (float)background.getSize().y;
+
+    Population population(count);
+    std::vector<float> ys(count), vels(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        ys[i] = (float)(rand() % 500) + 50;
+        vels[i] = 0;
+        population.add(static_cast<PlayerModel>(i % BirdAtlas::skinCount), 20.0f + (float)(rand() % 360),
+                       ys[i], 0, (float)(rand() % BirdAtlas::animationFrames));
+    }
+
+    sf::Clock deltaClock;
+    sf::Clock fpsClock;
+    unsigned frames = 0;
+    while (window.isOpen()) {
+        sf::Event event{};
+        while (window.pollEvent(event)) {
+            if (event.type == sf::Event::Closed) window.close();
+        }
+
+        float delta = deltaClock.restart().asSeconds();
+        for (std::size_t i = 0; i < count; ++i) {
+            vels[i] += delta * 1200;
+            ys[i] += vels[i] * delta;
+            if (ys[i] > floor - 150 && rand() % 8 == 0) vels[i] = -420;
+            if (ys[i] > floor - 48) { ys[i] = floor - 48; vels[i] = -420; }
+            population.set(i, ys[i], vels[i]);
+        }
+        population.animate(delta);
+
+        window.clear();
+        window.draw(sf::Sprite(background));
+        population.draw(window);
+        window.display();
+
+        frames++;
+        if (fpsClock.getElapsedTime().asSeconds() >= 1) {
+            auto fps = (float)frames / fpsClock.restart().asSeconds();
+            window.setTitle("Flappy Bird - populacja " + std::to_string(count) + " ptakow, " + std::to_string((int)fps) + " fps");
+            frames = 0;
+        }
+    }
+    return 0;
+}
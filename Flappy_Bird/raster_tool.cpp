@@ -0,0 +1,217 @@
+/**
+ * @file raster_tool.cpp
+ * @brief Zrzuty ekranu i obserwacje pikselowe bez okna (SoftwareRenderer).
+ *
+ * Użycie:
+ *   Flappy_Bird_raster bench [--frames N] [--difficulty 0-3]
+ *   Flappy_Bird_raster shot plik.png [--ticks N] [--seed S] [--difficulty 0-3] [--gray plik.png]
+ *   Flappy_Bird_raster compare a.png b.png [--tolerance T]
+ *
+ * bench rysuje klatki gry prowadzonej przez bota i wypisuje liczbę klatek na
+ * sekundę dla pełnej klatki RGBA i dla obserwacji 84x84 w skali szarości.
+ * shot zapisuje klatkę po N krokach gry bota (opcjonalnie także obserwację 84x84).
+ * compare porównuje dwa zrzuty, np. z okna gry (klawisz F12) i z SoftwareRenderer,
+ * i kończy się błędem, gdy więcej niż 1% pikseli różni się o więcej niż tolerancję.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <SFML/Graphics.hpp>
+#include "Bots.h"
+#include "SoftwareRenderer.h"
+
+namespace {
+
+constexpr int observationSize = 84; /**< Bok obserwacji dla agenta. */
+constexpr float stepTime = 1.0f / 60.0f; /**< Czas kroku symulacji. */
+
+/**
+ * @brief Gra bota z animacją ptaka i ziemi, jak w Engine.
+ */
+struct BotGame {
+    World world{}; /**< Świat. */
+    std::uint32_t seed; /**< Ziarno bieżącej gry. */
+    Difficulty difficulty; /**< Poziom trudności. */
+    std::uint32_t frames = 0; /**< Liczba kroków od uruchomienia, do animacji. */
+
+    BotGame(std::uint32_t seed, Difficulty difficulty) : seed(seed), difficulty(difficulty) {
+        Simulation::reset(world, seed);
+    }
+
+    /**
+     * @brief Wykonuje krok gry; po zderzeniu zaczyna kolejną.
+     */
+    void step() {
+        if (world.over) {
+            Simulation::reset(world, ++seed);
+        }
+        Simulation::stepWith(world, stepTime, Bots::center(world), Simulation::RuntimeRules::of(difficulty));
+        frames++;
+    }
+
+    /**
+     * @brief Zwraca scenę bieżącego kroku.
+     */
+    RenderScene scene() const {
+        RenderScene scene = RenderScene::of(world, difficulty);
+        scene.birdFrame = (int)(frames / 15 % 4); // Engine::animationPeriod = 0.25 s
+        scene.groundOffset = -std::fmod((float)frames * Physics::pipeSpeed * stepTime, 24.0f);
+        return scene;
+    }
+};
+
+/**
+ * @brief Odczytuje poziom trudności z argumentu.
+ */
+Difficulty parseDifficulty(const char* text) {
+    int d = std::atoi(text);
+    return static_cast<Difficulty>(d < 0 || d > 3 ? 1 : d);
+}
+
+/**
+ * @brief Mierzy liczbę klatek na sekundę.
+ *
+ * @param frames Liczba klatek.
+ * @param difficulty Poziom trudności.
+ * @return Kod zakończenia programu.
+ */
+int bench(int frames, Difficulty difficulty) {
+    SoftwareRenderer renderer;
+    if (!renderer.isReady()) return 1;
+    std::vector<std::uint8_t> rgba((std::size_t)SoftwareRenderer::width * SoftwareRenderer::height * 4);
+    std::vector<std::uint8_t> gray((std::size_t)observationSize * observationSize);
+
+    for (int pass = 0; pass < 2; ++pass) {
+        BotGame game(1, difficulty);
+        std::uint64_t checksum = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < frames; ++i) {
+            game.step();
+            if (pass == 0) {
+                renderer.render(game.scene(), rgba.data());
+                checksum += rgba[(std::size_t)i % rgba.size()];
+            } else {
+                renderer.renderGray(game.scene(), gray.data(), observationSize, observationSize);
+                checksum += gray[(std::size_t)i % gray.size()];
+            }
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        std::printf("%-14s %9.0f klatek/s  (%d klatek, suma kontrolna %llu)\n",
+                    pass == 0 ? "RGBA 450x700" : "szarosc 84x84", frames / elapsed.count(), frames,
+                    (unsigned long long)checksum);
+    }
+    return 0;
+}
+
+/**
+ * @brief Zapisuje klatkę gry bota.
+ *
+ * @param out Plik PNG.
+ * @param ticks Liczba kroków gry przed zrzutem.
+ * @param seed Ziarno toru.
+ * @param difficulty Poziom trudności.
+ * @param grayOut Plik PNG obserwacji 84x84 lub nullptr.
+ * @return Kod zakończenia programu.
+ */
+int shot(const char* out, int ticks, std::uint32_t seed, Difficulty difficulty, const char* grayOut) {
+    SoftwareRenderer renderer;
+    if (!renderer.isReady()) return 1;
+    BotGame game(seed, difficulty);
+    for (int i = 0; i < ticks; ++i) {
+        game.step();
+    }
+
+    std::vector<std::uint8_t> rgba((std::size_t)SoftwareRenderer::width * SoftwareRenderer::height * 4);
+    renderer.render(game.scene(), rgba.data());
+    if (!SoftwareRenderer::savePng(out, rgba.data(), SoftwareRenderer::width, SoftwareRenderer::height)) {
+        std::fprintf(stderr, "Nie udalo sie zapisac %s\n", out);
+        return 1;
+    }
+    std::printf("%s: wynik %u, %d rur\n", out, game.world.score, game.world.pipeCount);
+
+    if (grayOut) {
+        std::vector<std::uint8_t> gray((std::size_t)observationSize * observationSize);
+        renderer.renderGray(game.scene(), gray.data(), observationSize, observationSize);
+        std::vector<std::uint8_t> expanded(gray.size() * 4);
+        for (std::size_t i = 0; i < gray.size(); ++i) {
+            expanded[i * 4] = expanded[i * 4 + 1] = expanded[i * 4 + 2] = gray[i];
+            expanded[i * 4 + 3] = 255;
+        }
+        if (!SoftwareRenderer::savePng(grayOut, expanded.data(), observationSize, observationSize)) {
+            std::fprintf(stderr, "Nie udalo sie zapisac %s\n", grayOut);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Porównuje dwa zrzuty.
+ *
+ * @param first Pierwszy plik.
+ * @param second Drugi plik.
+ * @param tolerance Dopuszczalna różnica kanału.
+ * @return Kod zakończenia programu.
+ */
+int compare(const char* first, const char* second, int tolerance) {
+    sf::Image a, b;
+    if (!a.loadFromFile(first) || !b.loadFromFile(second)) return 1;
+    if (a.getSize() != b.getSize()) {
+        std::fprintf(stderr, "Rozne rozmiary: %ux%u i %ux%u\n", a.getSize().x, a.getSize().y, b.getSize().x, b.getSize().y);
+        return 1;
+    }
+    ImageDiff diff = SoftwareRenderer::compare(a.getPixelsPtr(), b.getPixelsPtr(),
+                                               (std::size_t)a.getSize().x * a.getSize().y, tolerance);
+    double share = 100.0 * (double)diff.differing / (double)diff.pixels;
+    std::printf("rozne piksele: %zu (%.3f%%), najwieksza roznica %d, srednia %.3f\n",
+                diff.differing, share, diff.maxDifference, diff.meanDifference);
+    return share <= 1.0 ? 0 : 1;
+}
+
+}
+
+/**
+ * @brief Punkt wejścia narzędzia.
+ *
+ * @param argc Liczba argumentów.
+ * @param argv Argumenty wywołania.
+ * @return Kod zakończenia programu.
+ */
+int main(int argc, char** argv) {
+    if (argc >= 2 && std::strcmp(argv[1], "bench") == 0) {
+        int frames = 5000;
+        Difficulty difficulty = Difficulty::Medium;
+        for (int i = 2; i + 1 < argc; i += 2) {
+            if (std::strcmp(argv[i], "--frames") == 0) frames = std::atoi(argv[i + 1]);
+            else if (std::strcmp(argv[i], "--difficulty") == 0) difficulty = parseDifficulty(argv[i + 1]);
+        }
+        return bench(frames > 0 ? frames : 1, difficulty);
+    }
+    if (argc >= 3 && std::strcmp(argv[1], "shot") == 0) {
+        int ticks = 600;
+        std::uint32_t seed = 1;
+        Difficulty difficulty = Difficulty::Medium;
+        const char* grayOut = nullptr;
+        for (int i = 3; i + 1 < argc; i += 2) {
+            if (std::strcmp(argv[i], "--ticks") == 0) ticks = std::atoi(argv[i + 1]);
+            else if (std::strcmp(argv[i], "--seed") == 0) seed = (std::uint32_t)std::strtoul(argv[i + 1], nullptr, 10);
+            else if (std::strcmp(argv[i], "--difficulty") == 0) difficulty = parseDifficulty(argv[i + 1]);
+            else if (std::strcmp(argv[i], "--gray") == 0) grayOut = argv[i + 1];
+        }
+        return shot(argv[2], ticks, seed, difficulty, grayOut);
+    }
+    if (argc >= 4 && std::strcmp(argv[1], "compare") == 0) {
+        int tolerance = 8;
+        if (argc >= 6 && std::strcmp(argv[4], "--tolerance") == 0) tolerance = std::atoi(argv[5]);
+        return compare(argv[2], argv[3], tolerance);
+    }
+    std::fprintf(stderr, "Uzycie:\n"
+                         "  %s bench [--frames N] [--difficulty 0-3]\n"
+                         "  %s shot plik.png [--ticks N] [--seed S] [--difficulty 0-3] [--gray plik.png]\n"
+                         "  %s compare a.png b.png [--tolerance T]\n", argv[0], argv[0], argv[0]);
+    return 2;
+}
@@ -0,0 +1,275 @@
+/**
+ * @file reach_tool.cpp
+ * @brief Liczenie i sprawdzanie tablicy osiągalności dla autopilota (ReachTable).
+ *
+ * Użycie:
+ *   Flappy_Bird_reach build reach.bin
+ *   Flappy_Bird_reach check reach.bin [--runs N] [--ticks N]
+ *
+ * build liczy dla każdego poziomu trudności zbiór stanów, z których ptak może
+ * przetrwać dowolnie długo (jądro przeżywalności): zaczyna od wszystkich stanów
+ * i usuwa te, z których żadna decyzja nie prowadzi do stanu z jądra bez zderzenia,
+ * aż nic się nie zmienia. Przedział wysokości jest sprawdzany w całości (ptak może
+ * być w dowolnym jego miejscu), rury mają zapas 0,5 px w pionie i 2 kroki
+ * w poziomie, a po minięciu rury następna może mieć dowolną z wysokości toru.
+ * Stany wychodzące poza zakres wysokości tablicy są traktowane jak zderzenie.
+ * Gdy obie decyzje są bezpieczne, wybierana jest ta, która zostawia ptaka dalej
+ * od granicy jądra. Poza jądrem bit zawiera decyzję bota Bots::center.
+ *
+ * check gra tablicą N rozgrywek na każdym poziomie trudności (do --ticks kroków)
+ * i wypisuje liczbę śmierci, udział decyzji spoza tablicy i czas jednej decyzji.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "Bots.h"
+#include "ReachTable.h"
+
+namespace {
+
+constexpr int overlapTicks = (int)((Physics::birdWidth + Physics::pipeWidth) / ReachTable::stepDistance) + 2; /**< Ostatni krok (z zapasem), w którym rura zachodzi na ptaka. */
+constexpr float pipeMargin = 0.5f; /**< Zapas od krawędzi rury w pionie. */
+constexpr int shiftCount = 2 * Physics::pipeHeights - 1; /**< Liczba możliwych zmian wysokości kolejnej rury. */
+
+/**
+ * @brief Jądro przeżywalności jednego poziomu trudności.
+ */
+struct Kernel {
+    float throat; /**< Gardło rur. */
+    std::vector<std::uint8_t> safe; /**< Czy stan należy do jądra, indeksowane ReachTable::bitOf. */
+    std::vector<std::uint8_t> margin; /**< Odległość stanu od najbliższego stanu spoza jądra, w przedziałach. */
+
+    /**
+     * @brief Sprawdza decyzję w stanie i zwraca najmniejszy zapas stanów, do których prowadzi.
+     *
+     * @param tick Krok do minięcia rury.
+     * @param velocity Numer prędkości.
+     * @param height Numer przedziału wysokości.
+     * @param flap Decyzja.
+     * @param depth Najmniejszy zapas stanów następnych (gdy margin jest policzony).
+     * @return true jeśli decyzja prowadzi wyłącznie do stanów jądra, bez zderzenia.
+     */
+    bool allows(int tick, int velocity, int height, bool flap, int& depth) const {
+        int nextVelocity = flap ? 0 : velocity + 1;
+        if (nextVelocity >= ReachTable::velocities) return false;
+        float speed = ReachTable::velocityMin + (float)nextVelocity * ReachTable::velocityStep;
+        float low = ReachTable::heightMin + (float)height * ReachTable::heightStep + speed * ReachTable::stepTime;
+
+        int nextTick = tick > 0 ? tick - 1 : ReachTable::periodTicks - 1;
+        if (tick > 0 && nextTick <= overlapTicks) {
+            if (low < Physics::pipeHeight - throat + pipeMargin ||
+                low + ReachTable::heightStep + Physics::birdHeight > throat - pipeMargin) {
+                return false;
+            }
+        }
+
+        // Po minięciu rury wysokość jest liczona względem następnej, o nieznanej wysokości.
+        depth = 255;
+        for (int s = 0; s < (tick > 0 ? 1 : shiftCount); ++s) {
+            float shift = tick > 0 ? 0 : (float)(s - (Physics::pipeHeights - 1)) * (Physics::pipeY(1) - Physics::pipeY(0));
+            float position = (low - shift - ReachTable::heightMin) / ReachTable::heightStep;
+            if (position < 0) return false;
+            int first = (int)position;
+            int last = position - (float)first > 1e-4f ? first + 1 : first;
+            if (last >= ReachTable::heights) return false;
+            for (int h = first; h <= last; ++h) {
+                std::size_t state = ReachTable::bitOf(nextTick, nextVelocity, h);
+                if (!safe[state]) return false;
+                if (!margin.empty()) depth = std::min(depth, (int)margin[state]);
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Usuwa stany spoza jądra, aż zbiór przestanie się zmieniać.
+     *
+     * @return Liczba przejść przez wszystkie stany.
+     */
+    int solve() {
+        safe.assign(ReachTable::tableBits, 1);
+        margin.clear();
+        int passes = 0;
+        bool changed = true;
+        int depth;
+        while (changed) {
+            changed = false;
+            passes++;
+            // Kroki rosnąco: stan zależy od kroku o jeden mniejszego, już poprawionego w tym przejściu.
+            for (int t = 0; t < ReachTable::periodTicks; ++t) {
+                for (int v = 0; v < ReachTable::velocities; ++v) {
+                    for (int h = 0; h < ReachTable::heights; ++h) {
+                        std::size_t state = ReachTable::bitOf(t, v, h);
+                        if (safe[state] && !allows(t, v, h, false, depth) && !allows(t, v, h, true, depth)) {
+                            safe[state] = 0;
+                            changed = true;
+                        }
+                    }
+                }
+            }
+        }
+
+        margin.assign(ReachTable::tableBits, 0);
+        for (int t = 0; t < ReachTable::periodTicks; ++t) {
+            for (int v = 0; v < ReachTable::velocities; ++v) {
+                std::size_t column = ReachTable::bitOf(t, v, 0);
+                int run = 0;
+                for (int h = 0; h < ReachTable::heights; ++h) {
+                    run = safe[column + h] ? std::min(run + 1, 255) : 0;
+                    margin[column + h] = (std::uint8_t)run;
+                }
+                run = 0;
+                for (int h = ReachTable::heights - 1; h >= 0; --h) {
+                    run = safe[column + h] ? std::min(run + 1, 255) : 0;
+                    margin[column + h] = (std::uint8_t)std::min((int)margin[column + h], run);
+                }
+            }
+        }
+        return passes;
+    }
+
+    /**
+     * @brief Zapisuje decyzje wszystkich stanów jako bity.
+     *
+     * @param bits Tablica ReachTable::tableBytes bajtów.
+     * @return Liczba stanów jądra.
+     */
+    std::size_t decisions(std::vector<std::uint8_t>& bits) const {
+        bits.assign(ReachTable::tableBytes, 0);
+        std::size_t count = 0;
+        for (int t = 0; t < ReachTable::periodTicks; ++t) {
+            for (int v = 0; v < ReachTable::velocities; ++v) {
+                for (int h = 0; h < ReachTable::heights; ++h) {
+                    std::size_t state = ReachTable::bitOf(t, v, h);
+                    bool flap;
+                    if (safe[state]) {
+                        int waitDepth = 0, flapDepth = 0;
+                        bool wait = allows(t, v, h, false, waitDepth);
+                        flap = allows(t, v, h, true, flapDepth) && (!wait || flapDepth > waitDepth);
+                        count++;
+                    } else {
+                        float height = ReachTable::heightMin + ((float)h + 0.5f) * ReachTable::heightStep;
+                        float speed = ReachTable::velocityMin + (float)v * ReachTable::velocityStep;
+                        flap = speed >= 0 && height + Physics::birdHeight / 2 > Physics::pipeHeight / 2 + 10;
+                    }
+                    if (flap) bits[state >> 3] |= (std::uint8_t)(1u << (state & 7));
+                }
+            }
+        }
+        return count;
+    }
+};
+
+/**
+ * @brief Liczy tablice wszystkich poziomów trudności i zapisuje je do pliku.
+ *
+ * @param out Plik wynikowy.
+ * @return Kod zakończenia programu.
+ */
+int build(const char* out) {
+    std::vector<std::uint8_t> bits[ReachTable::tables];
+    Kernel kernel;
+    for (int d = 0; d < ReachTable::tables; ++d) {
+        auto start = std::chrono::steady_clock::now();
+        kernel.throat = rulesFor(static_cast<Difficulty>(d)).throat;
+        int passes = kernel.solve();
+        std::size_t count = kernel.decisions(bits[d]);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        std::printf("poziom %d (gardlo %.0f): %zu z %zu stanow w jadrze, %d przejsc, %.1f s\n", d, kernel.throat, count,
+                    ReachTable::tableBits, passes, elapsed.count());
+    }
+    if (!ReachTable::write(out, bits)) {
+        std::fprintf(stderr, "Nie udalo sie zapisac %s\n", out);
+        return 1;
+    }
+    std::printf("%s: %d tablic po %zu bajtow\n", out, ReachTable::tables, ReachTable::tableBytes);
+    return 0;
+}
+
+/**
+ * @brief Gra tablicą i wypisuje wyniki.
+ *
+ * @param path Plik tablicy.
+ * @param runs Liczba rozgrywek na poziom trudności.
+ * @param maxTicks Najdłuższa rozgrywka.
+ * @return Kod zakończenia programu.
+ */
+int check(const char* path, std::uint32_t runs, std::uint32_t maxTicks) {
+    ReachTable table(path);
+    if (!table.isOpen()) {
+        std::fprintf(stderr, "Nie udalo sie wczytac %s\n", path);
+        return 1;
+    }
+    std::vector<World> samples;
+    std::uint64_t totalDeaths = 0;
+    for (int d = 0; d < ReachTable::tables; ++d) {
+        const auto rules = Simulation::RuntimeRules::of(static_cast<Difficulty>(d));
+        std::uint64_t deaths = 0, steps = 0, fallbacks = 0;
+        std::uint32_t minScore = UINT32_MAX;
+        for (std::uint32_t run = 0; run < runs; ++run) {
+            World world;
+            Simulation::reset(world, run * 2654435761u + 1);
+            while (!world.over && world.ticks < maxTicks) {
+                bool flap;
+                if (!table.decide(world, flap)) {
+                    flap = Bots::center(world);
+                    fallbacks++;
+                }
+                if (samples.size() < (1u << 20) && (steps & 7) == 0) samples.push_back(world);
+                Simulation::stepWith(world, ReachTable::stepTime, flap, rules);
+                steps++;
+            }
+            if (world.over) deaths++;
+            minScore = std::min(minScore, world.score);
+        }
+        totalDeaths += deaths;
+        std::printf("poziom %d: %u rozgrywek, smierci %llu, najmniejszy wynik %u, decyzje spoza tablicy %.3f%%\n", d, runs,
+                    (unsigned long long)deaths, minScore, 100.0 * (double)fallbacks / (double)std::max<std::uint64_t>(steps, 1));
+    }
+
+    // Czas samej decyzji, na stanach zebranych z rozgrywek.
+    std::uint64_t flaps = 0;
+    const int repeats = 8;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeats; ++r) {
+        for (const World& world : samples) {
+            bool flap = false;
+            table.decide(world, flap);
+            flaps += flap;
+        }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::printf("decyzja: %.1f ns (%zu stanow, %llu machniec)\n",
+                elapsed.count() * 1e9 / (double)(samples.size() * repeats), samples.size(), (unsigned long long)flaps);
+    return totalDeaths == 0 ? 0 : 1;
+}
+
+}
+
+/**
+ * @brief Punkt wejścia narzędzia.
+ *
+ * @param argc Liczba argumentów.
+ * @param argv Argumenty wywołania.
+ * @return Kod zakończenia programu.
+ */
+int main(int argc, char** argv) {
+    if (argc >= 3 && std::strcmp(argv[1], "build") == 0) {
+        return build(argv[2]);
+    }
+    if (argc >= 3 && std::strcmp(argv[1], "check") == 0) {
+        std::uint32_t runs = 200, ticks = 60 * 60 * 10;
+        for (int i = 3; i + 1 < argc; i += 2) {
+            if (std::strcmp(argv[i], "--runs") == 0) runs = (std::uint32_t)std::strtoul(argv[i + 1], nullptr, 10);
+            else if (std::strcmp(argv[i], "--ticks") == 0) ticks = (std::uint32_t)std::strtoul(argv[i + 1], nullptr, 10);
+        }
+        return check(argv[2], runs, ticks);
+    }
+    std::fprintf(stderr, "Uzycie:\n  %s build reach.bin\n  %s check reach.bin [--runs N] [--ticks N]\n", argv[0], argv[0]);
+    return 2;
+}
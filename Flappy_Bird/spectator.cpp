@@ -0,0 +1,203 @@
+/**
+ * @file spectator.cpp
+ * @brief Podgląd działającej gry: minimapa rysowana w terminalu ze stanu w pamięci współdzielonej.
+ *
+ * Użycie: Flappy_Bird_spectator [pid] [--fps N] [--once]
+ *
+ * Bez podanego pid podglądany jest pierwszy znaleziony segment /dev/shm/flappy_state.*.
+ * Stan jest czytany bez blokad (StateMirror::read), więc podgląd nie spowalnia gry.
+ * Na minimapie '@' to ptak, '#' rury, 'o' niezebrane monety, a ostatni wiersz to ziemia.
+ * Opcja --once rysuje jedną klatkę i kończy działanie.
+ */
+
+#include "StateMirror.h"
+#include "DifficultyRules.h"
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr int mapColumns = 45; /**< Szerokość minimapy w znakach. */
+constexpr int mapRows = 28; /**< Wysokość minimapy w znakach (bez ziemi). */
+constexpr float cellWidth = Physics::windowWidth / mapColumns; /**< Szerokość znaku w pikselach gry. */
+constexpr float cellHeight = Physics::floorY / mapRows; /**< Wysokość znaku w pikselach gry. */
+
+volatile std::sig_atomic_t stopRequested = 0; /**< Ustawiane przez SIGINT. */
+
+/**
+ * @brief Obsługa SIGINT: kończy pętlę podglądu.
+ */
+void onSignal(int) {
+    stopRequested = 1;
+}
+
+/**
+ * @brief Mapuje segment stanu procesu tylko do odczytu.
+ *
+ * @param pid Identyfikator procesu.
+ * @return Wskaźnik na blok lub nullptr, gdy segment nie istnieje lub jest niezgodny.
+ */
+const StateMirrorBlock* attach(std::uint64_t pid) {
+    auto name = StateMirror::segmentName(pid);
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) return nullptr;
+    void* data = mmap(nullptr, sizeof(StateMirrorBlock), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return nullptr;
+
+    auto* block = static_cast<const StateMirrorBlock*>(data);
+    if (block->magic != StateMirrorBlock::magicValue || block->size != sizeof(StateMirrorBlock)) {
+        munmap(data, sizeof(StateMirrorBlock));
+        return nullptr;
+    }
+    return block;
+}
+
+/**
+ * @brief Wyszukuje pierwszy proces, który publikuje stan.
+ *
+ * @return Identyfikator procesu lub 0.
+ */
+std::uint64_t discover() {
+    std::uint64_t pid = 0;
+    DIR* dir = opendir("/dev/shm");
+    if (!dir) return pid;
+    const char prefix[] = "flappy_state.";
+    while (auto* entry = readdir(dir)) {
+        if (std::strncmp(entry->d_name, prefix, sizeof(prefix) - 1) == 0) {
+            pid = std::strtoull(entry->d_name + sizeof(prefix) - 1, nullptr, 10);
+            break;
+        }
+    }
+    closedir(dir);
+    return pid;
+}
+
+/**
+ * @brief Zwraca nazwę ekranu gry.
+ */
+const char* screenOf(const MirrorState& state) {
+    if (state.flags & MirrorState::MainMenu) return "menu";
+    if (state.flags & MirrorState::GetReady) return "get ready";
+    if (state.flags & MirrorState::GameOver) return "game over";
+    if (state.flags & MirrorState::Paused) return "pauza";
+    if (state.flags & MirrorState::Running) return "gra";
+    return "start";
+}
+
+/**
+ * @brief Rysuje minimapę i wiersz stanu.
+ *
+ * @param state Migawka stanu.
+ * @param sequence Licznik sekwencji migawki.
+ * @param clear Czy wyczyścić wcześniej ekran terminala.
+ */
+void render(const MirrorState& state, std::uint64_t sequence, bool clear) {
+    char map[mapRows + 1][mapColumns + 1];
+    for (int row = 0; row < mapRows; ++row) {
+        std::memset(map[row], ' ', mapColumns);
+        map[row][mapColumns] = '\0';
+    }
+    std::memset(map[mapRows], '=', mapColumns);
+    map[mapRows][mapColumns] = '\0';
+
+    auto put = [&map](float x, float y, char c) {
+        int column = (int)(x / cellWidth), row = (int)(y / cellHeight);
+        if (column >= 0 && column < mapColumns && row >= 0 && row < mapRows) map[row][column] = c;
+    };
+
+    const std::uint32_t pipeCount = state.pipeCount < MirrorState::maxPipes ? state.pipeCount : MirrorState::maxPipes;
+    for (std::uint32_t i = 0; i < pipeCount; ++i) {
+        const MirrorPipe& pipe = state.pipes[i];
+        // Tak jak w Simulation::stepWith: górna rura kończy się na y - throat + pipeHeight, dolna zaczyna na y + throat.
+        const float gapTop = pipe.y - pipe.throat + Physics::pipeHeight, gapBottom = pipe.y + pipe.throat;
+        for (float x = pipe.x; x < pipe.x + Physics::pipeWidth; x += cellWidth) {
+            for (int row = 0; row < mapRows; ++row) {
+                float y = ((float)row + 0.5f) * cellHeight;
+                if (y < gapTop || y >= gapBottom) put(x, y, '#');
+            }
+        }
+        if (pipe.coinVisible) {
+            put(pipe.x + Physics::coinWidth / 2, pipe.y + pipe.throat / 2 + Physics::coinHeight / 2, 'o');
+        }
+    }
+    put(Physics::birdX + Physics::birdWidth / 2, state.birdY + Physics::birdHeight / 2, '@');
+
+    std::string frame;
+    frame.reserve((mapColumns + 3) * (mapRows + 4));
+    if (clear) frame += "\033[H\033[2J";
+    char line[160];
+    std::snprintf(line, sizeof(line), "%-9s wynik %d  kroki %u  y %.0f  v %.0f  ziarno %llu  migawka %llu\n",
+                  screenOf(state), state.score, state.ticks, state.birdY, state.birdVel,
+                  (unsigned long long)state.seed, (unsigned long long)(sequence / 2));
+    frame += line;
+    for (int row = 0; row <= mapRows; ++row) {
+        frame += '|';
+        frame += map[row];
+        frame += "|\n";
+    }
+    std::fwrite(frame.data(), 1, frame.size(), stdout);
+    std::fflush(stdout);
+}
+
+}
+
+/**
+ * @brief Punkt wejścia narzędzia.
+ *
+ * @param argc Liczba argumentów.
+ * @param argv Argumenty wywołania.
+ * @return Kod zakończenia programu.
+ */
+int main(int argc, char** argv) {
+    std::uint64_t pid = 0;
+    int fps = 30;
+    bool once = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--once") == 0) once = true;
+        else if (std::strcmp(argv[i], "--fps") == 0 && i + 1 < argc) fps = std::atoi(argv[++i]);
+        else pid = std::strtoull(argv[i], nullptr, 10);
+    }
+    if (fps < 1) fps = 1;
+    if (pid == 0) pid = discover();
+
+    const StateMirrorBlock* block = pid ? attach(pid) : nullptr;
+    if (!block) {
+        std::fprintf(stderr, "Nie znaleziono stanu zadnego procesu gry.\n");
+        return 1;
+    }
+    std::signal(SIGINT, onSignal);
+
+    MirrorState state;
+    std::uint64_t sequence = 0, shown = 1;
+    const auto period = std::chrono::microseconds(1000000 / fps);
+    auto next = std::chrono::steady_clock::now();
+    while (!stopRequested) {
+        if (kill((pid_t)pid, 0) != 0 && errno == ESRCH) {
+            std::fprintf(stderr, "Proces %llu zakonczyl dzialanie.\n", (unsigned long long)pid);
+            break;
+        }
+        if (!StateMirror::read(*block, state, sequence)) {
+            std::fprintf(stderr, "Nie udalo sie odczytac spojnego stanu.\n");
+        } else if (sequence != shown) {
+            // Ekran jest przerysowywany tylko po nowej migawce.
+            render(state, sequence, !once);
+            shown = sequence;
+        }
+        if (once) break;
+        next += period;
+        std::this_thread::sleep_until(next);
+    }
+    munmap(const_cast<StateMirrorBlock*>(block), sizeof(StateMirrorBlock));
+    return 0;
+}
@@ -0,0 +1,185 @@
+/**
+ * @file state_cases.cpp
+ * @brief Sprawdzenie, że GameCore::loadState odtwarza grę zapisaną przez saveState.
+ *
+ * Użycie: Flappy_Bird_state_cases [katalog_roboczy]
+ *
+ * Bot gra kolejne gry na GameCore. Co kilkadziesiąt klatek stan jest zapisywany,
+ * gra toczy się dalej przez kilka sekund (albo do śmierci), a machnięcia i stany
+ * po każdej klatce są zapamiętywane. Potem zapisany stan jest wczytywany, a te same
+ * machnięcia odtwarzane; każda klatka musi dać dokładnie ten sam stan: ptak z klatką
+ * animacji, rury, wynik, flagi, zegar gry, zdarzenia rur i animacji oraz pozycja
+ * w torze. Program zwraca 1 przy pierwszej różnicy.
+ */
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "Bots.h"
+#include "Course.h"
+#include "DifficultyRules.h"
+#include "GameCore.h"
+#include "ScoreLedger.h"
+
+namespace {
+
+constexpr float frameTime = 1.0f / 60.0f; /**< Czas klatki. */
+constexpr int windowFrames = 60 * 4; /**< Klatki gry między zapisem a porównaniem. */
+constexpr int saveInterval = 47; /**< Co ile klatek gra jest zapisywana. */
+constexpr int checkedWindows = 200; /**< Liczba sprawdzanych zapisów. */
+
+/**
+ * @brief Porównuje dwie migawki pole po polu.
+ *
+ * @param a Pierwsza migawka.
+ * @param b Druga migawka.
+ * @return true jeśli migawki są równe.
+ */
+bool same(const GameCore::State& a, const GameCore::State& b) {
+    if (a.bird.y != b.bird.y || a.bird.vel != b.bird.vel || a.bird.frame != b.bird.frame ||
+        a.bird.dieReported != b.bird.dieReported || a.pipeCount != b.pipeCount || a.score != b.score ||
+        a.gameRunning != b.gameRunning || a.gameOvered != b.gameOvered || a.gamePaused != b.gamePaused ||
+        a.scoreRecorded != b.scoreRecorded || a.seed != b.seed || a.ticks != b.ticks || a.clock != b.clock ||
+        a.spawnDue != b.spawnDue || a.animationDue != b.animationDue || a.coursePosition != b.coursePosition ||
+        a.upcomingValid != b.upcomingValid || a.upcoming.spacing != b.upcoming.spacing ||
+        a.upcoming.y != b.upcoming.y || a.upcoming.throat != b.upcoming.throat || a.upcoming.coin != b.upcoming.coin) {
+        return false;
+    }
+    for (std::uint32_t i = 0; i < a.pipeCount; ++i) {
+        const PipeState& p = a.pipes[i];
+        const PipeState& q = b.pipes[i];
+        if (p.x != q.x || p.y != q.y || p.throat != q.throat || p.scored != q.scored || p.coinVisible != q.coinVisible) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Gra bez okna sterowana botem, z zapisem i wczytaniem stanu.
+ */
+class SavedGame : public GameCore {
+public:
+    /**
+     * @brief Konstruktor klasy SavedGame.
+     *
+     * @param ledgerPath Ścieżka dziennika wyników.
+     */
+    explicit SavedGame(const std::string& ledgerPath) : scores(ledgerPath, 64), bot(Bots::casual, 5) {
+        course = &generated;
+        ledger = &scores;
+        SetDifficulty(Difficulty::Hard);
+        SetThroatDifficulty(rulesFor(Difficulty::Hard).throat);
+        reseed(1);
+    }
+
+    /**
+     * @brief Po śmierci od razu zaczyna nową grę.
+     */
+    void continueGame() {
+        if (gameOvered) {
+            restart(seed + 1);
+        }
+    }
+
+    /**
+     * @brief Decyduje o machnięciu.
+     *
+     * @return Czy ptak machnie skrzydłami w tej klatce.
+     */
+    bool decide() {
+        return !gameRunning || bot(toWorld());
+    }
+
+    /**
+     * @brief Wykonuje jedną klatkę z podaną decyzją.
+     *
+     * @param flapNow Czy ptak machnie skrzydłami.
+     */
+    void frame(bool flapNow) {
+        if (flapNow) flap();
+        update(frameTime);
+    }
+
+    bool over() const { return gameOvered; } /**< Czy gra jest zakończona. */
+    bool writing() const { return scores.isOpen(); } /**< Czy dziennik przyjmuje wyniki. */
+
+private:
+    GeneratedCourse generated; /**< Tor. */
+    ScoreLedger scores; /**< Dziennik wyników. */
+    Bots::Human bot; /**< Gracz. */
+};
+
+}
+
+/**
+ * @brief Punkt wejścia narzędzia.
+ *
+ * @param argc Liczba argumentów.
+ * @param argv Argumenty wywołania.
+ * @return 0 jeśli każda wczytana gra przebiegła tak samo jak zapisana.
+ */
+int main(int argc, char** argv) {
+    const std::string dir = argc > 1 ? argv[1] : ".";
+    const std::string ledgerPath = dir + "/state_cases.bin";
+    std::remove(ledgerPath.c_str());
+
+    SavedGame game(ledgerPath);
+    if (!game.writing()) {
+        std::fprintf(stderr, "Nie udalo sie otworzyc %s\n", ledgerPath.c_str());
+        return 1;
+    }
+
+    std::vector<bool> flaps;
+    std::vector<GameCore::State> expected;
+    flaps.reserve(windowFrames);
+    expected.reserve(windowFrames);
+    std::uint64_t frames = 0, endedWindows = 0, pipeWindows = 0;
+    for (int w = 0; w < checkedWindows; ++w) {
+        for (int i = 0; i < saveInterval; ++i) {
+            game.continueGame();
+            game.frame(game.decide());
+        }
+
+        GameCore::State saved{}, loaded{};
+        game.continueGame();
+        game.saveState(saved);
+        flaps.clear();
+        expected.clear();
+        for (int i = 0; i < windowFrames && !game.over(); ++i) {
+            bool flapNow = game.decide();
+            game.frame(flapNow);
+            flaps.push_back(flapNow);
+            expected.emplace_back();
+            game.saveState(expected.back());
+        }
+        endedWindows += game.over();
+        pipeWindows += saved.pipeCount > 0;
+
+        game.loadState(saved);
+        game.saveState(loaded);
+        if (!same(saved, loaded)) {
+            std::fprintf(stderr, "Zapis %d: stan po wczytaniu rozni sie od zapisanego\n", w);
+            return 1;
+        }
+        for (std::size_t i = 0; i < flaps.size(); ++i) {
+            game.frame(flaps[i]);
+            GameCore::State replayed{};
+            game.saveState(replayed);
+            if (!same(expected[i], replayed)) {
+                std::fprintf(stderr, "Zapis %d: klatka %zu po wczytaniu rozni sie od pierwszego przebiegu\n", w, i);
+                return 1;
+            }
+        }
+        frames += flaps.size();
+    }
+
+    std::printf("%d zapisow, %llu klatek odtworzonych, %llu konczy sie smiercia, %llu z rurami\n", checkedWindows,
+                (unsigned long long)frames, (unsigned long long)endedWindows, (unsigned long long)pipeWindows);
+    // Bez śmierci i rur w oknach test nie sprawdzałby końca gry ani odtwarzania rur.
+    if (endedWindows == 0 || pipeWindows == 0) {
+        std::fprintf(stderr, "Bot nie dotarl do rur albo nie zginal w zadnym oknie\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,440 @@
+/**
+ * @file verify.cpp
+ * @brief Weryfikacja zgłoszonych wyników przez ponowne odtworzenie rozgrywek.
+ *
+ * Użycie:
+ *   Flappy_Bird_verify [runs.bin | katalog | - ...] [--threads T] [--out verdicts.csv] [--cache MB] [--max-ticks N]
+ *
+ * Zgłoszenie to rozgrywka w pliku zapisu (RunLog): ziarno, poziom trudności,
+ * chwile machnięć oraz zgłoszony wynik i krok śmierci. Każde zgłoszenie jest
+ * odtwarzane symulacją gry (te same reguły co EntityWorld) i przyjmowane tylko
+ * wtedy, gdy ptak ginie dokładnie w zgłoszonym kroku ze zgłoszonym wynikiem,
+ * a po śmierci nie ma już machnięć.
+ *
+ * Wejściem są pliki zapisu, katalogi (wszystkie pliki *.bin, po nazwie) oraz "-",
+ * czyli kolejka ścieżek czytanych ze standardowego wejścia, po jednej w wierszu,
+ * przetwarzanych w miarę napływania.
+ *
+ * Zgłoszenia są czytane partiami do stałej puli i odtwarzane w puli wątków
+ * z podkradaniem zadań (WorkStealingPool), więc partie pełne długich rozgrywek
+ * nie blokują pozostałych rdzeni. Werdykty są zapisywane do pliku CSV w kolejności
+ * zgłoszeń. Wyniki odtworzeń są zapamiętywane w ograniczonej pamięci podręcznej
+ * według ziarna, poziomu i pełnej listy machnięć, więc wielokrotnie zgłoszona ta
+ * sama rozgrywka jest odtwarzana tylko raz.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "RunLog.h"
+#include "WorkStealingPool.h"
+
+namespace {
+
+constexpr std::size_t chunkRuns = 256; /**< Liczba zgłoszeń w jednym zadaniu puli. */
+constexpr std::size_t maxCachedFlaps = 4096; /**< Dłuższe rozgrywki nie trafiają do pamięci podręcznej. */
+constexpr unsigned cacheShards = 64; /**< Liczba niezależnie blokowanych części pamięci podręcznej. */
+
+/**
+ * @brief Werdykt weryfikacji.
+ */
+enum Verdict { Accepted, ScoreMismatch, TickMismatch, NoDeath, ExtraInputs, Malformed, verdictCount };
+
+const char* verdictNames[verdictCount] = {"accepted", "score_mismatch", "tick_mismatch", "no_death", "extra_inputs", "malformed"}; /**< Nazwy werdyktów w pliku wynikowym. */
+
+/**
+ * @brief Wynik odtworzenia rozgrywki.
+ */
+struct Outcome {
+    std::uint32_t score; /**< Wynik w chwili końca odtworzenia. */
+    std::uint32_t ticks; /**< Krok końca odtworzenia. */
+    bool over; /**< Czy ptak zginął. */
+};
+
+/**
+ * @brief Werdykt jednego zgłoszenia.
+ */
+struct Result {
+    Verdict verdict; /**< Werdykt. */
+    Outcome outcome; /**< Wynik odtworzenia. */
+};
+
+/**
+ * @brief Pamięć podręczna wyników odtworzeń (LRU w każdej części).
+ *
+ * Kluczem jest ziarno, poziom trudności i pełna lista machnięć - nie jej skrót,
+ * więc spreparowane zgłoszenie o tym samym skrócie nie przejmie cudzego werdyktu.
+ * Zapamiętywane są tylko odtworzenia zakończone śmiercią: wynik odtworzenia zależy
+ * od zgłoszonego kroku tylko przez limit odtwarzania, a ten nie ma znaczenia, jeśli
+ * ptak zginął przed nim.
+ */
+class ReplayCache {
+public:
+    /**
+     * @brief Konstruktor klasy ReplayCache.
+     *
+     * @param bytes Największy łączny rozmiar kluczy.
+     */
+    explicit ReplayCache(std::size_t bytes) : shardBytes(bytes / cacheShards), hits(0) {}
+
+    /**
+     * @brief Buduje klucz rozgrywki.
+     *
+     * @param run Nagłówek rozgrywki.
+     * @param flaps Machnięcia.
+     * @param count Liczba machnięć.
+     * @param key Wynik.
+     * @return false jeśli rozgrywka jest za długa, by ją zapamiętywać.
+     */
+    bool makeKey(const RunRecord& run, const std::uint32_t* flaps, std::size_t count, std::string& key) const {
+        if (shardBytes == 0 || count > maxCachedFlaps) return false;
+        key.resize(sizeof(run.seed) + 1 + count * sizeof(std::uint32_t));
+        std::memcpy(&key[0], &run.seed, sizeof(run.seed));
+        key[sizeof(run.seed)] = (char)run.difficulty;
+        if (count) std::memcpy(&key[sizeof(run.seed) + 1], flaps, count * sizeof(std::uint32_t));
+        return true;
+    }
+
+    /**
+     * @brief Szuka wyniku odtworzenia.
+     *
+     * @param key Klucz rozgrywki.
+     * @param outcome Znaleziony wynik.
+     * @return true jeśli wynik był zapamiętany.
+     */
+    bool find(const std::string& key, Outcome& outcome) {
+        Shard& shard = shardOf(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto found = shard.index.find(key);
+        if (found == shard.index.end()) return false;
+        shard.entries.splice(shard.entries.begin(), shard.entries, found->second);
+        outcome = found->second->second;
+        hits.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief Zapamiętuje wynik odtworzenia, usuwając najdawniej używane wpisy ponad limit.
+     *
+     * @param key Klucz rozgrywki.
+     * @param outcome Wynik.
+     */
+    void insert(const std::string& key, const Outcome& outcome) {
+        Shard& shard = shardOf(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (shard.index.count(key)) return;
+        shard.entries.emplace_front(key, outcome);
+        shard.index.emplace(shard.entries.front().first, shard.entries.begin());
+        shard.bytes += key.size();
+        while (shard.bytes > shardBytes && !shard.entries.empty()) {
+            const std::string& oldest = shard.entries.back().first;
+            shard.bytes -= oldest.size();
+            shard.index.erase(oldest);
+            shard.entries.pop_back();
+        }
+    }
+
+    /**
+     * @brief Zwraca liczbę trafień.
+     *
+     * @return Liczba trafień.
+     */
+    std::uint64_t getHits() const { return hits.load(std::memory_order_relaxed); }
+
+private:
+    /**
+     * @brief Część pamięci podręcznej z własną blokadą.
+     */
+    struct Shard {
+        std::mutex mutex; /**< Chroni wpisy. */
+        std::list<std::pair<std::string, Outcome>> entries; /**< Wpisy od ostatnio używanego. */
+        std::unordered_map<std::string_view, std::list<std::pair<std::string, Outcome>>::iterator> index; /**< Wpisy według klucza (widoki na klucze z entries). */
+        std::size_t bytes = 0; /**< Łączny rozmiar kluczy. */
+    };
+
+    /**
+     * @brief Zwraca część pamięci podręcznej dla klucza.
+     */
+    Shard& shardOf(const std::string& key) {
+        return shards[std::hash<std::string>()(key) % cacheShards];
+    }
+
+    Shard shards[cacheShards]; /**< Części pamięci podręcznej. */
+    std::size_t shardBytes; /**< Limit rozmiaru kluczy jednej części. */
+    std::atomic<std::uint64_t> hits; /**< Liczba trafień. */
+};
+
+/**
+ * @brief Partia zgłoszeń wraz z werdyktami, jedno zadanie puli.
+ */
+struct Chunk {
+    std::uint64_t sequence = 0; /**< Numer partii w kolejności zgłoszeń. */
+    std::size_t file = 0; /**< Numer pliku wejściowego. */
+    std::uint64_t first = 0; /**< Numer pierwszego zgłoszenia w pliku. */
+    RunBatch batch; /**< Zgłoszenia. */
+    std::vector<Result> results; /**< Werdykty. */
+    std::uint64_t steps = 0; /**< Odtworzone kroki. */
+};
+
+/**
+ * @brief Ustawienia narzędzia.
+ */
+struct Options {
+    std::vector<std::string> inputs; /**< Pliki, katalogi lub "-". */
+    unsigned threads = 0; /**< Liczba wątków (0 - wszystkie rdzenie). */
+    std::string out = "verdicts.csv"; /**< Plik werdyktów. */
+    std::size_t cacheBytes = (std::size_t)64 << 20; /**< Limit pamięci podręcznej. */
+    std::uint32_t maxTicks = 60 * 60 * 60; /**< Najdłuższa przyjmowana rozgrywka (godzina). */
+};
+
+/**
+ * @brief Rozwija wejścia narzędzia w kolejne ścieżki plików zapisu.
+ */
+class InputList {
+public:
+    /**
+     * @brief Konstruktor klasy InputList.
+     *
+     * @param inputs Pliki, katalogi lub "-".
+     */
+    explicit InputList(const std::vector<std::string>& inputs) : pending(inputs.rbegin(), inputs.rend()), stdinOpen(false) {}
+
+    /**
+     * @brief Zwraca następny plik zapisu.
+     *
+     * @param path Ścieżka pliku.
+     * @return false jeśli wejścia się skończyły.
+     */
+    bool next(std::string& path) {
+        while (true) {
+            if (stdinOpen) {
+                std::string line;
+                if (std::getline(std::cin, line)) {
+                    if (!line.empty() && line.back() == '\r') line.pop_back();
+                    if (!line.empty()) pending.push_back(line);
+                } else {
+                    stdinOpen = false;
+                }
+            }
+            if (pending.empty()) {
+                if (stdinOpen) continue;
+                return false;
+            }
+            path = pending.back();
+            pending.pop_back();
+            if (path == "-") {
+                stdinOpen = true;
+                continue;
+            }
+            std::error_code error;
+            if (!std::filesystem::is_directory(path, error)) return true;
+            std::vector<std::string> files;
+            for (const auto& entry : std::filesystem::directory_iterator(path, error)) {
+                if (entry.path().extension() == ".bin") files.push_back(entry.path().string());
+            }
+            std::sort(files.rbegin(), files.rend());
+            pending.insert(pending.end(), files.begin(), files.end());
+        }
+    }
+
+private:
+    std::vector<std::string> pending; /**< Ścieżki do rozwinięcia, ostatnia jest następna. */
+    bool stdinOpen; /**< Czy ścieżki są jeszcze czytane ze standardowego wejścia. */
+};
+
+/**
+ * @brief Ocenia zgłoszenie na podstawie wyniku odtworzenia.
+ */
+Verdict judge(const RunRecord& run, const std::uint32_t* flaps, std::size_t count, const Outcome& outcome) {
+    if (!outcome.over) return NoDeath;
+    // Krok śmierci nie zwiększa licznika kroków, więc machnięcie po nim nie mogło pochodzić z prawdziwej gry.
+    if (count > 0 && flaps[count - 1] > outcome.ticks) return ExtraInputs;
+    if (outcome.ticks != run.ticks) return TickMismatch;
+    if (outcome.score != run.score) return ScoreMismatch;
+    return Accepted;
+}
+
+/**
+ * @brief Weryfikuje zgłoszenia jednej partii.
+ */
+void verifyChunk(Chunk& chunk, ReplayCache& cache, std::uint32_t maxTicks) {
+    const RunBatch& batch = chunk.batch;
+    chunk.results.resize(batch.size());
+    chunk.steps = 0;
+    World world;
+    NoEvents events;
+    std::string key;
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        const RunRecord& run = batch.runs[i];
+        const std::uint32_t* flaps = batch.flapsOf(i);
+        const std::size_t count = batch.flapCountOf(i);
+        Result& result = chunk.results[i];
+        result.outcome = Outcome{0, 0, false};
+        // Gra zaczyna się machnięciem w kroku 0; późniejsze pierwsze machnięcie nie mogło pochodzić z prawdziwej gry.
+        if (run.difficulty > static_cast<std::uint8_t>(Difficulty::Nightmare) || run.ticks > maxTicks ||
+            (count > 0 && flaps[0] != 0)) {
+            result.verdict = Malformed;
+            continue;
+        }
+        bool cacheable = cache.makeKey(run, flaps, count, key);
+        Outcome cached;
+        if (cacheable && cache.find(key, cached) && (std::uint64_t)cached.ticks <= (std::uint64_t)run.ticks + RunLog::extraTicks) {
+            result.outcome = cached;
+        } else {
+            chunk.steps += RunLog::replay(run, flaps, count, world, events, [](const World&) {});
+            result.outcome = Outcome{world.score, world.ticks, world.over};
+            if (cacheable && world.over) cache.insert(key, result.outcome);
+        }
+        result.verdict = judge(run, flaps, count, result.outcome);
+    }
+}
+
+}
+
+/**
+ * @brief Punkt wejścia narzędzia.
+ *
+ * @param argc Liczba argumentów.
+ * @param argv Argumenty wywołania.
+ * @return Kod zakończenia programu.
+ */
+int main(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        if (argv[i][0] != '-' || argv[i][1] == '\0') {
+            options.inputs.push_back(argv[i]);
+        } else if (i + 1 < argc) {
+            if (std::strcmp(argv[i], "--threads") == 0) options.threads = (unsigned)std::strtoul(argv[i + 1], nullptr, 10);
+            else if (std::strcmp(argv[i], "--out") == 0) options.out = argv[i + 1];
+            else if (std::strcmp(argv[i], "--cache") == 0) options.cacheBytes = (std::size_t)std::strtoull(argv[i + 1], nullptr, 10) << 20;
+            else if (std::strcmp(argv[i], "--max-ticks") == 0) options.maxTicks = (std::uint32_t)std::strtoul(argv[i + 1], nullptr, 10);
+            ++i;
+        }
+    }
+    if (options.inputs.empty()) {
+        std::fprintf(stderr, "Uzycie: %s [runs.bin | katalog | - ...] [--threads T] [--out verdicts.csv] [--cache MB] "
+                             "[--max-ticks N]\n", argv[0]);
+        return 2;
+    }
+    FILE* csv = std::fopen(options.out.c_str(), "w");
+    if (!csv) {
+        std::fprintf(stderr, "Nie udalo sie otworzyc %s\n", options.out.c_str());
+        return 1;
+    }
+    std::fprintf(csv, "file,index,seed,difficulty,claimed_score,claimed_ticks,verdict,replayed_score,replayed_ticks\n");
+
+    ReplayCache cache(options.cacheBytes);
+    WorkStealingPool pool(options.threads);
+    std::vector<Chunk> chunks(4 * pool.size());
+    std::vector<Chunk*> free;
+    for (auto& chunk : chunks) {
+        free.push_back(&chunk);
+    }
+    std::vector<std::string> files;
+    std::mutex doneMutex;
+    std::condition_variable doneChanged;
+    std::map<std::uint64_t, Chunk*> done; // zweryfikowane partie czekające na zapis
+    std::uint64_t submitted = 0, written = 0;
+    std::uint64_t counts[verdictCount] = {}, steps = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    // Zapisuje zweryfikowane partie w kolejności zgłoszeń; przy wait czeka na następną.
+    auto writeDone = [&](bool wait) {
+        while (written < submitted) {
+            Chunk* chunk;
+            {
+                std::unique_lock<std::mutex> lock(doneMutex);
+                if (wait) doneChanged.wait(lock, [&] { return done.count(written) != 0; });
+                auto found = done.find(written);
+                if (found == done.end()) return;
+                chunk = found->second;
+                done.erase(found);
+            }
+            const std::string& file = files[chunk->file];
+            for (std::size_t i = 0; i < chunk->batch.size(); ++i) {
+                const RunRecord& run = chunk->batch.runs[i];
+                const Result& result = chunk->results[i];
+                std::fprintf(csv, "%s,%llu,%llu,%u,%u,%u,%s,%u,%u\n", file.c_str(), (unsigned long long)(chunk->first + i),
+                             (unsigned long long)run.seed, (unsigned)run.difficulty, run.score, run.ticks,
+                             verdictNames[result.verdict], result.outcome.score, result.outcome.ticks);
+                counts[result.verdict]++;
+            }
+            steps += chunk->steps;
+            free.push_back(chunk);
+            written++;
+            wait = false;
+        }
+    };
+
+    bool corrupt = false;
+    InputList inputs(options.inputs);
+    std::string path;
+    while (inputs.next(path)) {
+        RunReader reader(path);
+        if (!reader.isOpen()) {
+            std::fprintf(stderr, "Nie udalo sie otworzyc %s\n", path.c_str());
+            corrupt = true;
+            continue;
+        }
+        files.push_back(path);
+        std::uint64_t index = 0;
+        bool more = true;
+        while (more) {
+            writeDone(free.empty());
+            Chunk* chunk = free.back();
+            free.pop_back();
+            more = reader.read(chunk->batch, chunkRuns);
+            if (chunk->batch.size() == 0) {
+                free.push_back(chunk);
+                break;
+            }
+            chunk->sequence = submitted++;
+            chunk->file = files.size() - 1;
+            chunk->first = index;
+            index += chunk->batch.size();
+            pool.submit([chunk, &cache, &options, &doneMutex, &doneChanged, &done] {
+                verifyChunk(*chunk, cache, options.maxTicks);
+                {
+                    std::lock_guard<std::mutex> lock(doneMutex);
+                    done[chunk->sequence] = chunk;
+                }
+                doneChanged.notify_one();
+            });
+        }
+        if (reader.isCorrupt()) {
+            std::fprintf(stderr, "Plik %s jest uszkodzony - zweryfikowano tylko %llu zgloszen\n", path.c_str(),
+                         (unsigned long long)index);
+            corrupt = true;
+        }
+    }
+    while (written < submitted) {
+        writeDone(true);
+    }
+    std::fclose(csv);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::uint64_t total = 0;
+    for (int v = 0; v < verdictCount; ++v) total += counts[v];
+    std::printf("zgloszenia: %llu, %.2f s, %.0f zgloszen/s, %.1f mln krokow/s, podkradzione zadania: %llu, "
+                "trafienia pamieci podrecznej: %llu\n",
+                (unsigned long long)total, elapsed.count(), (double)total / elapsed.count(),
+                (double)steps / elapsed.count() / 1e6, (unsigned long long)pool.getSteals(),
+                (unsigned long long)cache.getHits());
+    for (int v = 0; v < verdictCount; ++v) {
+        std::printf("  %-15s %llu\n", verdictNames[v], (unsigned long long)counts[v]);
+    }
+    return corrupt ? 1 : 0;
+}
@@ -0,0 +1,141 @@
+/**
+ * @file verify_cases.cpp
+ * @brief Sprawdzenie werdyktów Flappy_Bird_verify na spreparowanych zgłoszeniach.
+ *
+ * Użycie: Flappy_Bird_verify_cases ścieżka_do_Flappy_Bird_verify [katalog_roboczy]
+ *
+ * Program zapisuje plik zgłoszeń z rozgrywką prawdziwą i jej przeróbkami
+ * (zmieniony wynik, pierwsze machnięcie po kroku 0, brak machnięć, machnięcie
+ * po śmierci), uruchamia na nim weryfikator i porównuje werdykty z oczekiwanymi.
+ * Zwraca 1 przy pierwszej różnicy; zawieszenie weryfikatora wykrywa limit czasu
+ * testu w CTest.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "Bots.h"
+#include "RunLog.h"
+
+/**
+ * @brief Spreparowane zgłoszenie i oczekiwany werdykt.
+ */
+struct Case {
+    const char* name; /**< Opis przypadku. */
+    std::uint32_t score; /**< Zgłoszony wynik. */
+    std::uint32_t ticks; /**< Zgłoszony krok końca. */
+    std::vector<std::uint32_t> flaps; /**< Chwile machnięć. */
+    const char* verdict; /**< Oczekiwany werdykt. */
+};
+
+/**
+ * @brief Rozgrywa prawdziwą grę botem naśladującym gracza.
+ *
+ * @param seed Ziarno toru.
+ * @param flaps Chwile machnięć (wynik).
+ * @return Świat po śmierci ptaka.
+ */
+static World play(std::uint32_t seed, std::vector<std::uint32_t>& flaps) {
+    World world;
+    Simulation::reset(world, seed);
+    const auto rules = Simulation::RuntimeRules::of(Difficulty::Nightmare);
+    NoEvents events;
+    Bots::Human bot(Bots::casual, seed);
+    flaps.clear();
+    while (!world.over && world.ticks < 20000) {
+        bool flap = !world.running || bot(world);
+        if (flap) flaps.push_back(world.ticks);
+        Simulation::stepWith(world, RunLog::stepTime, flap, rules, events);
+    }
+    return world;
+}
+
+/**
+ * @brief Punkt wejścia narzędzia.
+ *
+ * @param argc Liczba argumentów.
+ * @param argv Argumenty wywołania.
+ * @return 0 jeśli wszystkie werdykty są zgodne z oczekiwanymi.
+ */
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "Uzycie: %s sciezka_do_Flappy_Bird_verify [katalog_roboczy]\n", argv[0]);
+        return 2;
+    }
+    const std::string dir = argc > 2 ? argv[2] : ".";
+    const std::string runs = dir + "/verify_cases.bin";
+    const std::string verdicts = dir + "/verify_cases.csv";
+
+    std::vector<std::uint32_t> flaps;
+    World world = play(7, flaps);
+    if (!world.over || flaps.size() < 2) {
+        std::fprintf(stderr, "Bot nie rozegral pelnej gry\n");
+        return 1;
+    }
+    std::vector<std::uint32_t> late = flaps;
+    for (auto& tick : late) tick += 5;
+    std::vector<std::uint32_t> afterDeath = flaps;
+    afterDeath.push_back(world.ticks + 1);
+
+    std::vector<Case> cases = {
+            {"prawdziwa gra", world.score, world.ticks, flaps, "accepted"},
+            {"zawyzony wynik", world.score + 1, world.ticks, flaps, "score_mismatch"},
+            {"zly krok konca", world.score, world.ticks + 1, flaps, "tick_mismatch"},
+            {"pierwsze machniecie w kroku 5", world.score, world.ticks, late, "malformed"},
+            {"jedno machniecie w kroku 5", 0, 100, {5}, "malformed"},
+            {"brak machniec", 0, 100, {}, "no_death"},
+            {"machniecie po smierci", world.score, world.ticks, afterDeath, "extra_inputs"},
+    };
+
+    std::remove(runs.c_str());
+    {
+        RunWriter writer(runs);
+        if (!writer.isOpen()) {
+            std::fprintf(stderr, "Nie udalo sie otworzyc %s\n", runs.c_str());
+            return 1;
+        }
+        for (const auto& c : cases) {
+            writer.append(7, Difficulty::Nightmare, PlayerModel::Yellow, c.score, c.ticks, c.flaps);
+        }
+    }
+
+    const std::string command = std::string("\"") + argv[1] + "\" \"" + runs + "\" --threads 2 --out \"" + verdicts + "\"";
+    if (std::system(command.c_str()) != 0) {
+        std::fprintf(stderr, "Weryfikator zakonczyl sie bledem\n");
+        return 1;
+    }
+
+    FILE* csv = std::fopen(verdicts.c_str(), "r");
+    if (!csv) {
+        std::fprintf(stderr, "Nie udalo sie otworzyc %s\n", verdicts.c_str());
+        return 1;
+    }
+    char line[512];
+    std::fgets(line, sizeof(line), csv);
+    std::size_t row = 0;
+    int failures = 0;
+    while (std::fgets(line, sizeof(line), csv)) {
+        // Werdykt to siódma kolumna.
+        const char* field = line;
+        for (int column = 0; column < 6 && field; ++column) {
+            field = std::strchr(field, ',');
+            if (field) field++;
+        }
+        std::string verdict = field ? std::string(field, std::strcspn(field, ",\n")) : "";
+        if (row >= cases.size() || verdict != cases[row].verdict) {
+            std::fprintf(stderr, "%s: oczekiwano %s, jest %s\n", row < cases.size() ? cases[row].name : "nadmiarowy wiersz",
+                         row < cases.size() ? cases[row].verdict : "-", verdict.c_str());
+            failures++;
+        }
+        row++;
+    }
+    std::fclose(csv);
+    if (row != cases.size()) {
+        std::fprintf(stderr, "Oczekiwano %zu werdyktow, jest %zu\n", cases.size(), row);
+        failures++;
+    }
+    std::printf("%zu przypadkow, %d niezgodnych\n", cases.size(), failures);
+    return failures == 0 ? 0 : 1;
+}
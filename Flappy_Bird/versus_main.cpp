@@ -0,0 +1,209 @@
+/**
+ * @file versus_main.cpp
+ * @brief Wyścig dwóch graczy w osobnych procesach, połączonych przez UDP na localhost.
+ *
+ * Użycie:
+ *   Flappy_Bird_versus <gracz 0|1> <port_lokalny> <port_przeciwnika> [--seed N] [--difficulty 0-3] [--headless KLATKI]
+ *
+ * Przykład na jednej maszynie:
+ *   Flappy_Bird_versus 0 7000 7001 &
+ *   Flappy_Bird_versus 1 7001 7000
+ *
+ * W trybie --headless obaj gracze są sterowani botem z losowymi machnięciami,
+ * a po zadanej liczbie klatek program wypisuje sumę kontrolną stanu. Oba procesy
+ * muszą wypisać tę samą sumę - to sprawdza, że cofanie stanu odtwarza dokładnie
+ * tę samą rozgrywkę.
+ */
+
+#include <SFML/Graphics.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include "BirdAtlas.h"
+#include "Bots.h"
+#include "Netplay.h"
+
+/**
+ * @brief Rozgrywa wyścig bez okna i wypisuje sumę kontrolną.
+ *
+ * @param session Sesja wyścigu.
+ * @param frames Liczba klatek do rozegrania.
+ * @return Kod zakończenia programu.
+ */
+static int runHeadless(RollbackSession& session, std::uint32_t frames) {
+    std::uint32_t rng = 0x1234567u + (std::uint32_t)session.getLocalPlayer() * 7919u;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+
+    while (session.getState().frame < frames) {
+        const World& mine = session.getState().players[session.getLocalPlayer()];
+        std::uint32_t attempt = rng;
+        if (!session.advance(Bots::jitter(mine, attempt))) {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        } else {
+            rng = attempt;
+        }
+        if (std::chrono::steady_clock::now() > deadline) {
+            std::fprintf(stderr, "Przekroczono czas oczekiwania na przeciwnika\n");
+            return 1;
+        }
+    }
+    while (session.getConfirmedFrames() < frames && std::chrono::steady_clock::now() < deadline) {
+        session.poll();
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    // Przeciwnik może jeszcze czekać na nasze ostatnie wejścia.
+    for (int i = 0; i < 50; ++i) {
+        session.poll();
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+
+    const auto& state = session.getState();
+    std::printf("gracz %d: klatki %u, wyniki %u/%u, suma %016llx, cofniecia %llu, klatki ponownie %llu, maks. cofniecie %llu us\n",
+                session.getLocalPlayer(), state.frame, state.players[0].score, state.players[1].score,
+                (unsigned long long)RollbackSession::checksum(state),
+                (unsigned long long)session.getRollbacks(), (unsigned long long)session.getResimulatedFrames(),
+                (unsigned long long)session.getMaxRollbackUs());
+    return session.getConfirmedFrames() >= frames ? 0 : 1;
+}
+
+/**
+ * @brief Rozgrywa wyścig w oknie.
+ *
+ * @param session Sesja wyścigu.
+ * @param difficulty Poziom trudności.
+ * @return Kod zakończenia programu.
+ */
+static int runWindow(RollbackSession& session, Difficulty difficulty) {
+    const int local = session.getLocalPlayer();
+    sf::RenderWindow window(sf::VideoMode(450, 700), "Flappy Bird - wyscig, gracz " + std::to_string(local + 1));
+    window.setFramerateLimit(60);
+
+    const DifficultyRules& rules = rulesFor(difficulty);
+    sf::Texture background, ground, upperPipe, lowerPipe, coin;
+    background.loadFromFile(rules.background);
+    ground.loadFromFile("res/textures/ground.png");
+    coin.loadFromFile("res/textures/coin.png");
+    sf::Image pipeImage;
+    pipeImage.loadFromFile("res/textures/pipe.png");
+    upperPipe.loadFromImage(pipeImage);
+    pipeImage.flipVertically();
+    lowerPipe.loadFromImage(pipeImage);
+    sf::Font font;
+    font.loadFromFile("res/fonts/04B_19__.TTF");
+    const BirdAtlas& atlas = BirdAtlas::get();
+
+    sf::Text status("", font, 24);
+    sf::RectangleShape lowerRectangle({450, 700 - Physics::floorY - (float)ground.getSize().y});
+    lowerRectangle.setPosition(0, Physics::floorY + (float)ground.getSize().y);
+    lowerRectangle.setFillColor({245, 228, 138});
+
+    bool flapQueued = false;
+    float animation = 0;
+    while (window.isOpen()) {
+        sf::Event event{};
+        while (window.pollEvent(event)) {
+            if (event.type == sf::Event::Closed) window.close();
+            if ((event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Space) ||
+                (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left)) {
+                flapQueued = true;
+            }
+        }
+
+        // Dopóki przeciwnik się nie odezwie, sesja wykona najwyżej maxRollback klatek i będzie czekać.
+        if (session.advance(flapQueued)) {
+            flapQueued = false;
+            animation += RollbackSession::frameTime * 4;
+            if (animation >= BirdAtlas::animationFrames) animation -= BirdAtlas::animationFrames;
+        }
+
+        const auto& state = session.getState();
+        const World& mine = state.players[local];
+        const World& rival = state.players[1 - local];
+
+        window.clear();
+        window.draw(sf::Sprite(background));
+        for (int i = 0; i < mine.pipeCount; ++i) {
+            const auto& pipe = mine.pipes[i];
+            sf::Sprite upper(upperPipe);
+            upper.setPosition(pipe.x, pipe.y + pipe.throat);
+            sf::Sprite lower(lowerPipe);
+            lower.setPosition(pipe.x, pipe.y - pipe.throat);
+            window.draw(upper);
+            window.draw(lower);
+            if (pipe.coinVisible) {
+                sf::Sprite coinSprite(coin);
+                coinSprite.setPosition(pipe.x, pipe.y + pipe.throat / rules.coinOffsetDivisor);
+                window.draw(coinSprite);
+            }
+        }
+        sf::Sprite groundSprite(ground);
+        groundSprite.setPosition(-(float)((int)(state.frame * 100 / 60) % 24), Physics::floorY);
+        window.draw(groundSprite);
+        window.draw(lowerRectangle);
+
+        const World* birds[2] = {&rival, &mine};
+        for (int i = 0; i < 2; ++i) {
+            sf::Sprite bird(atlas.getTexture(), atlas.getFrameRect(i == 0 ? PlayerModel::Red : PlayerModel::Blue, (int)animation));
+            bird.setRotation(8 * (birds[i]->birdVel / 400));
+            bird.setPosition(Physics::birdX, birds[i]->birdY);
+            if (i == 0) bird.setColor({255, 255, 255, 140});
+            window.draw(bird);
+        }
+
+        std::string text = "Ty: " + std::to_string(mine.score) + "   Rywal: " + std::to_string(rival.score);
+        if (!session.connected()) {
+            text = "Czekam na przeciwnika...";
+        } else if (mine.over && rival.over) {
+            bool won = mine.ticks != rival.ticks ? mine.ticks > rival.ticks : mine.score > rival.score;
+            bool draw = mine.ticks == rival.ticks && mine.score == rival.score;
+            text += draw ? "   REMIS" : (won ? "   WYGRANA" : "   PRZEGRANA");
+        }
+        status.setString(text);
+        status.setPosition(225 - status.getLocalBounds().width / 2, 5);
+        window.draw(status);
+        window.display();
+    }
+
+    std::printf("cofniecia %llu, klatki ponownie %llu, maks. cofniecie %llu us\n",
+                (unsigned long long)session.getRollbacks(), (unsigned long long)session.getResimulatedFrames(),
+                (unsigned long long)session.getMaxRollbackUs());
+    return 0;
+}
+
+/**
+ * @brief Punkt wejścia programu.
+ *
+ * @param argc Liczba argumentów.
+ * @param argv Argumenty wywołania.
+ * @return Kod zakończenia programu.
+ */
+int main(int argc, char** argv) {
+    if (argc < 4) {
+        std::fprintf(stderr, "Uzycie: %s <gracz 0|1> <port_lokalny> <port_przeciwnika> [--seed N] [--difficulty 0-3] [--headless KLATKI]\n", argv[0]);
+        return 2;
+    }
+    int player = std::atoi(argv[1]) == 1 ? 1 : 0;
+    auto localPort = (std::uint16_t)std::atoi(argv[2]);
+    auto remotePort = (std::uint16_t)std::atoi(argv[3]);
+    std::uint32_t seed = 2024;
+    int difficulty = static_cast<int>(Difficulty::Medium);
+    std::uint32_t headlessFrames = 0;
+    for (int i = 4; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--seed") == 0) seed = (std::uint32_t)std::strtoul(argv[i + 1], nullptr, 10);
+        else if (std::strcmp(argv[i], "--difficulty") == 0) difficulty = std::atoi(argv[i + 1]) & 3;
+        else if (std::strcmp(argv[i], "--headless") == 0) headlessFrames = (std::uint32_t)std::strtoul(argv[i + 1], nullptr, 10);
+    }
+
+    RollbackSession session(player, seed, static_cast<Difficulty>(difficulty));
+    if (!session.open(localPort, remotePort)) {
+        std::fprintf(stderr, "Nie udalo sie otworzyc portu UDP %u\n", localPort);
+        return 1;
+    }
+    if (headlessFrames > 0) {
+        return runHeadless(session, headlessFrames);
+    }
+    return runWindow(session, static_cast<Difficulty>(difficulty));
+}